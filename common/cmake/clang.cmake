@@ -22,6 +22,7 @@ SET(FLAGS_SSE42 "-msse4.2")
 SET(FLAGS_AVX   "-mavx")
 SET(FLAGS_AVX2  "-mf16c -mavx2 -mfma -mlzcnt -mbmi -mbmi2")
 SET(FLAGS_AVX512KNL "-mavx512")
+SET(FLAGS_AVX512SKX "-mf16c -mavx2 -mfma -mlzcnt -mbmi -mbmi2 -mavx512f -mavx512dq -mavx512cd -mavx512bw -mavx512vl")
 
 IF (WIN32)
 
@@ -29,6 +29,7 @@ ELSE()
   SET(FLAGS_AVX2  "/arch:AVX2 /DCONFIG_AVX2 /QxCORE-AVX2")
 ENDIF()
 SET(FLAGS_AVX512KNL "")
+SET(FLAGS_AVX512SKX "")
 
 SET(COMMON_CXX_FLAGS "/EHsc /MP /GR ")
 
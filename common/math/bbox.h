@@ -145,6 +145,9 @@ namespace embree
   template<typename T> __forceinline BBox<T> operator +( const BBox<T>& a, const      T & b ) { return BBox<T>(a.lower+b      ,a.upper+b      ); }
   template<typename T> __forceinline BBox<T> operator -( const BBox<T>& a, const      T & b ) { return BBox<T>(a.lower-b      ,a.upper-b      ); }
 
+  /*! linear interpolation of bounding boxes */
+  template<typename T> __forceinline BBox<T> lerp(const BBox<T>& b0, const BBox<T>& b1, const float t) { return BBox<T>((1.0f-t)*b0.lower+t*b1.lower,(1.0f-t)*b0.upper+t*b1.upper); }
+
   /*! extension */
   template<typename T> __forceinline BBox<T> enlarge(const BBox<T>& a, const T& b) { return BBox<T>(a.lower-b, a.upper+b); }
 
@@ -176,6 +179,7 @@ namespace embree
   }
 
   /*! default template instantiations */
+  typedef BBox<float> BBox1f;
   typedef BBox<Vec2f> BBox2f;
   typedef BBox<Vec3f> BBox3f;
   typedef BBox<Vec3fa> BBox3fa;
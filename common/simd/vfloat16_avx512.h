@@ -263,8 +263,12 @@ namespace embree
   __forceinline const vfloat16 signmsk   ( const vfloat16& a ) { return _mm512_castsi512_ps(_mm512_and_epi32(_mm512_castps_si512(a),_mm512_set1_epi32(0x80000000))); }
 
   __forceinline const vfloat16 rcp  ( const vfloat16& a ) {
-#if defined(__AVX512F__)
+#if defined(__AVX512ER__)
     return _mm512_rcp28_ps(a); 
+#elif defined(__AVX512F__)
+    /* without AVX512ER refine the 14 bit approximation by one Newton-Raphson step */
+    const vfloat16 r = _mm512_rcp14_ps(a);
+    return _mm512_mul_ps(r,_mm512_fnmadd_ps(r,a,vfloat16(2.0f)));
 #else
     return _mm512_rcp23_ps(a); 
 #endif
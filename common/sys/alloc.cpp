@@ -35,6 +35,17 @@
 
 namespace embree
 {
+  HugePagePolicy hugePagePolicy = HUGE_PAGES_AUTO;
+
+  void os_set_huge_page_policy(HugePagePolicy policy) {
+    /* large pages require special privileges on Windows, thus standard pages are always used */
+    hugePagePolicy = policy;
+  }
+
+  HugePagePolicy os_get_huge_page_policy() {
+    return hugePagePolicy;
+  }
+
   void* os_malloc(size_t bytes, const int additional_flags) 
   {
     int flags = MEM_COMMIT|MEM_RESERVE|additional_flags;
@@ -68,6 +79,33 @@ namespace embree
     if (bytes == 0) return;
     VirtualFree(ptr,0,MEM_RELEASE);
   }
+
+  void* os_map_file(const char* fileName, size_t& bytes)
+  {
+    HANDLE file = CreateFileA(fileName,GENERIC_READ,FILE_SHARE_READ,nullptr,OPEN_EXISTING,FILE_ATTRIBUTE_NORMAL,nullptr);
+    if (file == INVALID_HANDLE_VALUE) return nullptr;
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file,&size) || size.QuadPart == 0) {
+      CloseHandle(file);
+      return nullptr;
+    }
+
+    /* the view keeps the mapping alive, thus we can close all handles */
+    HANDLE mapping = CreateFileMappingA(file,nullptr,PAGE_READONLY,0,0,nullptr);
+    CloseHandle(file);
+    if (mapping == nullptr) return nullptr;
+    void* ptr = MapViewOfFile(mapping,FILE_MAP_READ,0,0,0);
+    CloseHandle(mapping);
+    if (ptr == nullptr) return nullptr;
+
+    bytes = (size_t) size.QuadPart;
+    return ptr;
+  }
+
+  void os_unmap_file(void* ptr, size_t bytes) {
+    if (ptr) UnmapViewOfFile(ptr);
+  }
 }
 #endif
 
@@ -78,6 +116,9 @@ namespace embree
 #if defined(__UNIX__)
 
 #include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
 #include <errno.h>
 #include <stdlib.h>
 #include <string.h>
@@ -118,10 +159,31 @@ namespace embree
 // ============================================
 
   bool tryDirectHugePageAllocation = true;
+  HugePagePolicy hugePagePolicy = HUGE_PAGES_AUTO;
+
+  void os_set_huge_page_policy(HugePagePolicy policy)
+  {
+    /* keep a hugetlbfs failure in auto mode disabled if the policy does not change */
+    if (policy == hugePagePolicy) return;
+    hugePagePolicy = policy;
+    tryDirectHugePageAllocation = policy == HUGE_PAGES_AUTO || policy == HUGE_PAGES_HUGETLBFS;
+  }
+
+  HugePagePolicy os_get_huge_page_policy() {
+    return hugePagePolicy;
+  }
 
 #if USE_MADVISE
   void os_madvise(void *ptr, size_t bytes)
   {
+    /* explicitly opt out of transparent huge pages in case they are enabled system wide */
+    if (hugePagePolicy == HUGE_PAGES_OFF) {
+#ifdef MADV_NOHUGEPAGE
+      madvise(ptr,bytes,MADV_NOHUGEPAGE);
+#endif
+      return;
+    }
+
 #ifdef MADV_HUGEPAGE
     int res = madvise(ptr,bytes,MADV_HUGEPAGE); 
 #if defined(DEBUG)
@@ -131,6 +193,26 @@ namespace embree
 #endif
   }
 #endif
+
+  /*! tries to map hugetlbfs pages, returns nullptr on failure */
+  void* os_malloc_hugetlb(size_t bytes)
+  {
+#if !defined(__MACOSX__)
+    if (!tryDirectHugePageAllocation)
+      return nullptr;
+
+    const int hugePageFlags = MAP_ANONYMOUS | MAP_PRIVATE | MAP_HUGETLB;
+    void* ptr = (char*) mmap(0, bytes, PROT_READ | PROT_WRITE, hugePageFlags, -1, 0);
+    if (ptr != nullptr && ptr != MAP_FAILED)
+      return ptr;
+
+    /* in auto mode direct huge page allocation gets disabled for the
+     * future, an explicitly requested huge page pool may get refilled */
+    if (hugePagePolicy == HUGE_PAGES_AUTO)
+      tryDirectHugePageAllocation = false;
+#endif
+    return nullptr;
+  }
   
   void* os_malloc(size_t bytes, const int additional_flags)
   {
@@ -143,22 +225,9 @@ namespace embree
 #endif
       bytes = (bytes+PAGE_SIZE_2M-1)&ssize_t(-PAGE_SIZE_2M);
 
-#if !defined(__MACOSX__)
       /* try direct huge page allocation first */
-      if (tryDirectHugePageAllocation)
-      {
-        const int hugePageFlags = MAP_ANONYMOUS | MAP_PRIVATE | MAP_HUGETLB;
-        void* ptr = (char*) mmap(0, bytes, PROT_READ | PROT_WRITE, hugePageFlags, -1, 0);
-        
-        if (ptr == nullptr || ptr == MAP_FAILED)
-        {
-          /* direct huge page allocation failed, disable it for the future */
-          tryDirectHugePageAllocation = false;     
-        }
-        else
-          return ptr;
-      }
-#endif
+      if (void* ptr = os_malloc_hugetlb(bytes))
+        return ptr;
     } 
     else
       bytes = (bytes+PAGE_SIZE_4K-1)&ssize_t(-PAGE_SIZE_4K);
@@ -187,22 +256,9 @@ namespace embree
 #endif
       bytes = (bytes+PAGE_SIZE_2M-1)&ssize_t(-PAGE_SIZE_2M);
 
-#if !defined(__MACOSX__)
       /* try direct huge page allocation first */
-      if (tryDirectHugePageAllocation)
-      {
-        const int hugePageFlags = MAP_ANONYMOUS | MAP_PRIVATE | MAP_HUGETLB;
-        void* ptr = (char*) mmap(0, bytes, PROT_READ | PROT_WRITE, hugePageFlags, -1, 0);
-      
-        if (ptr == nullptr || ptr == MAP_FAILED)
-        {
-          /* direct huge page allocation failed, disable it for the future */
-          tryDirectHugePageAllocation = false;     
-        }
-        else
-          return ptr;          
-      }
-#endif
+      if (void* ptr = os_malloc_hugetlb(bytes))
+        return ptr;
     } 
     else
       bytes = (bytes+PAGE_SIZE_4K-1)&ssize_t(-PAGE_SIZE_4K);
@@ -265,6 +321,30 @@ namespace embree
       throw std::bad_alloc();
     }
   }
+
+  void* os_map_file(const char* fileName, size_t& bytes)
+  {
+    int fd = open(fileName,O_RDONLY);
+    if (fd == -1) return nullptr;
+
+    struct stat st;
+    if (fstat(fd,&st) == -1 || st.st_size == 0) {
+      close(fd);
+      return nullptr;
+    }
+
+    /* the mapping stays valid after closing the file descriptor */
+    void* ptr = mmap(0, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (ptr == nullptr || ptr == MAP_FAILED) return nullptr;
+
+    bytes = st.st_size;
+    return ptr;
+  }
+
+  void os_unmap_file(void* ptr, size_t bytes) {
+    if (ptr) munmap(ptr,bytes);
+  }
 }
 
 #endif
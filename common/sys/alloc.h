@@ -84,6 +84,21 @@ namespace embree
       }
     };
 
+  /*! huge page policy of OS allocations */
+  enum HugePagePolicy 
+  {
+    HUGE_PAGES_AUTO,      //!< tries hugetlbfs pages once, then uses transparent huge pages
+    HUGE_PAGES_OFF,       //!< uses standard pages only
+    HUGE_PAGES_THP,       //!< uses transparent huge pages
+    HUGE_PAGES_HUGETLBFS  //!< uses hugetlbfs pages, falls back to transparent huge pages if the huge page pool is exhausted
+  };
+
+  /*! sets the huge page policy of all following OS allocations, the policy is process wide */
+  void os_set_huge_page_policy(HugePagePolicy policy);
+
+  /*! returns the current huge page policy */
+  HugePagePolicy os_get_huge_page_policy();
+
   /*! allocates pages directly from OS */
   void* os_malloc (size_t bytes, const int additional_flags = 0);
   void* os_reserve(size_t bytes);
@@ -91,6 +106,10 @@ namespace embree
   size_t os_shrink (void* ptr, size_t bytesNew, size_t bytesOld);
   void  os_free   (void* ptr, size_t bytes);
 
+  /*! maps a file read-only into memory, returns nullptr on failure */
+  void* os_map_file  (const char* fileName, size_t& bytes);
+  void  os_unmap_file(void* ptr, size_t bytes);
+
   /*! allocator that performs OS allocations */
   template<typename T>
     struct os_allocator
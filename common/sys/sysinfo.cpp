@@ -18,6 +18,8 @@
 #include "intrinsics.h"
 #include "string.h"
 
+#include <algorithm>
+
 ////////////////////////////////////////////////////////////////////////////////
 /// All Platforms
 ////////////////////////////////////////////////////////////////////////////////
@@ -324,6 +326,7 @@ namespace embree
     if (isa == AVX) return "AVX";
     if (isa == AVX2) return "AVX2";
     if (isa == AVX512KNL) return "AVX512KNL";
+    if (isa == AVX512SKX) return "AVX512SKX";
     if (isa == KNC) return "KNC";
     return "UNKNOWN";
   }
@@ -345,9 +348,81 @@ namespace embree
     if (hasISA(features,AVXI)) v += "AVXI ";
     if (hasISA(features,AVX2)) v += "AVX2 ";
     if (hasISA(features,AVX512KNL)) v += "AVX512KNL ";
+    if (hasISA(features,AVX512SKX)) v += "AVX512SKX ";
     if (hasISA(features,KNC)) v += "KNC ";
     return v;
   }
+
+  /*! topology for systems we cannot query, every logical thread is its own core */
+  static std::vector<CPULocation> getFlatCPUTopology()
+  {
+    std::vector<CPULocation> topology(getNumberOfLogicalThreads());
+    for (size_t i=0; i<topology.size(); i++) {
+      topology[i].cpu = i;
+      topology[i].core = i;
+      topology[i].socket = 0;
+    }
+    return topology;
+  }
+
+  std::vector<CPULocation> getThreadPinningOrder(ThreadAffinity affinity) {
+    return getThreadPinningOrder(affinity,getCPUTopology());
+  }
+
+  std::vector<CPULocation> getThreadPinningOrder(ThreadAffinity affinity, const std::vector<CPULocation>& topology)
+  {
+    if (affinity == AFFINITY_NONE || affinity == AFFINITY_LINEAR) 
+      return topology;
+
+    /* rank each logical thread within its core and each core within its socket */
+    struct Key { size_t smt, core, socket, index; };
+    std::vector<Key> keys(topology.size());
+    for (size_t i=0; i<topology.size(); i++) 
+    {
+      std::vector<size_t> cores;
+      keys[i].smt = 0;
+      for (size_t j=0; j<topology.size(); j++) {
+        if (topology[j].core == topology[i].core && j < i) keys[i].smt++;
+        if (topology[j].socket == topology[i].socket && topology[j].core < topology[i].core) cores.push_back(topology[j].core);
+      }
+      std::sort(cores.begin(),cores.end());
+      keys[i].core = std::unique(cores.begin(),cores.end())-cores.begin();
+      keys[i].socket = topology[i].socket;
+      keys[i].index = i;
+    }
+
+    switch (affinity) 
+    {
+    case AFFINITY_COMPACT: 
+      std::sort(keys.begin(),keys.end(),[] (const Key& a, const Key& b) { 
+          if (a.socket != b.socket) return a.socket < b.socket;
+          if (a.core   != b.core  ) return a.core   < b.core;
+          return a.smt < b.smt;
+        });
+      break;
+    case AFFINITY_SCATTER: 
+      std::sort(keys.begin(),keys.end(),[] (const Key& a, const Key& b) { 
+          if (a.smt    != b.smt   ) return a.smt    < b.smt;
+          if (a.core   != b.core  ) return a.core   < b.core;
+          return a.socket < b.socket;
+        });
+      break;
+    case AFFINITY_SOCKET: 
+      std::sort(keys.begin(),keys.end(),[] (const Key& a, const Key& b) { 
+          if (a.socket != b.socket) return a.socket < b.socket;
+          if (a.smt    != b.smt   ) return a.smt    < b.smt;
+          return a.core < b.core;
+        });
+      break;
+    default:
+      break;
+    }
+
+    std::vector<CPULocation> order(keys.size());
+    for (size_t i=0; i<keys.size(); i++) 
+      order[i] = topology[keys[i].index];
+    return order;
+  }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -401,6 +476,53 @@ namespace embree
     return nThreads;
   }
 
+  size_t getNumberOfNumaNodes() 
+  {
+    ULONG highestNode = 0;
+    if (!GetNumaHighestNodeNumber(&highestNode)) return 1;
+    return highestNode+1;
+  }
+
+  size_t getCurrentNumaNode() 
+  {
+    UCHAR node = 0;
+    if (!GetNumaProcessorNode((UCHAR)GetCurrentProcessorNumber(),&node) || node == 0xFF) return 0;
+    return node;
+  }
+
+  std::vector<CPULocation> getCPUTopology()
+  {
+    std::vector<CPULocation> topology = getFlatCPUTopology();
+
+    /* only the processors of the first processor group are reported */
+    DWORD bytes = 0;
+    GetLogicalProcessorInformation(nullptr,&bytes);
+    if (GetLastError() != ERROR_INSUFFICIENT_BUFFER) return topology;
+    std::vector<SYSTEM_LOGICAL_PROCESSOR_INFORMATION> infos(bytes/sizeof(SYSTEM_LOGICAL_PROCESSOR_INFORMATION));
+    if (!GetLogicalProcessorInformation(infos.data(),&bytes)) return topology;
+
+    const size_t maxCPUs = std::min(topology.size(),size_t(8*sizeof(ULONG_PTR)));
+    size_t cores = 0, sockets = 0;
+    for (size_t i=0; i<infos.size(); i++)
+    {
+      const SYSTEM_LOGICAL_PROCESSOR_INFORMATION& info = infos[i];
+      if (info.Relationship != RelationProcessorCore && info.Relationship != RelationProcessorPackage) 
+        continue;
+
+      const size_t id = info.Relationship == RelationProcessorCore ? cores++ : sockets++;
+      for (size_t cpu=0; cpu<maxCPUs; cpu++) {
+        if (!(info.ProcessorMask & (ULONG_PTR(1) << cpu))) continue;
+        if (info.Relationship == RelationProcessorCore) topology[cpu].core = id;
+        else                                            topology[cpu].socket = id;
+      }
+    }
+
+    /* treat processors of other groups as separate cores */
+    for (size_t cpu=maxCPUs; cpu<topology.size(); cpu++)
+      topology[cpu].core = cores+cpu;
+    return topology;
+  }
+
   int getTerminalWidth() 
   {
     HANDLE handle = GetStdHandle(STD_OUTPUT_HANDLE);
@@ -427,6 +549,8 @@ namespace embree
 
 #include <stdio.h>
 #include <unistd.h>
+#include <sched.h>
+#include <vector>
 
 namespace embree
 {
@@ -438,6 +562,78 @@ namespace embree
     if (bytes != -1) buf[bytes] = '\0';
     return std::string(buf);
   }
+
+  /*! maps each logical CPU to its NUMA node using the sysfs node directories */
+  static std::vector<size_t> computeNumaNodeOfCPU()
+  {
+    std::vector<size_t> nodeOfCPU(getNumberOfLogicalThreads(),0);
+    for (size_t node=0; node<getNumberOfNumaNodes(); node++) {
+      for (size_t cpu=0; cpu<nodeOfCPU.size(); cpu++) {
+        char path[256]; sprintf(path,"/sys/devices/system/node/node%d/cpu%d",int(node),int(cpu));
+        if (access(path,F_OK) == 0) nodeOfCPU[cpu] = node;
+      }
+    }
+    return nodeOfCPU;
+  }
+
+  size_t getNumberOfNumaNodes() 
+  {
+    static int nNodes = -1;
+    if (nNodes != -1) return nNodes;
+
+    int nodes = 0;
+    for (size_t node=0; ; node++) {
+      char path[256]; sprintf(path,"/sys/devices/system/node/node%d",int(node));
+      if (access(path,F_OK) != 0) break;
+      nodes++;
+    }
+    return nNodes = nodes ? nodes : 1;
+  }
+
+  size_t getCurrentNumaNode() 
+  {
+    if (getNumberOfNumaNodes() == 1) return 0;
+    static const std::vector<size_t> nodeOfCPU = computeNumaNodeOfCPU();
+    const int cpu = sched_getcpu();
+    if (cpu < 0 || size_t(cpu) >= nodeOfCPU.size()) return 0;
+    return nodeOfCPU[cpu];
+  }
+
+  /*! reads a single integer from some sysfs file */
+  static bool readSysInt(const char* path, size_t& value)
+  {
+    FILE* file = fopen(path,"r");
+    if (!file) return false;
+    int v = 0;
+    const bool ok = fscanf(file,"%d",&v) == 1 && v >= 0;
+    fclose(file);
+    value = v;
+    return ok;
+  }
+
+  std::vector<CPULocation> getCPUTopology()
+  {
+    std::vector<CPULocation> topology = getFlatCPUTopology();
+
+    /* core IDs are only unique within a socket */
+    std::vector<std::pair<size_t,size_t> > cores;
+    for (size_t cpu=0; cpu<topology.size(); cpu++) 
+    {
+      size_t core = 0, socket = 0;
+      char path[256]; 
+      sprintf(path,"/sys/devices/system/cpu/cpu%d/topology/core_id",int(cpu));
+      if (!readSysInt(path,core)) return getFlatCPUTopology();
+      sprintf(path,"/sys/devices/system/cpu/cpu%d/topology/physical_package_id",int(cpu));
+      if (!readSysInt(path,socket)) return getFlatCPUTopology();
+      
+      const std::pair<size_t,size_t> key(socket,core);
+      size_t id = std::find(cores.begin(),cores.end(),key)-cores.begin();
+      if (id == cores.size()) cores.push_back(key);
+      topology[cpu].core = id;
+      topology[cpu].socket = socket;
+    }
+    return topology;
+  }
 }
 
 #endif
@@ -459,6 +655,18 @@ namespace embree
     if (_NSGetExecutablePath(buf, &size) != 0) return std::string();
     return std::string(buf);
   }
+
+  size_t getNumberOfNumaNodes() {
+    return 1;
+  }
+
+  size_t getCurrentNumaNode() {
+    return 0;
+  }
+
+  std::vector<CPULocation> getCPUTopology() {
+    return getFlatCPUTopology();
+  }
 }
 
 #endif
@@ -27,11 +27,17 @@
 
 #include "platform.h"
 
+#include <vector>
+
 /* define isa namespace and ISA bitvector */
 #if defined(__MIC__)
 #  define isa knc
 #  define ISA KNC
 #  define ISA_STR "KNC"
+#elif defined (__AVX512VL__)
+#  define isa avx512skx
+#  define ISA AVX512SKX
+#  define ISA_STR "AVX512SKX"
 #elif defined (__AVX512F__)
 #  define isa avx512
 #  define ISA AVX512KNL
@@ -164,6 +170,7 @@ namespace embree
   static const int AVXI   = AVX | CPU_FEATURE_F16C | CPU_FEATURE_RDRAND;
   static const int AVX2   = AVXI | CPU_FEATURE_AVX2 | CPU_FEATURE_FMA3 | CPU_FEATURE_BMI1 | CPU_FEATURE_BMI2 | CPU_FEATURE_LZCNT;
   static const int AVX512KNL = AVX2 | CPU_FEATURE_AVX512F | CPU_FEATURE_AVX512PF | CPU_FEATURE_AVX512ER | CPU_FEATURE_AVX512CD;
+  static const int AVX512SKX = AVX2 | CPU_FEATURE_AVX512F | CPU_FEATURE_AVX512DQ | CPU_FEATURE_AVX512CD | CPU_FEATURE_AVX512BW | CPU_FEATURE_AVX512VL;
   static const int KNC    = CPU_FEATURE_KNC;
 
   /*! converts ISA bitvector into a string */
@@ -171,6 +178,39 @@ namespace embree
 
   /*! return the number of logical threads of the system */
   size_t getNumberOfLogicalThreads();
+
+  /*! return the number of NUMA nodes of the system */
+  size_t getNumberOfNumaNodes();
+
+  /*! return the NUMA node the calling thread currently runs on */
+  size_t getCurrentNumaNode();
+
+  /*! location of a logical thread in the processor topology */
+  struct CPULocation
+  {
+    size_t cpu;     //!< ID of the logical thread as used for setting the affinity
+    size_t core;    //!< system wide unique ID of the physical core
+    size_t socket;  //!< ID of the processor package
+  };
+
+  /*! returns the location of all logical threads of the system */
+  std::vector<CPULocation> getCPUTopology();
+
+  /*! policies for pinning worker threads to logical threads */
+  enum ThreadAffinity
+  {
+    AFFINITY_NONE,     //!< threads are not pinned
+    AFFINITY_LINEAR,   //!< thread i is pinned to logical thread i
+    AFFINITY_COMPACT,  //!< fills all logical threads of a core, then the next core of the same socket
+    AFFINITY_SCATTER,  //!< one thread per core, alternating between sockets, SMT siblings last
+    AFFINITY_SOCKET    //!< one thread per core of a socket, then its SMT siblings, then the next socket
+  };
+
+  /*! returns the logical threads worker threads get pinned to in order of the thread index */
+  std::vector<CPULocation> getThreadPinningOrder(ThreadAffinity affinity);
+
+  /*! returns the pinning order for some given topology */
+  std::vector<CPULocation> getThreadPinningOrder(ThreadAffinity affinity, const std::vector<CPULocation>& topology);
   
   /*! returns the size of the terminal window in characters */
   int getTerminalWidth();
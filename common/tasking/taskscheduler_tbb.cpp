@@ -28,6 +28,7 @@ namespace embree
   size_t TaskSchedulerTBB::g_numThreads = 0;
   __thread TaskSchedulerTBB* TaskSchedulerTBB::g_instance = nullptr;
   __thread TaskSchedulerTBB::Thread* TaskSchedulerTBB::thread_local_thread = nullptr;
+  __thread const CPULocation* TaskSchedulerTBB::thread_local_location = nullptr;
   TaskSchedulerTBB::ThreadPool* TaskSchedulerTBB::threadPool = nullptr;
 
   template<typename Predicate, typename Body>
@@ -139,8 +140,12 @@ namespace embree
     pool->thread_loop(threadIndex);
   }
 
-  TaskSchedulerTBB::ThreadPool::ThreadPool(bool set_affinity)
-    : numThreads(0), numThreadsRunning(0), set_affinity(set_affinity), running(false) {}
+  TaskSchedulerTBB::ThreadPool::ThreadPool(ThreadAffinity affinity)
+    : numThreads(0), numThreadsRunning(0), affinity(affinity), running(false) 
+  {
+    if (affinity != AFFINITY_NONE)
+      pinning = getThreadPinningOrder(affinity);
+  }
 
   __dllexport void TaskSchedulerTBB::ThreadPool::startThreads()
   {
@@ -170,7 +175,8 @@ namespace embree
     {
       if (t == 0) continue;
       auto pair = std::make_pair(this,t);
-      threads.push_back(createThread((thread_func)threadPoolFunction,&pair,4*1024*1024,set_affinity ? t : -1));
+      const ssize_t cpu = pinning.size() ? pinning[t % pinning.size()].cpu : -1;
+      threads.push_back(createThread((thread_func)threadPoolFunction,&pair,4*1024*1024,cpu));
       g_barrier.wait();
     }
 
@@ -216,6 +222,9 @@ namespace embree
 
   void TaskSchedulerTBB::ThreadPool::thread_loop(size_t globalThreadIndex)
   {
+    if (pinning.size()) 
+      thread_local_location = &pinning[globalThreadIndex % pinning.size()];
+
     while (globalThreadIndex < numThreadsRunning)
     {
       Ref<TaskSchedulerTBB> scheduler = NULL;
@@ -284,9 +293,9 @@ namespace embree
     return g_instance;
   }
 
-  void TaskSchedulerTBB::create(size_t numThreads, bool set_affinity)
+  void TaskSchedulerTBB::create(size_t numThreads, ThreadAffinity affinity)
   {
-    if (!threadPool) threadPool = new TaskSchedulerTBB::ThreadPool(set_affinity);
+    if (!threadPool) threadPool = new TaskSchedulerTBB::ThreadPool(affinity);
     threadPool->setNumThreads(numThreads,false);
   }
 
@@ -345,6 +354,7 @@ namespace embree
     /* allocate thread structure */
     std::unique_ptr<Thread> mthread(new Thread(threadIndex,this)); // too large for stack allocation
     Thread& thread = *mthread;
+    thread.location = thread_local_location;
     threadLocal[threadIndex] = &thread;
     Thread* oldThread = swapThread(&thread);
 
@@ -372,23 +382,41 @@ namespace embree
     return except;
   }
 
+  /*! distance between two threads, 0 for SMT siblings, 1 for the same socket, 2 otherwise */
+  static __forceinline size_t stealDistance(const CPULocation* a, const CPULocation* b)
+  {
+    if (a == nullptr || b == nullptr) return 2;
+    if (a->core   == b->core  ) return 0;
+    if (a->socket == b->socket) return 1;
+    return 2;
+  }
+
   bool TaskSchedulerTBB::steal_from_other_threads(Thread& thread)
   {
     const size_t threadIndex = thread.threadIndex;
     const size_t threadCount = this->threadCounter;
 
-    for (size_t i=1; i<threadCount; i++) 
+    /* pinned threads first steal from their SMT siblings, then
+     * from threads of the same socket, and only then across sockets */
+    const size_t levels = thread.location ? 3 : 1;
+    for (size_t level=0; level<levels; level++)
     {
-      __pause_cpu(32);
-      size_t otherThreadIndex = threadIndex+i;
-      if (otherThreadIndex >= threadCount) otherThreadIndex -= threadCount;
+      for (size_t i=1; i<threadCount; i++) 
+      {
+        size_t otherThreadIndex = threadIndex+i;
+        if (otherThreadIndex >= threadCount) otherThreadIndex -= threadCount;
 
-      Thread* othread = threadLocal[otherThreadIndex];
-      if (!othread)
-        continue;
+        Thread* othread = threadLocal[otherThreadIndex];
+        if (!othread)
+          continue;
 
-      if (othread->tasks.steal(thread)) 
-        return true;      
+        if (thread.location && stealDistance(thread.location,othread->location) != level)
+          continue;
+
+        __pause_cpu(32);
+        if (othread->tasks.steal(thread)) 
+          return true;      
+      }
     }
 
     return false;
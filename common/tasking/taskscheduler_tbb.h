@@ -20,6 +20,7 @@
 #include "../sys/alloc.h"
 #include "../sys/barrier.h"
 #include "../sys/thread.h"
+#include "../sys/sysinfo.h"
 #include "../sys/mutex.h"
 #include "../sys/condition.h"
 #include "../sys/ref.h"
@@ -210,7 +211,7 @@ namespace embree
     struct Thread 
     {
       Thread (size_t threadIndex, const Ref<TaskSchedulerTBB>& scheduler)
-      : threadIndex(threadIndex), scheduler(scheduler), task(nullptr) {}
+      : threadIndex(threadIndex), scheduler(scheduler), task(nullptr), location(nullptr) {}
 
       __forceinline size_t threadCount() {
         return scheduler->threadCounter;
@@ -220,12 +221,13 @@ namespace embree
       TaskQueue tasks;                 //!< local task queue
       Task* task;                      //!< current active task
       Ref<TaskSchedulerTBB> scheduler;     //!< pointer to task scheduler
+      const CPULocation* location;     //!< logical thread this thread is pinned to or nullptr
     };
 
     /*! pool of worker threads */
     struct ThreadPool
     {
-      ThreadPool (bool set_affinity);
+      ThreadPool (ThreadAffinity affinity);
       ~ThreadPool ();
 
       /*! starts the threads */
@@ -249,7 +251,8 @@ namespace embree
     private:
       volatile size_t numThreads;
       volatile size_t numThreadsRunning;
-      bool set_affinity;
+      ThreadAffinity affinity;
+      std::vector<CPULocation> pinning;  //!< logical thread each pool thread gets pinned to
       bool running;
       std::vector<thread_t> threads;
 
@@ -263,7 +266,7 @@ namespace embree
     ~TaskSchedulerTBB ();
 
     /*! initializes the task scheduler */
-    static void create(size_t numThreads, bool set_affinity);
+    static void create(size_t numThreads, ThreadAffinity affinity);
 
     /*! destroys the task scheduler again */
     static void destroy();
@@ -404,6 +407,7 @@ namespace embree
     static size_t g_numThreads;
     static __thread TaskSchedulerTBB* g_instance;
     static __thread Thread* thread_local_thread;
+    static __thread const CPULocation* thread_local_location;
     static ThreadPool* threadPool;
   };
 };
@@ -124,12 +124,17 @@ RTCORE_API RTCORE_DEPRECATED void rtcExit();
 
 /*! \brief Parameters that can get configured using the rtcSetParameter functions. */
 enum RTCParameter {
-  RTC_SOFTWARE_CACHE_SIZE = 0      /*! Configures the software cache size (used
+  RTC_SOFTWARE_CACHE_SIZE = 0,     /*! Configures the software cache size (used
                                      to cache subdivision surfaces for
                                      instance). The size is specified as an
                                      integer number of bytes. The software
                                      cache cannot be configured during
                                      rendering. */
+
+  RTC_TRAVERSAL_STATISTICS = 1     /*! Enables (1) or disables (0) gathering
+                                     of traversal statistics. Statistics
+                                     are gathered for all devices and
+                                     are disabled by default. */
 };
 
 /*! \brief Configures some parameters. 
@@ -140,6 +145,30 @@ RTCORE_API RTCORE_DEPRECATED void rtcSetParameter1i(const RTCParameter parm, ssi
 /*! \brief Configures some device parameters. */
 RTCORE_API void rtcDeviceSetParameter1i(RTCDevice device, const RTCParameter parm, ssize_t val);
 
+/*! \brief Traversal statistics gathered when the
+    RTC_TRAVERSAL_STATISTICS parameter is enabled. */
+struct RTCTraversalStatistics
+{
+  size_t rays;        //!< number of traced rays
+  size_t nodes;       //!< number of visited inner nodes
+  size_t leaves;      //!< number of visited leaf nodes
+  size_t prims;       //!< number of tested primitive blocks
+  size_t filters;     //!< number of invoked filter callbacks
+};
+
+/*! \brief Returns the traversal statistics of all threads,
+    separately for rtcIntersect and rtcOccluded type of rays. Any of
+    the output pointers can be NULL. */
+RTCORE_API void rtcDeviceGetTraversalStatistics(RTCDevice device, RTCTraversalStatistics* intersect, RTCTraversalStatistics* occluded);
+
+/*! \brief Resets the traversal statistics of all threads. */
+RTCORE_API void rtcDeviceResetTraversalStatistics(RTCDevice device);
+
+/*! \brief Returns the traversal statistics of the calling
+    thread. Comparing the statistics before and after tracing a ray
+    gives the traversal cost of that ray. */
+RTCORE_API void rtcGetThreadTraversalStatistics(RTCTraversalStatistics* intersect, RTCTraversalStatistics* occluded);
+
 /*! \brief Error codes returned by the rtcGetError function. */
 enum RTCError {
   RTC_NO_ERROR = 0,          //!< No error has been recorded.
@@ -23,13 +23,17 @@
 /*! invalid geometry ID */
 #define RTC_INVALID_GEOMETRY_ID ((unsigned)-1)
 
+/*! maximal number of time steps of motion blurred triangle meshes,
+ *  quad meshes, and line segments */
+#define RTC_MAX_TIME_STEPS 129
+
 /*! \brief Specifies the type of buffers when mapping buffers */
 enum RTCBufferType {
   RTC_INDEX_BUFFER         = 0x01000000,
   
   RTC_VERTEX_BUFFER        = 0x02000000,
   RTC_VERTEX_BUFFER0       = 0x02000000,
-  RTC_VERTEX_BUFFER1       = 0x02000001,
+  RTC_VERTEX_BUFFER1       = 0x02000001, //!< use RTC_VERTEX_BUFFER0+t for the vertex buffer of time step t
 
   RTC_USER_VERTEX_BUFFER   = 0x02100000,
   RTC_USER_VERTEX_BUFFER0  = 0x02100000,
@@ -122,6 +126,20 @@ RTCORE_API unsigned rtcNewInstance (RTCScene target,                  //!< the s
                                     RTCScene source                   //!< the scene to instantiate
   );
 
+/*! \brief Creates a new geometry instance. 
+
+  A geometry instance references a triangle mesh or another geometry
+  instance of the same scene and places it with the transformation
+  set through rtcSetTransform. Geometry instances are traversed
+  natively through transformation nodes of the top level BVH, nested
+  instances get flattened at build time. If an instanced triangle is
+  hit, the geomID member of the ray is set to the ID of the instanced
+  triangle mesh, and the instID member to the ID of the outermost
+  geometry instance. */
+RTCORE_API unsigned rtcNewGeometryInstance (RTCScene scene,           //!< the scene the instance belongs to
+                                            unsigned geomID           //!< the geometry to instantiate
+  );
+
 /*! \brief Sets transformation of the instance */
 RTCORE_API void rtcSetTransform (RTCScene scene,                          //!< scene handle
                                  unsigned geomID,                         //!< ID of geometry
@@ -131,13 +149,16 @@ RTCORE_API void rtcSetTransform (RTCScene scene,                          //!< s
 
 /*! \brief Creates a new triangle mesh. The number of triangles
   (numTriangles), number of vertices (numVertices), and number of time
-  steps (1 for normal meshes, and 2 for linear motion blur), have to
-  get specified. The triangle indices can be set be mapping and
+  steps (1 for normal meshes, and 2 up to RTC_MAX_TIME_STEPS for
+  linear motion blur), have to get specified. The triangle indices can be set be mapping and
   writing to the index buffer (RTC_INDEX_BUFFER) and the triangle
   vertices can be set by mapping and writing into the vertex buffer
-  (RTC_VERTEX_BUFFER). In case of linear motion blur, two vertex
-  buffers have to get filled (RTC_VERTEX_BUFFER0, RTC_VERTEX_BUFFER1),
-  one for each time step. The index buffer has the default layout of
+  (RTC_VERTEX_BUFFER). In case of linear motion blur, one vertex
+  buffer has to get filled for each time step (RTC_VERTEX_BUFFER0,
+  RTC_VERTEX_BUFFER1, ..., RTC_VERTEX_BUFFER0+numTimeSteps-1). The
+  time steps are evenly distributed over the [0,1] time interval and
+  vertices get linearly interpolated between neighbouring time
+  steps. The index buffer has the default layout of
   three 32 bit integer indices for each triangle. An index points to
   the ith vertex. The vertex buffer stores single precision x,y,z
   floating point coordinates aligned to 16 bytes. The value of the 4th
@@ -152,13 +173,16 @@ RTCORE_API unsigned rtcNewTriangleMesh (RTCScene scene,                    //!<
 
 /*! \brief Creates a new quad mesh. The number of quads
   (numQuads), number of vertices (numVertices), and number of time
-  steps (1 for normal meshes, and 2 for linear motion blur), have to
-  get specified. The quad indices can be set be mapping and
+  steps (1 for normal meshes, and 2 up to RTC_MAX_TIME_STEPS for
+  linear motion blur), have to get specified. The quad indices can be set be mapping and
   writing to the index buffer (RTC_INDEX_BUFFER) and the quad
   vertices can be set by mapping and writing into the vertex buffer
-  (RTC_VERTEX_BUFFER). In case of linear motion blur, two vertex
-  buffers have to get filled (RTC_VERTEX_BUFFER0, RTC_VERTEX_BUFFER1),
-  one for each time step. The index buffer has the default layout of
+  (RTC_VERTEX_BUFFER). In case of linear motion blur, one vertex
+  buffer has to get filled for each time step (RTC_VERTEX_BUFFER0,
+  RTC_VERTEX_BUFFER1, ..., RTC_VERTEX_BUFFER0+numTimeSteps-1). The
+  time steps are evenly distributed over the [0,1] time interval and
+  vertices get linearly interpolated between neighbouring time
+  steps. The index buffer has the default layout of
   three 32 bit integer indices for each quad. An index points to
   the ith vertex. The vertex buffer stores single precision x,y,z
   floating point coordinates aligned to 16 bytes. The value of the 4th
@@ -263,12 +287,13 @@ RTCORE_API unsigned rtcNewHairGeometry (RTCScene scene,                    //!<
 /*! \brief Creates a new line segment geometry, consisting of multiple
   segments with varying radii. The number of line segments (numSegments),
   number of vertices (numVertices), and number of time steps (1 for
-  normal line segments, and 2 for linear motion blur), have to get
-  specified at construction time. Further, the segment index buffer
-  (RTC_INDEX_BUFFER) and the segment vertex buffer (RTC_VERTEX_BUFFER)
-  have to get set by mapping and writing to the appropiate buffers. In
-  case of linear motion blur, two vertex buffers have to get filled
-  (RTC_VERTEX_BUFFER0, RTC_VERTEX_BUFFER1), one for each time step. The
+  normal line segments, and 2 up to RTC_MAX_TIME_STEPS for linear
+  motion blur), have to get specified at construction time. Further,
+  the segment index buffer (RTC_INDEX_BUFFER) and the segment vertex
+  buffer (RTC_VERTEX_BUFFER) have to get set by mapping and writing to
+  the appropiate buffers. In case of linear motion blur, one vertex
+  buffer has to get filled for each time step (RTC_VERTEX_BUFFER0,
+  RTC_VERTEX_BUFFER1, ..., RTC_VERTEX_BUFFER0+numTimeSteps-1). The
   index buffer has the default layout of a single 32 bit integer index
   for each line segment, that references the start vertex of the segment.
   The vertex buffer stores 2 end points per line segment, each such point
@@ -354,6 +379,15 @@ RTCORE_API void rtcUpdate (RTCScene scene, unsigned geomID);
   some geometry as modified. */
 RTCORE_API void rtcUpdateBuffer (RTCScene scene, unsigned geomID, RTCBufferType type);
 
+/*! \brief Update range of specific geometry buffer. 
+
+  Tags only the items [offset,offset+num) of some buffer of the
+  geometry as modified. For vertex buffers of triangle meshes, line
+  segments, and points with RTC_GEOMETRY_DEFORMABLE flag, only the
+  parts of the BVH that reference these vertices get refitted. Other
+  buffers and geometry types get tagged as modified as a whole. */
+RTCORE_API void rtcUpdateBufferRange (RTCScene scene, unsigned geomID, RTCBufferType type, size_t offset, size_t num);
+
 /*! \brief Disable geometry. 
 
   Disabled geometry is not hit by any ray. Disabling and enabling
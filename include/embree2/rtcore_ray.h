@@ -149,6 +149,41 @@ public:
   unsigned instID[16];  //!< instance ID
 };
 
+/*! \brief Ray structure for a stream of N rays in structure of
+ *  pointers layout. Each member points to an array of N elements,
+ *  members marked as optional can be set to NULL. */
+struct RTCRayNp
+{
+  /* ray data */
+public:
+  float* orgx;  //!< x coordinate of ray origin
+  float* orgy;  //!< y coordinate of ray origin
+  float* orgz;  //!< z coordinate of ray origin
+
+  float* dirx;  //!< x coordinate of ray direction
+  float* diry;  //!< y coordinate of ray direction
+  float* dirz;  //!< z coordinate of ray direction
+
+  float* tnear; //!< Start of ray segment (optional)
+  float* tfar;  //!< End of ray segment (set to hit distance)
+
+  float* time;  //!< Time of this ray for motion blur (optional)
+  unsigned* mask;  //!< Used to mask out objects during traversal (optional)
+
+  /* hit data */
+public:
+  float* Ngx;   //!< x coordinate of geometry normal (optional)
+  float* Ngy;   //!< y coordinate of geometry normal (optional)
+  float* Ngz;   //!< z coordinate of geometry normal (optional)
+
+  float* u;     //!< Barycentric u coordinate of hit
+  float* v;     //!< Barycentric v coordinate of hit
+
+  unsigned* geomID;  //!< geometry ID
+  unsigned* primID;  //!< primitive ID
+  unsigned* instID;  //!< instance ID (optional)
+};
+
 /*! @} */
 
 #endif
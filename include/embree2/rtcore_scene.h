@@ -25,6 +25,7 @@ struct RTCRay;
 struct RTCRay4;
 struct RTCRay8;
 struct RTCRay16;
+struct RTCRayNp;
 
 /*! scene flags */
 enum RTCSceneFlags 
@@ -51,6 +52,8 @@ enum RTCAlgorithmFlags
   RTC_INTERSECT8 = (1 << 2),    //!< enables the rtcIntersect8 and rtcOccluded8 functions for this scene
   RTC_INTERSECT16 = (1 << 3),   //!< enables the rtcIntersect16 and rtcOccluded16 functions for this scene
   RTC_INTERPOLATE = (1 << 4),   //!< enables the rtcInterpolate function for this scene
+  RTC_INTERSECT_STREAM = (1 << 5), //!< enables the rtcIntersect1M, rtcIntersectNp, rtcOccluded1M and rtcOccludedNp functions for this scene
+  RTC_POINT_QUERY = (1 << 6),   //!< enables the rtcPointQuery and rtcClosestPoint functions for this scene
 };
 
 /*! \brief Defines an opaque scene type */
@@ -88,6 +91,22 @@ RTCORE_API void rtcCommit (RTCScene scene);
  *  coprocessor. */
 RTCORE_API void rtcCommitThread(RTCScene scene, unsigned int threadID, unsigned int numThreads);
 
+/*! Commits the geometry of the scene asynchronously. The function
+ *  returns immediately and the hierarchy gets built in a background
+ *  thread. The scene must neither be modified nor used for tracing
+ *  rays until rtcWaitCommit returned or rtcIsCommitted returns
+ *  true. Other scenes can be used for rendering in the meantime. */
+RTCORE_API void rtcCommitAsync (RTCScene scene);
+
+/*! Waits until a pending asynchronous commit of the scene has
+ *  finished. Errors that occurred during the asynchronous build are
+ *  reported here. */
+RTCORE_API void rtcWaitCommit (RTCScene scene);
+
+/*! Returns true if the scene is committed and no asynchronous commit
+ *  is pending. Does not block. */
+RTCORE_API bool rtcIsCommitted (RTCScene scene);
+
 /*! Intersects a single ray with the scene. The ray has to be aligned
  *  to 16 bytes. This function can only be called for scenes with the
  *  RTC_INTERSECT1 flag set. */
@@ -112,6 +131,21 @@ RTCORE_API void rtcIntersect8 (const void* valid, RTCScene scene, RTCRay8& ray);
  *  called if the CPU supports the 16-wide Xeon Phi instructions. */
 RTCORE_API void rtcIntersect16 (const void* valid, RTCScene scene, RTCRay16& ray);
 
+/*! Intersects a stream of M single rays with the scene. The rays
+ *  are stored in array of structures layout, with 'stride' bytes
+ *  between consecutive rays, and each ray has to be aligned to 16
+ *  bytes. The rays are sorted internally by direction octant and
+ *  origin and traced as coherent packets. This function can only be
+ *  called for scenes with the RTC_INTERSECT_STREAM flag set. */
+RTCORE_API void rtcIntersect1M (RTCScene scene, RTCRay* rays, const size_t M, const size_t stride);
+
+/*! Intersects a stream of N rays stored in structure of pointers
+ *  layout with the scene. The rays are sorted internally by
+ *  direction octant and origin and traced as coherent packets. This
+ *  function can only be called for scenes with the
+ *  RTC_INTERSECT_STREAM flag set. */
+RTCORE_API void rtcIntersectNp (RTCScene scene, const RTCRayNp& rays, const size_t N);
+
 /*! Tests if a single ray is occluded by the scene. The ray has to be
  *  aligned to 16 bytes. This function can only be called for scenes
  *  with the RTC_INTERSECT1 flag set. */
@@ -138,6 +172,138 @@ RTCORE_API void rtcOccluded8 (const void* valid, RTCScene scene, RTCRay8& ray);
  *  instructions. */
 RTCORE_API void rtcOccluded16 (const void* valid, RTCScene scene, RTCRay16& ray);
 
+/*! Tests if a stream of M single rays is occluded by the scene. The
+ *  rays are stored in array of structures layout, with 'stride'
+ *  bytes between consecutive rays, and each ray has to be aligned to
+ *  16 bytes. This function can only be called for scenes with the
+ *  RTC_INTERSECT_STREAM flag set. */
+RTCORE_API void rtcOccluded1M (RTCScene scene, RTCRay* rays, const size_t M, const size_t stride);
+
+/*! Tests if a stream of N rays stored in structure of pointers
+ *  layout is occluded by the scene. This function can only be called
+ *  for scenes with the RTC_INTERSECT_STREAM flag set. */
+RTCORE_API void rtcOccludedNp (RTCScene scene, const RTCRayNp& rays, const size_t N);
+
+/*! Point query structure for closest point and radius queries. */
+struct RTCORE_ALIGN(16) RTCPointQuery
+{
+  float p[3];        //!< query position
+  float radius;      //!< search radius, primitives farther away are culled
+};
+
+/*! Closest point of a primitive to the query position. */
+struct RTCORE_ALIGN(16) RTCClosestPoint
+{
+  float p[3];        //!< closest point on the surface of the primitive
+  float distance;    //!< distance between query position and closest point
+  unsigned geomID;   //!< geometry ID of the primitive
+  unsigned primID;   //!< primitive ID of the primitive
+};
+
+/*! Point query callback function. Gets called for each primitive
+ *  whose closest point lies within the search radius of the
+ *  query. The callback may shrink the radius of the query to cull
+ *  the remaining traversal. */
+typedef void (*RTCPointQueryFunc)(void* userPtr,                       /*!< pointer to user data */
+                                  RTCPointQuery& query,                /*!< point query */
+                                  const RTCClosestPoint& candidate     /*!< closest point of candidate primitive */);
+
+/*! Traverses the BVH of the scene and invokes the callback for each
+ *  triangle, quad, line segment and point primitive whose closest
+ *  point lies within the radius of the query. Primitives are visited
+ *  roughly in order of increasing distance. The query has to be
+ *  aligned to 16 bytes. Can only get called for scenes with the
+ *  RTC_POINT_QUERY flag set. Motion blurred geometries, user geometries,
+ *  hair geometries, subdivision meshes and instances are not
+ *  supported. */
+RTCORE_API void rtcPointQuery (RTCScene scene, RTCPointQuery& query, RTCPointQueryFunc func, void* userPtr);
+
+/*! Finds the closest point on the surface of the scene within the
+ *  radius of the query. If no primitive is found, the geomID of the
+ *  result is set to RTC_INVALID_GEOMETRY_ID. */
+RTCORE_API void rtcClosestPoint (RTCScene scene, const RTCPointQuery& query, RTCClosestPoint& result);
+
+/*! Maximal depth covered by the leaf depth histogram of RTCAccelStatistics. */
+#define RTC_MAX_STATISTICS_DEPTH 64
+
+/*! Build quality and memory statistics of one acceleration
+ *  structure of a scene. All byte counts refer to memory referenced
+ *  by the hierarchy, build times are in seconds. Build phases not
+ *  reported by the builder are 0. */
+struct RTCAccelStatistics
+{
+  const char* primitiveType;      //!< name of the primitive type stored in the leaves
+  size_t branchingFactor;         //!< maximal number of children of inner nodes
+
+  size_t numPrimitives;           //!< number of primitives the hierarchy is built over
+  size_t numVertices;             //!< number of vertices the hierarchy references
+
+  size_t numAlignedNodes;         //!< number of axis aligned inner nodes
+  size_t numUnalignedNodes;       //!< number of oriented inner nodes
+  size_t numAlignedNodesMB;       //!< number of axis aligned motion blur inner nodes
+  size_t numUnalignedNodesMB;     //!< number of oriented motion blur inner nodes
+  size_t numAlignedNodesMB4D;     //!< number of axis aligned motion blur inner nodes with time range
+  size_t numQuantizedNodes;       //!< number of quantized inner nodes
+  size_t numTransformNodes;       //!< number of transformation nodes
+  size_t numLeaves;               //!< number of leaves
+  size_t numPrimBlocks;           //!< number of primitive blocks stored in leaves
+
+  float nodeFillRate;             //!< fraction of used child slots of inner nodes
+  float leafFillRate;             //!< fraction of used primitive slots of leaf blocks
+
+  float sah;                      //!< SAH cost relative to the root bounds
+  float sahNodes;                 //!< SAH cost of inner node traversal
+  float sahLeaves;                //!< SAH cost of primitive intersection
+
+  size_t depth;                   //!< depth of the hierarchy
+  size_t leafDepthHistogram[RTC_MAX_STATISTICS_DEPTH]; //!< number of leaves at each depth, deeper leaves count into the last entry
+
+  size_t bytesNodes;              //!< bytes of all inner nodes
+  size_t bytesLeaves;             //!< bytes of all primitive blocks
+  size_t bytesVertices;           //!< bytes of vertices the hierarchy references
+  size_t bytesAllocated;          //!< bytes allocated by the acceleration structure
+
+  double buildTimePrimRefs;       //!< time to create primitive references
+  double buildTimeHierarchy;      //!< time to build the hierarchy
+  double buildTimeFinalize;       //!< time to release temporary data after the build
+  double buildTimeTotal;          //!< total build time
+};
+
+/*! Fills statistics of the acceleration structures of a committed
+ *  scene into the stats array. At most maxStats entries are written
+ *  and the number of acceleration structures of the scene is
+ *  returned, thus the function can be called with maxStats=0 to query
+ *  the required array size. Acceleration structures that do not
+ *  support statistics are skipped. */
+RTCORE_API size_t rtcGetSceneStatistics (RTCScene scene, RTCAccelStatistics* stats, size_t maxStats);
+
+/*! Usage statistics of the tessellation cache partition of a scene. */
+struct RTCTessellationCacheStatistics
+{
+  size_t bytes;                   //!< size of the partition in bytes
+  size_t hits;                    //!< number of lookups that found cached data
+  size_t misses;                  //!< number of lookups that had to tessellate
+  size_t segmentSwitches;         //!< number of reclaimed cache segments
+  size_t flushes;                 //!< number of invalidations of the entire partition
+};
+
+/*! Reserves a partition of the given size in bytes of the
+ *  tessellation cache for the scene. Patches of the scene then no
+ *  longer compete with patches of other scenes for cache space. A
+ *  budget of 0 makes the scene share the remaining cache with other
+ *  scenes again, which is the default. Changing partitions flushes
+ *  the entire tessellation cache. A budget that leaves less than a
+ *  quarter of the cache to other scenes is rejected with
+ *  RTC_INVALID_ARGUMENT. This function must not get called while the
+ *  scene (or any scene instancing it) is rendered, as dropping the old
+ *  partition frees memory still used by in-flight ray queries. */
+RTCORE_API void rtcSetTessellationCacheBudget (RTCScene scene, size_t bytes);
+
+/*! Returns usage statistics of the tessellation cache partition
+ *  used by the scene. Scenes without own budget report the shared
+ *  partition. */
+RTCORE_API void rtcGetTessellationCacheStatistics (RTCScene scene, RTCTessellationCacheStatistics* stats);
+
 /*! Deletes the scene. All contained geometry get also destroyed. */
 RTCORE_API void rtcDeleteScene (RTCScene scene);
 
@@ -20,6 +20,8 @@
 
 namespace embree
 {
+  struct PointQueryContext;
+
   /*! Base class for the acceleration structure data. */
   class AccelData : public RefCount 
   {
@@ -36,6 +38,9 @@ namespace embree
     /*! clears the acceleration structure data */
     virtual void clear() = 0;
 
+    /*! fills statistics into at most maxStats entries, returns the number of acceleration structures */
+    virtual size_t statistics(RTCAccelStatistics* stats, size_t maxStats) { return 0; }
+
   public:
     BBox3fa bounds;
     Type type;
@@ -85,6 +90,10 @@ namespace embree
                                     void* ptr,         /*!< pointer to user data */
                                     RTCRay16& ray      /*!< Ray packet to test occlusion. */);
   
+    /*! Type of point query function. */
+    typedef void (*PointQueryFunc) (void* ptr,                  /*!< pointer to user data */
+                                    PointQueryContext* context  /*!< point query and callback */);
+  
     typedef void (*ErrorFunc) ();
 
     struct Intersector1
@@ -158,10 +167,10 @@ namespace embree
     struct Intersectors 
     {
       Intersectors() 
-        : ptr(nullptr) {}
+        : ptr(nullptr), pointQuery(nullptr) {}
 
       Intersectors (ErrorFunc error) 
-        : ptr(nullptr), intersector1(error), intersector4(error), intersector8(error), intersector16(error) {}
+        : ptr(nullptr), intersector1(error), intersector4(error), intersector8(error), intersector16(error), pointQuery((PointQueryFunc)error) {}
 
       void print(size_t ident) 
       {
@@ -183,8 +192,14 @@ namespace embree
         }
       }
 
-      void select(bool filter4, bool filter8, bool filter16)
+      /*! selects between the full featured intersectors and the lean
+       *  variants that skip ray masks and filter functions */
+      void select(bool filter1, bool filter4, bool filter8, bool filter16)
       {
+	if (intersector1_filter) {
+	  if (filter1) intersector1 = intersector1_filter;
+	  else         intersector1 = intersector1_nofilter;
+	}
 	if (intersector4_filter) {
 	  if (filter4) intersector4 = intersector4_filter;
 	  else         intersector4 = intersector4_nofilter;
@@ -202,6 +217,8 @@ namespace embree
     public:
       AccelData* ptr;
       Intersector1 intersector1;
+      Intersector1 intersector1_filter;
+      Intersector1 intersector1_nofilter;
       Intersector4 intersector4;
       Intersector4 intersector4_filter;
       Intersector4 intersector4_nofilter;
@@ -211,6 +228,7 @@ namespace embree
       Intersector16 intersector16;
       Intersector16 intersector16_filter;
       Intersector16 intersector16_nofilter;
+      PointQueryFunc pointQuery;
     };
   
   public:
@@ -280,6 +298,14 @@ namespace embree
       intersectors.intersector16.occluded(valid,intersectors.ptr,ray);
     }
 
+    /*! Performs a point query on the acceleration structure. */
+    __forceinline void pointQuery (PointQueryContext* context) 
+    {
+      if (!intersectors.pointQuery) 
+        throw_RTCError(RTC_INVALID_OPERATION,"point queries not supported for this geometry type");
+      intersectors.pointQuery(intersectors.ptr,context);
+    }
+
   public:
     Intersectors intersectors;
   };
@@ -303,4 +329,7 @@ namespace embree
   Accel::Intersector16 symbol((Accel::IntersectFunc16)intersector::intersect, \
                               (Accel::OccludedFunc16)intersector::occluded,\
                               TOSTRING(isa) "::" TOSTRING(symbol));
+
+#define DEFINE_POINT_QUERY(symbol,query)                                \
+  Accel::PointQueryFunc symbol = (Accel::PointQueryFunc)query::pointQuery;
 }
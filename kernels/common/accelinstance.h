@@ -52,6 +52,10 @@ namespace embree
       builder->clear();
     }
 
+    size_t statistics(RTCAccelStatistics* stats, size_t maxStats) {
+      return accel->statistics(stats,maxStats);
+    }
+
   private:
     AccelData* accel;
     Builder* builder;
@@ -116,6 +116,13 @@ namespace embree
     }
   }
 
+  void AccelN::pointQuery (void* ptr, PointQueryContext* context) 
+  {
+    AccelN* This = (AccelN*)ptr;
+    for (size_t i=0; i<This->validAccels.size(); i++)
+      This->validAccels[i]->pointQuery(context);
+  }
+
   void AccelN::print(size_t ident)
   {
     for (size_t i=0; i<validAccels.size(); i++)
@@ -161,6 +168,7 @@ namespace embree
       intersectors.intersector4  = Intersector4(&intersect4,&occluded4,"AccelN::intersector4");
       intersectors.intersector8  = Intersector8(&intersect8,&occluded8,"AccelN::intersector8");
       intersectors.intersector16 = Intersector16(&intersect16,&occluded16,"AccelN::intersector16");
+      intersectors.pointQuery    = &pointQuery;
     }
     
     /*! calculate bounds */
@@ -169,10 +177,10 @@ namespace embree
       bounds.extend(validAccels[i]->bounds);
   }
 
-  void AccelN::select(bool filter4, bool filter8, bool filter16)
+  void AccelN::select(bool filter1, bool filter4, bool filter8, bool filter16)
   {
     for (size_t i=0; i<accels.size(); i++) 
-      accels[i]->intersectors.select(filter4,filter8,filter16);
+      accels[i]->intersectors.select(filter1,filter4,filter8,filter16);
   }
 
   void AccelN::deleteGeometry(size_t geomID) 
@@ -186,5 +194,13 @@ namespace embree
     for (size_t i=0; i<accels.size(); i++) 
       accels[i]->clear();
   }
+
+  size_t AccelN::statistics(RTCAccelStatistics* stats, size_t maxStats)
+  {
+    size_t num = 0;
+    for (size_t i=0; i<validAccels.size(); i++) 
+      num += validAccels[i]->statistics(stats+min(num,maxStats),maxStats-min(num,maxStats));
+    return num;
+  }
 }
 
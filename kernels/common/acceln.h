@@ -42,13 +42,17 @@ namespace embree
     static void occluded8 (const void* valid, void* ptr, RTCRay8& ray);
     static void occluded16 (const void* valid, void* ptr, RTCRay16& ray);
 
+  public:
+    static void pointQuery (void* ptr, PointQueryContext* context);
+
   public:
     void print(size_t ident);
     void immutable();
     void build (size_t threadIndex, size_t threadCount);
-    void select(bool filter4, bool filter8, bool filter16);
+    void select(bool filter1, bool filter4, bool filter8, bool filter16);
     void deleteGeometry(size_t geomID);
     void clear ();
+    size_t statistics(RTCAccelStatistics* stats, size_t maxStats);
       
   public:
     darray_t<Accel*,16> accels;
@@ -165,6 +165,13 @@ namespace embree
         return std::make_pair(box[0],box[1]);
       }
 
+      /*! Calculates the linear bounds of an item for the specified time range */
+      __forceinline std::pair<BBox3fa,BBox3fa> linearBounds (size_t item, const BBox1f& time_range) const
+      {
+        const std::pair<BBox3fa,BBox3fa> b = bounds_mblur(item);
+        return std::make_pair(lerp(b.first,b.second,time_range.lower),lerp(b.first,b.second,time_range.upper));
+      }
+
       /*! check if the i'th primitive is valid */
       __forceinline bool valid(size_t i, BBox3fa* bbox = nullptr) const 
       {
@@ -17,9 +17,105 @@
 #pragma once
 
 #include "default.h"
+#include "../algorithms/parallel_for.h"
 
 namespace embree
 {
+  /*! Pool of memory blocks freed by some allocator, that are kept
+   *  mapped to be reused by later allocations. This avoids the cost
+   *  of mapping and faulting in fresh pages for each commit of a
+   *  scene. */
+  class BlockPool
+  {
+  public:
+
+    /*! creates a pool that keeps at most 'maxBytes' bytes of blocks */
+    BlockPool (size_t maxBytes)
+      : maxBytes(maxBytes), pooledBytes(0), numHits(0), numMisses(0) {}
+
+    ~BlockPool () {
+      clear();
+    }
+
+    /*! returns the smallest pooled block of at least 'bytes' bytes whose
+     *  pages got first touched on NUMA node 'numaNode', 'bytes' gets set
+     *  to the size of the returned block */
+    void* get(size_t& bytes, size_t numaNode)
+    {
+      Lock<MutexSys> lock(mutex);
+      size_t best = blocks.size();
+      for (size_t i=0; i<blocks.size(); i++) {
+        if (blocks[i].numaNode != numaNode) continue;
+        if (blocks[i].bytes < bytes || blocks[i].bytes > 2*bytes) continue;
+        if (best == blocks.size() || blocks[i].bytes < blocks[best].bytes) best = i;
+      }
+      if (best == blocks.size()) {
+        numMisses++;
+        return nullptr;
+      }
+      void* ptr = blocks[best].ptr;
+      bytes = blocks[best].bytes;
+      blocks[best] = blocks.back();
+      blocks.pop_back();
+      pooledBytes -= bytes;
+      numHits++;
+      return ptr;
+    }
+
+    /*! hands a block of NUMA node 'numaNode' over to the pool, returns false if the pool is full */
+    bool put(void* ptr, size_t bytes, size_t numaNode)
+    {
+      Lock<MutexSys> lock(mutex);
+      if (pooledBytes+bytes > maxBytes) return false;
+      blocks.push_back(PooledBlock(ptr,bytes,numaNode));
+      pooledBytes += bytes;
+      return true;
+    }
+
+    /*! frees all pooled blocks */
+    void clear()
+    {
+      Lock<MutexSys> lock(mutex);
+      for (size_t i=0; i<blocks.size(); i++)
+        os_free(blocks[i].ptr,blocks[i].bytes);
+      blocks.clear();
+      pooledBytes = 0;
+    }
+
+    /*! prints statistics of the pool */
+    void print()
+    {
+      Lock<MutexSys> lock(mutex);
+      std::cout << "block pool:" << std::endl;
+      std::cout << "  blocks        = " << blocks.size() << std::endl;
+      std::cout << "  max size      = " << 1E-6*double(maxBytes) << " MB" << std::endl;
+      std::cout << "  pooled        = " << 1E-6*double(pooledBytes) << " MB" << std::endl;
+      std::cout << "  hits          = " << numHits << std::endl;
+      std::cout << "  misses        = " << numMisses << std::endl;
+    }
+
+  public:
+    const size_t maxBytes;                          //!< maximal number of pooled bytes
+
+  private:
+    struct PooledBlock
+    {
+      PooledBlock (void* ptr, size_t bytes, size_t numaNode)
+        : ptr(ptr), bytes(bytes), numaNode(numaNode) {}
+
+      void* ptr;                                    //!< start of the block
+      size_t bytes;                                 //!< size of the block
+      size_t numaNode;                              //!< NUMA node the pages of the block got first touched on
+    };
+
+  private:
+    size_t pooledBytes;                             //!< number of bytes currently pooled
+    size_t numHits;                                 //!< number of blocks served from the pool
+    size_t numMisses;                               //!< number of requests the pool could not serve
+    std::vector<PooledBlock> blocks;                //!< pooled blocks
+    MutexSys mutex;                                 //!< protects the pooled blocks
+  };
+
   class FastAllocator 
   {
     /*! maximal supported alignment */
@@ -148,8 +244,8 @@ namespace embree
       ThreadLocal alloc1;
     };
 
-    FastAllocator (MemoryMonitorInterface* device) 
-      : device(device), growSize(defaultBlockSize), usedBlocks(nullptr), freeBlocks(nullptr), slotMask(0),
+    FastAllocator (MemoryMonitorInterface* device, bool numaAware = false, BlockPool* pool = nullptr, bool prefault = false) 
+      : device(device), numaAware(numaAware), pool(pool), prefault(prefault), growSize(defaultBlockSize), usedBlocks(nullptr), freeBlocks(nullptr), slotMask(0),
       thread_local_allocators(this), thread_local_allocators2(this), bytesUsed(0)
     {
       for (size_t i=0; i<MAX_THREAD_USED_BLOCK_SLOTS; i++)
@@ -180,8 +276,16 @@ namespace embree
         return; 
       }
       if (bytesReserve == 0) bytesReserve = bytesAllocate;
-      usedBlocks = Block::create(device,bytesAllocate,bytesReserve);
+      usedBlocks = Block::create(device,bytesAllocate,bytesReserve,nullptr,numaAware ? getCurrentNumaNode() : 0,pool);
       growSize = max(size_t(defaultBlockSize),bytesReserve);
+
+      /* fault in the pages of the block in parallel */
+      if (prefault) {
+        Block* block = usedBlocks;
+        parallel_for(size_t(0), block->allocEnd, size_t(maxAllocationSize+maxAlignment), [&](const range<size_t>& r) {
+          block->touch(r.begin(),r.end());
+        });
+      }
     }
 
     /*! initializes the allocator */
@@ -191,6 +295,28 @@ namespace embree
       growSize = max(size_t(defaultBlockSize),bytesAllocate);
       if (bytesAllocate > 4*maxAllocationSize) slotMask = 0x1;
       if (bytesAllocate > 16*maxAllocationSize) slotMask = MAX_THREAD_USED_BLOCK_SLOTS-1;
+      if (prefault) prefaultBlocks(bytesAllocate);
+    }
+
+    /*! creates free blocks for the estimated number of bytes and faults
+     *  in their pages in parallel, each block gets first touched by
+     *  the thread (and thus NUMA node) that creates it */
+    void prefaultBlocks(size_t bytesAllocate)
+    {
+      if (bytesAllocate == 0) return;
+      const size_t blockSize = min(bytesAllocate,size_t(maxAllocationSize));
+      const size_t numBlocks = (bytesAllocate+blockSize-1)/blockSize;
+      std::vector<Block*> blocks(numBlocks);
+      parallel_for(size_t(0), numBlocks, [&](const range<size_t>& r) {
+        for (size_t i=r.begin(); i<r.end(); i++) {
+          blocks[i] = Block::create(device,blockSize,blockSize,nullptr,numaAware ? getCurrentNumaNode() : 0,pool);
+          blocks[i]->touch(0,blocks[i]->allocEnd);
+        }
+      });
+      for (size_t i=0; i<numBlocks; i++) {
+        blocks[i]->next = freeBlocks;
+        freeBlocks = blocks[i];
+      }
     }
 
     /*! frees state not required after build */
@@ -209,7 +335,7 @@ namespace embree
     /*! shrinks all memory blocks to the actually used size */
     void shrink () {
       if (usedBlocks) usedBlocks->shrink(device);
-      if (freeBlocks) freeBlocks->clear(device); freeBlocks = nullptr;
+      if (freeBlocks) freeBlocks->clear(device,pool); freeBlocks = nullptr;
     }
 
 
@@ -246,8 +372,8 @@ namespace embree
     {
       cleanup();
       bytesUsed = 0;
-      if (usedBlocks) usedBlocks->clear(device); usedBlocks = nullptr;
-      if (freeBlocks) freeBlocks->clear(device); freeBlocks = nullptr;
+      if (usedBlocks) usedBlocks->clear(device,pool); usedBlocks = nullptr;
+      if (freeBlocks) freeBlocks->clear(device,pool); freeBlocks = nullptr;
       for (size_t i=0; i<MAX_THREAD_USED_BLOCK_SLOTS; i++) threadUsedBlocks[i] = nullptr;
     }
 
@@ -259,9 +385,10 @@ namespace embree
 
       while (true) 
       {
-        /* allocate using current block */
+        /* allocate using current block, in NUMA aware mode threads of one NUMA node share the blocks of this node */
+        const size_t numaNode = numaAware ? getCurrentNumaNode() : 0;
         size_t threadIndex = TaskSchedulerTBB::threadIndex();
-        size_t slot = threadIndex & slotMask;
+        size_t slot = numaAware ? (numaNode & (MAX_THREAD_USED_BLOCK_SLOTS-1)) : (threadIndex & slotMask);
 	Block* myUsedBlocks = threadUsedBlocks[slot];
         if (myUsedBlocks) {
           void* ptr = myUsedBlocks->malloc(device,bytes,align); 
@@ -278,22 +405,38 @@ namespace embree
           Lock<AtomicMutex> lock(mutex);
 	  if (myUsedBlocks == threadUsedBlocks[slot])
 	  {
-	    if (freeBlocks) {
-	      Block* nextFreeBlock = freeBlocks->next;
-	      freeBlocks->next = usedBlocks;
+            /* only reuse free blocks whose pages got first touched by the same NUMA node */
+            Block* volatile* prevFreeBlock = &freeBlocks;
+            if (numaAware) {
+              while (*prevFreeBlock && (*prevFreeBlock)->numaNode != numaNode)
+                prevFreeBlock = &(*prevFreeBlock)->next;
+            }
+            
+	    if (Block* freeBlock = *prevFreeBlock) {
+	      Block* nextFreeBlock = freeBlock->next;
+	      freeBlock->next = usedBlocks;
 	      __memory_barrier();
-	      usedBlocks = freeBlocks;
-              threadUsedBlocks[slot] = freeBlocks;
-	      freeBlocks = nextFreeBlock;
+	      usedBlocks = freeBlock;
+              threadUsedBlocks[slot] = freeBlock;
+	      *prevFreeBlock = nextFreeBlock;
 	    } else {
 	      growSize = min(2*growSize,size_t(maxAllocationSize+maxAlignment));
-	      usedBlocks = threadUsedBlocks[slot] = Block::create(device,growSize-maxAlignment, growSize-maxAlignment, usedBlocks);
+	      usedBlocks = threadUsedBlocks[slot] = Block::create(device,growSize-maxAlignment, growSize-maxAlignment, usedBlocks, numaNode, pool);
 	    }
 	  }
         }
       }
     }
 
+    /*! allocates one contiguous memory block of arbitrary size, used to load prebuilt data */
+    void* mallocBlock(size_t bytes) 
+    {
+      Lock<AtomicMutex> lock(mutex);
+      usedBlocks = Block::create(device,bytes,bytes,usedBlocks);
+      bytesUsed += bytes;
+      return usedBlocks->malloc(device,bytes,maxAlignment);
+    }
+
     void* ptr() {
       return usedBlocks->ptr();
     }
@@ -382,31 +525,37 @@ namespace embree
 
     struct Block 
     {
-      static Block* create(MemoryMonitorInterface* device, size_t bytesAllocate, size_t bytesReserve, Block* next = nullptr)
+      static Block* create(MemoryMonitorInterface* device, size_t bytesAllocate, size_t bytesReserve, Block* next = nullptr, size_t numaNode = 0, BlockPool* pool = nullptr)
       {
         const size_t sizeof_Header = offsetof(Block,data[0]);
         bytesAllocate = ((sizeof_Header+bytesAllocate+defaultBlockSize-1) & ~(defaultBlockSize-1)); // always consume full pages
         bytesReserve  = ((sizeof_Header+bytesReserve +defaultBlockSize-1) & ~(defaultBlockSize-1)); // always consume full pages
         if (device) device->memoryMonitor(bytesAllocate,false);
-        void* ptr = os_reserve(bytesReserve);
+
+        /* reuse a pooled block of the same NUMA node if possible, pooled blocks may be larger than requested */
+        void* ptr = pool ? pool->get(bytesReserve,numaNode) : nullptr;
+        if (ptr == nullptr) ptr = os_reserve(bytesReserve);
         os_commit(ptr,bytesAllocate);
-        return new (ptr) Block(bytesAllocate-sizeof_Header,bytesReserve-sizeof_Header,next);
+        return new (ptr) Block(bytesAllocate-sizeof_Header,bytesReserve-sizeof_Header,next,numaNode);
       }
 
-      Block (size_t bytesAllocate, size_t bytesReserve, Block* next) 
-      : cur(0), allocEnd(bytesAllocate), reserveEnd(bytesReserve), next(next) 
-      {
-        //for (size_t i=0; i<allocEnd; i+=defaultBlockSize) data[i] = 0;
-      }
+      Block (size_t bytesAllocate, size_t bytesReserve, Block* next, size_t numaNode) 
+      : cur(0), allocEnd(bytesAllocate), reserveEnd(bytesReserve), next(next), numaNode(numaNode) {}
 
-      void clear (MemoryMonitorInterface* device) {
-	if (next) next->clear(device); next = nullptr;
+      void clear (MemoryMonitorInterface* device, BlockPool* pool = nullptr) {
+	if (next) next->clear(device,pool); next = nullptr;
         const size_t sizeof_Header = offsetof(Block,data[0]);
         size_t sizeof_This = sizeof_Header+reserveEnd;
         const size_t sizeof_Alloced = sizeof_Header+getBlockAllocatedBytes();
-        os_free(this,sizeof_This);
+        if (!pool || !pool->put(this,sizeof_This,numaNode))
+          os_free(this,sizeof_This);
         if (device) device->memoryMonitor(-sizeof_Alloced,true);
       }
+
+      /*! writes to each page in the range [begin,end) to fault it in */
+      void touch (size_t begin, size_t end) {
+        for (size_t i=begin; i<min(end,allocEnd); i+=defaultBlockSize) data[i] = 0;
+      }
       
       void* malloc(MemoryMonitorInterface* device, size_t bytes, size_t align = 16) 
       {
@@ -437,8 +586,12 @@ namespace embree
       {
         const size_t sizeof_Header = offsetof(Block,data[0]);
         size_t newSize = os_shrink(this,sizeof_Header+getRequiredBytes(),reserveEnd+sizeof_Header);
-        if (device) device->memoryMonitor(newSize-sizeof_Header-allocEnd,true);
+
+        /* allocEnd does not include the bytes malloc committed beyond it, and
+         * the block has to be consistent before the memory monitor may throw */
+        const ssize_t bytesAllocated = getBlockAllocatedBytes();
         reserveEnd = allocEnd = newSize-sizeof_Header;
+        if (device) device->memoryMonitor(ssize_t(allocEnd)-bytesAllocated,true);
         if (next) next->shrink(device);
       }
 
@@ -472,13 +625,17 @@ namespace embree
       size_t allocEnd;           //!< end of the allocated memory region
       size_t reserveEnd;         //!< end of the reserved memory region
       Block* next;               //!< pointer to next block in list
-      char align[maxAlignment-4*sizeof(size_t)]; //!< align data to maxAlignment
+      size_t numaNode;           //!< NUMA node of the thread that created the block
+      char align[maxAlignment-5*sizeof(size_t)]; //!< align data to maxAlignment
       char data[1];              //!< here starts memory to use for allocations
     };
 
 
   private:
     MemoryMonitorInterface* device;
+    bool numaAware;              //!< allocate blocks per NUMA node
+    BlockPool* pool;             //!< pool to get blocks from and return blocks to (optional)
+    bool prefault;               //!< fault in the estimated memory in parallel
     AtomicMutex mutex;
     size_t slotMask;
     Block* volatile threadUsedBlocks[MAX_THREAD_USED_BLOCK_SLOTS];
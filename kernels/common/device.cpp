@@ -23,6 +23,8 @@
 #include "scene_subdiv_mesh.h"
 
 #include "subdiv/tessellation_cache.h"
+#include "out_of_core_cache.h"
+#include "alloc.h"
 
 #include "acceln.h"
 #include "geometry.h"
@@ -30,6 +32,7 @@
 #if !defined(__MIC__)
 #include "../xeon/bvh/bvh4_factory.h"
 #include "../xeon/bvh/bvh8_factory.h"
+#include "../xeon/bvh/bvh16_factory.h"
 #endif
 
 #if defined(TASKING_LOCKSTEP)
@@ -49,6 +52,10 @@ namespace embree
   void BVH4HairRegister();
 #endif
 
+#if defined(RTCORE_RAY_PACKETS) && !defined(__MIC__)
+  DECLARE_SYMBOL2(RayStreamFilterFuncs,rayStreamFilters);
+#endif
+
 #if defined(TASKING_TBB)
 
   bool g_tbb_threads_initialized = false;
@@ -57,10 +64,12 @@ namespace embree
   class TBBAffinity: public tbb::task_scheduler_observer
   {
     tbb::atomic<int> threadCount;
+    std::vector<CPULocation> pinning;
 
     void on_scheduler_entry( bool ) {
       ++threadCount;
-      setAffinity(TaskSchedulerTBB::threadIndex()); // FIXME: use threadCount?
+      const size_t threadIndex = TaskSchedulerTBB::threadIndex(); // FIXME: use threadCount?
+      if (pinning.size()) setAffinity(pinning[threadIndex % pinning.size()].cpu);
     }
 
     void on_scheduler_exit( bool ) { 
@@ -72,6 +81,7 @@ namespace embree
 
     int  get_concurrency()      { return threadCount; }
     void set_concurrency(int i) { threadCount = i; }
+    void set_pinning(ThreadAffinity affinity) { pinning = getThreadPinningOrder(affinity); }
 
   } tbb_affinity;
 #endif
@@ -92,9 +102,38 @@ namespace embree
       State::parseFile(FileName::homeFolder()+FileName(".embree" TOSTRING(__EMBREE_VERSION_MAJOR__)));
     State::verify();
     
+    /*! set pinning policy of worker threads */
+    if      (State::thread_affinity == ""       ) thread_affinity = State::set_affinity ? AFFINITY_LINEAR : AFFINITY_NONE;
+    else if (State::thread_affinity == "none"   ) thread_affinity = AFFINITY_NONE;
+    else if (State::thread_affinity == "linear" ) thread_affinity = AFFINITY_LINEAR;
+    else if (State::thread_affinity == "compact") thread_affinity = AFFINITY_COMPACT;
+    else if (State::thread_affinity == "scatter") thread_affinity = AFFINITY_SCATTER;
+    else if (State::thread_affinity == "socket" ) thread_affinity = AFFINITY_SOCKET;
+    else throw_RTCError(RTC_INVALID_ARGUMENT,"unknown thread affinity "+State::thread_affinity);
+
+    /*! set huge page policy of build memory, the policy is process wide, thus only gets changed if requested */
+    hugepages_prev = os_get_huge_page_policy();
+    if      (State::hugepages == ""         ) hugepages_policy = hugepages_prev;
+    else if (State::hugepages == "auto"     ) hugepages_policy = HUGE_PAGES_AUTO;
+    else if (State::hugepages == "off"      ) hugepages_policy = HUGE_PAGES_OFF;
+    else if (State::hugepages == "thp"      ) hugepages_policy = HUGE_PAGES_THP;
+    else if (State::hugepages == "hugetlbfs") hugepages_policy = HUGE_PAGES_HUGETLBFS;
+    else throw_RTCError(RTC_INVALID_ARGUMENT,"unknown huge page policy "+State::hugepages);
+    os_set_huge_page_policy(hugepages_policy);
+
     /*! set tessellation cache size */
     setCacheSize( State::tessellation_cache_size );
 
+    /*! create cache for paged geometry */
+    out_of_core_cache = nullptr;
+    if (State::out_of_core_dir != "")
+      out_of_core_cache = new OutOfCoreCache(State::out_of_core_budget);
+
+    /*! create pool for BVH memory blocks */
+    block_pool = nullptr;
+    if (State::alloc_pool_size)
+      block_pool = new BlockPool(State::alloc_pool_size);
+
     /*! enable some floating point exceptions to catch bugs */
     if (State::float_exceptions)
     {
@@ -117,6 +156,10 @@ namespace embree
     /* register all algorithms */
     instance_factory = new InstanceFactory(enabled_cpu_features);
 
+#if defined(RTCORE_RAY_PACKETS) && !defined(__MIC__)
+    SELECT_SYMBOL_DEFAULT_SSE42_AVX_AVX2_AVX512KNL(enabled_cpu_features,rayStreamFilters);
+#endif
+
 #if !defined(__MIC__)
     bvh4_factory = new BVH4Factory(enabled_cpu_features);
 #endif
@@ -125,6 +168,10 @@ namespace embree
     bvh8_factory = new BVH8Factory(enabled_cpu_features);
 #endif
 
+#if defined(__TARGET_AVX512KNL__) || defined(__TARGET_AVX512SKX__)
+    bvh16_factory = new BVH16Factory(enabled_cpu_features);
+#endif
+
 #if defined(__MIC__)
     BVH4iRegister();
     BVH4MBRegister();
@@ -149,9 +196,19 @@ namespace embree
 #if defined(__TARGET_AVX__)
     delete bvh8_factory;
 #endif
+#if defined(__TARGET_AVX512KNL__) || defined(__TARGET_AVX512SKX__)
+    delete bvh16_factory;
 #endif
+#endif
+    delete out_of_core_cache;
+    if (block_pool && State::verbosity(2)) block_pool->print();
+    delete block_pool;
     setCacheSize(0);
     exitTaskingSystem();
+
+    /*! restore huge page policy, unless another device changed it in the meantime */
+    if (os_get_huge_page_policy() == hugepages_policy)
+      os_set_huge_page_policy(hugepages_prev);
   }
 
   std::string getEnabledTargets()
@@ -171,6 +228,9 @@ namespace embree
 #endif
 #if defined(__TARGET_AVX512KNL__)
     v += "AVX512KNL ";
+#endif
+#if defined(__TARGET_AVX512SKX__)
+    v += "AVX512SKX ";
 #endif
     return v;
   }
@@ -214,6 +274,7 @@ namespace embree
     const bool hasDAZ = _mm_getcsr() & _MM_DENORMALS_ZERO_ON;
     std::cout << "   MXCSR    : " << "FTZ=" << hasFTZ << ", DAZ=" << hasDAZ << std::endl;
 #endif
+    std::cout << "   NUMA     : " << getNumberOfNumaNodes() << " nodes" << std::endl;
     std::cout << "  Config" << std::endl;
     std::cout << "    Threads : " << (numThreads ? toString(numThreads) : std::string("default")) << std::endl;
     std::cout << "    ISA     : " << stringOfCPUFeatures(enabled_cpu_features) << std::endl;
@@ -381,11 +442,11 @@ namespace embree
       maxNumThreads = 0;
 
 #if defined(TASKING_LOCKSTEP)
-    TaskScheduler::create(maxNumThreads,State::set_affinity);
+    TaskScheduler::create(maxNumThreads,thread_affinity != AFFINITY_NONE);
 #endif
 
 #if defined(TASKING_TBB_INTERNAL)
-    TaskSchedulerTBB::create(maxNumThreads,State::set_affinity);
+    TaskSchedulerTBB::create(maxNumThreads,thread_affinity);
 #endif
 
 #if defined(TASKING_TBB)
@@ -397,7 +458,8 @@ namespace embree
     }
 
     /* only set affinity if requested by the user */
-    if (State::set_affinity) {
+    if (thread_affinity != AFFINITY_NONE) {
+      tbb_affinity.set_pinning(thread_affinity);
       tbb_affinity.set_concurrency(0);
       tbb_affinity.observe(true); 
     }
@@ -432,6 +494,7 @@ namespace embree
   {
     switch (parm) {
     case RTC_SOFTWARE_CACHE_SIZE: setCacheSize(val); break;
+    case RTC_TRAVERSAL_STATISTICS: TraversalStat::enabled = val != 0; break;
     default: throw_RTCError(RTC_INVALID_ARGUMENT, "unknown parameter"); break;
     };
   }
@@ -18,12 +18,16 @@
 
 #include "default.h"
 #include "state.h"
+#include "ray_stream.h"
 
 namespace embree
 {
   class BVH4Factory;
   class BVH8Factory;
+  class BVH16Factory;
   class InstanceFactory;
+  class OutOfCoreCache;
+  class BlockPool;
 
   class Device : public State, public MemoryMonitorInterface
   {
@@ -77,6 +81,10 @@ namespace embree
 
     InstanceFactory* instance_factory;
 
+#if defined(RTCORE_RAY_PACKETS) && !defined(__MIC__)
+    RayStreamFilterFuncs rayStreamFilters;
+#endif
+
 #if !defined(__MIC__)
     BVH4Factory* bvh4_factory;
 #endif
@@ -85,6 +93,16 @@ namespace embree
     BVH8Factory* bvh8_factory;
 #endif
 
+#if defined(__TARGET_AVX512KNL__) || defined(__TARGET_AVX512SKX__)
+    BVH16Factory* bvh16_factory;
+#endif
+
+    OutOfCoreCache* out_of_core_cache;  //!< cache of paged geometry, only present if out_of_core_dir is set
+    ThreadAffinity thread_affinity;     //!< pinning policy of worker threads
+    BlockPool* block_pool;              //!< pool of BVH memory blocks reused across commits, only present if alloc_pool_size is set
+    HugePagePolicy hugepages_policy;    //!< huge page policy set by this device
+    HugePagePolicy hugepages_prev;      //!< huge page policy before this device got created, restored on destruction
+
 #if USE_TASK_ARENA
   tbb::task_arena* arena;
 #endif
@@ -21,7 +21,7 @@ namespace embree
 {
   Geometry::Geometry (Scene* parent, Type type, size_t numPrimitives, size_t numTimeSteps, RTCGeometryFlags flags) 
     : parent(parent), type(type), numPrimitives(numPrimitives), numTimeSteps(numTimeSteps), id(0), flags(flags),
-      enabled(true), modified(true), mask(-1), used(1),
+      enabled(true), modified(true), partiallyModified(false), mask(-1), used(1),
       intersectionFilter1(nullptr), occlusionFilter1(nullptr),
       intersectionFilter4(nullptr), occlusionFilter4(nullptr), ispcIntersectionFilter4(false), ispcOcclusionFilter4(false), 
       intersectionFilter8(nullptr), occlusionFilter8(nullptr), ispcIntersectionFilter8(false), ispcOcclusionFilter8(false), 
@@ -42,10 +42,12 @@ namespace embree
   void Geometry::updateIntersectionFilters(bool enable)
   {
     if (enable) {
+      atomic_add(&parent->numIntersectionFilters1,(intersectionFilter1 != nullptr) + (occlusionFilter1 != nullptr));
       atomic_add(&parent->numIntersectionFilters4,(intersectionFilter4 != nullptr) + (occlusionFilter4 != nullptr));
       atomic_add(&parent->numIntersectionFilters8,(intersectionFilter8 != nullptr) + (occlusionFilter8 != nullptr));
       atomic_add(&parent->numIntersectionFilters16,(intersectionFilter16 != nullptr) + (occlusionFilter16 != nullptr));
     } else {
+      atomic_sub(&parent->numIntersectionFilters1,(intersectionFilter1 != nullptr) + (occlusionFilter1 != nullptr));
       atomic_sub(&parent->numIntersectionFilters4,(intersectionFilter4 != nullptr) + (occlusionFilter4 != nullptr));
       atomic_sub(&parent->numIntersectionFilters8,(intersectionFilter8 != nullptr) + (occlusionFilter8 != nullptr));
       atomic_sub(&parent->numIntersectionFilters16,(intersectionFilter16 != nullptr) + (occlusionFilter16 != nullptr));
@@ -74,6 +76,22 @@ namespace embree
 
     parent->setModified();
     modified = true;
+    partiallyModified = false;
+    modifiedRanges.clear();
+  }
+
+  void Geometry::updateVertexRange(size_t begin, size_t end) 
+  {
+    if (parent->isStatic() && parent->isBuild()) 
+      throw_RTCError(RTC_INVALID_OPERATION,"static scenes cannot get modified");
+
+    /* ranges are only tracked as long as nothing else got modified */
+    if (!modified || partiallyModified) {
+      partiallyModified = true;
+      modifiedRanges.push_back(range<size_t>(begin,end));
+    }
+    parent->setModified();
+    modified = true;
   }
 
   void Geometry::disable () 
@@ -107,7 +125,10 @@ namespace embree
     if (type != TRIANGLE_MESH && type != QUAD_MESH && type != LINE_SEGMENTS && type != BEZIER_CURVES && type != SUBDIV_MESH)
       throw_RTCError(RTC_INVALID_OPERATION,"filter functions not supported for this geometry"); 
     
+    atomic_sub(&parent->numIntersectionFilters1,intersectionFilter1 != nullptr);
+    atomic_add(&parent->numIntersectionFilters1,filter != nullptr);
     intersectionFilter1 = filter;
+    parent->setModified();
   }
     
   void Geometry::setIntersectionFilterFunction4 (RTCFilterFunc4 filter, bool ispc) 
@@ -122,6 +143,7 @@ namespace embree
     atomic_add(&parent->numIntersectionFilters4,filter != nullptr);
     intersectionFilter4 = filter;
     ispcIntersectionFilter4 = ispc;
+    parent->setModified();
   }
     
   void Geometry::setIntersectionFilterFunction8 (RTCFilterFunc8 filter, bool ispc) 
@@ -136,6 +158,7 @@ namespace embree
     atomic_add(&parent->numIntersectionFilters8,filter != nullptr);
     intersectionFilter8 = filter;
     ispcIntersectionFilter8 = ispc;
+    parent->setModified();
   }
   
   void Geometry::setIntersectionFilterFunction16 (RTCFilterFunc16 filter, bool ispc) 
@@ -150,6 +173,7 @@ namespace embree
     atomic_add(&parent->numIntersectionFilters16,filter != nullptr);
     intersectionFilter16 = filter;
     ispcIntersectionFilter16 = ispc;
+    parent->setModified();
   }
 
   void Geometry::setOcclusionFilterFunction (RTCFilterFunc filter, bool ispc) 
@@ -160,7 +184,10 @@ namespace embree
     if (type != TRIANGLE_MESH && type != QUAD_MESH && type != LINE_SEGMENTS && type != BEZIER_CURVES && type != SUBDIV_MESH)
       throw_RTCError(RTC_INVALID_OPERATION,"filter functions not supported for this geometry"); 
 
+    atomic_sub(&parent->numIntersectionFilters1,occlusionFilter1 != nullptr);
+    atomic_add(&parent->numIntersectionFilters1,filter != nullptr);
     occlusionFilter1 = filter;
+    parent->setModified();
   }
     
   void Geometry::setOcclusionFilterFunction4 (RTCFilterFunc4 filter, bool ispc) 
@@ -175,6 +202,7 @@ namespace embree
     atomic_add(&parent->numIntersectionFilters4,filter != nullptr);
     occlusionFilter4 = filter;
     ispcOcclusionFilter4 = ispc;
+    parent->setModified();
   }
     
   void Geometry::setOcclusionFilterFunction8 (RTCFilterFunc8 filter, bool ispc) 
@@ -189,6 +217,7 @@ namespace embree
     atomic_add(&parent->numIntersectionFilters8,filter != nullptr);
     occlusionFilter8 = filter;
     ispcOcclusionFilter8 = ispc;
+    parent->setModified();
   }
   
   void Geometry::setOcclusionFilterFunction16 (RTCFilterFunc16 filter, bool ispc) 
@@ -203,6 +232,7 @@ namespace embree
     atomic_add(&parent->numIntersectionFilters16,filter != nullptr);
     occlusionFilter16 = filter;
     ispcOcclusionFilter16 = ispc;
+    parent->setModified();
   }
 
   void Geometry::interpolateN(const void* valid_i, const unsigned* primIDs, const float* u, const float* v, size_t numUVs, 
@@ -17,6 +17,7 @@
 #pragma once
 
 #include "default.h"
+#include "../algorithms/range.h"
 
 namespace embree
 {
@@ -63,7 +64,13 @@ namespace embree
     __forceinline bool isModified() const { return numPrimitives && modified; }
 
     /*! clears modified flag */
-    __forceinline void clearModified() { modified = false; }
+    __forceinline void clearModified() { modified = false; partiallyModified = false; modifiedRanges.clear(); }
+
+    /*! tests if only the vertex ranges returned by getModifiedRanges got modified */
+    __forceinline bool isPartiallyModified() const { return isModified() && partiallyModified; }
+
+    /*! returns the modified vertex ranges of a partially modified geometry */
+    __forceinline const std::vector<range<size_t>>& getModifiedRanges() const { return modifiedRanges; }
 
     /*! test if this is a static geometry */
     __forceinline bool isStatic() const { return flags == RTC_GEOMETRY_STATIC; }
@@ -93,10 +100,22 @@ namespace embree
     virtual void updateBuffer (RTCBufferType type) {
       update(); // update everything for geometries not supporting this call
     }
+
+    /*! Update range of geometry buffer. */
+    virtual void updateBufferRange (RTCBufferType type, size_t offset, size_t num) {
+      updateBuffer(type); // update entire buffer for geometries not supporting this call
+    }
     
     /*! Disable geometry. */
     virtual void disable ();
 
+  protected:
+
+    /*! tags the vertices [begin,end) as modified */
+    void updateVertexRange (size_t begin, size_t end);
+
+  public:
+
     /*! Free buffers that are unused */
     virtual void immutable () {}
 
@@ -246,6 +265,54 @@ namespace embree
       throw_RTCError(RTC_INVALID_OPERATION,"operation not supported for this geometry"); 
     }
 
+  public:
+
+    /*! returns the time segment the specified time falls into, and the local time inside that segment */
+    __forceinline size_t timeSegment(const float time, float& ftime) const
+    {
+      const float numTimeSegments = float(numTimeSteps-1);
+      const float timeScaled = time*numTimeSegments;
+      const float itimef = clamp(floorf(timeScaled),0.0f,numTimeSegments-1.0f);
+      ftime = timeScaled-itimef;
+      return size_t(itimef);
+    }
+
+    /*! calculates bounds that linearly bound the geometry over the
+     *  specified time range, bounds(j) has to return the bounds at
+     *  the j'th timestep */
+    template<typename BoundsFunc>
+      __forceinline std::pair<BBox3fa,BBox3fa> linearBounds(const BoundsFunc& bounds, const BBox1f& time_range) const
+    {
+      if (numTimeSteps == 1) {
+        const BBox3fa b = bounds(0);
+        return std::make_pair(b,b);
+      }
+
+      /* interpolate bounds at start and end of time range */
+      const float numTimeSegments = float(numTimeSteps-1);
+      const float lower = time_range.lower*numTimeSegments;
+      const float upper = time_range.upper*numTimeSegments;
+      auto interpolate = [&] (const float t) -> BBox3fa {
+        const float itimef = clamp(floorf(t),0.0f,numTimeSegments-1.0f);
+        const size_t itime = size_t(itimef);
+        return lerp(bounds(itime),bounds(itime+1),t-itimef);
+      };
+      BBox3fa b0 = interpolate(lower);
+      BBox3fa b1 = interpolate(upper);
+
+      /* enlarge bounds to also enclose all timesteps inside the time range */
+      for (size_t j=size_t(floorf(lower))+1; j<size_t(ceilf(upper)); j++)
+      {
+        const BBox3fa bt = bounds(j);
+        const BBox3fa bi = lerp(b0,b1,(float(j)-lower)/(upper-lower));
+        const Vec3fa dlower = min(bt.lower-bi.lower,Vec3fa(zero));
+        const Vec3fa dupper = max(bt.upper-bi.upper,Vec3fa(zero));
+        b0.lower += dlower; b1.lower += dlower;
+        b0.upper += dupper; b1.upper += dupper;
+      }
+      return std::make_pair(b0,b1);
+    }
+
   public:
     __forceinline bool hasIntersectionFilter1() const { return intersectionFilter1 != nullptr; }
     __forceinline bool hasOcclusionFilter1() const { return occlusionFilter1 != nullptr; }
@@ -257,10 +324,12 @@ namespace embree
     unsigned id;               //!< internal geometry ID
     Type type;                 //!< geometry type 
     ssize_t numPrimitives;     //!< number of primitives of this geometry
-    unsigned numTimeSteps;     //!< number of time steps (1 or 2)
+    unsigned numTimeSteps;     //!< number of time steps (1 to RTC_MAX_TIME_STEPS)
     RTCGeometryFlags flags;    //!< flags of geometry
     bool enabled;              //!< true if geometry is enabled
     bool modified;             //!< true if geometry is modified
+    bool partiallyModified;    //!< true if only the modifiedRanges of the vertex buffers got modified
+    std::vector<range<size_t>> modifiedRanges; //!< modified vertex ranges
     void* userPtr;             //!< user pointer
     unsigned mask;             //!< for masking out geometry
     atomic_t used;             //!< counts by how many enabled instances this geometry is used
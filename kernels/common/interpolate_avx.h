@@ -0,0 +1,97 @@
+// ======================================================================== //
+// Copyright 2009-2015 Intel Corporation                                    //
+//                                                                          //
+// Licensed under the Apache License, Version 2.0 (the "License");          //
+// you may not use this file except in compliance with the License.         //
+// You may obtain a copy of the License at                                  //
+//                                                                          //
+//     http://www.apache.org/licenses/LICENSE-2.0                           //
+//                                                                          //
+// Unless required by applicable law or agreed to in writing, software      //
+// distributed under the License is distributed on an "AS IS" BASIS,        //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. //
+// See the License for the specific language governing permissions and      //
+// limitations under the License.                                           //
+// ======================================================================== //
+
+#pragma once
+
+#include "default.h"
+
+/* helpers for interpolating vertex attributes of 8 hits at once,
+ * vertices get addressed by 32 bit offsets counted in floats */
+
+namespace embree
+{
+  /*! batch of up to 8 hits to interpolate */
+  struct InterpolateHits8
+  {
+    /*! loads hits [i,i+8), lanes past numUVs or with a zero valid flag are disabled */
+    __forceinline InterpolateHits8 (const int* valid, const unsigned* primIDs, const float* u, const float* v, size_t i, size_t numUVs)
+    {
+      const size_t n = min(size_t(8),numUVs-i);
+      if (likely(n == 8)) {
+        primID = vint8((const int*)&primIDs[i]);
+        uu = vfloat8::loadu(&u[i]);
+        vv = vfloat8::loadu(&v[i]);
+        mask = valid ? movemask(vint8(&valid[i]) != vint8(zero)) : 0xFF;
+      }
+      else
+      {
+        /* do not read past the end of the input arrays */
+        primID = zero; uu = zero; vv = zero; mask = 0;
+        for (size_t k=0; k<n; k++) {
+          primID[k] = primIDs[i+k];
+          uu[k] = u[i+k];
+          vv[k] = v[i+k];
+          if (!valid || valid[i+k]) mask |= 1 << k;
+        }
+      }
+    }
+
+    /*! mask of active lanes */
+    __forceinline vboolf8 active() const {
+      return vboolf8(int(mask));
+    }
+
+  public:
+    vint8 primID;
+    vfloat8 uu, vv;
+    size_t mask;
+  };
+
+  /*! loads the float4 block at float offset 'ofs[k]' for each of the 8 lanes and transposes into SoA layout */
+  __forceinline void gather4f(const float* src, const vint8& ofs, vfloat8& c0, vfloat8& c1, vfloat8& c2, vfloat8& c3)
+  {
+    const vfloat4 r0 = vfloat4::loadu(src+ofs[0]);
+    const vfloat4 r1 = vfloat4::loadu(src+ofs[1]);
+    const vfloat4 r2 = vfloat4::loadu(src+ofs[2]);
+    const vfloat4 r3 = vfloat4::loadu(src+ofs[3]);
+    const vfloat4 r4 = vfloat4::loadu(src+ofs[4]);
+    const vfloat4 r5 = vfloat4::loadu(src+ofs[5]);
+    const vfloat4 r6 = vfloat4::loadu(src+ofs[6]);
+    const vfloat4 r7 = vfloat4::loadu(src+ofs[7]);
+    transpose(vfloat8(r0,r4),vfloat8(r1,r5),vfloat8(r2,r6),vfloat8(r3,r7),c0,c1,c2,c3);
+  }
+
+  /*! gathers the float at float offset 'ofs[k]' for each of the 8 lanes */
+  __forceinline vfloat8 gather1f(const float* src, const vint8& ofs)
+  {
+#if defined(__AVX2__)
+    return _mm256_i32gather_ps(src,ofs,4);
+#else
+    return vfloat8(src[ofs[0]],src[ofs[1]],src[ofs[2]],src[ofs[3]],src[ofs[4]],src[ofs[5]],src[ofs[6]],src[ofs[7]]);
+#endif
+  }
+
+  /*! stores the active lanes of an interpolated attribute, never touches memory of inactive lanes */
+  __forceinline void storeAttribute(const vboolf8& active, float* dst, const vfloat8& a) {
+    vfloat8::store(active,dst,a);
+  }
+
+  /*! tests if all offsets of a vertex buffer fit into 32 bit float offsets */
+  __forceinline bool gatherable(const char* src, size_t stride, size_t numVertices, size_t numFloats) {
+    return src && (size_t(src) % sizeof(float)) == 0 && (stride % sizeof(float)) == 0 &&
+      numVertices*(stride/sizeof(float)) + numFloats < size_t(std::numeric_limits<int>::max());
+  }
+}
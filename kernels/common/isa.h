@@ -25,6 +25,7 @@ namespace embree
   namespace avx    { extern type name; }                                 \
   namespace avx2   { extern type name; }                                 \
   namespace avx512 { extern type name; }                                 \
+  namespace avx512skx { extern type name; }                              \
   void name##_error() { throw_RTCError(RTC_UNKNOWN_ERROR,"internal error in ISA selection for " TOSTRING(name)); } \
   type name((type)name##_error);
 
@@ -38,6 +39,7 @@ namespace embree
   namespace avx    { extern type name; }                                 \
   namespace avx2   { extern type name; }                                 \
   namespace avx512 { extern type name; }                                 \
+  namespace avx512skx { extern type name; }                              \
   void name##_error() { throw_RTCError(RTC_UNKNOWN_ERROR,"internal error in ISA selection for " TOSTRING(name)); }
 
 // FIXME: simplify ISA selection
@@ -48,6 +50,7 @@ namespace embree
   namespace avx   { extern Builder* symbol(Accel* accel, Mesh* scene, Args args); } \
   namespace avx2  { extern Builder* symbol(Accel* accel, Mesh* scene, Args args); } \
   namespace avx512  { extern Builder* symbol(Accel* accel, Mesh* scene, Args args); } \
+  namespace avx512skx { extern Builder* symbol(Accel* accel, Mesh* scene, Args args); } \
   void symbol##_error() { throw_RTCError(RTC_UNSUPPORTED_CPU,"builder " TOSTRING(symbol) " not supported by your CPU"); } \
   symbol##Func symbol = (symbol##Func) symbol##_error;
 
@@ -61,6 +64,7 @@ namespace embree
   namespace avx   { extern Builder* symbol(Accel* accel, Mesh* scene, Args args); } \
   namespace avx2  { extern Builder* symbol(Accel* accel, Mesh* scene, Args args); } \
   namespace avx512  { extern Builder* symbol(Accel* accel, Mesh* scene, Args args); } \
+  namespace avx512skx { extern Builder* symbol(Accel* accel, Mesh* scene, Args args); } \
   void symbol##_error() { throw_RTCError(RTC_UNSUPPORTED_CPU,"builder " TOSTRING(symbol) " not supported by your CPU"); } \
 
 #define INIT_SYMBOL(intersector) \
@@ -112,6 +116,16 @@ namespace embree
 #define SELECT_SYMBOL_AVX512KNL(features,intersector)
 #endif
 
+#if defined(__TARGET_AVX512SKX__)
+#if !defined(__TARGET_SIMD16__)
+#define __TARGET_SIMD16__
+#endif
+#define SELECT_SYMBOL_AVX512SKX(features,intersector) \
+  if ((features & AVX512SKX) == AVX512SKX) intersector = avx512skx::intersector; 
+#else
+#define SELECT_SYMBOL_AVX512SKX(features,intersector)
+#endif
+
 #if defined(__MIC__)
 #if !defined(__TARGET_SIMD4__)
 #define __TARGET_SIMD16__
@@ -194,6 +208,11 @@ namespace embree
 #define SELECT_SYMBOL_INIT_AVX512KNL(features,intersector)            \
   INIT_SYMBOL(intersector);                                        \
   SELECT_SYMBOL_AVX512KNL(features,intersector);
+
+#define SELECT_SYMBOL_INIT_AVX512KNL_AVX512SKX(features,intersector)  \
+  INIT_SYMBOL(intersector);                                        \
+  SELECT_SYMBOL_AVX512KNL(features,intersector);                   \
+  SELECT_SYMBOL_AVX512SKX(features,intersector);
   
   struct VerifyMultiTargetLinking {
     static __noinline int getISA(int depth = 5) { 
@@ -207,4 +226,5 @@ namespace embree
   namespace avx    { int getISA(); };
   namespace avx2   { int getISA(); };
   namespace avx512 { int getISA(); };
+  namespace avx512skx { int getISA(); };
 }
@@ -0,0 +1,127 @@
+// ======================================================================== //
+// Copyright 2009-2015 Intel Corporation                                    //
+//                                                                          //
+// Licensed under the Apache License, Version 2.0 (the "License");          //
+// you may not use this file except in compliance with the License.         //
+// You may obtain a copy of the License at                                  //
+//                                                                          //
+//     http://www.apache.org/licenses/LICENSE-2.0                           //
+//                                                                          //
+// Unless required by applicable law or agreed to in writing, software      //
+// distributed under the License is distributed on an "AS IS" BASIS,        //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. //
+// See the License for the specific language governing permissions and      //
+// limitations under the License.                                           //
+// ======================================================================== //
+
+#include "out_of_core_cache.h"
+
+namespace embree
+{
+  OutOfCoreCache::OutOfCoreCache (size_t budget)
+    : budget(budget), residentBytes(0), numPageIns(0), numPageOuts(0), time(0) {}
+
+  void OutOfCoreCache::insert(Entry* entry, size_t bytes, bool pinned)
+  {
+    {
+      Lock<MutexSys> lock(mutex);
+      assert(!entry->registered);
+      entry->bytes = bytes;
+      entry->pinned = pinned;
+      entry->registered = true;
+      entry->lastAccess = time;
+      if (entry->resident == 0) entry->resident.inc();
+      residentBytes += bytes;
+      entries.push_back(entry);
+    }
+    evict();
+  }
+
+  void OutOfCoreCache::remove(Entry* entry)
+  {
+    Lock<MutexSys> lock(mutex);
+    if (!entry->registered) return;
+    assert(entry->users == 0);
+
+    for (size_t i=0; i<entries.size(); i++) {
+      if (entries[i] != entry) continue;
+      entries[i] = entries.back();
+      entries.pop_back();
+      break;
+    }
+    entry->registered = false;
+
+    Lock<MutexSys> elock(entry->mutex);
+    if (entry->resident) residentBytes -= entry->bytes;
+    entry->bytes = 0;
+  }
+
+  void OutOfCoreCache::pageIn(Entry* entry)
+  {
+    {
+      Lock<MutexSys> lock(entry->mutex);
+      if (entry->resident == 0)
+      {
+        const size_t bytes = entry->pageIn();
+        if (bytes == 0) {
+          entry->release();
+          throw_RTCError(RTC_UNKNOWN_ERROR,"paging in out of core geometry failed");
+        }
+        entry->bytes = bytes;
+        residentBytes += bytes;
+        numPageIns++;
+        entry->resident.inc();
+      }
+      entry->lastAccess = ++time;
+    }
+    evict();
+  }
+
+  void OutOfCoreCache::evict()
+  {
+    if (size_t(residentBytes) <= budget)
+      return;
+
+    Lock<MutexSys> lock(mutex);
+
+    /* sort evictable entries by time of last access */
+    std::vector<std::pair<atomic_t,Entry*> > lru;
+    for (size_t i=0; i<entries.size(); i++) {
+      Entry* entry = entries[i];
+      if (entry->pinned || entry->resident == 0 || entry->users != 0) continue;
+      lru.push_back(std::make_pair(entry->lastAccess,entry));
+    }
+    std::sort(lru.begin(),lru.end());
+
+    for (size_t i=0; i<lru.size() && size_t(residentBytes) > budget; i++)
+    {
+      Entry* entry = lru[i].second;
+      Lock<MutexSys> elock(entry->mutex);
+      if (entry->resident == 0) continue;
+
+      /* clear the resident flag before checking the users, a ray
+       * that started using the entry in between either sees the
+       * cleared flag and waits for the lock, or gets seen here */
+      entry->resident.dec();
+      if (entry->users != 0) {
+        entry->resident.inc();
+        continue;
+      }
+      entry->pageOut();
+      residentBytes -= entry->bytes;
+      entry->bytes = 0;
+      numPageOuts++;
+    }
+  }
+
+  void OutOfCoreCache::print()
+  {
+    Lock<MutexSys> lock(mutex);
+    std::cout << "out of core cache:" << std::endl;
+    std::cout << "  entries       = " << entries.size() << std::endl;
+    std::cout << "  budget        = " << 1E-6*double(budget) << " MB" << std::endl;
+    std::cout << "  resident      = " << 1E-6*double(size_t(residentBytes)) << " MB" << std::endl;
+    std::cout << "  page ins      = " << size_t(numPageIns) << std::endl;
+    std::cout << "  page outs     = " << size_t(numPageOuts) << std::endl;
+  }
+}
@@ -0,0 +1,113 @@
+// ======================================================================== //
+// Copyright 2009-2015 Intel Corporation                                    //
+//                                                                          //
+// Licensed under the Apache License, Version 2.0 (the "License");          //
+// you may not use this file except in compliance with the License.         //
+// You may obtain a copy of the License at                                  //
+//                                                                          //
+//     http://www.apache.org/licenses/LICENSE-2.0                           //
+//                                                                          //
+// Unless required by applicable law or agreed to in writing, software      //
+// distributed under the License is distributed on an "AS IS" BASIS,        //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. //
+// See the License for the specific language governing permissions and      //
+// limitations under the License.                                           //
+// ======================================================================== //
+
+#pragma once
+
+#include "default.h"
+#include "accel.h"
+
+namespace embree
+{
+  /*! Cache of demand paged acceleration structures for scenes that do
+   *  not fit into memory. Each entry is backed by a file and gets
+   *  paged in when a ray reaches it. If the resident entries exceed
+   *  the memory budget, the least recently used entries that are not
+   *  traversed by some ray get paged out again. */
+  class OutOfCoreCache
+  {
+  public:
+
+    /*! demand paged acceleration structure */
+    class Entry
+    {
+      friend class OutOfCoreCache;
+
+    public:
+      Entry (OutOfCoreCache* cache)
+        : cache(cache), resident(0), users(0), lastAccess(0), bytes(0), pinned(false), registered(false) {}
+
+      virtual ~Entry() {}
+
+      /*! loads the acceleration structure, returns the number of resident bytes or 0 on failure */
+      virtual size_t pageIn() = 0;
+
+      /*! frees the memory of the acceleration structure */
+      virtual void pageOut() = 0;
+
+      /*! makes the entry resident and protects it against eviction until released */
+      __forceinline void acquire()
+      {
+        users++;
+        lastAccess = cache->time;
+        if (unlikely(resident == 0))
+          cache->pageIn(this);
+      }
+
+      /*! allows eviction of the entry again */
+      __forceinline void release() {
+        users--;
+      }
+
+    public:
+      Accel::Intersectors intersectors;  //!< intersectors of the paged acceleration structure
+
+    protected:
+      OutOfCoreCache* cache;             //!< cache managing this entry
+
+    private:
+      AtomicCounter resident;            //!< 1 if the acceleration structure is in memory
+      AtomicCounter users;               //!< number of rays traversing the entry
+      volatile atomic_t lastAccess;      //!< time of last access used for LRU eviction
+      size_t bytes;                      //!< resident size in bytes
+      bool pinned;                       //!< entry cannot get paged out
+      bool registered;                   //!< entry is managed by the cache
+      MutexSys mutex;                    //!< serializes paging of this entry
+    };
+
+  public:
+
+    /*! creates a cache that keeps at most 'budget' bytes resident */
+    OutOfCoreCache (size_t budget);
+
+    /*! registers a resident entry, pinned entries stay resident */
+    void insert(Entry* entry, size_t bytes, bool pinned);
+
+    /*! unregisters an entry, the entry must not be in use */
+    void remove(Entry* entry);
+
+    /*! prints statistics of the cache */
+    void print();
+
+  private:
+
+    /*! pages in some entry and evicts others if the budget is exceeded */
+    void pageIn(Entry* entry);
+
+    /*! pages out least recently used entries until the budget is met */
+    void evict();
+
+  public:
+    const size_t budget;               //!< maximal number of resident bytes
+    AtomicCounter residentBytes;       //!< number of bytes currently resident
+    AtomicCounter numPageIns;          //!< number of entries paged in
+    AtomicCounter numPageOuts;         //!< number of entries paged out
+
+  private:
+    AtomicCounter time;                //!< incremented on every page in
+    std::vector<Entry*> entries;       //!< all registered entries
+    MutexSys mutex;                    //!< protects entry list and eviction
+  };
+}
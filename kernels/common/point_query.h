@@ -0,0 +1,60 @@
+// ======================================================================== //
+// Copyright 2009-2015 Intel Corporation                                    //
+//                                                                          //
+// Licensed under the Apache License, Version 2.0 (the "License");          //
+// you may not use this file except in compliance with the License.         //
+// You may obtain a copy of the License at                                  //
+//                                                                          //
+//     http://www.apache.org/licenses/LICENSE-2.0                           //
+//                                                                          //
+// Unless required by applicable law or agreed to in writing, software      //
+// distributed under the License is distributed on an "AS IS" BASIS,        //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. //
+// See the License for the specific language governing permissions and      //
+// limitations under the License.                                           //
+// ======================================================================== //
+
+
+#pragma once
+
+#include "default.h"
+
+namespace embree
+{
+  class Scene;
+
+  /*! State of a point query that is passed through the acceleration structures. */
+  struct PointQueryContext
+  {
+    __forceinline PointQueryContext (Scene* scene, RTCPointQuery& query, RTCPointQueryFunc func, void* userPtr)
+      : scene(scene), query(query), func(func), userPtr(userPtr) {}
+
+    /*! returns the query position */
+    __forceinline Vec3fa p() const {
+      return Vec3fa(query.p[0],query.p[1],query.p[2]);
+    }
+
+    /*! returns the current search radius, the callback may have shrunk it */
+    __forceinline float radius() const {
+      return query.radius;
+    }
+
+    /*! reports the closest point of some primitive to the callback if it is inside the search radius */
+    __forceinline void report(const Vec3fa& closest, const float distance, const unsigned geomID, const unsigned primID)
+    {
+      if (distance > query.radius) return;
+      RTCClosestPoint candidate;
+      candidate.p[0] = closest.x; candidate.p[1] = closest.y; candidate.p[2] = closest.z;
+      candidate.distance = distance;
+      candidate.geomID = geomID;
+      candidate.primID = primID;
+      func(userPtr,query,candidate);
+    }
+
+  public:
+    Scene* scene;             //!< scene the query is performed on
+    RTCPointQuery& query;     //!< point query, radius may change during traversal
+    RTCPointQueryFunc func;   //!< user callback
+    void* userPtr;            //!< user pointer passed to the callback
+  };
+}
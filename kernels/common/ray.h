@@ -54,6 +54,9 @@ namespace embree
     __forceinline void get(RayK<1>* ray) const;
     __forceinline void set(const RayK<1>* ray);
 
+    __forceinline void get(size_t i, RayK<1>& ray) const;
+    __forceinline void set(size_t i, const RayK<1>& ray);
+
 #if defined(__MIC__)
     template<int PFHINT>
     __forceinline void prefetchHitData() const
@@ -232,6 +235,30 @@ namespace embree
     }
   }
 
+  /* Extracts a single ray from the ray packet */
+  template<int K>
+  __forceinline void RayK<K>::get(size_t i, RayK<1>& ray) const
+  {
+    ray.org.x = org.x[i]; ray.org.y = org.y[i]; ray.org.z = org.z[i];
+    ray.dir.x = dir.x[i]; ray.dir.y = dir.y[i]; ray.dir.z = dir.z[i];
+    ray.tnear = tnear[i]; ray.tfar  = tfar [i]; ray.time  = time[i]; ray.mask = mask[i];
+    ray.Ng.x = Ng.x[i]; ray.Ng.y = Ng.y[i]; ray.Ng.z = Ng.z[i];
+    ray.u = u[i]; ray.v = v[i];
+    ray.geomID = geomID[i]; ray.primID = primID[i]; ray.instID = instID[i];
+  }
+
+  /* Writes a single ray back into the ray packet */
+  template<int K>
+  __forceinline void RayK<K>::set(size_t i, const RayK<1>& ray)
+  {
+    org.x[i] = ray.org.x; org.y[i] = ray.org.y; org.z[i] = ray.org.z;
+    dir.x[i] = ray.dir.x; dir.y[i] = ray.dir.y; dir.z[i] = ray.dir.z;
+    tnear[i] = ray.tnear; tfar [i] = ray.tfar;  time[i] = ray.time; mask[i] = ray.mask;
+    Ng.x[i] = ray.Ng.x; Ng.y[i] = ray.Ng.y; Ng.z[i] = ray.Ng.z;
+    u[i] = ray.u; v[i] = ray.v;
+    geomID[i] = ray.geomID; primID[i] = ray.primID; instID[i] = ray.instID;
+  }
+
   /* Shortcuts */
   typedef RayK<1>  Ray;
   typedef RayK<4>  Ray4;
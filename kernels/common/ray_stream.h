@@ -0,0 +1,47 @@
+// ======================================================================== //
+// Copyright 2009-2015 Intel Corporation                                    //
+//                                                                          //
+// Licensed under the Apache License, Version 2.0 (the "License");          //
+// you may not use this file except in compliance with the License.         //
+// You may obtain a copy of the License at                                  //
+//                                                                          //
+//     http://www.apache.org/licenses/LICENSE-2.0                           //
+//                                                                          //
+// Unless required by applicable law or agreed to in writing, software      //
+// distributed under the License is distributed on an "AS IS" BASIS,        //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. //
+// See the License for the specific language governing permissions and      //
+// limitations under the License.                                           //
+// ======================================================================== //
+
+
+#pragma once
+
+#include "default.h"
+
+namespace embree
+{
+  class Scene;
+
+  /*! Function table of the ray stream API. The stream filters sort
+   *  the rays of a stream into coherent packets and trace these
+   *  packets using the packet intersectors of the scene. */
+  struct RayStreamFilterFuncs
+  {
+    /*! Type of stream function for rays in array of structures layout. */
+    typedef void (*FilterAOSFunc)(Scene* scene, RTCRay* rays, const size_t M, const size_t stride, const bool intersect);
+
+    /*! Type of stream function for rays in structure of pointers layout. */
+    typedef void (*FilterSOPFunc)(Scene* scene, const RTCRayNp& rays, const size_t N, const bool intersect);
+
+    __forceinline RayStreamFilterFuncs()
+      : filterAOS(nullptr), filterSOP(nullptr) {}
+
+    __forceinline RayStreamFilterFuncs(FilterAOSFunc filterAOS, FilterSOPFunc filterSOP)
+      : filterAOS(filterAOS), filterSOP(filterSOP) {}
+
+  public:
+    FilterAOSFunc filterAOS;
+    FilterSOPFunc filterSOP;
+  };
+}
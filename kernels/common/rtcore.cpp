@@ -23,12 +23,50 @@
 #include "device.h"
 #include "scene.h"
 #include "raystream_log.h"
+#include "point_query.h"
 
 namespace embree
 {  
   /* mutex to make API thread safe */
   static MutexSys g_mutex;
 
+  /* counts the active rays of a ray packet */
+  static __forceinline size_t countValid(const void* valid, const size_t N) 
+  {
+    size_t cnt = 0;
+    for (size_t i=0; i<N; i++) cnt += ((int*)valid)[i] == -1;
+    return cnt;
+  }
+
+  /* traces the active rays of a ray packet as one sub-packet per
+   * direction octant, such that the packet traversal does not fall
+   * back to single rays for packets of incoherent directions */
+  template<size_t K, typename RTCRayK, typename Trace>
+  static __forceinline void traceSortedPacket(const void* valid, RTCRayK& ray, const Trace& trace)
+  {
+    unsigned int octant[K];
+    unsigned int octants = 0;
+    for (size_t i=0; i<K; i++) {
+      octant[i] = (ray.dirx[i] < 0.0f ? 1 : 0) | (ray.diry[i] < 0.0f ? 2 : 0) | (ray.dirz[i] < 0.0f ? 4 : 0);
+      if (((int*)valid)[i] == -1) octants |= 1 << octant[i];
+    }
+
+    /* coherent packets are traced directly */
+    if ((octants & (octants-1)) == 0) {
+      trace(valid);
+      return;
+    }
+
+    while (octants)
+    {
+      const unsigned int o = __bscf(octants);
+      __aligned(64) int subvalid[K];
+      for (size_t i=0; i<K; i++)
+        subvalid[i] = (((int*)valid)[i] == -1 && octant[i] == o) ? -1 : 0;
+      trace(subvalid);
+    }
+  }
+
   RTCORE_API RTCDevice rtcNewDevice(const char* cfg)
   {
     RTCORE_CATCH_BEGIN;
@@ -92,6 +130,49 @@ namespace embree
     RTCORE_CATCH_END(device);
   }
 
+  static void copyTraversalStatistics(RTCTraversalStatistics* out, const TraversalStat::Counters& in)
+  {
+    if (out == nullptr) return;
+    out->rays    = in.travs;
+    out->nodes   = in.nodes;
+    out->leaves  = in.leaves;
+    out->prims   = in.prims;
+    out->filters = in.filters;
+  }
+
+  RTCORE_API void rtcDeviceGetTraversalStatistics(RTCDevice hdevice, RTCTraversalStatistics* intersect, RTCTraversalStatistics* occluded)
+  {
+    Device* device = (Device*) hdevice;
+    RTCORE_CATCH_BEGIN;
+    RTCORE_TRACE(rtcDeviceGetTraversalStatistics);
+    RTCORE_VERIFY_HANDLE(hdevice);
+    TraversalStat::Counters normal, shadow;
+    TraversalStat::sum(normal,shadow);
+    copyTraversalStatistics(intersect,normal);
+    copyTraversalStatistics(occluded,shadow);
+    RTCORE_CATCH_END(device);
+  }
+
+  RTCORE_API void rtcDeviceResetTraversalStatistics(RTCDevice hdevice)
+  {
+    Device* device = (Device*) hdevice;
+    RTCORE_CATCH_BEGIN;
+    RTCORE_TRACE(rtcDeviceResetTraversalStatistics);
+    RTCORE_VERIFY_HANDLE(hdevice);
+    TraversalStat::clear();
+    RTCORE_CATCH_END(device);
+  }
+
+  RTCORE_API void rtcGetThreadTraversalStatistics(RTCTraversalStatistics* intersect, RTCTraversalStatistics* occluded)
+  {
+    RTCORE_CATCH_BEGIN;
+    RTCORE_TRACE(rtcGetThreadTraversalStatistics);
+    const TraversalStat::ThreadCounters& counters = TraversalStat::get();
+    copyTraversalStatistics(intersect,counters.normal);
+    copyTraversalStatistics(occluded,counters.shadow);
+    RTCORE_CATCH_END_NOREPORT;
+  }
+
   RTCORE_API RTCError rtcGetError()
   {
     RTCORE_CATCH_BEGIN;
@@ -208,12 +289,53 @@ namespace embree
     RayStreamLogger::rayStreamLogger.dumpGeometry(scene);
 #endif
 
+    /* wait for pending asynchronous build */
+    scene->waitBuild();
+
     /* perform scene build */
     scene->build(0,0);
     
     RTCORE_CATCH_END(scene->device);
   }
 
+  RTCORE_API void rtcCommitAsync (RTCScene hscene) 
+  {
+    Scene* scene = (Scene*) hscene;
+    RTCORE_CATCH_BEGIN;
+    RTCORE_TRACE(rtcCommitAsync);
+    RTCORE_VERIFY_HANDLE(hscene);
+
+#if defined(RTCORE_ENABLE_RAYSTREAM_LOGGER)
+    RayStreamLogger::rayStreamLogger.dumpGeometry(scene);
+#endif
+
+    /* start scene build in background thread */
+    scene->buildAsync();
+    
+    RTCORE_CATCH_END(scene->device);
+  }
+
+  RTCORE_API void rtcWaitCommit (RTCScene hscene) 
+  {
+    Scene* scene = (Scene*) hscene;
+    RTCORE_CATCH_BEGIN;
+    RTCORE_TRACE(rtcWaitCommit);
+    RTCORE_VERIFY_HANDLE(hscene);
+    scene->waitBuild();
+    RTCORE_CATCH_END(scene->device);
+  }
+
+  RTCORE_API bool rtcIsCommitted (RTCScene hscene) 
+  {
+    Scene* scene = (Scene*) hscene;
+    RTCORE_CATCH_BEGIN;
+    RTCORE_TRACE(rtcIsCommitted);
+    RTCORE_VERIFY_HANDLE(hscene);
+    return scene->isCommitted();
+    RTCORE_CATCH_END(scene->device);
+    return false;
+  }
+
   RTCORE_API void rtcCommitThread(RTCScene hscene, unsigned int threadID, unsigned int numThreads) 
   {
     Scene* scene = (Scene*) hscene;
@@ -235,6 +357,9 @@ namespace embree
     _mm_setcsr(mxcsr | /* FTZ */ (1<<15) | /* DAZ */ (1<<6));
 #endif
     
+    /* wait for pending asynchronous build */
+    if (threadID == 0) scene->waitBuild();
+
      /* perform scene build */
     scene->build(threadID,numThreads);
 
@@ -262,6 +387,7 @@ namespace embree
 #endif
 
     STAT3(normal.travs,1,1,1);
+    TRAVSTAT(normal.travs,1);
     scene->intersect(ray);
 
 #if defined(RTCORE_ENABLE_RAYSTREAM_LOGGER)
@@ -287,6 +413,7 @@ namespace embree
 #endif
     STAT(size_t cnt=0; for (size_t i=0; i<4; i++) cnt += ((int*)valid)[i] == -1;);
     STAT3(normal.travs,1,cnt,4);
+    TRAVSTAT(normal.travs,countValid(valid,4));
 
 #if defined(RTCORE_ENABLE_RAYSTREAM_LOGGER)
     RTCRay4 old_ray = ray;
@@ -320,12 +447,16 @@ namespace embree
 #endif
     STAT(size_t cnt=0; for (size_t i=0; i<8; i++) cnt += ((int*)valid)[i] == -1;);
     STAT3(normal.travs,1,cnt,8);
+    TRAVSTAT(normal.travs,countValid(valid,8));
 
 #if defined(RTCORE_ENABLE_RAYSTREAM_LOGGER)
     RTCRay8 old_ray = ray;
 #endif
 
-    scene->intersect8(valid,ray);
+    if (scene->device->ray_sorting)
+      traceSortedPacket<8>(valid,ray,[&] (const void* subvalid) { scene->intersect8(subvalid,ray); });
+    else
+      scene->intersect8(valid,ray);
 
 #if defined(RTCORE_ENABLE_RAYSTREAM_LOGGER)
     RayStreamLogger::rayStreamLogger.logRay8Intersect(valid,scene,old_ray,ray);
@@ -353,17 +484,67 @@ namespace embree
 #endif
     STAT(size_t cnt=0; for (size_t i=0; i<16; i++) cnt += ((int*)valid)[i] == -1;);
     STAT3(normal.travs,1,cnt,16);
+    TRAVSTAT(normal.travs,countValid(valid,16));
 
 #if defined(RTCORE_ENABLE_RAYSTREAM_LOGGER)
     RTCRay16 old_ray = ray;
 #endif
 
-    scene->intersect16(valid,ray);
+    if (scene->device->ray_sorting)
+      traceSortedPacket<16>(valid,ray,[&] (const void* subvalid) { scene->intersect16(subvalid,ray); });
+    else
+      scene->intersect16(valid,ray);
 
 #if defined(RTCORE_ENABLE_RAYSTREAM_LOGGER)
     RayStreamLogger::rayStreamLogger.logRay16Intersect(valid,scene,old_ray,ray);
 #endif
 
+#endif
+    RTCORE_CATCH_END(scene->device);
+  }
+#endif
+  
+#if defined (RTCORE_RAY_PACKETS)
+  RTCORE_API void rtcIntersect1M (RTCScene hscene, RTCRay* rays, const size_t M, const size_t stride) 
+  {
+    Scene* scene = (Scene*) hscene;
+    RTCORE_CATCH_BEGIN;
+    RTCORE_TRACE(rtcIntersect1M);
+#if defined(__MIC__)
+    throw_RTCError(RTC_INVALID_OPERATION,"rtcIntersect1M not supported");
+#else
+#if defined(DEBUG)
+    RTCORE_VERIFY_HANDLE(hscene);
+    if (scene->isModified()) throw_RTCError(RTC_INVALID_OPERATION,"scene got not committed");
+    if (((size_t)rays  ) & 0x0F      ) throw_RTCError(RTC_INVALID_ARGUMENT, "rays not aligned to 16 bytes");   
+    if (((size_t)stride) & 0x0F      ) throw_RTCError(RTC_INVALID_ARGUMENT, "stride not a multiple of 16 bytes");   
+#endif
+    if ((scene->aflags & RTC_INTERSECT_STREAM) == 0) throw_RTCError(RTC_INVALID_OPERATION,"rtcIntersect1M and rtcIntersectNp not enabled");
+    STAT3(normal.travs,1,M,M);
+    TRAVSTAT(normal.travs,M);
+    scene->device->rayStreamFilters.filterAOS(scene,rays,M,stride,true);
+#endif
+    RTCORE_CATCH_END(scene->device);
+  }
+#endif
+
+#if defined (RTCORE_RAY_PACKETS)
+  RTCORE_API void rtcIntersectNp (RTCScene hscene, const RTCRayNp& rays, const size_t N) 
+  {
+    Scene* scene = (Scene*) hscene;
+    RTCORE_CATCH_BEGIN;
+    RTCORE_TRACE(rtcIntersectNp);
+#if defined(__MIC__)
+    throw_RTCError(RTC_INVALID_OPERATION,"rtcIntersectNp not supported");
+#else
+#if defined(DEBUG)
+    RTCORE_VERIFY_HANDLE(hscene);
+    if (scene->isModified()) throw_RTCError(RTC_INVALID_OPERATION,"scene got not committed");
+#endif
+    if ((scene->aflags & RTC_INTERSECT_STREAM) == 0) throw_RTCError(RTC_INVALID_OPERATION,"rtcIntersect1M and rtcIntersectNp not enabled");
+    STAT3(normal.travs,1,N,N);
+    TRAVSTAT(normal.travs,N);
+    scene->device->rayStreamFilters.filterSOP(scene,rays,N,true);
 #endif
     RTCORE_CATCH_END(scene->device);
   }
@@ -375,6 +556,7 @@ namespace embree
     RTCORE_CATCH_BEGIN;
     RTCORE_TRACE(rtcOccluded);
     STAT3(shadow.travs,1,1,1);
+    TRAVSTAT(shadow.travs,1);
 #if defined(DEBUG)
     RTCORE_VERIFY_HANDLE(hscene);
     if (scene->isModified()) throw_RTCError(RTC_INVALID_OPERATION,"scene got not committed");
@@ -410,6 +592,7 @@ namespace embree
 #endif
     STAT(size_t cnt=0; for (size_t i=0; i<4; i++) cnt += ((int*)valid)[i] == -1;);
     STAT3(shadow.travs,1,cnt,4);
+    TRAVSTAT(shadow.travs,countValid(valid,4));
 
 #if defined(RTCORE_ENABLE_RAYSTREAM_LOGGER)
     RTCRay4 old_ray = ray;
@@ -443,12 +626,16 @@ namespace embree
 #endif
     STAT(size_t cnt=0; for (size_t i=0; i<8; i++) cnt += ((int*)valid)[i] == -1;);
     STAT3(shadow.travs,1,cnt,8);
+    TRAVSTAT(shadow.travs,countValid(valid,8));
 
 #if defined(RTCORE_ENABLE_RAYSTREAM_LOGGER)
     RTCRay8 old_ray = ray;
 #endif
 
-    scene->occluded8(valid,ray);
+    if (scene->device->ray_sorting)
+      traceSortedPacket<8>(valid,ray,[&] (const void* subvalid) { scene->occluded8(subvalid,ray); });
+    else
+      scene->occluded8(valid,ray);
 
 #if defined(RTCORE_ENABLE_RAYSTREAM_LOGGER)
     RayStreamLogger::rayStreamLogger.logRay8Occluded(valid,scene,old_ray,ray);
@@ -476,12 +663,16 @@ namespace embree
 #endif
     STAT(size_t cnt=0; for (size_t i=0; i<16; i++) cnt += ((int*)valid)[i] == -1;);
     STAT3(shadow.travs,1,cnt,16);
+    TRAVSTAT(shadow.travs,countValid(valid,16));
 
 #if defined(RTCORE_ENABLE_RAYSTREAM_LOGGER)
     RTCRay16 old_ray = ray;
 #endif
 
-    scene->occluded16(valid,ray);
+    if (scene->device->ray_sorting)
+      traceSortedPacket<16>(valid,ray,[&] (const void* subvalid) { scene->occluded16(subvalid,ray); });
+    else
+      scene->occluded16(valid,ray);
 
 #if defined(RTCORE_ENABLE_RAYSTREAM_LOGGER)
     RayStreamLogger::rayStreamLogger.logRay16Occluded(valid,scene,old_ray,ray);
@@ -492,6 +683,136 @@ namespace embree
   }
 #endif
   
+#if defined (RTCORE_RAY_PACKETS)
+  RTCORE_API void rtcOccluded1M (RTCScene hscene, RTCRay* rays, const size_t M, const size_t stride) 
+  {
+    Scene* scene = (Scene*) hscene;
+    RTCORE_CATCH_BEGIN;
+    RTCORE_TRACE(rtcOccluded1M);
+#if defined(__MIC__)
+    throw_RTCError(RTC_INVALID_OPERATION,"rtcOccluded1M not supported");
+#else
+#if defined(DEBUG)
+    RTCORE_VERIFY_HANDLE(hscene);
+    if (scene->isModified()) throw_RTCError(RTC_INVALID_OPERATION,"scene got not committed");
+    if (((size_t)rays  ) & 0x0F      ) throw_RTCError(RTC_INVALID_ARGUMENT, "rays not aligned to 16 bytes");   
+    if (((size_t)stride) & 0x0F      ) throw_RTCError(RTC_INVALID_ARGUMENT, "stride not a multiple of 16 bytes");   
+#endif
+    if ((scene->aflags & RTC_INTERSECT_STREAM) == 0) throw_RTCError(RTC_INVALID_OPERATION,"rtcOccluded1M and rtcOccludedNp not enabled");
+    STAT3(shadow.travs,1,M,M);
+    TRAVSTAT(shadow.travs,M);
+    scene->device->rayStreamFilters.filterAOS(scene,rays,M,stride,false);
+#endif
+    RTCORE_CATCH_END(scene->device);
+  }
+#endif
+
+#if defined (RTCORE_RAY_PACKETS)
+  RTCORE_API void rtcOccludedNp (RTCScene hscene, const RTCRayNp& rays, const size_t N) 
+  {
+    Scene* scene = (Scene*) hscene;
+    RTCORE_CATCH_BEGIN;
+    RTCORE_TRACE(rtcOccludedNp);
+#if defined(__MIC__)
+    throw_RTCError(RTC_INVALID_OPERATION,"rtcOccludedNp not supported");
+#else
+#if defined(DEBUG)
+    RTCORE_VERIFY_HANDLE(hscene);
+    if (scene->isModified()) throw_RTCError(RTC_INVALID_OPERATION,"scene got not committed");
+#endif
+    if ((scene->aflags & RTC_INTERSECT_STREAM) == 0) throw_RTCError(RTC_INVALID_OPERATION,"rtcOccluded1M and rtcOccludedNp not enabled");
+    STAT3(shadow.travs,1,N,N);
+    TRAVSTAT(shadow.travs,N);
+    scene->device->rayStreamFilters.filterSOP(scene,rays,N,false);
+#endif
+    RTCORE_CATCH_END(scene->device);
+  }
+#endif
+  
+  RTCORE_API void rtcPointQuery (RTCScene hscene, RTCPointQuery& query, RTCPointQueryFunc func, void* userPtr) 
+  {
+    Scene* scene = (Scene*) hscene;
+    RTCORE_CATCH_BEGIN;
+    RTCORE_TRACE(rtcPointQuery);
+#if defined(__MIC__)
+    throw_RTCError(RTC_INVALID_OPERATION,"rtcPointQuery not supported");
+#else
+#if defined(DEBUG)
+    RTCORE_VERIFY_HANDLE(hscene);
+    if (scene->isModified()) throw_RTCError(RTC_INVALID_OPERATION,"scene got not committed");
+    if (((size_t)&query) & 0x0F) throw_RTCError(RTC_INVALID_ARGUMENT, "query not aligned to 16 bytes");   
+#endif
+    if ((scene->aflags & RTC_POINT_QUERY) == 0) throw_RTCError(RTC_INVALID_OPERATION,"rtcPointQuery and rtcClosestPoint not enabled");
+    if (func == nullptr) throw_RTCError(RTC_INVALID_ARGUMENT,"invalid point query function");
+    if (!(query.radius >= 0.0f)) throw_RTCError(RTC_INVALID_ARGUMENT,"invalid point query radius");
+    PointQueryContext context(scene,query,func,userPtr);
+    scene->pointQuery(&context);
+#endif
+    RTCORE_CATCH_END(scene->device);
+  }
+
+  /*! keeps the closest candidate and shrinks the search radius to its distance */
+  static void closestPointFunc(void* userPtr, RTCPointQuery& query, const RTCClosestPoint& candidate)
+  {
+    RTCClosestPoint& result = *(RTCClosestPoint*) userPtr;
+    if (candidate.distance >= result.distance) return;
+    result = candidate;
+    query.radius = candidate.distance;
+  }
+
+  RTCORE_API void rtcClosestPoint (RTCScene hscene, const RTCPointQuery& query, RTCClosestPoint& result) 
+  {
+    Scene* scene = (Scene*) hscene;
+    RTCORE_CATCH_BEGIN;
+    RTCORE_TRACE(rtcClosestPoint);
+    result.p[0] = result.p[1] = result.p[2] = 0.0f;
+    result.distance = inf;
+    result.geomID = RTC_INVALID_GEOMETRY_ID;
+    result.primID = RTC_INVALID_GEOMETRY_ID;
+    RTCPointQuery q = query;
+    rtcPointQuery(hscene,q,closestPointFunc,&result);
+    RTCORE_CATCH_END(scene->device);
+  }
+
+  RTCORE_API size_t rtcGetSceneStatistics (RTCScene hscene, RTCAccelStatistics* stats, size_t maxStats) 
+  {
+    Scene* scene = (Scene*) hscene;
+    RTCORE_CATCH_BEGIN;
+    RTCORE_TRACE(rtcGetSceneStatistics);
+    RTCORE_VERIFY_HANDLE(hscene);
+    if (scene->isModified()) throw_RTCError(RTC_INVALID_OPERATION,"scene got not committed");
+    if (stats == nullptr && maxStats != 0) throw_RTCError(RTC_INVALID_ARGUMENT,"invalid statistics array");
+    return scene->accels.statistics(stats,maxStats);
+    RTCORE_CATCH_END(scene->device);
+    return 0;
+  }
+
+  RTCORE_API void rtcSetTessellationCacheBudget (RTCScene hscene, size_t bytes) 
+  {
+    Scene* scene = (Scene*) hscene;
+    RTCORE_CATCH_BEGIN;
+    RTCORE_TRACE(rtcSetTessellationCacheBudget);
+    RTCORE_VERIFY_HANDLE(hscene);
+    scene->setTessellationCacheBudget(bytes);
+    RTCORE_CATCH_END(scene->device);
+  }
+
+  RTCORE_API void rtcGetTessellationCacheStatistics (RTCScene hscene, RTCTessellationCacheStatistics* stats) 
+  {
+    Scene* scene = (Scene*) hscene;
+    RTCORE_CATCH_BEGIN;
+    RTCORE_TRACE(rtcGetTessellationCacheStatistics);
+    RTCORE_VERIFY_HANDLE(hscene);
+    if (stats == nullptr) throw_RTCError(RTC_INVALID_ARGUMENT,"invalid statistics pointer");
+    const SharedLazyTessellationCache::Statistics s = SharedLazyTessellationCache::sharedLazyTessellationCache.getStatistics(scene->tessellationPartition);
+    stats->bytes           = s.bytes;
+    stats->hits            = s.hits;
+    stats->misses          = s.misses;
+    stats->segmentSwitches = s.segmentSwitches;
+    stats->flushes         = s.flushes;
+    RTCORE_CATCH_END(scene->device);
+  }
+
   RTCORE_API void rtcDeleteScene (RTCScene hscene) 
   {
     Scene* scene = (Scene*) hscene;
@@ -517,7 +838,7 @@ namespace embree
     return -1;
   }
 
-  /*RTCORE_API unsigned rtcNewGeometryInstance (RTCScene hscene, unsigned geomID) 
+  RTCORE_API unsigned rtcNewGeometryInstance (RTCScene hscene, unsigned geomID) 
   {
     Scene* scene = (Scene*) hscene;
     RTCORE_CATCH_BEGIN;
@@ -527,7 +848,7 @@ namespace embree
     return scene->newGeometryInstance(scene->get_locked(geomID));
     RTCORE_CATCH_END(scene->device);
     return -1;
-    }*/
+  }
 
   RTCORE_API void rtcSetTransform (RTCScene hscene, unsigned geomID, RTCMatrixType layout, const float* xfm) 
   {
@@ -749,6 +1070,17 @@ namespace embree
     RTCORE_CATCH_END(scene->device);
   }
 
+  RTCORE_API void rtcUpdateBufferRange (RTCScene hscene, unsigned geomID, RTCBufferType type, size_t offset, size_t num) 
+  {
+    Scene* scene = (Scene*) hscene;
+    RTCORE_CATCH_BEGIN;
+    RTCORE_TRACE(rtcUpdateBufferRange);
+    RTCORE_VERIFY_HANDLE(hscene);
+    RTCORE_VERIFY_GEOMID(geomID);
+    scene->get_locked(geomID)->updateBufferRange(type,offset,num);
+    RTCORE_CATCH_END(scene->device);
+  }
+
   RTCORE_API void rtcDisable (RTCScene hscene, unsigned geomID) 
   {
     Scene* scene = (Scene*) hscene;
@@ -148,9 +148,9 @@ namespace embree
     return rtcNewInstance(target,source);
   }
 
-  /*extern "C" unsigned ispcNewGeometryInstance (RTCScene scene, unsigned geomID) {
+  extern "C" unsigned ispcNewGeometryInstance (RTCScene scene, unsigned geomID) {
     return rtcNewGeometryInstance(scene,geomID);
-    }*/
+  }
   
   extern "C" void ispcSetTransform (RTCScene scene, unsigned geomID, RTCMatrixType layout, const float* xfm) {
     return rtcSetTransform(scene,geomID,layout,xfm);
@@ -221,6 +221,10 @@ namespace embree
   extern "C" void ispcUpdateBuffer (RTCScene scene, unsigned geomID, RTCBufferType type) {
     rtcUpdateBuffer(scene,geomID,type);
   }
+
+  extern "C" void ispcUpdateBufferRange (RTCScene scene, unsigned geomID, RTCBufferType type, size_t offset, size_t num) {
+    rtcUpdateBufferRange(scene,geomID,type,offset,num);
+  }
   
   extern "C" void ispcDisable (RTCScene scene, unsigned geomID) {
     rtcDisable(scene,geomID);
@@ -19,6 +19,7 @@
 #if !defined(__MIC__)
 #include "../xeon/bvh/bvh4_factory.h"
 #include "../xeon/bvh/bvh8_factory.h"
+#include "../xeon/bvh/bvh16_factory.h"
 #else
 #include "../xeonphi/bvh4i/bvh4i_factory.h"
 #include "../xeonphi/bvh4mb/bvh4mb_factory.h"
@@ -48,8 +49,10 @@ namespace embree
       needLineIndices(false), needLineVertices(false),
       needPointVertices(false),
       needSubdivIndices(false), needSubdivVertices(false),
-      numIntersectionFilters4(0), numIntersectionFilters8(0), numIntersectionFilters16(0),
+      numIntersectionFilters1(0), numIntersectionFilters4(0), numIntersectionFilters8(0), numIntersectionFilters16(0),
       commitCounter(0), commitCounterSubdiv(0), 
+      tessellationPartition(SharedLazyTessellationCache::sharedLazyTessellationCache.getSharedPartition()),
+      asyncBuildThread(nullptr), asyncBuildDone(false), asyncBuildError(RTC_NO_ERROR),
       progress_monitor_function(nullptr), progress_monitor_ptr(nullptr), progress_monitor_counter(0),
       progressInterface(this)
   {
@@ -66,6 +69,17 @@ namespace embree
     if (device->scene_flags != -1)
       flags = (RTCSceneFlags) device->scene_flags;
 
+    /* point queries read the vertices of the original geometries */
+    if (aflags & RTC_POINT_QUERY) {
+      needTriangleIndices = true;
+      needQuadIndices = true;
+      needLineIndices = true;
+      needTriangleVertices = true;
+      needQuadVertices = true;      
+      needLineVertices = true;
+      needPointVertices = true;
+    }
+
     if (aflags & RTC_INTERPOLATE) {
       needTriangleIndices = true;
       needQuadIndices = true;
@@ -152,7 +166,7 @@ namespace embree
     createPointAccel();
     createPointMBAccel();
     createSubdivAccel();
-    accels.add(device->bvh4_factory->BVH4InstancedBVH4Triangle4ObjectSplit(this));
+    accels.add(device->bvh4_factory->BVH4InstancedBVH4Triangle4ObjectSplit(this)); // sets the instID field of a hit, thus has to come after the non-instanced geometry
     accels.add(device->bvh4_factory->BVH4UserGeometry(this)); // has to be the last as the instID field of a hit instance is not invalidated by other hit geometry
     accels.add(device->bvh4_factory->BVH4UserGeometryMB(this)); // has to be the last as the instID field of a hit instance is not invalidated by other hit geometry
 #endif
@@ -167,7 +181,11 @@ namespace embree
   {
     if (device->tri_accel == "default") 
     {
-      if (isStatic()) {
+      /* static scenes page their geometry out if an out of core directory is set */
+      if (isStatic() && device->out_of_core_dir != "") {
+        accels.add(device->bvh4_factory->BVH4Triangle4OutOfCore(this));
+      }
+      else if (isStatic()) {
         int mode =  2*(int)isCompact() + 1*(int)isRobust(); 
         switch (mode) {
         case /*0b00*/ 0: 
@@ -204,11 +222,17 @@ namespace embree
     else if (device->tri_accel == "bvh4.triangle4")       accels.add(device->bvh4_factory->BVH4Triangle4(this));
     else if (device->tri_accel == "bvh4.triangle4v")      accels.add(device->bvh4_factory->BVH4Triangle4v(this));
     else if (device->tri_accel == "bvh4.triangle4i")      accels.add(device->bvh4_factory->BVH4Triangle4i(this));
+    else if (device->tri_accel == "bvh4q.triangle4")      accels.add(device->bvh4_factory->BVH4QuantizedTriangle4(this));
+    else if (device->tri_accel == "bvh4.triangle4.ooc")   accels.add(device->bvh4_factory->BVH4Triangle4OutOfCore(this));
 
 #if defined (__TARGET_AVX__)
     else if (device->tri_accel == "bvh4.triangle8")       accels.add(device->bvh4_factory->BVH4Triangle8(this));
     else if (device->tri_accel == "bvh8.triangle4")       accels.add(device->bvh8_factory->BVH8Triangle4(this));
     else if (device->tri_accel == "bvh8.triangle8")       accels.add(device->bvh8_factory->BVH8Triangle8(this));
+    else if (device->tri_accel == "bvh8q.triangle4")      accels.add(device->bvh8_factory->BVH8QuantizedTriangle4(this));
+#endif
+#if defined (__TARGET_AVX512KNL__) || defined (__TARGET_AVX512SKX__)
+    else if (device->tri_accel == "bvh16.triangle4")      accels.add(device->bvh16_factory->BVH16Triangle4(this));
 #endif
     else throw_RTCError(RTC_INVALID_ARGUMENT,"unknown triangle acceleration structure "+device->tri_accel);
   }
@@ -406,7 +430,7 @@ namespace embree
 
   void Scene::createPointAccel()
   {
-    if (device->line_accel == "default")
+    if (device->point_accel == "default")
     {
       if (isStatic())
       {
@@ -422,16 +446,16 @@ namespace embree
         accels.add(device->bvh4_factory->BVH4Point4iTwolevel(this));
       }
     }
-    else if (device->line_accel == "bvh4.point4i") accels.add(device->bvh4_factory->BVH4Point4i(this));
+    else if (device->point_accel == "bvh4.point4i") accels.add(device->bvh4_factory->BVH4Point4i(this));
 #if defined (__TARGET_AVX__)
-    else if (device->line_accel == "bvh8.point4i") accels.add(device->bvh8_factory->BVH8Point4i(this));
+    else if (device->point_accel == "bvh8.point4i") accels.add(device->bvh8_factory->BVH8Point4i(this));
 #endif
-    else throw_RTCError(RTC_INVALID_ARGUMENT,"unknown point acceleration structure "+device->line_accel);
+    else throw_RTCError(RTC_INVALID_ARGUMENT,"unknown point acceleration structure "+device->point_accel);
   }
 
   void Scene::createPointMBAccel()
   {
-    if (device->line_accel_mb == "default")
+    if (device->point_accel_mb == "default")
     {
 #if defined (__TARGET_AVX__)
       if (device->hasISA(AVX) && !isCompact())
@@ -440,11 +464,11 @@ namespace embree
 #endif
         accels.add(device->bvh4_factory->BVH4Point4iMB(this));
     }
-    else if (device->line_accel_mb == "bvh4.point4imb") accels.add(device->bvh4_factory->BVH4Point4iMB(this));
+    else if (device->point_accel_mb == "bvh4.point4imb") accels.add(device->bvh4_factory->BVH4Point4iMB(this));
 #if defined (__TARGET_AVX__)
-    else if (device->line_accel_mb == "bvh8.point4imb") accels.add(device->bvh8_factory->BVH8Point4iMB(this));
+    else if (device->point_accel_mb == "bvh8.point4imb") accels.add(device->bvh8_factory->BVH8Point4iMB(this));
 #endif
-    else throw_RTCError(RTC_INVALID_ARGUMENT,"unknown motion blur point acceleration structure "+device->line_accel_mb);
+    else throw_RTCError(RTC_INVALID_ARGUMENT,"unknown motion blur point acceleration structure "+device->point_accel_mb);
   }
 
   void Scene::createSubdivAccel()
@@ -481,9 +505,15 @@ namespace embree
 
   Scene::~Scene () 
   {
+    /* an asynchronous build may still access the scene */
+    if (asyncBuildThread) 
+      join(asyncBuildThread);
+
     for (size_t i=0; i<geometries.size(); i++)
       delete geometries[i];
 
+    setTessellationCacheBudget(0);
+
 #if TASKING_TBB
     delete group; group = nullptr;
 #endif
@@ -506,7 +536,12 @@ namespace embree
     return geom->id;
   }
   
-  unsigned Scene::newGeometryInstance (Geometry* geom) {
+  unsigned Scene::newGeometryInstance (Geometry* geom) 
+  {
+    /* only triangle meshes get instantiated natively, possibly through other geometry instances */
+    if ((geom->getType() & ~Geometry::INSTANCE) != Geometry::TRIANGLE_MESH)
+      throw_RTCError(RTC_INVALID_OPERATION,"geometry instances only support triangle meshes");
+
     Geometry* instance = new GeometryInstance(this,geom);
     return instance->id;
   }
@@ -518,12 +553,18 @@ namespace embree
       return -1;
     }
 
-    if (numTimeSteps == 0 || numTimeSteps > 2) {
-      throw_RTCError(RTC_INVALID_OPERATION,"only 1 or 2 time steps supported");
+    if (numTimeSteps == 0 || numTimeSteps > RTC_MAX_TIME_STEPS) {
+      throw_RTCError(RTC_INVALID_OPERATION,"only 1 to " TOSTRING(RTC_MAX_TIME_STEPS) " time steps supported");
       return -1;
     }
     
-    Geometry* geom = new TriangleMesh(this,gflags,numTriangles,numVertices,numTimeSteps);
+    Geometry* geom = nullptr;
+#if defined(__TARGET_AVX__)
+    if (device->hasISA(AVX))
+      geom = new TriangleMeshAVX(this,gflags,numTriangles,numVertices,numTimeSteps);
+    else 
+#endif
+      geom = new TriangleMesh(this,gflags,numTriangles,numVertices,numTimeSteps);
     return geom->id;
   }
 
@@ -534,12 +575,18 @@ namespace embree
       return -1;
     }
 
-    if (numTimeSteps == 0 || numTimeSteps > 2) {
-      throw_RTCError(RTC_INVALID_OPERATION,"only 1 or 2 time steps supported");
+    if (numTimeSteps == 0 || numTimeSteps > RTC_MAX_TIME_STEPS) {
+      throw_RTCError(RTC_INVALID_OPERATION,"only 1 to " TOSTRING(RTC_MAX_TIME_STEPS) " time steps supported");
       return -1;
     }
     
-    Geometry* geom = new QuadMesh(this,gflags,numQuads,numVertices,numTimeSteps);
+    Geometry* geom = nullptr;
+#if defined(__TARGET_AVX__)
+    if (device->hasISA(AVX))
+      geom = new QuadMeshAVX(this,gflags,numQuads,numVertices,numTimeSteps);
+    else 
+#endif
+      geom = new QuadMesh(this,gflags,numQuads,numVertices,numTimeSteps);
     return geom->id;
   }
 
@@ -589,8 +636,8 @@ namespace embree
       return -1;
     }
 
-    if (numTimeSteps == 0 || numTimeSteps > 2) {
-      throw_RTCError(RTC_INVALID_OPERATION,"only 1 or 2 time steps supported");
+    if (numTimeSteps == 0 || numTimeSteps > RTC_MAX_TIME_STEPS) {
+      throw_RTCError(RTC_INVALID_OPERATION,"only 1 to " TOSTRING(RTC_MAX_TIME_STEPS) " time steps supported");
       return -1;
     }
 
@@ -658,9 +705,9 @@ namespace embree
 
     /* enable only algorithms choosen by application */
     if ((aflags & RTC_INTERSECT1) == 0) intersectors.intersector1 = Accel::Intersector1(&invalid_rtcIntersect1);
-    if ((aflags & RTC_INTERSECT4) == 0) intersectors.intersector4 = Accel::Intersector4(&invalid_rtcIntersect4);
-    if ((aflags & RTC_INTERSECT8) == 0) intersectors.intersector8 = Accel::Intersector8(&invalid_rtcIntersect8);
-    if ((aflags & RTC_INTERSECT16) == 0) intersectors.intersector16 = Accel::Intersector16(&invalid_rtcIntersect16);
+    if ((aflags & (RTC_INTERSECT4  | RTC_INTERSECT_STREAM)) == 0) intersectors.intersector4 = Accel::Intersector4(&invalid_rtcIntersect4);
+    if ((aflags & (RTC_INTERSECT8  | RTC_INTERSECT_STREAM)) == 0) intersectors.intersector8 = Accel::Intersector8(&invalid_rtcIntersect8);
+    if ((aflags & (RTC_INTERSECT16 | RTC_INTERSECT_STREAM)) == 0) intersectors.intersector16 = Accel::Intersector16(&invalid_rtcIntersect16);
 
     /* update commit counter */
     commitCounter++;
@@ -672,12 +719,32 @@ namespace embree
 #endif
   }
 
+  bool Scene::hasGeometryMasks() const
+  {
+#if defined(RTCORE_RAY_MASK)
+    for (size_t i=0; i<geometries.size(); i++) {
+      Geometry* geom = geometries[i];
+      if (geom && geom->isEnabled() && geom->mask != unsigned(-1)) return true;
+    }
+#endif
+    return false;
+  }
+
+  void Scene::selectIntersectors()
+  {
+    const bool masks = hasGeometryMasks();
+    accels.select(masks || numIntersectionFilters1,
+                  masks || numIntersectionFilters4,
+                  masks || numIntersectionFilters8,
+                  masks || numIntersectionFilters16);
+  }
+
   void Scene::build_task ()
   {
     progress_monitor_counter = 0;
 
     /* select fast code path if no intersection filter is present */
-    accels.select(numIntersectionFilters4,numIntersectionFilters8,numIntersectionFilters16);
+    selectIntersectors();
   
     /* build all hierarchies of this scene */
     accels.build(0,0);
@@ -710,6 +777,62 @@ namespace embree
     setModified(false);
   }
 
+  void Scene::async_build_thread (void* ptr)
+  {
+    Scene* scene = (Scene*) ptr;
+    try {
+      scene->build(0,0);
+    } catch (std::bad_alloc&) {
+      scene->asyncBuildError = RTC_OUT_OF_MEMORY;
+      scene->asyncBuildErrorMessage = "out of memory";
+    } catch (rtcore_error& e) {
+      scene->asyncBuildError = e.error;
+      scene->asyncBuildErrorMessage = e.what();
+    } catch (std::exception& e) {
+      scene->asyncBuildError = RTC_UNKNOWN_ERROR;
+      scene->asyncBuildErrorMessage = e.what();
+    } catch (...) {
+      scene->asyncBuildError = RTC_UNKNOWN_ERROR;
+      scene->asyncBuildErrorMessage = "unknown exception caught";
+    }
+    scene->asyncBuildDone = true;
+  }
+
+  void Scene::buildAsync ()
+  {
+    /* only one asynchronous build at a time */
+    waitBuild();
+
+    Lock<MutexSys> lock(asyncBuildMutex);
+    asyncBuildDone = false;
+    asyncBuildError = RTC_NO_ERROR;
+    asyncBuildThread = createThread(async_build_thread,this);
+  }
+
+  void Scene::waitBuild ()
+  {
+    Lock<MutexSys> lock(asyncBuildMutex);
+    if (asyncBuildThread == nullptr) 
+      return;
+
+    join(asyncBuildThread);
+    asyncBuildThread = nullptr;
+
+    /* report errors of the asynchronous build to the waiting thread */
+    if (asyncBuildError != RTC_NO_ERROR) {
+      const RTCError error = asyncBuildError; asyncBuildError = RTC_NO_ERROR;
+      throw_RTCError(error,asyncBuildErrorMessage);
+    }
+  }
+
+  bool Scene::isCommitted ()
+  {
+    Lock<MutexSys> lock(asyncBuildMutex);
+    if (asyncBuildThread && !asyncBuildDone) 
+      return false;
+    return !isModified();
+  }
+
 #if defined(TASKING_LOCKSTEP)
 
   void Scene::task_build_parallel(size_t threadIndex, size_t threadCount, size_t taskIndex, size_t taskCount, TaskScheduler::Event* event) 
@@ -734,7 +857,7 @@ namespace embree
     }
 
     /* select fast code path if no intersection filter is present */
-    accels.select(numIntersectionFilters4,numIntersectionFilters8,numIntersectionFilters16);
+    selectIntersectors();
 
     /* if user provided threads use them */
     if (threadCount)
@@ -944,6 +1067,23 @@ namespace embree
     mutex.unlock();
   }
 
+  void Scene::setTessellationCacheBudget(size_t bytes)
+  {
+    SharedLazyTessellationCache& cache = SharedLazyTessellationCache::sharedLazyTessellationCache;
+    SharedLazyTessellationCache::Partition* shared = cache.getSharedPartition();
+
+    if (bytes == 0) {
+      if (tessellationPartition == shared) return;
+      SharedLazyTessellationCache::Partition* old = tessellationPartition;
+      tessellationPartition = shared;
+      cache.destroyPartition(old);
+    } 
+    else if (tessellationPartition == shared)
+      tessellationPartition = cache.createPartition(bytes);
+    else
+      cache.setPartitionBudget(tessellationPartition,bytes);
+  }
+
   void Scene::progressMonitor(double dn)
   {
     if (progress_monitor_function) {
@@ -67,7 +67,7 @@ namespace embree
         if (geom == nullptr) return nullptr;
         if (!all && !geom->isEnabled()) return nullptr;
         if (geom->getType() != Ty::geom_type) return nullptr;
-        if (geom->numTimeSteps != timeSteps) return nullptr;
+        if ((geom->numTimeSteps == 1) != (timeSteps == 1)) return nullptr; // timeSteps == 2 selects all motion blurred geometries
         return (Ty*) geom;
       }
 
@@ -156,6 +156,19 @@ namespace embree
     void build (size_t threadIndex, size_t threadCount);
     void build_task ();
 
+    /*! Starts building the acceleration structure in a separate thread. */
+    void buildAsync ();
+
+    /*! Waits until a pending asynchronous build has finished. */
+    void waitBuild ();
+
+    /*! Tests if the scene got committed and no asynchronous build is pending. */
+    bool isCommitted ();
+
+  private:
+    static void async_build_thread (void* ptr);
+  public:
+
     /*! stores scene into binary file */
     void write(std::ofstream& file);
 
@@ -307,6 +320,12 @@ namespace embree
     /* test if scene got already build */
     __forceinline bool isBuild() const { return is_build; }
 
+    /* test if some enabled geometry masks out any ray */
+    bool hasGeometryMasks() const;
+
+    /* selects the lean traversal kernels if neither ray masks nor filter functions are in use */
+    void selectIntersectors();
+
   public:
     std::vector<int> usedIDs; // FIXME: encapsulate this functionality into own class
     std::vector<Geometry*> geometries; //!< list of all user geometries
@@ -318,6 +337,7 @@ namespace embree
     AccelN accels;
     unsigned int commitCounter;
     atomic_t commitCounterSubdiv;
+    SharedLazyTessellationCache::Partition* tessellationPartition; //!< tessellation cache partition used by this scene
     atomic_t numMappedBuffers;         //!< number of mapped buffers
     RTCSceneFlags flags;
     RTCAlgorithmFlags aflags;
@@ -335,6 +355,11 @@ namespace embree
     bool is_build;
     MutexSys buildMutex;
     AtomicMutex geometriesMutex;
+    MutexSys asyncBuildMutex;
+    thread_t asyncBuildThread;           //!< thread of pending asynchronous build
+    volatile bool asyncBuildDone;        //!< true if asynchronous build thread has finished
+    RTCError asyncBuildError;            //!< error of last asynchronous build
+    std::string asyncBuildErrorMessage;
     bool modified;                   //!< true if scene got modified
     
     /*! global lock step task scheduler */
@@ -363,6 +388,9 @@ namespace embree
     void progressMonitor(double nprims);
     void setProgressMonitorFunction(RTCProgressMonitorFunc func, void* ptr);
 
+    /*! reserves some bytes of the tessellation cache for this scene, 0 shares the cache with other scenes */
+    void setTessellationCacheBudget(size_t bytes);
+
   public:
     struct GeometryCounts 
     {
@@ -395,6 +423,7 @@ namespace embree
 
     template<typename Mesh, int timeSteps> __forceinline size_t getNumPrimitives() const;
    
+    atomic_t numIntersectionFilters1;   //!< number of enabled intersection/occlusion filters for single rays
     atomic_t numIntersectionFilters4;   //!< number of enabled intersection/occlusion filters for 4-wide ray packets
     atomic_t numIntersectionFilters8;   //!< number of enabled intersection/occlusion filters for 8-wide ray packets
     atomic_t numIntersectionFilters16;  //!< number of enabled intersection/occlusion filters for 16-wide ray packets
@@ -25,8 +25,17 @@ namespace embree
     enabling();
   }
 
+  Geometry* GeometryInstance::base() const
+  {
+    Geometry* base = geom;
+    while (base->type & INSTANCE)
+      base = ((GeometryInstance*)base)->geom;
+    return base;
+  }
+
   void GeometryInstance::count(ssize_t f)
   {
+    const Geometry* geom = base();
     if (geom->numTimeSteps == 1)
     {
       switch (geom->type) {
@@ -49,15 +58,27 @@ namespace embree
     }
   }
 
+  void GeometryInstance::use(ssize_t f)
+  {
+    /* all geometries along the instance chain get used, such that
+     * the instanced geometry gets rebuilt when modified */
+    Geometry* g = geom;
+    while (true) {
+      atomic_add(&g->used,f);
+      if (!(g->type & INSTANCE)) break;
+      g = ((GeometryInstance*)g)->geom;
+    }
+  }
+
   void GeometryInstance::enabling () 
   {
-    atomic_add(&geom->used,+1);
+    use(+1);
     count(+1);
   }
 
   void GeometryInstance::disabling() 
   {
-    atomic_add(&geom->used,-1);
+    use(-1);
     count(-1);
   }
   
@@ -31,7 +31,11 @@ namespace embree
     virtual void setMask (unsigned mask);
     virtual void setTransform(const AffineSpace3fa& local2world);
     
+    /*! returns the instanced non-instance geometry at the end of the instance chain */
+    Geometry* base() const;
+
     void count(ssize_t f);
+    void use(ssize_t f);
   public:
     AffineSpace3fa local2world; //!< transforms from local space to world space
     AffineSpace3fa world2local; //!< transforms from world space to local space
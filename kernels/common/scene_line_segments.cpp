@@ -23,6 +23,7 @@ namespace embree
     : Geometry(parent,LINE_SEGMENTS,numPrimitives,numTimeSteps,flags)
   {
     segments.init(parent->device,numPrimitives,sizeof(int));
+    vertices.resize(numTimeSteps);
     for (size_t i=0; i<numTimeSteps; i++) {
       vertices[i].init(parent->device,numVertices,sizeof(Vec3fa));
     }
@@ -67,18 +68,18 @@ namespace embree
     }
 #endif
 
+    if (type >= RTC_VERTEX_BUFFER0 && type < RTC_VERTEX_BUFFER0+numTimeSteps)
+    {
+      const size_t t = type - RTC_VERTEX_BUFFER0;
+      vertices[t].set(ptr,offset,stride);
+      vertices[t].checkPadding16();
+      return;
+    }
+
     switch (type) {
     case RTC_INDEX_BUFFER  :
       segments.set(ptr,offset,stride);
       break;
-    case RTC_VERTEX_BUFFER0:
-      vertices[0].set(ptr,offset,stride);
-      vertices[0].checkPadding16();
-      break;
-    case RTC_VERTEX_BUFFER1:
-      vertices[1].set(ptr,offset,stride);
-      vertices[1].checkPadding16();
-      break;
     case RTC_USER_VERTEX_BUFFER0  :
       if (userbuffers[0] == nullptr) userbuffers[0].reset(new Buffer(parent->device,numVertices(),stride));
       userbuffers[0]->set(ptr,offset,stride);
@@ -95,6 +96,18 @@ namespace embree
     }
   }
 
+  void LineSegments::updateBufferRange(RTCBufferType type, size_t offset, size_t num)
+  {
+    if (type >= RTC_VERTEX_BUFFER0 && type < RTC_VERTEX_BUFFER0+numTimeSteps)
+    {
+      if (offset+num > numVertices())
+        throw_RTCError(RTC_INVALID_ARGUMENT,"vertex range out of bounds");
+      updateVertexRange(offset,offset+num);
+    }
+    else
+      updateBuffer(type);
+  }
+
   void* LineSegments::map(RTCBufferType type)
   {
     if (parent->isStatic() && parent->isBuild()) {
@@ -102,10 +115,11 @@ namespace embree
       return nullptr;
     }
 
+    if (type >= RTC_VERTEX_BUFFER0 && type < RTC_VERTEX_BUFFER0+numTimeSteps)
+      return vertices[type - RTC_VERTEX_BUFFER0].map(parent->numMappedBuffers);
+
     switch (type) {
     case RTC_INDEX_BUFFER  : return segments.map(parent->numMappedBuffers);
-    case RTC_VERTEX_BUFFER0: return vertices[0].map(parent->numMappedBuffers);
-    case RTC_VERTEX_BUFFER1: return vertices[1].map(parent->numMappedBuffers);
     default: throw_RTCError(RTC_INVALID_ARGUMENT,"unknown buffer type"); return nullptr;
     }
   }
@@ -115,10 +129,13 @@ namespace embree
     if (parent->isStatic() && parent->isBuild())
       throw_RTCError(RTC_INVALID_OPERATION,"static geometries cannot get modified");
 
+    if (type >= RTC_VERTEX_BUFFER0 && type < RTC_VERTEX_BUFFER0+numTimeSteps) {
+      vertices[type - RTC_VERTEX_BUFFER0].unmap(parent->numMappedBuffers);
+      return;
+    }
+
     switch (type) {
     case RTC_INDEX_BUFFER  : segments.unmap(parent->numMappedBuffers); break;
-    case RTC_VERTEX_BUFFER0: vertices[0].unmap(parent->numMappedBuffers); break;
-    case RTC_VERTEX_BUFFER1: vertices[1].unmap(parent->numMappedBuffers); break;
     default: throw_RTCError(RTC_INVALID_ARGUMENT,"unknown buffer type"); break;
     }
   }
@@ -128,13 +145,14 @@ namespace embree
     const bool freeIndices  = !parent->needLineIndices;
     const bool freeVertices = !parent->needLineVertices;
     if (freeIndices) segments.free();
-    if (freeVertices ) vertices[0].free();
-    if (freeVertices ) vertices[1].free();
+    if (freeVertices )
+      for (size_t t=0; t<numTimeSteps; t++) vertices[t].free();
   }
 
   bool LineSegments::verify ()
   {
-    if (numTimeSteps == 2 && vertices[0].size() != vertices[1].size())
+    for (size_t t=1; t<numTimeSteps; t++)
+      if (vertices[t].size() != vertices[0].size())
         return false;
 
     for (size_t i=0; i<numPrimitives; i++) {
@@ -162,7 +180,7 @@ namespace embree
 
 
     /* calculate base pointer and stride */
-    assert((buffer >= RTC_VERTEX_BUFFER0 && buffer <= RTC_VERTEX_BUFFER1) ||
+    assert((buffer >= RTC_VERTEX_BUFFER0 && buffer < RTC_VERTEX_BUFFER0+numTimeSteps) ||
            (buffer >= RTC_USER_VERTEX_BUFFER0 && buffer <= RTC_USER_VERTEX_BUFFER1));
     const char* src = nullptr;
     size_t stride = 0;
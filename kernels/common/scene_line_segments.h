@@ -42,6 +42,7 @@ namespace embree
     void disabling();
     void setMask (unsigned mask);
     void setBuffer(RTCBufferType type, void* ptr, size_t offset, size_t stride);
+    void updateBufferRange(RTCBufferType type, size_t offset, size_t num);
     void* map(RTCBufferType type);
     void unmap(RTCBufferType type);
     void immutable ();
@@ -118,6 +119,11 @@ namespace embree
       return enlarge(b,Vec3fa(max(r0,r1)));
     }
 
+    /*! calculates the linear bounds of the i'th line segment for the specified time range */
+    __forceinline std::pair<BBox3fa,BBox3fa> linearBounds(size_t i, const BBox1f& time_range) const {
+      return Geometry::linearBounds([&] (size_t j) { return bounds(i,j); }, time_range);
+    }
+
     /*! calculates bounding box of i'th line segment */
     __forceinline BBox3fa bounds(const AffineSpace3fa& space, size_t i, size_t j = 0) const
     {
@@ -164,7 +170,7 @@ namespace embree
 
   public:
     BufferT<int> segments;                          //!< array of line segment indices
-    array_t<BufferT<Vec3fa>,2> vertices;            //!< vertex array
+    std::vector<BufferT<Vec3fa>> vertices;        //!< vertex array for each timestep
     array_t<std::unique_ptr<Buffer>,2> userbuffers; //!< user buffers
   };
 }
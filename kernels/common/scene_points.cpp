@@ -94,6 +94,18 @@ namespace embree
     }
   }
 
+  void Points::updateBufferRange(RTCBufferType type, size_t offset, size_t num)
+  {
+    if (type >= RTC_VERTEX_BUFFER0 && type < RTC_VERTEX_BUFFER0+numTimeSteps)
+    {
+      if (offset+num > numVertices())
+        throw_RTCError(RTC_INVALID_ARGUMENT,"vertex range out of bounds");
+      updateVertexRange(offset,offset+num);
+    }
+    else
+      updateBuffer(type);
+  }
+
   void* Points::map(RTCBufferType type)
   {
     if (parent->isStatic() && parent->isBuild()) {
@@ -57,7 +57,6 @@ namespace embree
     void immutable ();
     bool verify ();
     void interpolate(unsigned primID, float u, float v, RTCBufferType buffer, float* P, float* dPdu, float* dPdv, size_t numFloats);
-    // FIXME: implement interpolateN
 
   public:
 
@@ -86,17 +85,22 @@ namespace embree
       return vertices[j].getPtr(i);
     }
 
-    /*! calculates the bounds of the i'th quad */
-    __forceinline BBox3fa bounds(size_t i) const 
+    /*! calculates the bounds of the i'th quad at the j'th timestep */
+    __forceinline BBox3fa bounds(size_t i, size_t j = 0) const 
     {
       const Quad& q = quad(i);
-      const Vec3fa v0  = vertex(q.v[0]);
-      const Vec3fa v1  = vertex(q.v[1]);
-      const Vec3fa v2  = vertex(q.v[2]);
-      const Vec3fa v3  = vertex(q.v[3]);
+      const Vec3fa v0  = vertex(q.v[0],j);
+      const Vec3fa v1  = vertex(q.v[1],j);
+      const Vec3fa v2  = vertex(q.v[2],j);
+      const Vec3fa v3  = vertex(q.v[3],j);
       return BBox3fa(min(v0,v1,v2,v3),max(v0,v1,v2,v3));
     }
 
+    /*! calculates the linear bounds of the i'th quad for the specified time range */
+    __forceinline std::pair<BBox3fa,BBox3fa> linearBounds(size_t i, const BBox1f& time_range) const {
+      return Geometry::linearBounds([&] (size_t j) { return bounds(i,j); }, time_range);
+    }
+
     /*! check if the i'th primitive is valid */
     __forceinline bool valid(size_t i, BBox3fa* bbox = nullptr) const 
     {
@@ -125,7 +129,16 @@ namespace embree
     
   public:
     BufferT<Quad> quads;                            //!< array of quads
-    array_t<BufferT<Vec3fa>,2> vertices;            //!< vertex array
+    std::vector<BufferT<Vec3fa>> vertices;          //!< vertex array for each timestep
     array_t<std::unique_ptr<Buffer>,2> userbuffers; //!< user buffers
   };
+
+  class QuadMeshAVX : public QuadMesh
+  {
+  public:
+    QuadMeshAVX (Scene* parent, RTCGeometryFlags flags, size_t numQuads, size_t numVertices, size_t numTimeSteps);
+
+    void interpolateN(const void* valid_i, const unsigned* primIDs, const float* u, const float* v, size_t numUVs, 
+                      RTCBufferType buffer, float* P, float* dPdu, float* dPdv, size_t numFloats);
+  };
 }
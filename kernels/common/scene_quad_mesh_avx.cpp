@@ -0,0 +1,119 @@
+// ======================================================================== //
+// Copyright 2009-2015 Intel Corporation                                    //
+//                                                                          //
+// Licensed under the Apache License, Version 2.0 (the "License");          //
+// you may not use this file except in compliance with the License.         //
+// You may obtain a copy of the License at                                  //
+//                                                                          //
+//     http://www.apache.org/licenses/LICENSE-2.0                           //
+//                                                                          //
+// Unless required by applicable law or agreed to in writing, software      //
+// distributed under the License is distributed on an "AS IS" BASIS,        //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. //
+// See the License for the specific language governing permissions and      //
+// limitations under the License.                                           //
+// ======================================================================== //
+
+#include "scene_quad_mesh.h"
+#include "scene.h"
+#include "interpolate_avx.h"
+
+namespace embree
+{
+  QuadMeshAVX::QuadMeshAVX (Scene* parent, RTCGeometryFlags flags, size_t numQuads, size_t numVertices, size_t numTimeSteps)
+    : QuadMesh(parent,flags,numQuads,numVertices,numTimeSteps) {}
+
+  void QuadMeshAVX::interpolateN(const void* valid_i, const unsigned* primIDs, const float* u, const float* v, size_t numUVs,
+                                 RTCBufferType buffer, float* P, float* dPdu, float* dPdv, size_t numFloats)
+  {
+#if defined(DEBUG)
+    if ((parent->aflags & RTC_INTERPOLATE) == 0)
+      throw_RTCError(RTC_INVALID_OPERATION,"rtcInterpolate can only get called when RTC_INTERPOLATE is enabled for the scene");
+#endif
+    if (numFloats > 256) throw_RTCError(RTC_INVALID_OPERATION,"maximally 256 floating point values can be interpolated per vertex");
+
+    /* calculate base pointer and stride */
+    assert((buffer >= RTC_VERTEX_BUFFER0 && buffer < RTC_VERTEX_BUFFER0+numTimeSteps) ||
+           (buffer >= RTC_USER_VERTEX_BUFFER0 && buffer <= RTC_USER_VERTEX_BUFFER1));
+    const char* src = nullptr;
+    size_t stride = 0, num = 0;
+    if (buffer >= RTC_USER_VERTEX_BUFFER0) {
+      src    = userbuffers[buffer&0xFFFF]->getPtr();
+      stride = userbuffers[buffer&0xFFFF]->getStride();
+      num    = userbuffers[buffer&0xFFFF]->size();
+    } else {
+      src    = vertices[buffer&0xFFFF].getPtr();
+      stride = vertices[buffer&0xFFFF].getStride();
+      num    = vertices[buffer&0xFFFF].size();
+    }
+
+    /* huge or misaligned buffers cannot get addressed by 32 bit float offsets */
+    if (!gatherable(src,stride,num,numFloats)) {
+      Geometry::interpolateN(valid_i,primIDs,u,v,numUVs,buffer,P,dPdu,dPdv,numFloats);
+      return;
+    }
+
+    const float* fsrc = (const float*) src;
+    const int fstride = int(stride/sizeof(float));
+    const int* valid = (const int*) valid_i;
+
+    for (size_t i=0; i<numUVs; i+=8)
+    {
+      InterpolateHits8 hits(valid,primIDs,u,v,i,numUVs);
+      if (hits.mask == 0) continue;
+
+      /* fetch vertex offsets, inactive lanes replicate the first active lane */
+      const Quad& quad0 = quad(hits.primID[__bsf(hits.mask)]);
+      vint8 ofs0(quad0.v[0]*fstride), ofs1(quad0.v[1]*fstride), ofs2(quad0.v[2]*fstride), ofs3(quad0.v[3]*fstride);
+      for (size_t m=hits.mask; m!=0; )
+      {
+        const size_t k = __bscf(m);
+        const Quad& q = quad(hits.primID[k]);
+        ofs0[k] = q.v[0]*fstride;
+        ofs1[k] = q.v[1]*fstride;
+        ofs2[k] = q.v[2]*fstride;
+        ofs3[k] = q.v[3]*fstride;
+      }
+
+      const vboolf8 active = hits.active();
+      const vfloat8 uu = hits.uu, vv = hits.vv;
+      const vfloat8 su = 1.0f-uu, sv = 1.0f-vv;
+      float* Pi    = P    ? P+i    : nullptr;
+      float* dPdui = dPdu ? dPdu+i : nullptr;
+      float* dPdvi = dPdv ? dPdv+i : nullptr;
+
+      size_t j=0;
+
+      /* full float4 blocks get loaded per hit and transposed */
+      for (; j+4<=numFloats; j+=4)
+      {
+        vfloat8 p0[4], p1[4], p2[4], p3[4];
+        gather4f(fsrc+j,ofs0,p0[0],p0[1],p0[2],p0[3]);
+        gather4f(fsrc+j,ofs1,p1[0],p1[1],p1[2],p1[3]);
+        gather4f(fsrc+j,ofs2,p2[0],p2[1],p2[2],p2[3]);
+        gather4f(fsrc+j,ofs3,p3[0],p3[1],p3[2],p3[3]);
+        for (size_t k=0; k<4; k++)
+        {
+          const size_t o = (j+k)*numUVs;
+          if (Pi   ) storeAttribute(active,Pi+o,(su*p0[k] + uu*p1[k])*sv + vv*(su*p3[k] + uu*p2[k]));
+          if (dPdui) storeAttribute(active,dPdui+o,sv*(p1[k]-p0[k]) + vv*(p2[k]-p3[k]));
+          if (dPdvi) storeAttribute(active,dPdvi+o,su*(p3[k]-p0[k]) + uu*(p2[k]-p1[k]));
+        }
+      }
+
+      /* remaining floats get gathered one at a time */
+      for (; j<numFloats; j++)
+      {
+        const vfloat8 p0 = gather1f(fsrc+j,ofs0);
+        const vfloat8 p1 = gather1f(fsrc+j,ofs1);
+        const vfloat8 p2 = gather1f(fsrc+j,ofs2);
+        const vfloat8 p3 = gather1f(fsrc+j,ofs3);
+        const size_t o = j*numUVs;
+        if (Pi   ) storeAttribute(active,Pi+o,(su*p0 + uu*p1)*sv + vv*(su*p3 + uu*p2));
+        if (dPdui) storeAttribute(active,dPdui+o,sv*(p1-p0) + vv*(p2-p3));
+        if (dPdvi) storeAttribute(active,dPdvi+o,su*(p3-p0) + uu*(p2-p1));
+      }
+    }
+    AVX_ZERO_UPPER();
+  }
+}
@@ -142,6 +142,9 @@ namespace embree
       return vertices[t];
     }
 
+    /*! returns the boundary interpolation mode */
+    __forceinline RTCBoundaryMode getBoundaryMode() const { return boundary; }
+
      /* check for simple edge level update */
     __forceinline bool checkLevelUpdate() const { return levelUpdate; }
 
@@ -49,14 +49,12 @@ namespace embree
       baseEntry = &vertex_buffer_tags[bufID];
     }
 
-    auto alloc = [](size_t bytes) { return SharedLazyTessellationCache::malloc(bytes); };
-    
     for (size_t i=0,slot=0; i<numFloats; slot++)
     {
       if (i+4 >= numFloats)
       {
         vfloat4 Pt, dPdut, dPdvt; 
-        isa::PatchEval<vfloat4>(baseEntry->at(interpolationSlot(primID,slot,stride)),parent->commitCounterSubdiv,
+        isa::PatchEval<vfloat4>(baseEntry->at(interpolationSlot(primID,slot,stride)),*parent->tessellationPartition,parent->commitCounterSubdiv,
                           getHalfEdge(primID),src+i*sizeof(float),stride,u,v,P ? &Pt : nullptr, dPdu ? &dPdut : nullptr, dPdv ? &dPdvt : nullptr);
 
         if (P   ) for (size_t j=i; j<min(i+4,numFloats); j++) P[j] = Pt[j-i];
@@ -67,7 +65,7 @@ namespace embree
       else
       {
         vfloat8 Pt, dPdut, dPdvt; 
-        isa::PatchEval<vfloat8>(baseEntry->at(interpolationSlot(primID,slot,stride)),parent->commitCounterSubdiv,
+        isa::PatchEval<vfloat8>(baseEntry->at(interpolationSlot(primID,slot,stride)),*parent->tessellationPartition,parent->commitCounterSubdiv,
                                getHalfEdge(primID),src+i*sizeof(float),stride,u,v,P ? &Pt : nullptr, dPdu ? &dPdut : nullptr, dPdv ? &dPdvt : nullptr);
                                      
         if (P   ) for (size_t j=i; j<i+8; j++) P[j] = Pt[j-i];
@@ -107,7 +105,7 @@ namespace embree
         if (j+4 >= numFloats)
         {
           const size_t M = min(size_t(4),numFloats-j);
-          isa::PatchEvalSimd<vbool,vint,vfloat,vfloat4>(baseEntry->at(interpolationSlot(primID,slot,stride)),parent->commitCounterSubdiv,
+          isa::PatchEvalSimd<vbool,vint,vfloat,vfloat4>(baseEntry->at(interpolationSlot(primID,slot,stride)),*parent->tessellationPartition,parent->commitCounterSubdiv,
                                                        getHalfEdge(primID),src+j*sizeof(float),stride,valid1,uu,vv,
                                                        P ? P+j*numUVs : nullptr,dPdu ? dPdu+j*numUVs : nullptr,dPdv ? dPdv+j*numUVs : nullptr,numUVs,M);
           j+=4;
@@ -115,7 +113,7 @@ namespace embree
         else
         {
           const size_t M = min(size_t(8),numFloats-j);
-          isa::PatchEvalSimd<vbool,vint,vfloat,vfloat8>(baseEntry->at(interpolationSlot(primID,slot,stride)),parent->commitCounterSubdiv,
+          isa::PatchEvalSimd<vbool,vint,vfloat,vfloat8>(baseEntry->at(interpolationSlot(primID,slot,stride)),*parent->tessellationPartition,parent->commitCounterSubdiv,
                                                        getHalfEdge(primID),src+j*sizeof(float),stride,valid1,uu,vv,
                                                        P ? P+j*numUVs : nullptr,dPdu ? dPdu+j*numUVs : nullptr,dPdv ? dPdv+j*numUVs : nullptr,numUVs,M);
           j+=8;
@@ -118,12 +118,12 @@ namespace embree
     void disabling();
     void setMask (unsigned mask);
     void setBuffer(RTCBufferType type, void* ptr, size_t offset, size_t stride);
+    void updateBufferRange(RTCBufferType type, size_t offset, size_t num);
     void* map(RTCBufferType type);
     void unmap(RTCBufferType type);
     void immutable ();
     bool verify ();
     void interpolate(unsigned primID, float u, float v, RTCBufferType buffer, float* P, float* dPdu, float* dPdv, size_t numFloats);
-    // FIXME: implement interpolateN
 
   public:
 
@@ -164,16 +164,21 @@ namespace embree
     }
 #endif
 
-    /*! calculates the bounds of the i'th triangle */
-    __forceinline BBox3fa bounds(size_t i) const 
+    /*! calculates the bounds of the i'th triangle at the j'th timestep */
+    __forceinline BBox3fa bounds(size_t i, size_t j = 0) const 
     {
       const Triangle& tri = triangle(i);
-      const Vec3fa v0 = vertex(tri.v[0]);
-      const Vec3fa v1 = vertex(tri.v[1]);
-      const Vec3fa v2 = vertex(tri.v[2]);
+      const Vec3fa v0 = vertex(tri.v[0],j);
+      const Vec3fa v1 = vertex(tri.v[1],j);
+      const Vec3fa v2 = vertex(tri.v[2],j);
       return BBox3fa(min(v0,v1,v2),max(v0,v1,v2));
     }
 
+    /*! calculates the linear bounds of the i'th triangle for the specified time range */
+    __forceinline std::pair<BBox3fa,BBox3fa> linearBounds(size_t i, const BBox1f& time_range) const {
+      return Geometry::linearBounds([&] (size_t j) { return bounds(i,j); }, time_range);
+    }
+
     /*! check if the i'th primitive is valid */
     __forceinline bool valid(size_t i, BBox3fa* bbox = nullptr) const 
     {
@@ -256,8 +261,17 @@ namespace embree
     
   public:
     BufferT<Triangle> triangles;                    //!< array of triangles
-    array_t<BufferT<Vec3fa>,2> vertices;            //!< vertex array
+    std::vector<BufferT<Vec3fa>> vertices;          //!< vertex array for each timestep
     array_t<std::unique_ptr<Buffer>,2> userbuffers; //!< user buffers
 
   };
+
+  class TriangleMeshAVX : public TriangleMesh
+  {
+  public:
+    TriangleMeshAVX (Scene* parent, RTCGeometryFlags flags, size_t numTriangles, size_t numVertices, size_t numTimeSteps);
+
+    void interpolateN(const void* valid_i, const unsigned* primIDs, const float* u, const float* v, size_t numUVs, 
+                      RTCBufferType buffer, float* P, float* dPdu, float* dPdv, size_t numFloats);
+  };
 }
@@ -111,4 +111,51 @@ namespace embree
     }
     cout << std::endl;
   }
+
+  volatile bool TraversalStat::enabled = false;
+  __thread TraversalStat::ThreadCounters* TraversalStat::thread_counters = nullptr;
+  TraversalStat::CounterList TraversalStat::all_counters;
+  MutexSys TraversalStat::mutex;
+
+  TraversalStat::CounterList::~CounterList()
+  {
+    /* threads may still hold their counters, thus stop counting first */
+    enabled = false;
+    for (size_t i=0; i<size(); i++) 
+      delete (*this)[i];
+    clear();
+  }
+
+  TraversalStat::ThreadCounters& TraversalStat::create()
+  {
+    /* counters of exited threads are kept to not lose their statistics */
+    thread_counters = new ThreadCounters;
+    Lock<MutexSys> lock(mutex);
+    all_counters.push_back(thread_counters);
+    return *thread_counters;
+  }
+
+  void TraversalStat::sum(Counters& normal, Counters& shadow)
+  {
+    memset(&normal,0,sizeof(Counters));
+    memset(&shadow,0,sizeof(Counters));
+
+    Lock<MutexSys> lock(mutex);
+    for (size_t i=0; i<all_counters.size(); i++) 
+    {
+      const ThreadCounters* c = all_counters[i];
+      normal.travs   += c->normal.travs;   shadow.travs   += c->shadow.travs;
+      normal.nodes   += c->normal.nodes;   shadow.nodes   += c->shadow.nodes;
+      normal.leaves  += c->normal.leaves;  shadow.leaves  += c->shadow.leaves;
+      normal.prims   += c->normal.prims;   shadow.prims   += c->shadow.prims;
+      normal.filters += c->normal.filters; shadow.filters += c->shadow.filters;
+    }
+  }
+
+  void TraversalStat::clear()
+  {
+    Lock<MutexSys> lock(mutex);
+    for (size_t i=0; i<all_counters.size(); i++) 
+      all_counters[i]->clear();
+  }
 }
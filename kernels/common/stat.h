@@ -30,6 +30,10 @@
 #  define STAT3(s,x,y,z)
 #endif
 
+/* Makro to gather runtime switchable traversal statistics */
+#define TRAVSTAT(s,x) \
+  do { if (unlikely(TraversalStat::enabled)) TraversalStat::get().s += x; } while (0)
+
 namespace embree
 {
   /*! Gathers ray tracing statistics. We count 1) how often a code
@@ -95,4 +99,74 @@ namespace embree
   private:
     static Stat instance;
   };
+
+  /*! Gathers traversal statistics at runtime. Counting is disabled
+   *  by default and gets enabled through the
+   *  RTC_TRAVERSAL_STATISTICS parameter. Each thread counts into its
+   *  own counters, thus the difference of the thread counters before
+   *  and after tracing a ray gives the cost of that ray. */
+  class TraversalStat
+  {
+  public:
+
+    /*! counters per ray type */
+    struct Counters
+    {
+      size_t travs;      //!< number of traced rays
+      size_t nodes;      //!< number of visited inner nodes
+      size_t leaves;     //!< number of visited leaf nodes
+      size_t prims;      //!< number of tested primitive blocks
+      size_t filters;    //!< number of invoked filter callbacks
+    };
+
+    /*! counters of one thread */
+    struct __aligned(64) ThreadCounters 
+    {
+      ALIGNED_STRUCT;
+
+      ThreadCounters () { 
+        clear(); 
+      }
+      
+      void clear() { 
+        memset(&normal,0,sizeof(Counters)); 
+        memset(&shadow,0,sizeof(Counters)); 
+      }
+
+    public:
+      Counters normal, shadow;
+    };
+
+  public:
+
+    /*! returns the counters of the calling thread */
+    static __forceinline ThreadCounters& get() 
+    {
+      if (unlikely(thread_counters == nullptr)) return create();
+      return *thread_counters;
+    }
+
+    /*! sums up the counters of all threads */
+    static void sum(Counters& normal, Counters& shadow);
+
+    /*! clears the counters of all threads */
+    static void clear();
+
+  private:
+
+    /*! creates the counters of the calling thread */
+    static ThreadCounters& create();
+
+    /*! counters of all threads, get freed when the library gets unloaded */
+    struct CounterList : public std::vector<ThreadCounters*> {
+      ~CounterList();
+    };
+
+  public:
+    static volatile bool enabled;                       //!< true if counting is enabled
+  private:
+    static __thread ThreadCounters* thread_counters;    //!< counters of the calling thread
+    static CounterList all_counters;                    //!< counters of all threads
+    static MutexSys mutex;
+  };
 }
@@ -72,6 +72,11 @@ namespace embree
     line_accel_mb = "default";
     line_builder_mb = "default";
     line_traverser_mb = "default";
+
+    point_accel = "default";
+    point_builder = "default";
+    point_accel_mb = "default";
+    point_builder_mb = "default";
     
     hair_accel = "default";
     hair_builder = "default";
@@ -98,6 +103,16 @@ namespace embree
 #endif
 
     subdiv_accel = "default";
+    subdiv_grid_compression = false;
+
+    bvh_cache_dir = "";
+
+    out_of_core_dir = "";
+    out_of_core_budget = 1024*1024*1024;
+
+    ray_sorting = false;
+
+    refit_quality_threshold = 1.5f;
 
     float_exceptions = false;
     scene_flags = -1;
@@ -111,6 +126,12 @@ namespace embree
 #else
     set_affinity = false;
 #endif
+    thread_affinity = "";
+
+    numa_alloc = false;
+    hugepages = "";
+    alloc_prefault = false;
+    alloc_pool_size = 0;
 
     error_function = nullptr;
     memory_monitor_function = nullptr;
@@ -159,6 +180,9 @@ namespace embree
 #if defined (__TARGET_AVX512KNL__)
     assert(avx512::getISA() <= AVX512KNL);
 #endif
+#if defined (__TARGET_AVX512SKX__)
+    assert(avx512skx::getISA() <= AVX512SKX);
+#endif
 #endif
   }
 
@@ -223,6 +247,17 @@ namespace embree
       
       else if (tok == Token::Id("set_affinity")&& cin->trySymbol("=")) 
         set_affinity = cin->get().Int();
+      else if (tok == Token::Id("thread_affinity") && cin->trySymbol("=")) 
+        thread_affinity = cin->get().Identifier();
+
+      else if (tok == Token::Id("numa_alloc")&& cin->trySymbol("=")) 
+        numa_alloc = cin->get().Int();
+      else if (tok == Token::Id("hugepages") && cin->trySymbol("=")) 
+        hugepages = cin->get().Identifier();
+      else if (tok == Token::Id("alloc_prefault") && cin->trySymbol("=")) 
+        alloc_prefault = cin->get().Int();
+      else if (tok == Token::Id("alloc_pool_size") && cin->trySymbol("=")) 
+        alloc_pool_size = cin->get().Float() * 1024 * 1024;
       
       else if (tok == Token::Id("isa") && cin->trySymbol("=")) {
         std::string isa = toLowerCase(cin->get().Identifier());
@@ -280,6 +315,15 @@ namespace embree
         line_builder_mb = cin->get().Identifier();
       else if ((tok == Token::Id("line_traverser_mb")) && cin->trySymbol("="))
         line_traverser_mb = cin->get().Identifier();
+
+      else if ((tok == Token::Id("point_accel")) && cin->trySymbol("="))
+        point_accel = cin->get().Identifier();
+      else if ((tok == Token::Id("point_builder")) && cin->trySymbol("="))
+        point_builder = cin->get().Identifier();
+      else if ((tok == Token::Id("point_accel_mb")) && cin->trySymbol("="))
+        point_accel_mb = cin->get().Identifier();
+      else if ((tok == Token::Id("point_builder_mb")) && cin->trySymbol("="))
+        point_builder_mb = cin->get().Identifier();
       
       else if (tok == Token::Id("hair_accel") && cin->trySymbol("="))
         hair_accel = cin->get().Identifier();
@@ -305,6 +349,19 @@ namespace embree
 
       else if (tok == Token::Id("subdiv_accel") && cin->trySymbol("="))
         subdiv_accel = cin->get().Identifier();
+      else if (tok == Token::Id("subdiv_grid_compression") && cin->trySymbol("="))
+        subdiv_grid_compression = cin->get().Int();
+
+      else if (tok == Token::Id("bvh_cache_dir") && cin->trySymbol("="))
+        bvh_cache_dir = cin->get().String();
+
+      else if (tok == Token::Id("out_of_core_dir") && cin->trySymbol("="))
+        out_of_core_dir = cin->get().String();
+      else if (tok == Token::Id("out_of_core_budget") && cin->trySymbol("="))
+        out_of_core_budget = cin->get().Float() * 1024 * 1024;
+
+      else if (tok == Token::Id("ray_sorting") && cin->trySymbol("="))
+        ray_sorting = cin->get().Int();
       
       else if (tok == Token::Id("verbose") && cin->trySymbol("="))
         verbose = cin->get().Int();
@@ -335,6 +392,9 @@ namespace embree
       else if (tok == Token::Id("tessellation_cache_size") && cin->trySymbol("="))
         tessellation_cache_size = cin->get().Float() * 1024 * 1024;
 
+      else if (tok == Token::Id("refit_quality_threshold") && cin->trySymbol("="))
+        refit_quality_threshold = cin->get().Float();
+
       cin->trySymbol(","); // optional , separator
     }
   }
@@ -347,6 +407,11 @@ namespace embree
   {
     std::cout << "general:" << std::endl;
     std::cout << "  build threads = " << numThreads << std::endl;
+    std::cout << "  affinity      = " << (thread_affinity != "" ? thread_affinity : (set_affinity ? "linear" : "none")) << std::endl;
+    std::cout << "  numa alloc    = " << numa_alloc << std::endl;
+    std::cout << "  hugepages     = " << hugepages << std::endl;
+    std::cout << "  prefault      = " << alloc_prefault << std::endl;
+    std::cout << "  pool size     = " << alloc_pool_size << std::endl;
     std::cout << "  verbosity     = " << verbose << std::endl;
     
     std::cout << "triangles:" << std::endl;
@@ -379,6 +444,14 @@ namespace embree
     std::cout << "  accel         = " << line_accel_mb << std::endl;
     std::cout << "  builder       = " << line_builder_mb << std::endl;
     std::cout << "  traverser     = " << line_traverser_mb << std::endl;
+
+    std::cout << "points:" << std::endl;
+    std::cout << "  accel         = " << point_accel << std::endl;
+    std::cout << "  builder       = " << point_builder << std::endl;
+
+    std::cout << "motion blur points:" << std::endl;
+    std::cout << "  accel         = " << point_accel_mb << std::endl;
+    std::cout << "  builder       = " << point_builder_mb << std::endl;
     
     std::cout << "hair:" << std::endl;
     std::cout << "  accel         = " << hair_accel << std::endl;
@@ -391,6 +464,20 @@ namespace embree
     
     std::cout << "subdivision surfaces:" << std::endl;
     std::cout << "  accel         = " << subdiv_accel << std::endl;
+    std::cout << "  compression   = " << subdiv_grid_compression << std::endl;
+
+    std::cout << "bvh cache:" << std::endl;
+    std::cout << "  directory     = " << bvh_cache_dir << std::endl;
+
+    std::cout << "out of core:" << std::endl;
+    std::cout << "  directory     = " << out_of_core_dir << std::endl;
+    std::cout << "  budget        = " << out_of_core_budget << std::endl;
+
+    std::cout << "ray sorting:" << std::endl;
+    std::cout << "  enabled       = " << ray_sorting << std::endl;
+
+    std::cout << "refit:" << std::endl;
+    std::cout << "  quality threshold = " << refit_quality_threshold << std::endl;
 
     std::cout << "object_accel:" << std::endl;
     std::cout << "  min_leaf_size = " << object_accel_min_leaf_size << std::endl;
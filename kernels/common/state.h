@@ -81,6 +81,12 @@ namespace embree
     std::string line_builder_mb;           //!< builder to use for motion blur line segments
     std::string line_traverser_mb;         //!< traverser to use for motion blur line segments
 
+  public:
+    std::string point_accel;               //!< acceleration structure to use for points
+    std::string point_builder;             //!< builder to use for points
+    std::string point_accel_mb;            //!< acceleration structure to use for motion blur points
+    std::string point_builder_mb;          //!< builder to use for motion blur points
+
   public:
     std::string hair_accel;                //!< hair acceleration structure to use
     std::string hair_builder;              //!< builder to use for hair
@@ -101,7 +107,19 @@ namespace embree
   public:
     float       memory_preallocation_factor; 
     size_t      tessellation_cache_size;   //!< size of the shared tessellation cache 
+    float       refit_quality_threshold;   //!< refitted BVHs get rotated if their SAH cost grew by this factor (disabled if 0)
     std::string subdiv_accel;              //!< acceleration structure to use for subdivision surfaces
+    bool        subdiv_grid_compression;   //!< quantizes the vertices of eagerly built subdivision grids
+
+  public:
+    std::string bvh_cache_dir;             //!< directory of the persistent BVH cache for static scenes (disabled if empty)
+
+  public:
+    std::string out_of_core_dir;           //!< directory to page out geometry of static scenes to (disabled if empty)
+    size_t      out_of_core_budget;        //!< maximal size of paged geometry kept in memory
+
+  public:
+    bool ray_sorting;                      //!< sorts rays of packets and streams into coherent sub-packets before traversal
 
   public:
     bool float_exceptions;                 //!< enable floating point exceptions
@@ -113,6 +131,11 @@ namespace embree
   public:
     size_t numThreads;                     //!< number of threads to use in builders
     bool set_affinity;                     //!< sets affinity for worker threads
+    std::string thread_affinity;           //!< pinning policy of worker threads (none, linear, compact, scatter, socket), derived from set_affinity if empty
+    bool numa_alloc;                       //!< allocates BVH memory per NUMA node
+    std::string hugepages;                 //!< huge page policy of build memory (auto, off, thp, hugetlbfs), keeps the current policy if empty
+    bool alloc_prefault;                   //!< touches the estimated BVH memory in parallel before building
+    size_t alloc_pool_size;                //!< maximal size of freed BVH memory blocks kept for reuse (disabled if 0)
     int enabled_cpu_features;              //!< CPU ISA features to use
 
   public:
@@ -32,12 +32,12 @@ namespace embree
         typedef typename Patch::Ref Ref;
         typedef CatmullClarkPatchT<Vertex,Vertex_t> CatmullClarkPatch;
         
-        PatchEval (SharedLazyTessellationCache::CacheEntry& entry, size_t commitCounter, 
+        PatchEval (SharedLazyTessellationCache::CacheEntry& entry, SharedLazyTessellationCache::Partition& partition, size_t commitCounter, 
                    const HalfEdge* edge, const char* vertices, size_t stride, const float u, const float v, Vertex* P, Vertex* dPdu, Vertex* dPdv)
         : P(P), dPdu(dPdu), dPdv(dPdv)
         {
-          Ref patch = SharedLazyTessellationCache::lookup(entry,commitCounter,[&] () {
-              auto alloc = [](size_t bytes) { return SharedLazyTessellationCache::malloc(bytes); };
+          Ref patch = SharedLazyTessellationCache::lookup(entry,partition,commitCounter,[&] () {
+              auto alloc = [&](size_t bytes) { return SharedLazyTessellationCache::malloc(partition,bytes); };
               return Patch::create(alloc,edge,vertices,stride);
             });
           
@@ -32,13 +32,13 @@ namespace embree
         typedef typename Patch::Ref Ref;
         typedef CatmullClarkPatchT<Vertex,Vertex_t> CatmullClarkPatch;
 
-        PatchEvalSimd (SharedLazyTessellationCache::CacheEntry& entry, size_t commitCounter, 
+        PatchEvalSimd (SharedLazyTessellationCache::CacheEntry& entry, SharedLazyTessellationCache::Partition& partition, size_t commitCounter, 
                        const HalfEdge* edge, const char* vertices, size_t stride, const vbool& valid0, const vfloat& u, const vfloat& v, 
                        float* P, float* dPdu, float* dPdv, const size_t dstride, const size_t N)
         : P(P), dPdu(dPdu), dPdv(dPdv), dstride(dstride), N(N)
         {
-          Ref patch = SharedLazyTessellationCache::lookup(entry,commitCounter,[&] () {
-              auto alloc = [](size_t bytes) { return SharedLazyTessellationCache::malloc(bytes); };
+          Ref patch = SharedLazyTessellationCache::lookup(entry,partition,commitCounter,[&] () {
+              auto alloc = [&](size_t bytes) { return SharedLazyTessellationCache::malloc(partition,bytes); };
               return Patch::create(alloc,edge,vertices,stride);
             });
           
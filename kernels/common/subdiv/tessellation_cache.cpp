@@ -39,22 +39,18 @@ namespace embree
   }
   
   SharedLazyTessellationCache::SharedLazyTessellationCache()
+    : sharedPartition(0,0)
   {
     size = 0;
     data = nullptr;
     maxBlocks              = size/64;
-    localTime              = NUM_CACHE_SEGMENTS;
-    next_block             = 0;
+    generation             = 0;
     numRenderThreads       = 0;
-#if FORCE_SIMPLE_FLUSH == 1
-    switch_block_threshold = maxBlocks;
-#else
-    switch_block_threshold = maxBlocks/NUM_CACHE_SEGMENTS;
-#endif
     threadWorkState     = new ThreadWorkState[NUM_PREALLOC_THREAD_WORK_STATES];
 
     reset_state.reset();
     linkedlist_mtx.reset();
+    layoutPartitions();
   }
 
   SharedLazyTessellationCache::~SharedLazyTessellationCache() 
@@ -67,6 +63,9 @@ namespace embree
     }
 
     delete[] threadWorkState;
+
+    for (size_t i=0; i<partitions.size(); i++)
+      delete partitions[i];
   }
 
   void SharedLazyTessellationCache::getNextRenderThreadWorkState() 
@@ -98,60 +97,63 @@ namespace embree
        }
    }
 
-  void SharedLazyTessellationCache::allocNextSegment() 
+  void SharedLazyTessellationCache::openSegment(Partition& partition)
   {
-    if (reset_state.try_lock())
-      {
-	if (next_block >= switch_block_threshold)
-	  {
-            /* lock the linked list of thread states */
-
-            linkedlist_mtx.lock();
-
-            /* block all threads */
-	    for (ThreadWorkState *t=current_t_state;t!=nullptr;t=t->next)
-	      if (lockThread(t) == 1)
-		waitForUsersLessEqual(t,1);
-
-
-            /* switch to the next segment */
-	    addCurrentIndex();
-	    CACHE_STATS(PRINT("RESET TESS CACHE"));
-
 #if FORCE_SIMPLE_FLUSH == 1
-	    next_block = 0;
-	    switch_block_threshold = maxBlocks;
+    const size_t begin = partition.beginBlock;
+    const size_t end   = begin + NUM_CACHE_SEGMENTS*partition.segmentBlocks;
 #else
-	    const size_t region = localTime % NUM_CACHE_SEGMENTS;
-	    next_block = region * (maxBlocks/NUM_CACHE_SEGMENTS);
-	    switch_block_threshold = next_block + (maxBlocks/NUM_CACHE_SEGMENTS);
-	    assert( switch_block_threshold <= maxBlocks );
+    const size_t region = partition.localTime % NUM_CACHE_SEGMENTS;
+    const size_t begin  = partition.beginBlock + region*partition.segmentBlocks;
+    const size_t end    = begin + partition.segmentBlocks;
 #endif
+    assert( end <= maxBlocks );
+
+    /* close the segment first such that concurrent allocations fail until the new range is set */
+    partition.switch_block_threshold = 0;
+    __memory_barrier();
+    partition.next_block = begin;
+    __memory_barrier();
+    partition.switch_block_threshold = end;
+  }
 
-	    CACHE_STATS(SharedTessellationCacheStats::cache_flushes++);
-
-            /* release all blocked threads */
-
-	    for (ThreadWorkState *t=current_t_state;t!=nullptr;t=t->next)
-	      unlockThread(t);
-
-            /* unlock the linked list of thread states */
-
-            linkedlist_mtx.unlock();
-	    
-
-	  }
-	reset_state.unlock();
+  void SharedLazyTessellationCache::allocNextSegment(Partition& partition) 
+  {
+    if (partition.switch_mtx.try_lock())
+    {
+      if (partition.next_block >= partition.switch_block_threshold)
+      {
+        /* advancing the time invalidates all data of the oldest segment */
+        partition.localTime.add(1);
+        partition.numSegmentSwitches++;
+
+        /* Threads that lock the cache from now on see the new time
+         * and cannot get references into the oldest segment anymore,
+         * thus we only wait for threads that locked the cache
+         * before. Other threads keep running. */
+        const size_t epoch = generation.add(1)+1;
+        linkedlist_mtx.lock();
+        for (ThreadWorkState *t=current_t_state;t!=nullptr;t=t->next)
+          while (t->counter != 0 && t->epoch < epoch)
+            _mm_pause();
+        linkedlist_mtx.unlock();
+
+        /* reuse the oldest segment */
+        openSegment(partition);
       }
+      partition.switch_mtx.unlock();
+    }
     else
-      reset_state.wait_until_unlocked();	   
+      partition.switch_mtx.wait_until_unlocked();	   
   }
 
-
-  void SharedLazyTessellationCache::reset()
+  void SharedLazyTessellationCache::lockAllThreads()
   {
-    /* lock the reset_state */
+    /* lock the reset_state and all segment switches */
     reset_state.lock();
+    sharedPartition.switch_mtx.lock();
+    for (size_t i=0; i<partitions.size(); i++)
+      partitions[i]->switch_mtx.lock();
 
     /* lock the linked list of thread states */
     linkedlist_mtx.lock();
@@ -160,18 +162,10 @@ namespace embree
     for (ThreadWorkState *t=current_t_state;t!=nullptr;t=t->next)
       if (lockThread(t) == 1)
         waitForUsersLessEqual(t,1);
+  }
 
-    /* reset to the first segment */
-    next_block = 0;
-#if FORCE_SIMPLE_FLUSH == 1
-    switch_block_threshold = maxBlocks;
-#else
-    switch_block_threshold = maxBlocks/NUM_CACHE_SEGMENTS;
-#endif
-
-    /* reset local time */
-    localTime = NUM_CACHE_SEGMENTS;
-
+  void SharedLazyTessellationCache::unlockAllThreads()
+  {
     /* release all blocked threads */
     for (ThreadWorkState *t=current_t_state;t!=nullptr;t=t->next)
       unlockThread(t);
@@ -179,22 +173,72 @@ namespace embree
     /* unlock the linked list of thread states */
     linkedlist_mtx.unlock();	    
 
-    /* unlock the reset_state */
+    /* unlock all segment switches and the reset_state */
+    for (size_t i=0; i<partitions.size(); i++)
+      partitions[i]->switch_mtx.unlock();
+    sharedPartition.switch_mtx.unlock();
     reset_state.unlock();
   }
 
-  void SharedLazyTessellationCache::realloc(const size_t new_size)
+  void SharedLazyTessellationCache::layoutPartitions()
   {
-    /* lock the reset_state */
-    reset_state.lock();
+    /* partitions with budget get their memory from the end of the
+     * cache, as long as there is some left, the shared partition gets
+     * the remaining memory but never less than its minimal fraction,
+     * which matters if the cache got shrunk after budgets were set */
+    const size_t minSharedBlocks = maxBlocks/MIN_SHARED_PARTITION_FRACTION;
+    size_t blocks = maxBlocks;
+    for (size_t i=0; i<partitions.size(); i++)
+    {
+      Partition* partition = partitions[i];
+      size_t numBlocks = min(partition->budget/64,blocks-minSharedBlocks);
+      numBlocks -= numBlocks % NUM_CACHE_SEGMENTS;
+      blocks -= numBlocks;
+      partition->beginBlock = blocks;
+      partition->segmentBlocks = numBlocks/NUM_CACHE_SEGMENTS;
+    }
+    sharedPartition.beginBlock = 0;
+    sharedPartition.segmentBlocks = blocks/NUM_CACHE_SEGMENTS;
+
+    /* Invalidate all partitions. Cache tags store times of the
+     * partition they were created in and a scene may move to another
+     * partition, thus every partition continues after the latest time
+     * of all partitions, which invalidates data of all partitions
+     * in all partitions. */
+    size_t time = sharedPartition.localTime;
+    for (size_t i=0; i<partitions.size(); i++)
+      time = max(time,size_t(partitions[i]->localTime));
+    time += NUM_CACHE_SEGMENTS;
+
+    sharedPartition.localTime = time;
+    sharedPartition.numFlushes++;
+    openSegment(sharedPartition);
+    for (size_t i=0; i<partitions.size(); i++) {
+      partitions[i]->localTime = time;
+      partitions[i]->numFlushes++;
+      openSegment(*partitions[i]);
+    }
+  }
 
-    /* lock the linked list of thread states */
-    linkedlist_mtx.lock();
+  bool SharedLazyTessellationCache::validBudget(const Partition* partition, size_t budget)
+  {
+    if (budget < 64*NUM_CACHE_SEGMENTS) return false;
+    size_t total = budget;
+    for (size_t i=0; i<partitions.size(); i++)
+      if (partitions[i] != partition) total += partitions[i]->budget;
+    return total <= size - size/MIN_SHARED_PARTITION_FRACTION;
+  }
 
-    /* block all threads */
-    for (ThreadWorkState *t=current_t_state;t!=nullptr;t=t->next)
-      if (lockThread(t) == 1)
-        waitForUsersLessEqual(t,1);
+  void SharedLazyTessellationCache::reset()
+  {
+    lockAllThreads();
+    layoutPartitions();
+    unlockAllThreads();
+  }
+
+  void SharedLazyTessellationCache::realloc(const size_t new_size)
+  {
+    lockAllThreads();
 
     /* reallocate data */
     if (data) os_free(data,size);
@@ -203,28 +247,83 @@ namespace embree
     maxBlocks = size/64;    
 
     /* invalidate entire cache */
-    localTime += NUM_CACHE_SEGMENTS; 
+    layoutPartitions();
 
-    /* reset to the first segment */
-#if FORCE_SIMPLE_FLUSH == 1
-    next_block = 0;
-    switch_block_threshold = maxBlocks;
-#else
-    const size_t region = localTime % NUM_CACHE_SEGMENTS;
-    next_block = region * (maxBlocks/NUM_CACHE_SEGMENTS);
-    switch_block_threshold = next_block + (maxBlocks/NUM_CACHE_SEGMENTS);
-    assert( switch_block_threshold <= maxBlocks );
-#endif
+    unlockAllThreads();
+  }
+
+  SharedLazyTessellationCache::Partition* SharedLazyTessellationCache::createPartition(size_t budget)
+  {
+    lockAllThreads();
+
+    /* find unused statistics slot, slot 0 belongs to the shared partition */
+    size_t slot = 1;
+    for (; slot<MAX_TESSELLATION_CACHE_PARTITIONS; slot++) {
+      bool used = false;
+      for (size_t i=0; i<partitions.size(); i++) 
+        used |= partitions[i]->slot == slot;
+      if (!used) break;
+    }
+    if (slot == MAX_TESSELLATION_CACHE_PARTITIONS) {
+      unlockAllThreads();
+      throw_RTCError(RTC_INVALID_OPERATION,"too many tessellation cache partitions");
+    }
+    if (!validBudget(nullptr,budget)) {
+      unlockAllThreads();
+      throw_RTCError(RTC_INVALID_ARGUMENT,"tessellation cache budget is too small or leaves too little memory for other scenes");
+    }
 
-    /* release all blocked threads */
     for (ThreadWorkState *t=current_t_state;t!=nullptr;t=t->next)
-      unlockThread(t);
+      t->hits[slot] = t->misses[slot] = 0;
 
-    /* unlock the linked list of thread states */
-    linkedlist_mtx.unlock();	    
+    Partition* partition = new Partition(slot,budget);
+    partitions.push_back(partition);
+    layoutPartitions();
 
-    /* unlock the reset_state */
-    reset_state.unlock();
+    unlockAllThreads();
+    return partition;
+  }
+
+  void SharedLazyTessellationCache::setPartitionBudget(Partition* partition, size_t budget)
+  {
+    lockAllThreads();
+    if (!validBudget(partition,budget)) {
+      unlockAllThreads();
+      throw_RTCError(RTC_INVALID_ARGUMENT,"tessellation cache budget is too small or leaves too little memory for other scenes");
+    }
+    partition->budget = budget;
+    layoutPartitions();
+    unlockAllThreads();
+  }
+
+  void SharedLazyTessellationCache::destroyPartition(Partition* partition)
+  {
+    lockAllThreads();
+    partitions.erase(std::find(partitions.begin(),partitions.end(),partition));
+
+    /* the memory of the partition goes back to the shared partition */
+    layoutPartitions();
+
+    /* the partition is not locked anymore by unlockAllThreads */
+    partition->switch_mtx.unlock();
+    unlockAllThreads();
+    delete partition;
+  }
+
+  SharedLazyTessellationCache::Statistics SharedLazyTessellationCache::getStatistics(const Partition* partition)
+  {
+    Statistics stats;
+    stats.bytes = 64*NUM_CACHE_SEGMENTS*partition->segmentBlocks;
+    stats.hits = stats.misses = 0;
+    linkedlist_mtx.lock();
+    for (ThreadWorkState *t=current_t_state;t!=nullptr;t=t->next) {
+      stats.hits   += t->hits  [partition->slot];
+      stats.misses += t->misses[partition->slot];
+    }
+    linkedlist_mtx.unlock();
+    stats.segmentSwitches = partition->numSegmentSwitches;
+    stats.flushes = partition->numFlushes;
+    return stats;
   }
 
 
@@ -232,10 +331,6 @@ namespace embree
   ////////////////////////////////////////////////////////////////////////////////////////////////////////////
   ////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-  AtomicCounter SharedTessellationCacheStats::cache_accesses           = 0;
-  AtomicCounter SharedTessellationCacheStats::cache_hits               = 0;
-  AtomicCounter SharedTessellationCacheStats::cache_misses             = 0;
-  AtomicCounter SharedTessellationCacheStats::cache_flushes            = 0;  
   AtomicMutex   SharedTessellationCacheStats::mtx;  
   AtomicCounter *SharedTessellationCacheStats::cache_patch_builds      = NULL;                
   size_t SharedTessellationCacheStats::cache_num_patches               = 0;
@@ -243,12 +338,14 @@ namespace embree
 
   void SharedTessellationCacheStats::printStats()
   {
-    PRINT(cache_accesses);
-    PRINT(cache_misses);
-    PRINT(cache_hits);
-    PRINT(cache_flushes);
-    PRINT(100.0f * cache_hits / cache_accesses);
-    assert(cache_hits + cache_misses == cache_accesses);
+    SharedLazyTessellationCache& cache = SharedLazyTessellationCache::sharedLazyTessellationCache;
+    const SharedLazyTessellationCache::Statistics stats = cache.getStatistics(cache.getSharedPartition());
+    PRINT(stats.bytes);
+    PRINT(stats.hits);
+    PRINT(stats.misses);
+    PRINT(stats.segmentSwitches);
+    PRINT(stats.flushes);
+    PRINT(100.0f * stats.hits / max(size_t(1),stats.hits+stats.misses));
     PRINT(cache_num_patches);
     size_t patches = 0;
     size_t builds  = 0;
@@ -265,10 +362,6 @@ namespace embree
 
   void SharedTessellationCacheStats::clearStats()
   {
-    SharedTessellationCacheStats::cache_accesses  = 0;
-    SharedTessellationCacheStats::cache_hits      = 0;
-    SharedTessellationCacheStats::cache_misses    = 0;
-    SharedTessellationCacheStats::cache_flushes   = 0;
     for (size_t i=0;i<cache_num_patches;i++)
       cache_patch_builds[i] = 0;
   }
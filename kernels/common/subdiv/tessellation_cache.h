@@ -43,10 +43,6 @@ namespace embree
  {
  public:
     /* stats */
-   static AtomicCounter cache_accesses;
-   static AtomicCounter cache_hits;
-   static AtomicCounter cache_misses;
-   static AtomicCounter cache_flushes;                
    static AtomicCounter *cache_patch_builds;                
    static size_t        cache_num_patches;
    static float **      cache_new_delete_ptr;  
@@ -82,6 +78,12 @@ namespace embree
  ////////////////////////////////////////////////////////////////////////////////
  ////////////////////////////////////////////////////////////////////////////////
 
+ /*! maximal number of tessellation cache partitions including the shared one */
+ static const size_t MAX_TESSELLATION_CACHE_PARTITIONS = 16;
+
+ /*! the shared partition always keeps at least this fraction of the tessellation cache */
+ static const size_t MIN_SHARED_PARTITION_FRACTION = 4;
+
  struct __aligned(64) ThreadWorkState 
  {
    ALIGNED_STRUCT;
@@ -89,11 +91,16 @@ namespace embree
    AtomicCounter counter;
    ThreadWorkState* next;
    bool allocated;
+   volatile size_t epoch;                               //!< cache generation when the thread started to use cached data
+   size_t hits  [MAX_TESSELLATION_CACHE_PARTITIONS];    //!< cache hits of this thread per partition
+   size_t misses[MAX_TESSELLATION_CACHE_PARTITIONS];    //!< cache misses of this thread per partition
 
    __forceinline ThreadWorkState(bool allocated = false) 
-     : counter(0), next(nullptr), allocated(allocated) 
+     : counter(0), next(nullptr), allocated(allocated), epoch(0)
    {
      assert( ((size_t)this % 64) == 0 ); 
+     for (size_t i=0; i<MAX_TESSELLATION_CACHE_PARTITIONS; i++)
+       hits[i] = misses[i] = 0;
    }   
  };
 
@@ -166,6 +173,42 @@ namespace embree
      RWMutex mutex;
    };
 
+   /*! Range of the cache with its own ring of segments. Scenes
+    *  without budget share one partition, scenes with budget get a
+    *  partition of their own and cannot evict data of other scenes. */
+   struct __aligned(64) Partition
+   {
+     ALIGNED_STRUCT;
+
+     Partition (size_t slot, size_t budget)
+       : slot(slot), budget(budget), beginBlock(0), segmentBlocks(0), 
+         localTime(NUM_CACHE_SEGMENTS), next_block(0), switch_block_threshold(0), numSegmentSwitches(0), numFlushes(0) 
+     {
+       switch_mtx.reset();
+     }
+
+     size_t slot;                                        //!< index of the per thread statistics of this partition
+     size_t budget;                                      //!< requested size in bytes, 0 for the shared partition
+     size_t beginBlock;                                  //!< first block of the partition
+     size_t segmentBlocks;                               //!< number of blocks of each segment
+     __aligned(64) AtomicCounter localTime;
+     __aligned(64) AtomicCounter next_block;
+     __aligned(64) AtomicCounter switch_block_threshold;
+     __aligned(64) AtomicMutex   switch_mtx;             //!< serializes segment switches of this partition
+     AtomicCounter numSegmentSwitches;                   //!< number of times the oldest segment got reclaimed
+     AtomicCounter numFlushes;                           //!< number of times the entire partition got invalidated
+   };
+
+   /*! statistics of one partition */
+   struct Statistics
+   {
+     size_t bytes;               //!< size of the partition
+     size_t hits;                //!< number of lookups that found valid data
+     size_t misses;              //!< number of lookups that had to build the data
+     size_t segmentSwitches;     //!< number of reclaimed segments
+     size_t flushes;             //!< number of invalidations of the entire partition
+   };
+
  private:
 
    float *data;
@@ -173,13 +216,13 @@ namespace embree
    size_t maxBlocks;
    ThreadWorkState *threadWorkState;
       
-   __aligned(64) AtomicCounter localTime;
-   __aligned(64) AtomicCounter next_block;
+   __aligned(64) AtomicCounter generation;
    __aligned(64) AtomicMutex   reset_state;
    __aligned(64) AtomicMutex   linkedlist_mtx;
-   __aligned(64) AtomicCounter switch_block_threshold;
    __aligned(64) AtomicCounter numRenderThreads;
 
+   Partition sharedPartition;             //!< partition of all scenes without budget
+   std::vector<Partition*> partitions;    //!< partitions of scenes with budget
 
  public:
 
@@ -189,14 +232,18 @@ namespace embree
 
    void getNextRenderThreadWorkState();
 
-   //__forceinline size_t getCurrentIndex() { return localTime; }
-   __forceinline void   addCurrentIndex(const size_t i=1) { localTime.add(i); }
+   __forceinline Partition* getSharedPartition() { return &sharedPartition; }
 
-   __forceinline size_t getTime(const unsigned globalTime) {
-     return localTime+NUM_CACHE_SEGMENTS*globalTime;
+   __forceinline size_t getTime(const Partition& partition, const unsigned globalTime) {
+     return partition.localTime+NUM_CACHE_SEGMENTS*globalTime;
    }
 
-   __forceinline unsigned int lockThread  (ThreadWorkState *const t_state) { return t_state->counter.add(1);  }
+   __forceinline unsigned int lockThread (ThreadWorkState *const t_state) 
+   {
+     const unsigned int lock = t_state->counter.add(1);
+     if (lock == 0) t_state->epoch = generation;
+     return lock;
+   }
    __forceinline unsigned int unlockThread(ThreadWorkState *const t_state) { assert(isLocked(t_state)); return t_state->counter.add(-1); }
    __forceinline bool isLocked(ThreadWorkState *const t_state) { return t_state->counter != 0; }
 
@@ -220,7 +267,7 @@ namespace embree
      }
    }
 
-   static __forceinline void* lookup(CacheEntry& entry, unsigned globalTime)
+   static __forceinline void* lookup(CacheEntry& entry, Partition& partition, unsigned globalTime)
    {   
 #if defined(__X86_64__)
      const int64_t subdiv_patch_root_ref = entry.tag.data; 
@@ -229,46 +276,44 @@ namespace embree
      const int64_t subdiv_patch_root_ref = entry.tag.data; 
      entry.mutex.read_unlock();
 #endif
-     CACHE_STATS(SharedTessellationCacheStats::cache_accesses++);
      
      if (likely(subdiv_patch_root_ref != 0)) 
      {
        const size_t subdiv_patch_root = (subdiv_patch_root_ref & REF_TAG_MASK) + (size_t)sharedLazyTessellationCache.getDataPtr();
        const size_t subdiv_patch_cache_index = extractCommitIndex(subdiv_patch_root_ref);
        
-       if (likely( sharedLazyTessellationCache.validCacheIndex(subdiv_patch_cache_index,globalTime) ))
-       {
-         CACHE_STATS(SharedTessellationCacheStats::cache_hits++);
+       if (likely( sharedLazyTessellationCache.validCacheIndex(partition,subdiv_patch_cache_index,globalTime) ))
          return (void*) subdiv_patch_root;
-       }
      }
-     CACHE_STATS(SharedTessellationCacheStats::cache_misses++);
      return nullptr;
    }
 
    template<typename Constructor>
-     static __forceinline auto lookup (CacheEntry& entry, unsigned globalTime, const Constructor constructor) -> decltype(constructor())
+     static __forceinline auto lookup (CacheEntry& entry, Partition& partition, unsigned globalTime, const Constructor constructor) -> decltype(constructor())
    {
      ThreadWorkState *t_state = SharedLazyTessellationCache::threadState();
 
      while (true)
      {
        sharedLazyTessellationCache.lockThreadLoop(t_state);
-       void* patch = SharedLazyTessellationCache::lookup(entry,globalTime);
-       if (patch) return (decltype(constructor())) patch;
+       void* patch = SharedLazyTessellationCache::lookup(entry,partition,globalTime);
+       if (patch) {
+         t_state->hits[partition.slot]++;
+         return (decltype(constructor())) patch;
+       }
        
        if (entry.mutex.try_write_lock())
        {
-         if (!validTag(entry.tag,globalTime)) 
+         if (!validTag(partition,entry.tag,globalTime)) 
          {
-           auto time = sharedLazyTessellationCache.getTime(globalTime);
+           t_state->misses[partition.slot]++;
+           auto time = sharedLazyTessellationCache.getTime(partition,globalTime);
            auto ret = constructor();
            __memory_barrier();
-           //const size_t commitIndex = SharedLazyTessellationCache::sharedLazyTessellationCache.getCurrentIndex();
            entry.tag = SharedLazyTessellationCache::Tag(ret,time);
            __memory_barrier();
            entry.mutex.write_unlock();
-           if (!validTag(entry.tag,globalTime)) return nullptr;
+           if (!validTag(partition,entry.tag,globalTime)) return nullptr;
            else return ret;
          }
          entry.mutex.write_unlock();
@@ -277,23 +322,18 @@ namespace embree
      }
    }
    
-   static __forceinline size_t lookupIndex(volatile Tag* tag, unsigned globalTime)
+   static __forceinline size_t lookupIndex(Partition& partition, volatile Tag* tag, unsigned globalTime)
    {
      const int64_t subdiv_patch_root_ref = tag->data; 
      
-     CACHE_STATS(SharedTessellationCacheStats::cache_accesses++);
      if (likely(subdiv_patch_root_ref != 0)) 
      {
        const size_t subdiv_patch_root = (subdiv_patch_root_ref & REF_TAG_MASK);
        const size_t subdiv_patch_cache_index = extractCommitIndex(subdiv_patch_root_ref);
        
-       if (likely( sharedLazyTessellationCache.validCacheIndex(subdiv_patch_cache_index,globalTime) ))
-       {
-         CACHE_STATS(SharedTessellationCacheStats::cache_hits++);
+       if (likely( sharedLazyTessellationCache.validCacheIndex(partition,subdiv_patch_cache_index,globalTime) ))
          return subdiv_patch_root;
-       }
      }
-     CACHE_STATS(SharedTessellationCacheStats::cache_misses++);
      return -1;
    }
 
@@ -303,48 +343,47 @@ namespace embree
 #endif
    }
 
-   __forceinline bool validCacheIndex(const size_t i, const unsigned globalTime)
+   __forceinline bool validCacheIndex(const Partition& partition, const size_t i, const unsigned globalTime)
    {
 #if FORCE_SIMPLE_FLUSH == 1
-     return i == getTime(globalTime);
+     return i == getTime(partition,globalTime);
 #else
-     return i+(NUM_CACHE_SEGMENTS-1) >= getTime(globalTime);
+     return i+(NUM_CACHE_SEGMENTS-1) >= getTime(partition,globalTime);
 #endif
    }
 
-    static __forceinline bool validTag(const Tag& tag, unsigned globalTime)
+    static __forceinline bool validTag(const Partition& partition, const Tag& tag, unsigned globalTime)
     {
       const int64_t subdiv_patch_root_ref = tag.data; 
       if (subdiv_patch_root_ref == 0) return false;
       const size_t subdiv_patch_cache_index = extractCommitIndex(subdiv_patch_root_ref);
-      return sharedLazyTessellationCache.validCacheIndex(subdiv_patch_cache_index,globalTime);
+      return sharedLazyTessellationCache.validCacheIndex(partition,subdiv_patch_cache_index,globalTime);
     }
 
    void waitForUsersLessEqual(ThreadWorkState *const t_state,
 			      const unsigned int users);
     
-   __forceinline size_t alloc(const size_t blocks)
+   __forceinline size_t alloc(Partition& partition, const size_t blocks)
    {
-     if (unlikely(blocks >= switch_block_threshold))
+     if (unlikely(blocks >= partition.segmentBlocks))
      {
        throw_RTCError(RTC_INVALID_OPERATION,"allocation exceeds size of tessellation cache segment");
      }
-     assert(blocks < switch_block_threshold);
-     size_t index = next_block.add(blocks);
-     if (unlikely(index + blocks >= switch_block_threshold)) return (size_t)-1;
+     size_t index = partition.next_block.add(blocks);
+     if (unlikely(index + blocks >= partition.switch_block_threshold)) return (size_t)-1;
      return index;
    }
 
-   static __forceinline size_t allocIndexLoop(ThreadWorkState *const t_state, const size_t blocks)
+   static __forceinline size_t allocIndexLoop(ThreadWorkState *const t_state, Partition& partition, const size_t blocks)
    {
      size_t block_index = -1;
      while (true)
      {
-       block_index = sharedLazyTessellationCache.alloc(blocks);
+       block_index = sharedLazyTessellationCache.alloc(partition,blocks);
        if (block_index == (size_t)-1)
        {
          sharedLazyTessellationCache.unlockThread(t_state);		  
-         sharedLazyTessellationCache.allocNextSegment();
+         sharedLazyTessellationCache.allocNextSegment(partition);
          sharedLazyTessellationCache.lockThread(t_state);
          continue; 
        }
@@ -353,41 +392,12 @@ namespace embree
      return block_index;
    }
 
-   static __forceinline void* allocLoop(ThreadWorkState *const t_state, const size_t bytes)
-   {
-     size_t block_index = -1;
-     while (true)
-     {
-       block_index = sharedLazyTessellationCache.alloc((bytes+63)/64);
-       if (block_index == (size_t)-1)
-       {
-         sharedLazyTessellationCache.unlockThread(t_state);		  
-         sharedLazyTessellationCache.allocNextSegment();
-         sharedLazyTessellationCache.lockThread(t_state);
-         continue; 
-       }
-       break;
-     }
-     return sharedLazyTessellationCache.getBlockPtr(block_index);
+   static __forceinline void* allocLoop(ThreadWorkState *const t_state, Partition& partition, const size_t bytes) {
+     return sharedLazyTessellationCache.getBlockPtr(allocIndexLoop(t_state,partition,(bytes+63)/64));
    }
 
-   static __forceinline void* malloc(const size_t bytes)
-   {
-     size_t block_index = -1;
-     ThreadWorkState *const t_state = threadState();
-     while (true)
-     {
-       block_index = sharedLazyTessellationCache.alloc((bytes+63)/64);
-       if (block_index == (size_t)-1)
-       {
-         sharedLazyTessellationCache.unlockThread(t_state);		  
-         sharedLazyTessellationCache.allocNextSegment();
-         sharedLazyTessellationCache.lockThread(t_state);
-         continue; 
-       }
-       break;
-     }
-     return sharedLazyTessellationCache.getBlockPtr(block_index);
+   static __forceinline void* malloc(Partition& partition, const size_t bytes) {
+     return allocLoop(threadState(),partition,bytes);
    }
 
    __forceinline void *getBlockPtr(const size_t block_index)
@@ -397,17 +407,46 @@ namespace embree
    }
 
    __forceinline void*  getDataPtr()      { return data; }
-   __forceinline size_t getNumUsedBytes() { return next_block * 64; }
    __forceinline size_t getMaxBlocks()    { return maxBlocks; }
    __forceinline size_t getSize()         { return size; }
 
-   void allocNextSegment();
+   /*! reclaims the oldest segment of some partition, only waits for threads that may still use the reclaimed segment */
+   void allocNextSegment(Partition& partition);
+
    void realloc(const size_t newSize);
 
    void reset();
 
+   /*! creates a partition with its own budget in bytes */
+   Partition* createPartition(size_t budget);
+
+   /*! changes the budget of a partition */
+   void setPartitionBudget(Partition* partition, size_t budget);
+
+   /*! destroys a partition again */
+   void destroyPartition(Partition* partition);
+
+   /*! returns statistics of some partition */
+   Statistics getStatistics(const Partition* partition);
+
    static SharedLazyTessellationCache sharedLazyTessellationCache;
-    
+
+ private:
+
+   /*! blocks all threads from using the cache */
+   void lockAllThreads();
+
+   /*! releases all threads blocked by lockAllThreads */
+   void unlockAllThreads();
+
+   /*! assigns memory to all partitions and invalidates them, all threads have to be locked */
+   void layoutPartitions();
+
+   /*! tests if a budget fits one block per segment and leaves enough memory for the shared partition */
+   bool validBudget(const Partition* partition, size_t budget);
+
+   /*! switches partition to the segment of its current time */
+   void openSegment(Partition& partition);
  };
 
   // =========================================================================================================
@@ -112,6 +112,80 @@ namespace embree
       return pinfo;
     }
 
+    template<typename Mesh>
+    PrimInfo createPrimRefArrayMB(Mesh* mesh, const BBox1f& time_range, mvector<PrimRef>& prims, BuildProgressMonitor& progressMonitor)
+    {
+      ParallelPrefixSumState<PrimInfo> pstate;
+      auto primRefs = [&](const range<size_t>& r, size_t k) -> PrimInfo
+      {
+        PrimInfo pinfo(empty);
+        for (size_t j=r.begin(); j<r.end(); j++)
+        {
+          if (!mesh->valid(j)) continue;
+          const std::pair<BBox3fa,BBox3fa> lbounds = mesh->linearBounds(j,time_range);
+          const BBox3fa bounds = lerp(lbounds.first,lbounds.second,0.5f);
+          const PrimRef prim(bounds,mesh->id,j);
+          pinfo.add(bounds,bounds.center2());
+          prims[k++] = prim;
+        }
+        return pinfo;
+      };
+
+      /* first try */
+      progressMonitor(0);
+      PrimInfo pinfo = parallel_prefix_sum( pstate, size_t(0), mesh->size(), size_t(1024), PrimInfo(empty), [&](const range<size_t>& r, const PrimInfo& base) -> PrimInfo {
+          return primRefs(r,r.begin());
+        }, [](const PrimInfo& a, const PrimInfo& b) -> PrimInfo { return PrimInfo::merge(a,b); });
+      
+      /* if we need to filter out geometry, run again */
+      if (pinfo.size() != prims.size())
+      {
+        progressMonitor(0);
+        pinfo = parallel_prefix_sum( pstate, size_t(0), mesh->size(), size_t(1024), PrimInfo(empty), [&](const range<size_t>& r, const PrimInfo& base) -> PrimInfo {
+            return primRefs(r,base.size());
+          }, [](const PrimInfo& a, const PrimInfo& b) -> PrimInfo { return PrimInfo::merge(a,b); });
+      }
+      return pinfo;
+    }
+
+    template<typename Mesh>
+    PrimInfo createPrimRefArrayMB(Scene* scene, const BBox1f& time_range, mvector<PrimRef>& prims, BuildProgressMonitor& progressMonitor)
+    {
+      ParallelForForPrefixSumState<PrimInfo> pstate;
+      Scene::Iterator<Mesh,2> iter(scene);
+      auto primRefs = [&](Mesh* mesh, const range<size_t>& r, size_t k) -> PrimInfo
+      {
+        PrimInfo pinfo(empty);
+        for (size_t j=r.begin(); j<r.end(); j++)
+        {
+          if (!mesh->valid(j)) continue;
+          const std::pair<BBox3fa,BBox3fa> lbounds = mesh->linearBounds(j,time_range);
+          const BBox3fa bounds = lerp(lbounds.first,lbounds.second,0.5f);
+          const PrimRef prim(bounds,mesh->id,j);
+          pinfo.add(bounds,bounds.center2());
+          prims[k++] = prim;
+        }
+        return pinfo;
+      };
+      
+      /* first try */
+      progressMonitor(0);
+      pstate.init(iter,size_t(1024));
+      PrimInfo pinfo = parallel_for_for_prefix_sum( pstate, iter, PrimInfo(empty), [&](Mesh* mesh, const range<size_t>& r, size_t k, const PrimInfo& base) -> PrimInfo {
+          return primRefs(mesh,r,k);
+        }, [](const PrimInfo& a, const PrimInfo& b) -> PrimInfo { return PrimInfo::merge(a,b); });
+      
+      /* if we need to filter out geometry, run again */
+      if (pinfo.size() != prims.size())
+      {
+        progressMonitor(0);
+        pinfo = parallel_for_for_prefix_sum( pstate, iter, PrimInfo(empty), [&](Mesh* mesh, const range<size_t>& r, size_t k, const PrimInfo& base) -> PrimInfo {
+            return primRefs(mesh,r,base.size());
+          }, [](const PrimInfo& a, const PrimInfo& b) -> PrimInfo { return PrimInfo::merge(a,b); });
+      }
+      return pinfo;
+    }
+
     template<typename Mesh, size_t timeSteps>
       PrimInfo createPrimRefList(Scene* scene, PrimRefList& prims_o, BuildProgressMonitor& progressMonitor)
     {
@@ -235,6 +309,18 @@ namespace embree
     template PrimInfo createPrimRefArray<AccelSet,1>(Scene* scene, mvector<PrimRef>& prims, BuildProgressMonitor& progressMonitor);
     template PrimInfo createPrimRefArray<AccelSet,2>(Scene* scene, mvector<PrimRef>& prims, BuildProgressMonitor& progressMonitor);
 
+    template PrimInfo createPrimRefArrayMB<TriangleMesh>(TriangleMesh* mesh, const BBox1f& time_range, mvector<PrimRef>& prims, BuildProgressMonitor& progressMonitor);
+    template PrimInfo createPrimRefArrayMB<QuadMesh>(QuadMesh* mesh, const BBox1f& time_range, mvector<PrimRef>& prims, BuildProgressMonitor& progressMonitor);
+    template PrimInfo createPrimRefArrayMB<LineSegments>(LineSegments* mesh, const BBox1f& time_range, mvector<PrimRef>& prims, BuildProgressMonitor& progressMonitor);
+    template PrimInfo createPrimRefArrayMB<Points>(Points* mesh, const BBox1f& time_range, mvector<PrimRef>& prims, BuildProgressMonitor& progressMonitor);
+    template PrimInfo createPrimRefArrayMB<AccelSet>(AccelSet* mesh, const BBox1f& time_range, mvector<PrimRef>& prims, BuildProgressMonitor& progressMonitor);
+
+    template PrimInfo createPrimRefArrayMB<TriangleMesh>(Scene* scene, const BBox1f& time_range, mvector<PrimRef>& prims, BuildProgressMonitor& progressMonitor);
+    template PrimInfo createPrimRefArrayMB<QuadMesh>(Scene* scene, const BBox1f& time_range, mvector<PrimRef>& prims, BuildProgressMonitor& progressMonitor);
+    template PrimInfo createPrimRefArrayMB<LineSegments>(Scene* scene, const BBox1f& time_range, mvector<PrimRef>& prims, BuildProgressMonitor& progressMonitor);
+    template PrimInfo createPrimRefArrayMB<Points>(Scene* scene, const BBox1f& time_range, mvector<PrimRef>& prims, BuildProgressMonitor& progressMonitor);
+    template PrimInfo createPrimRefArrayMB<AccelSet>(Scene* scene, const BBox1f& time_range, mvector<PrimRef>& prims, BuildProgressMonitor& progressMonitor);
+
     template PrimInfo createBezierRefArray<1>(Scene* scene, mvector<BezierPrim>& prims, BuildProgressMonitor& progressMonitor);
     template PrimInfo createBezierRefArray<2>(Scene* scene, mvector<BezierPrim>& prims, BuildProgressMonitor& progressMonitor);
 
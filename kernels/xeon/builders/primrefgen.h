@@ -31,6 +31,13 @@ namespace embree
     template<typename Mesh, size_t timeSteps>
       PrimInfo createPrimRefArray(Scene* scene, mvector<PrimRef>& prims, BuildProgressMonitor& progressMonitor);
 
+    /*! creates primitive references for motion blurred geometry, bounded at the center of the time range */
+    template<typename Mesh>
+      PrimInfo createPrimRefArrayMB(Mesh* mesh, const BBox1f& time_range, mvector<PrimRef>& prims, BuildProgressMonitor& progressMonitor);
+
+    template<typename Mesh>
+      PrimInfo createPrimRefArrayMB(Scene* scene, const BBox1f& time_range, mvector<PrimRef>& prims, BuildProgressMonitor& progressMonitor);
+
     template<typename Mesh, size_t timeSteps>
       PrimInfo createPrimRefList(Scene* scene, PrimRefList& prims, BuildProgressMonitor& progressMonitor);
 
@@ -23,7 +23,7 @@ namespace embree
   BVHN<N>::BVHN (const PrimitiveType& primTy, Scene* scene)
     : AccelData((N==4) ? AccelData::TY_BVH4 : (N==8) ? AccelData::TY_BVH8 : AccelData::TY_UNKNOWN),
       primTy(primTy), device(scene->device), scene(scene),
-      root(emptyNode), alloc(scene->device), numPrimitives(0), numVertices(0), data_mem(nullptr), size_data_mem(0) {}
+      root(emptyNode), alloc(scene->device,scene->device->numa_alloc,scene->device->block_pool,scene->device->alloc_prefault), numPrimitives(0), numVertices(0), buildStart(0.0), buildPhaseStart(0.0), data_mem(nullptr), size_data_mem(0) {}
 
   template<int N>
   BVHN<N>::~BVHN ()
@@ -59,6 +59,18 @@ namespace embree
     std::cout << BVHNStatistics<N>(this).str();
   }	
 
+  template<int N>
+  size_t BVHN<N>::statistics(RTCAccelStatistics* stats, size_t maxStats)
+  {
+    if (maxStats == 0) return 1;
+    BVHNStatistics<N>(this).fill(stats[0]);
+    stats[0].buildTimePrimRefs  = buildTimes.primrefs;
+    stats[0].buildTimeHierarchy = buildTimes.hierarchy;
+    stats[0].buildTimeFinalize  = buildTimes.finalize;
+    stats[0].buildTimeTotal     = buildTimes.total;
+    return 1;
+  }
+
   template<int N>
   void BVHN<N>::clearBarrier(NodeRef& node)
   {
@@ -133,6 +145,9 @@ namespace embree
   template<int N>
   double BVHN<N>::preBuild(const std::string& builderName)
   {
+    buildTimes = BuildTimes();
+    buildStart = buildPhaseStart = getSeconds();
+
     if (builderName == "") 
       return inf;
 
@@ -147,6 +162,8 @@ namespace embree
   template<int N>
   void BVHN<N>::postBuild(double t0)
   {
+    buildTimes.total = getSeconds()-buildStart;
+
     if (t0 == double(inf))
       return;
     
@@ -173,7 +190,9 @@ namespace embree
     }
   }
 
-#if defined(__AVX__)
+#if defined(__AVX512F__)
+  template class BVHN<16>;
+#elif defined(__AVX__)
   template class BVHN<8>;
 #else
   template class BVHN<4>;
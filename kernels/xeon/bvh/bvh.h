@@ -34,12 +34,14 @@ namespace embree
     BVH_FLAG_UNALIGNED_NODE = 0x00100,
     BVH_FLAG_UNALIGNED_NODE_MB = 0x01000,
     BVH_FLAG_TRANSFORM_NODE = 0x10000,
+    BVH_FLAG_QUANTIZED_NODE = 0x100000,
 
     /* short versions */
     BVH_AN1 = BVH_FLAG_ALIGNED_NODE,
     BVH_AN2 = BVH_FLAG_ALIGNED_NODE_MB,
     BVH_UN1 = BVH_FLAG_UNALIGNED_NODE,
     BVH_UN2 = BVH_FLAG_UNALIGNED_NODE_MB,
+    BVH_QN1 = BVH_FLAG_QUANTIZED_NODE,
     BVH_MB = BVH_FLAG_ALIGNED_NODE_MB | BVH_FLAG_UNALIGNED_NODE_MB,
     BVH_AN1_UN1 = BVH_FLAG_ALIGNED_NODE | BVH_FLAG_UNALIGNED_NODE,
     BVH_AN2_UN2 = BVH_FLAG_ALIGNED_NODE_MB | BVH_FLAG_UNALIGNED_NODE_MB,
@@ -59,9 +61,11 @@ namespace embree
     struct BaseNode;
     struct Node;
     struct NodeMB;
+    struct NodeMB4D;
     struct UnalignedNode;
     struct UnalignedNodeMB;
     struct TransformNode;
+    struct QuantizedNode;
 
     /*! Number of bytes the nodes and primitives are minimally aligned to.*/
     static const size_t byteAlignment = 16;
@@ -80,6 +84,8 @@ namespace embree
     static const size_t tyUnalignedNode = 2;
     static const size_t tyUnalignedNodeMB = 3;
     static const size_t tyTransformNode = 4;
+    static const size_t tyQuantizedNode = 5;
+    static const size_t tyNodeMB4D = 6;
     static const size_t tyLeaf = 8;
 
     /*! Empty node */
@@ -137,6 +143,30 @@ namespace embree
       BVHN* bvh;
     };
 
+    /*! Builder interface to create QuantizedNode */
+    struct CreateQuantizedNode
+    {
+      __forceinline CreateQuantizedNode (BVHN* bvh) : bvh(bvh) {}
+
+      template<typename BuildRecord>
+      __forceinline QuantizedNode* operator() (const BuildRecord& current, BuildRecord* children, const size_t n, FastAllocator::ThreadLocal2* alloc)
+      {
+        BBox3fa bounds = empty;
+        for (size_t i=0; i<n; i++) 
+          bounds.extend(children[i].bounds());
+
+        QuantizedNode* node = (QuantizedNode*) alloc->alloc0.malloc(sizeof(QuantizedNode), byteNodeAlignment); node->clear(bounds);
+        for (size_t i=0; i<n; i++) {
+          node->set(i,children[i].bounds());
+          children[i].parent = (size_t*)&node->child(i);
+        }
+        *current.parent = bvh->encodeNode(node);
+        return node;
+      }
+
+      BVHN* bvh;
+    };
+
     struct NoRotate
     {
       __forceinline size_t operator() (Node* node, const size_t* counts, const size_t n) {
@@ -168,7 +198,7 @@ namespace embree
           prefetchL1(((char*)ptr)+3*64);
 #endif
         }
-        if ((N >= 8) && (types > BVH_FLAG_ALIGNED_NODE)) {
+        if ((N >= 16) || ((N >= 8) && (types > BVH_FLAG_ALIGNED_NODE))) {
           prefetchL1(((char*)ptr)+4*64);
           prefetchL1(((char*)ptr)+5*64);
           prefetchL1(((char*)ptr)+6*64);
@@ -183,7 +213,7 @@ namespace embree
           embree::prefetchL2(((char*)ptr)+2*64);
           embree::prefetchL2(((char*)ptr)+3*64);
         }
-        if ((N >= 8) && (types > BVH_FLAG_ALIGNED_NODE)) {
+        if ((N >= 16) || ((N >= 8) && (types > BVH_FLAG_ALIGNED_NODE))) {
           embree::prefetchL2(((char*)ptr)+4*64);
           embree::prefetchL2(((char*)ptr)+5*64);
           embree::prefetchL2(((char*)ptr)+6*64);
@@ -198,7 +228,7 @@ namespace embree
           embree::prefetchEX(((char*)ptr)+2*64);
           embree::prefetchEX(((char*)ptr)+3*64);
         }
-        if ((N >= 8) && (types > BVH_FLAG_ALIGNED_NODE)) {
+        if ((N >= 16) || ((N >= 8) && (types > BVH_FLAG_ALIGNED_NODE))) {
           embree::prefetchEX(((char*)ptr)+4*64);
           embree::prefetchEX(((char*)ptr)+5*64);
           embree::prefetchEX(((char*)ptr)+6*64);
@@ -227,12 +257,18 @@ namespace embree
       /*! checks if this is a motion blur node */
       __forceinline int isNodeMB() const { return (ptr & (size_t)align_mask) == tyNodeMB; }
 
+      /*! checks if this is a motion blur node with time range */
+      __forceinline int isNodeMB4D() const { return (ptr & (size_t)align_mask) == tyNodeMB4D; }
+
       /*! checks if this is a node with unaligned bounding boxes */
       __forceinline int isUnalignedNode() const { return (ptr & (size_t)align_mask) == tyUnalignedNode; }
 
       /*! checks if this is a motion blur node with unaligned bounding boxes */
       __forceinline int isUnalignedNodeMB() const { return (ptr & (size_t)align_mask) == tyUnalignedNodeMB; }
 
+      /*! checks if this is a quantized node */
+      __forceinline int isQuantizedNode() const { return (ptr & (size_t)align_mask) == tyQuantizedNode; }
+
       /*! checks if this is a transformation node */
       __forceinline int isTransformNode() const { return (ptr & (size_t)align_mask) == tyTransformNode; }
       __forceinline int isTransformNode(int types) const { return (types == BVH_FLAG_TRANSFORM_NODE) || ((types & BVH_FLAG_TRANSFORM_NODE) && isTransformNode()); }
@@ -267,6 +303,10 @@ namespace embree
       __forceinline       NodeMB* nodeMB()       { assert(isNodeMB()); return (      NodeMB*)(ptr & ~(size_t)align_mask); }
       __forceinline const NodeMB* nodeMB() const { assert(isNodeMB()); return (const NodeMB*)(ptr & ~(size_t)align_mask); }
 
+      /*! returns motion blur node with time range pointer */
+      __forceinline       NodeMB4D* nodeMB4D()       { assert(isNodeMB4D()); return (      NodeMB4D*)(ptr & ~(size_t)align_mask); }
+      __forceinline const NodeMB4D* nodeMB4D() const { assert(isNodeMB4D()); return (const NodeMB4D*)(ptr & ~(size_t)align_mask); }
+
       /*! returns unaligned node pointer */
       __forceinline       UnalignedNode* unalignedNode()       { assert(isUnalignedNode()); return (      UnalignedNode*)(ptr & ~(size_t)align_mask); }
       __forceinline const UnalignedNode* unalignedNode() const { assert(isUnalignedNode()); return (const UnalignedNode*)(ptr & ~(size_t)align_mask); }
@@ -279,6 +319,10 @@ namespace embree
       __forceinline       TransformNode* transformNode()       { assert(isTransformNode()); return (      TransformNode*)(ptr & ~(size_t)align_mask); }
       __forceinline const TransformNode* transformNode() const { assert(isTransformNode()); return (const TransformNode*)(ptr & ~(size_t)align_mask); }
 
+      /*! returns quantized node pointer */
+      __forceinline       QuantizedNode* quantizedNode()       { assert(isQuantizedNode()); return (      QuantizedNode*)(ptr & ~(size_t)align_mask); }
+      __forceinline const QuantizedNode* quantizedNode() const { assert(isQuantizedNode()); return (const QuantizedNode*)(ptr & ~(size_t)align_mask); }
+
       /*! returns leaf pointer */
       __forceinline char* leaf(size_t& num) const {
         assert(isLeaf());
@@ -459,6 +503,24 @@ namespace embree
         }
       }
 
+      /*! Sets bounding boxes of child at begin and end of a time range,
+       *  the linear motion is extrapolated to the full [0,1] time
+       *  interval and conservatively enlarged to cover rounding errors */
+      __forceinline void set(size_t i, const BBox3fa& bounds0, const BBox3fa& bounds1, const BBox1f& time_range)
+      {
+        if (time_range.lower == 0.0f && time_range.upper == 1.0f) { set(i,bounds0,bounds1); return; }
+        if (unlikely(bounds0.empty())) { set(i,bounds0,bounds1); return; }
+
+        const float rdt = 1.0f/time_range.size();
+        const Vec3fa dlower = (bounds1.lower-bounds0.lower)*rdt;
+        const Vec3fa dupper = (bounds1.upper-bounds0.upper)*rdt;
+        const Vec3fa lower0 = bounds0.lower-time_range.lower*dlower;
+        const Vec3fa upper0 = bounds0.upper-time_range.lower*dupper;
+        const Vec3fa mag = max(max(abs(lower0),abs(upper0)),max(abs(lower0+dlower),abs(upper0+dupper)));
+        const Vec3fa eps = 16.0f*float(ulp)*max(mag,max(abs(bounds0.lower),abs(bounds0.upper)));
+        set(i,BBox3fa(lower0-eps,upper0+eps),BBox3fa(lower0+dlower-eps,upper0+dupper+eps));
+      }
+
       /*! tests if the node has valid bounds */
       __forceinline bool hasBounds() const {
         return lower_dx.i[0] != cast_f2i(float(nan));
@@ -537,6 +599,47 @@ namespace embree
       vfloat<N> upper_dz;        //!< Z dimension of upper bounds of all N children.
     };
 
+    /*! Motion blur node whose children are only valid inside a time
+     *  range, used to split the time interval of multi segment motion
+     *  blur into pieces that are bounded by linear motion each */
+    struct NodeMB4D : public NodeMB
+    {
+      using BaseNode::children;
+      using NodeMB::set;
+
+      /*! Clears the node. */
+      __forceinline void clear()  {
+        NodeMB::clear();
+        lower_t = vfloat<N>(pos_inf);
+        upper_t = vfloat<N>(neg_inf);
+      }
+
+      /*! Sets bounding boxes at begin and end of time range and the time range of child. */
+      __forceinline void set(size_t i, const BBox3fa& bounds0, const BBox3fa& bounds1, const BBox1f& time_range)
+      {
+        NodeMB::set(i,bounds0,bounds1,time_range);
+        lower_t[i] = time_range.lower;
+        upper_t[i] = time_range.upper;
+      }
+
+      /*! Returns time range of specified child */
+      __forceinline BBox1f timeRange(size_t i) const {
+        return BBox1f(lower_t[i],upper_t[i]);
+      }
+
+      /*! swap two children of the node */
+      __forceinline void swap(size_t i, size_t j)
+      {
+        NodeMB::swap(i,j);
+        std::swap(lower_t[i],lower_t[j]);
+        std::swap(upper_t[i],upper_t[j]);
+      }
+
+    public:
+      vfloat<N> lower_t;        //!< start of time range of all N children.
+      vfloat<N> upper_t;        //!< end of time range of all N children.
+    };
+
     /*! Node with unaligned bounds */
     struct UnalignedNode : public BaseNode
     {
@@ -661,6 +764,121 @@ namespace embree
       BBox3vfN b1;
     };
 
+    /*! Quantized Node. Stores the bounds of the N children with 8 bit
+     *  precision relative to the bounds of the node, which requires
+     *  about half the memory of a Node. */
+    struct QuantizedNode : public BaseNode
+    {
+      using BaseNode::children;
+
+      /*! Clears the node and sets the bounds all children are quantized relative to. */
+      __forceinline void clear(const BBox3fa& bounds)
+      {
+        /* empty children get inverted bounds that no ray can hit */
+        for (size_t i=0; i<N; i++) {
+          lower_x[i] = lower_y[i] = lower_z[i] = 255;
+          upper_x[i] = upper_y[i] = upper_z[i] = 0;
+        }
+        start = Vec3f(bounds.lower.x,bounds.lower.y,bounds.lower.z);
+        scale = Vec3f(quantizationScale(bounds.lower.x,bounds.upper.x),
+                      quantizationScale(bounds.lower.y,bounds.upper.y),
+                      quantizationScale(bounds.lower.z,bounds.upper.z));
+        BaseNode::clear();
+      }
+
+      /*! Sets ID of child. */
+      __forceinline void set(size_t i, const NodeRef& childID) {
+        assert(i < N);
+        children[i] = childID;
+      }
+
+      /*! Sets bounding box of child, the quantized bounds always enclose the original bounds. */
+      __forceinline void set(size_t i, const BBox3fa& bounds)
+      {
+        assert(i < N);
+        lower_x[i] = quantizeLower(bounds.lower.x,start.x,scale.x); upper_x[i] = quantizeUpper(bounds.upper.x,start.x,scale.x);
+        lower_y[i] = quantizeLower(bounds.lower.y,start.y,scale.y); upper_y[i] = quantizeUpper(bounds.upper.y,start.y,scale.y);
+        lower_z[i] = quantizeLower(bounds.lower.z,start.z,scale.z); upper_z[i] = quantizeUpper(bounds.upper.z,start.z,scale.z);
+      }
+
+      /*! Sets bounding box and ID of child. */
+      __forceinline void set(size_t i, const BBox3fa& bounds, const NodeRef& childID) {
+        set(i,bounds);
+        children[i] = childID;
+      }
+
+      /*! Returns bounds of specified child. */
+      __forceinline BBox3fa bounds(size_t i) const
+      {
+        assert(i < N);
+        const Vec3fa lower(start.x+scale.x*float(lower_x[i]),start.y+scale.y*float(lower_y[i]),start.z+scale.z*float(lower_z[i]));
+        const Vec3fa upper(start.x+scale.x*float(upper_x[i]),start.y+scale.y*float(upper_y[i]),start.z+scale.z*float(upper_z[i]));
+        return BBox3fa(lower,upper);
+      }
+
+      /*! Returns bounds of node. */
+      __forceinline BBox3fa bounds() const 
+      {
+        BBox3fa b = empty;
+        for (size_t i=0; i<N; i++)
+          if (children[i] != emptyNode) b.extend(bounds(i));
+        return b;
+      }
+
+      /*! Returns extent of bounds of specified child. */
+      __forceinline Vec3fa extend(size_t i) const {
+        return bounds(i).size();
+      }
+
+      /*! Returns reference to specified child */
+      __forceinline       NodeRef& child(size_t i)       { assert(i<N); return children[i]; }
+      __forceinline const NodeRef& child(size_t i) const { assert(i<N); return children[i]; }
+
+    private:
+
+      /*! true if the dequantized value is not larger than v, independent of whether the traversal uses FMA instructions */
+      static __forceinline bool dequantizedLE(int q, float start, float scale, float v) {
+        return start+scale*float(q) <= v && float(double(start)+double(scale)*double(q)) <= v;
+      }
+
+      /*! true if the dequantized value is not smaller than v, independent of whether the traversal uses FMA instructions */
+      static __forceinline bool dequantizedGE(int q, float start, float scale, float v) {
+        return start+scale*float(q) >= v && float(double(start)+double(scale)*double(q)) >= v;
+      }
+
+      /*! calculates quantization step such that 255 steps cover [lower,upper] */
+      static __forceinline float quantizationScale(float lower, float upper)
+      {
+        /* degenerated extents still need a positive step to keep empty children unhittable */
+        const float extent = max(upper-lower,4.0f*float(ulp)*max(abs(lower),abs(upper)),1E-18f);
+        float scale = extent/255.0f;
+        while (!dequantizedGE(255,lower,scale,upper)) scale *= 1.0f+2.0f*float(ulp);
+        return scale;
+      }
+
+      static __forceinline unsigned char quantizeLower(float v, float start, float scale) {
+        int q = clamp(int(floorf((v-start)/scale)),0,255);
+        while (q > 0 && !dequantizedLE(q,start,scale,v)) q--;
+        return (unsigned char) q;
+      }
+
+      static __forceinline unsigned char quantizeUpper(float v, float start, float scale) {
+        int q = clamp(int(ceilf((v-start)/scale)),0,255);
+        while (q < 255 && !dequantizedGE(q,start,scale,v)) q++;
+        return (unsigned char) q;
+      }
+
+    public:
+      unsigned char lower_x[N];    //!< X dimension of quantized lower bounds of all N children.
+      unsigned char upper_x[N];    //!< X dimension of quantized upper bounds of all N children.
+      unsigned char lower_y[N];    //!< Y dimension of quantized lower bounds of all N children.
+      unsigned char upper_y[N];    //!< Y dimension of quantized upper bounds of all N children.
+      unsigned char lower_z[N];    //!< Z dimension of quantized lower bounds of all N children.
+      unsigned char upper_z[N];    //!< Z dimension of quantized upper bounds of all N children.
+      Vec3f start;                 //!< lower bounds of the node
+      Vec3f scale;                 //!< size of one quantization step
+    };
+
     struct TransformNode
     {
       __forceinline TransformNode () {}
@@ -749,6 +967,9 @@ namespace embree
     /*! prints statistics about the BVH */
     void printStatistics();
 
+    /*! fills statistics about the BVH into the API structure */
+    size_t statistics(RTCAccelStatistics* stats, size_t maxStats);
+
     /*! Clears the barrier bits of a subtree. */
     void clearBarrier(NodeRef& node);
 
@@ -767,6 +988,14 @@ namespace embree
     /*! called by all builders after build ended */
     void postBuild(double t0);
 
+    /*! called by builders at the end of a build phase, stores the time since the previous phase */
+    __forceinline void endBuildPhase(double& phaseTime) 
+    {
+      const double t1 = getSeconds();
+      phaseTime = t1-buildPhaseStart;
+      buildPhaseStart = t1;
+    }
+
     /*! shrink allocated memory */
     void shrink() {
       alloc.shrink();
@@ -791,6 +1020,12 @@ namespace embree
       return NodeRef((size_t) node | tyNodeMB);
     }
 
+    /*! Encodes a motion blur node with time range */
+    static __forceinline NodeRef encodeNode(NodeMB4D* node) {
+      assert(!((size_t)node & align_mask));
+      return NodeRef((size_t) node | tyNodeMB4D);
+    }
+
     /*! Encodes an unaligned node */
     static __forceinline NodeRef encodeNode(UnalignedNode* node) {
       return NodeRef((size_t) node | tyUnalignedNode);
@@ -801,6 +1036,12 @@ namespace embree
       return NodeRef((size_t) node | tyUnalignedNodeMB);
     }
 
+    /*! Encodes a quantized node */
+    static __forceinline NodeRef encodeNode(QuantizedNode* node) {
+      assert(!((size_t)node & align_mask));
+      return NodeRef((size_t) node | tyQuantizedNode);
+    }
+
     /*! Encodes a transformation node */
     static __forceinline NodeRef encodeNode(TransformNode* node) {
       return NodeRef((size_t) node | tyTransformNode);
@@ -835,6 +1076,23 @@ namespace embree
     size_t numPrimitives;              //!< number of primitives the BVH is build over
     size_t numVertices;                //!< number of vertices the BVH references
 
+    /*! build times of the last build */
+  public:
+    struct BuildTimes
+    {
+      BuildTimes () 
+        : primrefs(0.0), hierarchy(0.0), finalize(0.0), total(0.0) {}
+
+    public:
+      double primrefs;                 //!< creation of primitive references
+      double hierarchy;                //!< construction of the hierarchy
+      double finalize;                 //!< release of temporary data
+      double total;                    //!< total build time
+    };
+    BuildTimes buildTimes;             //!< phases not reported by the builder stay 0
+    double buildStart;                 //!< start time of the last build
+    double buildPhaseStart;            //!< start time of the current build phase
+
     /*! data arrays for special builders */
   public:
     std::vector<BVHN*> objects;
@@ -865,4 +1123,5 @@ namespace embree
 
   typedef BVHN<4> BVH4;
   typedef BVHN<8> BVH8;
+  typedef BVHN<16> BVH16;
 }
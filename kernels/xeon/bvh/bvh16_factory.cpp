@@ -0,0 +1,97 @@
+// ======================================================================== //
+// Copyright 2009-2015 Intel Corporation                                    //
+//                                                                          //
+// Licensed under the Apache License, Version 2.0 (the "License");          //
+// you may not use this file except in compliance with the License.         //
+// You may obtain a copy of the License at                                  //
+//                                                                          //
+//     http://www.apache.org/licenses/LICENSE-2.0                           //
+//                                                                          //
+// Unless required by applicable law or agreed to in writing, software      //
+// distributed under the License is distributed on an "AS IS" BASIS,        //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. //
+// See the License for the specific language governing permissions and      //
+// limitations under the License.                                           //
+// ======================================================================== //
+
+#if defined (__TARGET_AVX512KNL__) || defined (__TARGET_AVX512SKX__)
+
+#include "bvh16_factory.h"
+#include "../bvh/bvh.h"
+
+#include "../geometry/triangle.h"
+#include "../../common/accelinstance.h"
+
+namespace embree
+{
+  DECLARE_SYMBOL2(Accel::Intersector1,BVH16Triangle4Intersector1Moeller);
+  DECLARE_SYMBOL2(Accel::Intersector1,BVH16Triangle4Intersector1MoellerNoFilter);
+
+  DECLARE_SYMBOL2(Accel::Intersector4,BVH16Triangle4Intersector4HybridMoeller);
+  DECLARE_SYMBOL2(Accel::Intersector4,BVH16Triangle4Intersector4HybridMoellerNoFilter);
+
+  DECLARE_SYMBOL2(Accel::Intersector8,BVH16Triangle4Intersector8HybridMoeller);
+  DECLARE_SYMBOL2(Accel::Intersector8,BVH16Triangle4Intersector8HybridMoellerNoFilter);
+
+  DECLARE_SYMBOL2(Accel::Intersector16,BVH16Triangle4Intersector16HybridMoeller);
+  DECLARE_SYMBOL2(Accel::Intersector16,BVH16Triangle4Intersector16HybridMoellerNoFilter);
+
+  DECLARE_BUILDER2(void,Scene,size_t,BVH16Triangle4SceneBuilderSAH);
+
+  BVH16Factory::BVH16Factory (int features)
+  {
+    /* select builders */
+    SELECT_SYMBOL_INIT_AVX512KNL_AVX512SKX(features,BVH16Triangle4SceneBuilderSAH);
+
+    /* select intersectors1 */
+    SELECT_SYMBOL_INIT_AVX512KNL_AVX512SKX(features,BVH16Triangle4Intersector1Moeller);
+    SELECT_SYMBOL_INIT_AVX512KNL_AVX512SKX(features,BVH16Triangle4Intersector1MoellerNoFilter);
+
+#if defined (RTCORE_RAY_PACKETS)
+
+    /* select intersectors4 */
+    SELECT_SYMBOL_INIT_AVX512KNL_AVX512SKX(features,BVH16Triangle4Intersector4HybridMoeller);
+    SELECT_SYMBOL_INIT_AVX512KNL_AVX512SKX(features,BVH16Triangle4Intersector4HybridMoellerNoFilter);
+
+    /* select intersectors8 */
+    SELECT_SYMBOL_INIT_AVX512KNL_AVX512SKX(features,BVH16Triangle4Intersector8HybridMoeller);
+    SELECT_SYMBOL_INIT_AVX512KNL_AVX512SKX(features,BVH16Triangle4Intersector8HybridMoellerNoFilter);
+
+    /* select intersectors16 */
+    SELECT_SYMBOL_INIT_AVX512KNL_AVX512SKX(features,BVH16Triangle4Intersector16HybridMoeller);
+    SELECT_SYMBOL_INIT_AVX512KNL_AVX512SKX(features,BVH16Triangle4Intersector16HybridMoellerNoFilter);
+
+#endif
+  }
+
+  Accel::Intersectors BVH16Factory::BVH16Triangle4Intersectors(BVH16* bvh)
+  {
+    Accel::Intersectors intersectors;
+    intersectors.ptr = bvh;
+    intersectors.intersector1           = BVH16Triangle4Intersector1Moeller;
+    intersectors.intersector1_filter    = BVH16Triangle4Intersector1Moeller;
+    intersectors.intersector1_nofilter  = BVH16Triangle4Intersector1MoellerNoFilter;
+    intersectors.intersector4_filter    = BVH16Triangle4Intersector4HybridMoeller;
+    intersectors.intersector4_nofilter  = BVH16Triangle4Intersector4HybridMoellerNoFilter;
+    intersectors.intersector8_filter    = BVH16Triangle4Intersector8HybridMoeller;
+    intersectors.intersector8_nofilter  = BVH16Triangle4Intersector8HybridMoellerNoFilter;
+    intersectors.intersector16_filter   = BVH16Triangle4Intersector16HybridMoeller;
+    intersectors.intersector16_nofilter = BVH16Triangle4Intersector16HybridMoellerNoFilter;
+    return intersectors;
+  }
+
+  Accel* BVH16Factory::BVH16Triangle4(Scene* scene)
+  {
+    BVH16* accel = new BVH16(Triangle4::type,scene);
+    Accel::Intersectors intersectors= BVH16Triangle4Intersectors(accel);
+
+    Builder* builder = nullptr;
+    if      (scene->device->tri_builder == "default") builder = BVH16Triangle4SceneBuilderSAH(accel,scene,0);
+    else if (scene->device->tri_builder == "sah"    ) builder = BVH16Triangle4SceneBuilderSAH(accel,scene,0);
+    else throw_RTCError(RTC_INVALID_ARGUMENT,"unknown builder "+scene->device->tri_builder+" for BVH16<Triangle4>");
+
+    return new AccelInstance(accel,builder,intersectors);
+  }
+}
+
+#endif
@@ -0,0 +1,53 @@
+// ======================================================================== //
+// Copyright 2009-2015 Intel Corporation                                    //
+//                                                                          //
+// Licensed under the Apache License, Version 2.0 (the "License");          //
+// you may not use this file except in compliance with the License.         //
+// You may obtain a copy of the License at                                  //
+//                                                                          //
+//     http://www.apache.org/licenses/LICENSE-2.0                           //
+//                                                                          //
+// Unless required by applicable law or agreed to in writing, software      //
+// distributed under the License is distributed on an "AS IS" BASIS,        //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. //
+// See the License for the specific language governing permissions and      //
+// limitations under the License.                                           //
+// ======================================================================== //
+
+#pragma once
+
+#include "../bvh/bvh.h"
+#include "../../common/isa.h"
+#include "../../common/accel.h"
+#include "../../common/scene.h"
+
+namespace embree
+{
+  /*! BVH16 instantiations */
+  class BVH16Factory
+  {
+  public:
+    BVH16Factory(int features);
+
+  public:
+    Accel* BVH16Triangle4(Scene* scene);
+
+  private:
+    Accel::Intersectors BVH16Triangle4Intersectors(BVH16* bvh);
+
+  private:
+    DEFINE_SYMBOL2(Accel::Intersector1,BVH16Triangle4Intersector1Moeller);
+    DEFINE_SYMBOL2(Accel::Intersector1,BVH16Triangle4Intersector1MoellerNoFilter);
+
+    DEFINE_SYMBOL2(Accel::Intersector4,BVH16Triangle4Intersector4HybridMoeller);
+    DEFINE_SYMBOL2(Accel::Intersector4,BVH16Triangle4Intersector4HybridMoellerNoFilter);
+
+    DEFINE_SYMBOL2(Accel::Intersector8,BVH16Triangle4Intersector8HybridMoeller);
+    DEFINE_SYMBOL2(Accel::Intersector8,BVH16Triangle4Intersector8HybridMoellerNoFilter);
+
+    DEFINE_SYMBOL2(Accel::Intersector16,BVH16Triangle4Intersector16HybridMoeller);
+    DEFINE_SYMBOL2(Accel::Intersector16,BVH16Triangle4Intersector16HybridMoellerNoFilter);
+
+    DEFINE_BUILDER2(void,Scene,size_t,BVH16Triangle4SceneBuilderSAH);
+  };
+}
@@ -30,6 +30,7 @@
 #include "../geometry/quadi_mb.h"
 #include "../geometry/subdivpatch1cached.h"
 #include "../geometry/object.h"
+#include "../geometry/paged_object.h"
 #include "../../common/accelinstance.h"
 
 namespace embree
@@ -44,8 +45,12 @@ namespace embree
   DECLARE_SYMBOL2(Accel::Intersector1,BVH4Bezier1iIntersector1_OBB);
   DECLARE_SYMBOL2(Accel::Intersector1,BVH4Bezier1iMBIntersector1_OBB);
   DECLARE_SYMBOL2(Accel::Intersector1,BVH4Triangle4Intersector1Moeller);
+  DECLARE_SYMBOL2(Accel::Intersector1,BVH4Triangle4Intersector1MoellerNoFilter);
+  DECLARE_SYMBOL2(Accel::Intersector1,BVH4QuantizedTriangle4Intersector1Moeller);
+  DECLARE_SYMBOL2(Accel::Intersector1,BVH4QuantizedTriangle4Intersector1MoellerNoFilter);
   DECLARE_SYMBOL2(Accel::Intersector1,BVH4XfmTriangle4Intersector1Moeller);
   DECLARE_SYMBOL2(Accel::Intersector1,BVH4Triangle8Intersector1Moeller);
+  DECLARE_SYMBOL2(Accel::Intersector1,BVH4Triangle8Intersector1MoellerNoFilter);
   DECLARE_SYMBOL2(Accel::Intersector1,BVH4Triangle4vIntersector1Pluecker);
   DECLARE_SYMBOL2(Accel::Intersector1,BVH4Triangle4iIntersector1Pluecker);
   DECLARE_SYMBOL2(Accel::Intersector1,BVH4Triangle4vMBIntersector1Moeller);
@@ -53,7 +58,9 @@ namespace embree
   DECLARE_SYMBOL2(Accel::Intersector1,BVH4GridAOSIntersector1);
   DECLARE_SYMBOL2(Accel::Intersector1,BVH4VirtualIntersector1);
   DECLARE_SYMBOL2(Accel::Intersector1,BVH4VirtualMBIntersector1);
+  DECLARE_SYMBOL2(Accel::Intersector1,BVH4PagedObjectIntersector1);
   DECLARE_SYMBOL2(Accel::Intersector1,BVH4Quad4vIntersector1Moeller);
+  DECLARE_SYMBOL2(Accel::Intersector1,BVH4Quad4vIntersector1MoellerNoFilter);
   DECLARE_SYMBOL2(Accel::Intersector1,BVH4Quad4iIntersector1Pluecker);
   DECLARE_SYMBOL2(Accel::Intersector1,BVH4Quad4iMBIntersector1Pluecker);
 
@@ -67,7 +74,9 @@ namespace embree
   DECLARE_SYMBOL2(Accel::Intersector4,BVH4Bezier1iIntersector4Single_OBB);
   DECLARE_SYMBOL2(Accel::Intersector4,BVH4Bezier1iMBIntersector4Single_OBB);
   DECLARE_SYMBOL2(Accel::Intersector4,BVH4Triangle4Intersector4HybridMoeller);
+  DECLARE_SYMBOL2(Accel::Intersector4,BVH4QuantizedTriangle4Intersector4HybridMoeller);
   DECLARE_SYMBOL2(Accel::Intersector4,BVH4Triangle4Intersector4HybridMoellerNoFilter);
+  DECLARE_SYMBOL2(Accel::Intersector4,BVH4QuantizedTriangle4Intersector4HybridMoellerNoFilter);
   DECLARE_SYMBOL2(Accel::Intersector4,BVH4Triangle8Intersector4HybridMoeller);
   DECLARE_SYMBOL2(Accel::Intersector4,BVH4Triangle8Intersector4HybridMoellerNoFilter);
   DECLARE_SYMBOL2(Accel::Intersector4,BVH4Triangle4vIntersector4HybridPluecker);
@@ -81,6 +90,8 @@ namespace embree
   DECLARE_SYMBOL2(Accel::Intersector4,BVH4GridAOSIntersector4);
   DECLARE_SYMBOL2(Accel::Intersector4,BVH4VirtualIntersector4Chunk);
   DECLARE_SYMBOL2(Accel::Intersector4,BVH4VirtualMBIntersector4Chunk);
+  DECLARE_SYMBOL2(Accel::Intersector4,BVH4PagedObjectIntersector4Chunk);
+  DECLARE_SYMBOL2(Accel::Intersector4,BVH4XfmTriangle4Intersector4Moeller);
 
   DECLARE_SYMBOL2(Accel::Intersector8,BVH4Line4iIntersector8);
   DECLARE_SYMBOL2(Accel::Intersector8,BVH4Line4iMBIntersector8);
@@ -92,7 +103,9 @@ namespace embree
   DECLARE_SYMBOL2(Accel::Intersector8,BVH4Bezier1iIntersector8Single_OBB);
   DECLARE_SYMBOL2(Accel::Intersector8,BVH4Bezier1iMBIntersector8Single_OBB);
   DECLARE_SYMBOL2(Accel::Intersector8,BVH4Triangle4Intersector8HybridMoeller);
+  DECLARE_SYMBOL2(Accel::Intersector8,BVH4QuantizedTriangle4Intersector8HybridMoeller);
   DECLARE_SYMBOL2(Accel::Intersector8,BVH4Triangle4Intersector8HybridMoellerNoFilter);
+  DECLARE_SYMBOL2(Accel::Intersector8,BVH4QuantizedTriangle4Intersector8HybridMoellerNoFilter);
   DECLARE_SYMBOL2(Accel::Intersector8,BVH4Triangle8Intersector8HybridMoeller);
   DECLARE_SYMBOL2(Accel::Intersector8,BVH4Triangle8Intersector8HybridMoellerNoFilter);
   DECLARE_SYMBOL2(Accel::Intersector8,BVH4Triangle4vIntersector8HybridPluecker);
@@ -106,6 +119,8 @@ namespace embree
   DECLARE_SYMBOL2(Accel::Intersector8,BVH4GridAOSIntersector8);
   DECLARE_SYMBOL2(Accel::Intersector8,BVH4VirtualIntersector8Chunk);
   DECLARE_SYMBOL2(Accel::Intersector8,BVH4VirtualMBIntersector8Chunk);
+  DECLARE_SYMBOL2(Accel::Intersector8,BVH4PagedObjectIntersector8Chunk);
+  DECLARE_SYMBOL2(Accel::Intersector8,BVH4XfmTriangle4Intersector8Moeller);
 
   DECLARE_SYMBOL2(Accel::Intersector16,BVH4Line4iIntersector16);
   DECLARE_SYMBOL2(Accel::Intersector16,BVH4Line4iMBIntersector16);
@@ -117,7 +132,9 @@ namespace embree
   DECLARE_SYMBOL2(Accel::Intersector16,BVH4Bezier1iIntersector16Single_OBB);
   DECLARE_SYMBOL2(Accel::Intersector16,BVH4Bezier1iMBIntersector16Single_OBB);
   DECLARE_SYMBOL2(Accel::Intersector16,BVH4Triangle4Intersector16HybridMoeller);
+  DECLARE_SYMBOL2(Accel::Intersector16,BVH4QuantizedTriangle4Intersector16HybridMoeller);
   DECLARE_SYMBOL2(Accel::Intersector16,BVH4Triangle4Intersector16HybridMoellerNoFilter);
+  DECLARE_SYMBOL2(Accel::Intersector16,BVH4QuantizedTriangle4Intersector16HybridMoellerNoFilter);
   DECLARE_SYMBOL2(Accel::Intersector16,BVH4Triangle8Intersector16HybridMoeller);
   DECLARE_SYMBOL2(Accel::Intersector16,BVH4Triangle8Intersector16HybridMoellerNoFilter);
   DECLARE_SYMBOL2(Accel::Intersector16,BVH4Triangle4vIntersector16HybridPluecker);
@@ -131,11 +148,25 @@ namespace embree
   DECLARE_SYMBOL2(Accel::Intersector16,BVH4GridAOSIntersector16);
   DECLARE_SYMBOL2(Accel::Intersector16,BVH4VirtualIntersector16Chunk);
   DECLARE_SYMBOL2(Accel::Intersector16,BVH4VirtualMBIntersector16Chunk);
+  DECLARE_SYMBOL2(Accel::Intersector16,BVH4PagedObjectIntersector16Chunk);
+  DECLARE_SYMBOL2(Accel::Intersector16,BVH4XfmTriangle4Intersector16Moeller);
+
+  DECLARE_SYMBOL2(Accel::PointQueryFunc,BVH4Triangle4PointQuery);
+  DECLARE_SYMBOL2(Accel::PointQueryFunc,BVH4QuantizedTriangle4PointQuery);
+  DECLARE_SYMBOL2(Accel::PointQueryFunc,BVH4Triangle4vPointQuery);
+  DECLARE_SYMBOL2(Accel::PointQueryFunc,BVH4Triangle4iPointQuery);
+  DECLARE_SYMBOL2(Accel::PointQueryFunc,BVH4Triangle8PointQuery);
+  DECLARE_SYMBOL2(Accel::PointQueryFunc,BVH4Quad4vPointQuery);
+  DECLARE_SYMBOL2(Accel::PointQueryFunc,BVH4Quad4iPointQuery);
+  DECLARE_SYMBOL2(Accel::PointQueryFunc,BVH4Line4iPointQuery);
+  DECLARE_SYMBOL2(Accel::PointQueryFunc,BVH4Point4iPointQuery);
 
   DECLARE_BUILDER2(void,Scene,const createLineSegmentsAccelTy,BVH4BuilderTwoLevelLineSegmentsSAH);
   DECLARE_BUILDER2(void,Scene,const createPointsAccelTy,BVH4BuilderTwoLevelPointsSAH);
   DECLARE_BUILDER2(void,Scene,const createTriangleMeshAccelTy,BVH4BuilderTwoLevelTriangleMeshSAH);
   DECLARE_BUILDER2(void,Scene,const createTriangleMeshAccelTy,BVH4BuilderInstancingTriangleMeshSAH);
+  DECLARE_BUILDER2(void,Scene,const createTriangleMeshAccelTy,BVH4BuilderOutOfCoreTriangleMeshSAH);
+  DECLARE_BUILDER2(void,Scene,Builder*,BVH4CacheBuilder);
 
   DECLARE_BUILDER2(void,Scene,size_t,BVH4Bezier1vBuilder_OBB_New);
   DECLARE_BUILDER2(void,Scene,size_t,BVH4Bezier1iBuilder_OBB_New);
@@ -198,6 +229,7 @@ namespace embree
     SELECT_SYMBOL_DEFAULT_AVX(features,BVH4BuilderTwoLevelPointsSAH);
     SELECT_SYMBOL_DEFAULT_AVX(features,BVH4BuilderTwoLevelTriangleMeshSAH);
     SELECT_SYMBOL_DEFAULT_AVX(features,BVH4BuilderInstancingTriangleMeshSAH);
+    SELECT_SYMBOL_DEFAULT_AVX(features,BVH4BuilderOutOfCoreTriangleMeshSAH);
 
     SELECT_SYMBOL_DEFAULT_AVX(features,BVH4Bezier1vBuilder_OBB_New);
     SELECT_SYMBOL_DEFAULT_AVX(features,BVH4Bezier1iBuilder_OBB_New);
@@ -234,6 +266,7 @@ namespace embree
     SELECT_SYMBOL_DEFAULT_AVX(features,BVH4Bezier1iSceneBuilderSAH);
     SELECT_SYMBOL_DEFAULT_AVX(features,BVH4VirtualSceneBuilderSAH);
     SELECT_SYMBOL_DEFAULT_AVX(features,BVH4VirtualMBSceneBuilderSAH);
+    SELECT_SYMBOL_DEFAULT_AVX(features,BVH4CacheBuilder);
 
     SELECT_SYMBOL_DEFAULT_AVX_AVX512KNL(features,BVH4SubdivPatch1CachedBuilderBinnedSAH);
     SELECT_SYMBOL_DEFAULT_AVX(features,BVH4SubdivGridEagerBuilderBinnedSAH);
@@ -261,8 +294,12 @@ namespace embree
     SELECT_SYMBOL_DEFAULT_AVX_AVX2      (features,BVH4Bezier1iIntersector1_OBB);
     SELECT_SYMBOL_DEFAULT_AVX_AVX2      (features,BVH4Bezier1iMBIntersector1_OBB);
     SELECT_SYMBOL_DEFAULT_AVX_AVX2_AVX512KNL(features,BVH4Triangle4Intersector1Moeller);
+    SELECT_SYMBOL_DEFAULT_AVX_AVX2_AVX512KNL(features,BVH4Triangle4Intersector1MoellerNoFilter);
+    SELECT_SYMBOL_DEFAULT_AVX_AVX2_AVX512KNL(features,BVH4QuantizedTriangle4Intersector1Moeller);
+    SELECT_SYMBOL_DEFAULT_AVX_AVX2_AVX512KNL(features,BVH4QuantizedTriangle4Intersector1MoellerNoFilter);
     SELECT_SYMBOL_DEFAULT_AVX_AVX2_AVX512KNL(features,BVH4XfmTriangle4Intersector1Moeller);
     SELECT_SYMBOL_INIT_AVX_AVX2         (features,BVH4Triangle8Intersector1Moeller);
+    SELECT_SYMBOL_INIT_AVX_AVX2         (features,BVH4Triangle8Intersector1MoellerNoFilter);
     SELECT_SYMBOL_DEFAULT_SSE42_AVX     (features,BVH4Triangle4vIntersector1Pluecker);
     SELECT_SYMBOL_DEFAULT_SSE42_AVX     (features,BVH4Triangle4iIntersector1Pluecker);
     SELECT_SYMBOL_DEFAULT_SSE42_AVX_AVX2(features,BVH4Triangle4vMBIntersector1Moeller);
@@ -270,7 +307,9 @@ namespace embree
     SELECT_SYMBOL_DEFAULT_SSE42_AVX_AVX2(features,BVH4GridAOSIntersector1);
     SELECT_SYMBOL_DEFAULT_SSE42_AVX_AVX2(features,BVH4VirtualIntersector1);
     SELECT_SYMBOL_DEFAULT_SSE42_AVX_AVX2(features,BVH4VirtualMBIntersector1);
+    SELECT_SYMBOL_DEFAULT_SSE42_AVX_AVX2(features,BVH4PagedObjectIntersector1);
     SELECT_SYMBOL_DEFAULT_SSE42_AVX_AVX2(features,BVH4Quad4vIntersector1Moeller);
+    SELECT_SYMBOL_DEFAULT_SSE42_AVX_AVX2(features,BVH4Quad4vIntersector1MoellerNoFilter);
     SELECT_SYMBOL_DEFAULT_SSE42_AVX_AVX2(features,BVH4Quad4iIntersector1Pluecker);
     SELECT_SYMBOL_DEFAULT_SSE42_AVX_AVX2(features,BVH4Quad4iMBIntersector1Pluecker);
 
@@ -287,7 +326,9 @@ namespace embree
     SELECT_SYMBOL_DEFAULT_AVX_AVX2(features,BVH4Bezier1iIntersector4Single_OBB);
     SELECT_SYMBOL_DEFAULT_AVX_AVX2(features,BVH4Bezier1iMBIntersector4Single_OBB);
     SELECT_SYMBOL_DEFAULT_SSE42_AVX_AVX2(features,BVH4Triangle4Intersector4HybridMoeller);
+    SELECT_SYMBOL_DEFAULT_SSE42_AVX_AVX2(features,BVH4QuantizedTriangle4Intersector4HybridMoeller);
     SELECT_SYMBOL_DEFAULT_SSE42_AVX_AVX2(features,BVH4Triangle4Intersector4HybridMoellerNoFilter);
+    SELECT_SYMBOL_DEFAULT_SSE42_AVX_AVX2(features,BVH4QuantizedTriangle4Intersector4HybridMoellerNoFilter);
     SELECT_SYMBOL_INIT_AVX_AVX2(features,BVH4Triangle8Intersector4HybridMoeller);
     SELECT_SYMBOL_INIT_AVX_AVX2(features,BVH4Triangle8Intersector4HybridMoellerNoFilter);
     SELECT_SYMBOL_DEFAULT_SSE42_AVX(features,BVH4Triangle4vIntersector4HybridPluecker);
@@ -301,6 +342,8 @@ namespace embree
     SELECT_SYMBOL_DEFAULT_AVX_AVX2      (features,BVH4GridAOSIntersector4);
     SELECT_SYMBOL_DEFAULT_SSE42_AVX_AVX2(features,BVH4VirtualIntersector4Chunk);
     SELECT_SYMBOL_DEFAULT_SSE42_AVX_AVX2(features,BVH4VirtualMBIntersector4Chunk);
+    SELECT_SYMBOL_DEFAULT_SSE42_AVX_AVX2(features,BVH4PagedObjectIntersector4Chunk);
+    SELECT_SYMBOL_DEFAULT_AVX_AVX2(features,BVH4XfmTriangle4Intersector4Moeller);
     SELECT_SYMBOL_DEFAULT_SSE42_AVX_AVX2(features,BVH4Quad4vIntersector4HybridMoeller);
 
     /* select intersectors8 */
@@ -314,7 +357,9 @@ namespace embree
     SELECT_SYMBOL_INIT_AVX_AVX2(features,BVH4Bezier1iIntersector8Single_OBB);
     SELECT_SYMBOL_INIT_AVX_AVX2(features,BVH4Bezier1iMBIntersector8Single_OBB);
     SELECT_SYMBOL_INIT_AVX_AVX2(features,BVH4Triangle4Intersector8HybridMoeller);
+    SELECT_SYMBOL_INIT_AVX_AVX2(features,BVH4QuantizedTriangle4Intersector8HybridMoeller);
     SELECT_SYMBOL_INIT_AVX_AVX2(features,BVH4Triangle4Intersector8HybridMoellerNoFilter);
+    SELECT_SYMBOL_INIT_AVX_AVX2(features,BVH4QuantizedTriangle4Intersector8HybridMoellerNoFilter);
     SELECT_SYMBOL_INIT_AVX_AVX2(features,BVH4Triangle8Intersector8HybridMoeller);
     SELECT_SYMBOL_INIT_AVX_AVX2(features,BVH4Triangle8Intersector8HybridMoellerNoFilter);
     SELECT_SYMBOL_INIT_AVX     (features,BVH4Triangle4vIntersector8HybridPluecker);
@@ -328,6 +373,8 @@ namespace embree
     SELECT_SYMBOL_INIT_AVX_AVX2(features,BVH4GridAOSIntersector8);
     SELECT_SYMBOL_INIT_AVX_AVX2(features,BVH4VirtualIntersector8Chunk);
     SELECT_SYMBOL_INIT_AVX_AVX2(features,BVH4VirtualMBIntersector8Chunk);
+    SELECT_SYMBOL_INIT_AVX_AVX2(features,BVH4PagedObjectIntersector8Chunk);
+    SELECT_SYMBOL_INIT_AVX_AVX2(features,BVH4XfmTriangle4Intersector8Moeller);
 
     /* select intersectors16 */
     SELECT_SYMBOL_INIT_AVX512KNL(features,BVH4Line4iIntersector16);
@@ -340,7 +387,9 @@ namespace embree
     SELECT_SYMBOL_INIT_AVX512KNL(features,BVH4Bezier1iIntersector16Single_OBB);
     SELECT_SYMBOL_INIT_AVX512KNL(features,BVH4Bezier1iMBIntersector16Single_OBB);
     SELECT_SYMBOL_INIT_AVX512KNL(features,BVH4Triangle4Intersector16HybridMoeller);
+    SELECT_SYMBOL_INIT_AVX512KNL(features,BVH4QuantizedTriangle4Intersector16HybridMoeller);
     SELECT_SYMBOL_INIT_AVX512KNL(features,BVH4Triangle4Intersector16HybridMoellerNoFilter);
+    SELECT_SYMBOL_INIT_AVX512KNL(features,BVH4QuantizedTriangle4Intersector16HybridMoellerNoFilter);
     SELECT_SYMBOL_INIT_AVX512KNL(features,BVH4Triangle8Intersector16HybridMoeller);
     SELECT_SYMBOL_INIT_AVX512KNL(features,BVH4Triangle8Intersector16HybridMoellerNoFilter);
     SELECT_SYMBOL_INIT_AVX512KNL(features,BVH4Triangle4vIntersector16HybridPluecker);
@@ -354,8 +403,21 @@ namespace embree
     SELECT_SYMBOL_INIT_AVX512KNL(features,BVH4GridAOSIntersector16);
     SELECT_SYMBOL_INIT_AVX512KNL(features,BVH4VirtualIntersector16Chunk);
     SELECT_SYMBOL_INIT_AVX512KNL(features,BVH4VirtualMBIntersector16Chunk);
+    SELECT_SYMBOL_INIT_AVX512KNL(features,BVH4PagedObjectIntersector16Chunk);
+    SELECT_SYMBOL_INIT_AVX512KNL(features,BVH4XfmTriangle4Intersector16Moeller);
 
 #endif
+
+    /* select point queries */
+    SELECT_SYMBOL_DEFAULT_AVX(features,BVH4Triangle4PointQuery);
+    SELECT_SYMBOL_DEFAULT_AVX(features,BVH4QuantizedTriangle4PointQuery);
+    SELECT_SYMBOL_DEFAULT_AVX(features,BVH4Triangle4vPointQuery);
+    SELECT_SYMBOL_DEFAULT_AVX(features,BVH4Triangle4iPointQuery);
+    SELECT_SYMBOL_INIT_AVX   (features,BVH4Triangle8PointQuery);
+    SELECT_SYMBOL_DEFAULT_AVX(features,BVH4Quad4vPointQuery);
+    SELECT_SYMBOL_DEFAULT_AVX(features,BVH4Quad4iPointQuery);
+    SELECT_SYMBOL_DEFAULT_AVX(features,BVH4Line4iPointQuery);
+    SELECT_SYMBOL_DEFAULT_AVX(features,BVH4Point4iPointQuery);
   }
 
   Accel::Intersectors BVH4Factory::BVH4Bezier1vIntersectors(BVH4* bvh)
@@ -388,6 +450,7 @@ namespace embree
     intersectors.intersector4  = BVH4Line4iIntersector4;
     intersectors.intersector8  = BVH4Line4iIntersector8;
     intersectors.intersector16 = BVH4Line4iIntersector16;
+    intersectors.pointQuery    = BVH4Line4iPointQuery;
     return intersectors;
   }
 
@@ -410,6 +473,7 @@ namespace embree
     intersectors.intersector4  = BVH4Point4iIntersector4;
     intersectors.intersector8  = BVH4Point4iIntersector8;
     intersectors.intersector16 = BVH4Point4iIntersector16;
+    intersectors.pointQuery    = BVH4Point4iPointQuery;
     return intersectors;
   }
 
@@ -462,12 +526,32 @@ namespace embree
     Accel::Intersectors intersectors;
     intersectors.ptr = bvh;
     intersectors.intersector1           = BVH4Triangle4Intersector1Moeller;
+    intersectors.intersector1_filter    = BVH4Triangle4Intersector1Moeller;
+    intersectors.intersector1_nofilter  = BVH4Triangle4Intersector1MoellerNoFilter;
     intersectors.intersector4_filter    = BVH4Triangle4Intersector4HybridMoeller;
     intersectors.intersector4_nofilter  = BVH4Triangle4Intersector4HybridMoellerNoFilter;
     intersectors.intersector8_filter    = BVH4Triangle4Intersector8HybridMoeller;
     intersectors.intersector8_nofilter  = BVH4Triangle4Intersector8HybridMoellerNoFilter;
     intersectors.intersector16_filter   = BVH4Triangle4Intersector16HybridMoeller;
     intersectors.intersector16_nofilter = BVH4Triangle4Intersector16HybridMoellerNoFilter;
+    intersectors.pointQuery             = BVH4Triangle4PointQuery;
+    return intersectors;
+  }
+
+  Accel::Intersectors BVH4Factory::BVH4QuantizedTriangle4Intersectors(BVH4* bvh)
+  {
+    Accel::Intersectors intersectors;
+    intersectors.ptr = bvh;
+    intersectors.intersector1           = BVH4QuantizedTriangle4Intersector1Moeller;
+    intersectors.intersector1_filter    = BVH4QuantizedTriangle4Intersector1Moeller;
+    intersectors.intersector1_nofilter  = BVH4QuantizedTriangle4Intersector1MoellerNoFilter;
+    intersectors.intersector4_filter    = BVH4QuantizedTriangle4Intersector4HybridMoeller;
+    intersectors.intersector4_nofilter  = BVH4QuantizedTriangle4Intersector4HybridMoellerNoFilter;
+    intersectors.intersector8_filter    = BVH4QuantizedTriangle4Intersector8HybridMoeller;
+    intersectors.intersector8_nofilter  = BVH4QuantizedTriangle4Intersector8HybridMoellerNoFilter;
+    intersectors.intersector16_filter   = BVH4QuantizedTriangle4Intersector16HybridMoeller;
+    intersectors.intersector16_nofilter = BVH4QuantizedTriangle4Intersector16HybridMoellerNoFilter;
+    intersectors.pointQuery             = BVH4QuantizedTriangle4PointQuery;
     return intersectors;
   }
 
@@ -475,7 +559,10 @@ namespace embree
   {
     Accel::Intersectors intersectors;
     intersectors.ptr = bvh;
-    intersectors.intersector1 = BVH4XfmTriangle4Intersector1Moeller;
+    intersectors.intersector1  = BVH4XfmTriangle4Intersector1Moeller;
+    intersectors.intersector4  = BVH4XfmTriangle4Intersector4Moeller;
+    intersectors.intersector8  = BVH4XfmTriangle4Intersector8Moeller;
+    intersectors.intersector16 = BVH4XfmTriangle4Intersector16Moeller;
     return intersectors;
   }
 
@@ -484,12 +571,15 @@ namespace embree
     Accel::Intersectors intersectors;
     intersectors.ptr = bvh;
     intersectors.intersector1           = BVH4Triangle8Intersector1Moeller;
+    intersectors.intersector1_filter    = BVH4Triangle8Intersector1Moeller;
+    intersectors.intersector1_nofilter  = BVH4Triangle8Intersector1MoellerNoFilter;
     intersectors.intersector4_filter    = BVH4Triangle8Intersector4HybridMoeller;
     intersectors.intersector4_nofilter  = BVH4Triangle8Intersector4HybridMoellerNoFilter;
     intersectors.intersector8_filter    = BVH4Triangle8Intersector8HybridMoeller;
     intersectors.intersector8_nofilter  = BVH4Triangle8Intersector8HybridMoellerNoFilter;
     intersectors.intersector16_filter   = BVH4Triangle8Intersector16HybridMoeller;
     intersectors.intersector16_nofilter = BVH4Triangle8Intersector16HybridMoellerNoFilter;
+    intersectors.pointQuery             = BVH4Triangle8PointQuery;
     return intersectors;
   }
 
@@ -501,6 +591,7 @@ namespace embree
     intersectors.intersector4  = BVH4Triangle4vIntersector4HybridPluecker;
     intersectors.intersector8  = BVH4Triangle4vIntersector8HybridPluecker;
     intersectors.intersector16 = BVH4Triangle4vIntersector16HybridPluecker;
+    intersectors.pointQuery    = BVH4Triangle4vPointQuery;
     return intersectors;
   }
 
@@ -512,6 +603,7 @@ namespace embree
     intersectors.intersector4  = BVH4Triangle4iIntersector4HybridPluecker;
     intersectors.intersector8  = BVH4Triangle4iIntersector8HybridPluecker;
     intersectors.intersector16 = BVH4Triangle4iIntersector16HybridPluecker;
+    intersectors.pointQuery    = BVH4Triangle4iPointQuery;
     return intersectors;
   }
 
@@ -531,12 +623,15 @@ namespace embree
     Accel::Intersectors intersectors;
     intersectors.ptr = bvh;
     intersectors.intersector1           = BVH4Quad4vIntersector1Moeller;
+    intersectors.intersector1_filter    = BVH4Quad4vIntersector1Moeller;
+    intersectors.intersector1_nofilter  = BVH4Quad4vIntersector1MoellerNoFilter;
     intersectors.intersector4_filter    = BVH4Quad4vIntersector4HybridMoeller;
     intersectors.intersector4_nofilter  = BVH4Quad4vIntersector4HybridMoellerNoFilter;
     intersectors.intersector8_filter    = BVH4Quad4vIntersector8HybridMoeller;
     intersectors.intersector8_nofilter  = BVH4Quad4vIntersector8HybridMoellerNoFilter;
     intersectors.intersector16_filter   = BVH4Quad4vIntersector16HybridMoeller;
     intersectors.intersector16_nofilter = BVH4Quad4vIntersector16HybridMoellerNoFilter;
+    intersectors.pointQuery             = BVH4Quad4vPointQuery;
     return intersectors;
   }
 
@@ -548,6 +643,7 @@ namespace embree
     intersectors.intersector4 = BVH4Quad4iIntersector4HybridPluecker;
     intersectors.intersector8 = BVH4Quad4iIntersector8HybridPluecker;
     intersectors.intersector16= BVH4Quad4iIntersector16HybridPluecker;
+    intersectors.pointQuery   = BVH4Quad4iPointQuery;
     return intersectors;
   }
 
@@ -616,6 +712,42 @@ namespace embree
     builder = mesh->parent->device->bvh4_factory->BVH4Triangle4iMeshBuilderMortonGeneral(accel,mesh,0); 
   }
 
+  void BVH4Factory::createTriangleMeshTriangle4MortonOptimized(TriangleMesh* mesh, AccelData*& accel, Builder*& builder)
+  {
+    accel = new BVH4(Triangle4::type,mesh->parent);
+    builder = mesh->parent->device->bvh4_factory->BVH4Triangle4MeshBuilderMortonGeneral(accel,mesh,MODE_TREELET_OPTIMIZE);
+  }
+
+#if defined (__TARGET_AVX__)
+  void BVH4Factory::createTriangleMeshTriangle8MortonOptimized(TriangleMesh* mesh, AccelData*& accel, Builder*& builder)
+  {
+    accel = new BVH4(Triangle8::type,mesh->parent);
+    builder = mesh->parent->device->bvh4_factory->BVH4Triangle8MeshBuilderMortonGeneral(accel,mesh,MODE_TREELET_OPTIMIZE);
+  }
+#endif
+
+  void BVH4Factory::createTriangleMeshTriangle4vMortonOptimized(TriangleMesh* mesh, AccelData*& accel, Builder*& builder)
+  {
+    accel = new BVH4(Triangle4v::type,mesh->parent);
+    builder = mesh->parent->device->bvh4_factory->BVH4Triangle4vMeshBuilderMortonGeneral(accel,mesh,MODE_TREELET_OPTIMIZE);
+  }
+
+  void BVH4Factory::createTriangleMeshTriangle4iMortonOptimized(TriangleMesh* mesh, AccelData*& accel, Builder*& builder)
+  {
+    accel = new BVH4(Triangle4i::type,mesh->parent);
+    builder = mesh->parent->device->bvh4_factory->BVH4Triangle4iMeshBuilderMortonGeneral(accel,mesh,MODE_TREELET_OPTIMIZE);
+  }
+
+  void BVH4Factory::createTriangleMeshTriangle4Paged(TriangleMesh* mesh, AccelData*& accel, Builder*& builder)
+  {
+    /* paged BVHs get rebuild from scratch, thus refitting is not supported */
+    BVH4Factory* factory = mesh->parent->device->bvh4_factory;
+    BVH4* bvh = new BVH4(Triangle4::type,mesh->parent);
+    Accel::Intersectors intersectors = factory->BVH4Triangle4IntersectorsHybrid(bvh);
+    accel = new AccelInstance(bvh,factory->BVH4Triangle4MeshBuilderSAH(bvh,mesh,0),intersectors);
+    builder = nullptr;
+  }
+
   void BVH4Factory::createTriangleMeshTriangle4(TriangleMesh* mesh, AccelData*& accel, Builder*& builder)
   {
     BVH4Factory* factory = mesh->parent->device->bvh4_factory;
@@ -670,7 +802,7 @@ namespace embree
   {
     BVH4* accel = new BVH4(Bezier1v::type,scene);
     Accel::Intersectors intersectors = BVH4Bezier1vIntersectors(accel);
-    Builder* builder = BVH4Bezier1vSceneBuilderSAH(accel,scene,0);
+    Builder* builder = BVH4CacheBuilder(accel,scene,BVH4Bezier1vSceneBuilderSAH(accel,scene,0));
     return new AccelInstance(accel,builder,intersectors);
   }
 
@@ -678,7 +810,7 @@ namespace embree
   {
     BVH4* accel = new BVH4(Bezier1i::type,scene);
     Accel::Intersectors intersectors = BVH4Bezier1iIntersectors(accel);
-    Builder* builder = BVH4Bezier1iSceneBuilderSAH(accel,scene,0);
+    Builder* builder = BVH4CacheBuilder(accel,scene,BVH4Bezier1iSceneBuilderSAH(accel,scene,0));
     scene->needBezierVertices = true;
     return new AccelInstance(accel,builder,intersectors);
   }
@@ -689,8 +821,8 @@ namespace embree
     Accel::Intersectors intersectors = BVH4Line4iIntersectors(accel);
 
     Builder* builder = nullptr;
-    if      (scene->device->line_builder == "default"     ) builder = BVH4Line4iSceneBuilderSAH(accel,scene,0);
-    else if (scene->device->line_builder == "sah"         ) builder = BVH4Line4iSceneBuilderSAH(accel,scene,0);
+    if      (scene->device->line_builder == "default"     ) builder = BVH4CacheBuilder(accel,scene,BVH4Line4iSceneBuilderSAH(accel,scene,0));
+    else if (scene->device->line_builder == "sah"         ) builder = BVH4CacheBuilder(accel,scene,BVH4Line4iSceneBuilderSAH(accel,scene,0));
     else if (scene->device->line_builder == "dynamic"     ) builder = BVH4BuilderTwoLevelLineSegmentsSAH(accel,scene,&createLineSegmentsLine4i);
     else throw_RTCError(RTC_INVALID_ARGUMENT,"unknown builder "+scene->device->line_builder+" for BVH4<Line4i>");
 
@@ -702,7 +834,7 @@ namespace embree
   {
     BVH4* accel = new BVH4(Line4i::type,scene);
     Accel::Intersectors intersectors = BVH4Line4iMBIntersectors(accel);
-    Builder* builder = BVH4Line4iMBSceneBuilderSAH(accel,scene,0);
+    Builder* builder = BVH4CacheBuilder(accel,scene,BVH4Line4iMBSceneBuilderSAH(accel,scene,0));
     scene->needLineVertices = true;
     return new AccelInstance(accel,builder,intersectors);
   }
@@ -721,10 +853,10 @@ namespace embree
     Accel::Intersectors intersectors = BVH4Point4iIntersectors(accel);
 
     Builder* builder = nullptr;
-    if      (scene->device->line_builder == "default"     ) builder = BVH4Point4iSceneBuilderSAH(accel,scene,0);
-    else if (scene->device->line_builder == "sah"         ) builder = BVH4Point4iSceneBuilderSAH(accel,scene,0);
-    else if (scene->device->line_builder == "dynamic"     ) builder = BVH4BuilderTwoLevelPointsSAH(accel,scene,&createPointsPoint4i);
-    else throw_RTCError(RTC_INVALID_ARGUMENT,"unknown builder "+scene->device->line_builder+" for BVH4<Point4i>");
+    if      (scene->device->point_builder == "default"    ) builder = BVH4CacheBuilder(accel,scene,BVH4Point4iSceneBuilderSAH(accel,scene,0));
+    else if (scene->device->point_builder == "sah"        ) builder = BVH4CacheBuilder(accel,scene,BVH4Point4iSceneBuilderSAH(accel,scene,0));
+    else if (scene->device->point_builder == "dynamic"    ) builder = BVH4BuilderTwoLevelPointsSAH(accel,scene,&createPointsPoint4i);
+    else throw_RTCError(RTC_INVALID_ARGUMENT,"unknown builder "+scene->device->point_builder+" for BVH4<Point4i>");
 
     scene->needPointVertices = true;
     return new AccelInstance(accel,builder,intersectors);
@@ -734,7 +866,7 @@ namespace embree
   {
     BVH4* accel = new BVH4(Point4i::type,scene);
     Accel::Intersectors intersectors = BVH4Point4iMBIntersectors(accel);
-    Builder* builder = BVH4Point4iMBSceneBuilderSAH(accel,scene,0);
+    Builder* builder = BVH4CacheBuilder(accel,scene,BVH4Point4iMBSceneBuilderSAH(accel,scene,0));
     scene->needPointVertices = true;
     return new AccelInstance(accel,builder,intersectors);
   }
@@ -751,7 +883,7 @@ namespace embree
   {
     BVH4* accel = new BVH4(Bezier1v::type,scene);
     Accel::Intersectors intersectors = BVH4Bezier1vIntersectors_OBB(accel);
-    Builder* builder = BVH4Bezier1vBuilder_OBB_New(accel,scene,0);
+    Builder* builder = BVH4CacheBuilder(accel,scene,BVH4Bezier1vBuilder_OBB_New(accel,scene,0));
     return new AccelInstance(accel,builder,intersectors);
   }
 
@@ -759,7 +891,7 @@ namespace embree
   {
     BVH4* accel = new BVH4(Bezier1i::type,scene);
     Accel::Intersectors intersectors = BVH4Bezier1iIntersectors_OBB(accel);
-    Builder* builder = BVH4Bezier1iBuilder_OBB_New(accel,scene,0);
+    Builder* builder = BVH4CacheBuilder(accel,scene,BVH4Bezier1iBuilder_OBB_New(accel,scene,0));
     scene->needBezierVertices = true;
     return new AccelInstance(accel,builder,intersectors);
   }
@@ -768,7 +900,7 @@ namespace embree
   {
     BVH4* accel = new BVH4(Bezier1i::type,scene);
     Accel::Intersectors intersectors = BVH4Bezier1iMBIntersectors_OBB(accel);
-    Builder* builder = BVH4Bezier1iMBBuilder_OBB_New(accel,scene,0);
+    Builder* builder = BVH4CacheBuilder(accel,scene,BVH4Bezier1iMBBuilder_OBB_New(accel,scene,0));
     scene->needBezierVertices = true;
     return new AccelInstance(accel,builder,intersectors);
   }
@@ -783,17 +915,32 @@ namespace embree
     else throw_RTCError(RTC_INVALID_ARGUMENT,"unknown traverser "+scene->device->tri_traverser+" for BVH4<Triangle4>");
 
     Builder* builder = nullptr;
-    if      (scene->device->tri_builder == "default"     ) builder = BVH4Triangle4SceneBuilderSAH(accel,scene,0);
-    else if (scene->device->tri_builder == "sah"         ) builder = BVH4Triangle4SceneBuilderSAH(accel,scene,0);
-    else if (scene->device->tri_builder == "sah_spatial" ) builder = BVH4Triangle4SceneBuilderSpatialSAH(accel,scene,0);
-    else if (scene->device->tri_builder == "sah_presplit") builder = BVH4Triangle4SceneBuilderSAH(accel,scene,MODE_HIGH_QUALITY);
+    if      (scene->device->tri_builder == "default"     ) builder = BVH4CacheBuilder(accel,scene,BVH4Triangle4SceneBuilderSAH(accel,scene,0));
+    else if (scene->device->tri_builder == "sah"         ) builder = BVH4CacheBuilder(accel,scene,BVH4Triangle4SceneBuilderSAH(accel,scene,0));
+    else if (scene->device->tri_builder == "sah_spatial" ) builder = BVH4CacheBuilder(accel,scene,BVH4Triangle4SceneBuilderSpatialSAH(accel,scene,0));
+    else if (scene->device->tri_builder == "sah_presplit") builder = BVH4CacheBuilder(accel,scene,BVH4Triangle4SceneBuilderSAH(accel,scene,MODE_HIGH_QUALITY));
     else if (scene->device->tri_builder == "dynamic"     ) builder = BVH4BuilderTwoLevelTriangleMeshSAH(accel,scene,&createTriangleMeshTriangle4);
     else if (scene->device->tri_builder == "morton"      ) builder = BVH4BuilderTwoLevelTriangleMeshSAH(accel,scene,&createTriangleMeshTriangle4Morton);
+    else if (scene->device->tri_builder == "morton.optimized") builder = BVH4BuilderTwoLevelTriangleMeshSAH(accel,scene,&createTriangleMeshTriangle4MortonOptimized);
     else throw_RTCError(RTC_INVALID_ARGUMENT,"unknown builder "+scene->device->tri_builder+" for BVH4<Triangle4>");
 
     return new AccelInstance(accel,builder,intersectors);
   }
 
+  Accel* BVH4Factory::BVH4QuantizedTriangle4(Scene* scene)
+  {
+    BVH4* accel = new BVH4(Triangle4::type,scene);
+    Accel::Intersectors intersectors = BVH4QuantizedTriangle4Intersectors(accel);
+
+    Builder* builder = nullptr;
+    if      (scene->device->tri_builder == "default"     ) builder = BVH4CacheBuilder(accel,scene,BVH4Triangle4SceneBuilderSAH(accel,scene,MODE_QUANTIZED));
+    else if (scene->device->tri_builder == "sah"         ) builder = BVH4CacheBuilder(accel,scene,BVH4Triangle4SceneBuilderSAH(accel,scene,MODE_QUANTIZED));
+    else if (scene->device->tri_builder == "sah_presplit") builder = BVH4CacheBuilder(accel,scene,BVH4Triangle4SceneBuilderSAH(accel,scene,MODE_HIGH_QUALITY | MODE_QUANTIZED));
+    else throw_RTCError(RTC_INVALID_ARGUMENT,"unknown builder "+scene->device->tri_builder+" for quantized BVH4<Triangle4>");
+
+    return new AccelInstance(accel,builder,intersectors);
+  }
+
 #if defined (__TARGET_AVX__)
   Accel* BVH4Factory::BVH4Triangle8(Scene* scene)
   {
@@ -805,12 +952,13 @@ namespace embree
     else throw_RTCError(RTC_INVALID_ARGUMENT,"unknown traverser "+scene->device->tri_traverser+" for BVH4<Triangle8>");
 
     Builder* builder = nullptr;
-    if      (scene->device->tri_builder == "default"     ) builder = BVH4Triangle8SceneBuilderSAH(accel,scene,0);
-    else if (scene->device->tri_builder == "sah"         ) builder = BVH4Triangle8SceneBuilderSAH(accel,scene,0);
-    else if (scene->device->tri_builder == "sah_spatial" ) builder = BVH4Triangle8SceneBuilderSpatialSAH(accel,scene,0);
-    else if (scene->device->tri_builder == "sah_presplit") builder = BVH4Triangle8SceneBuilderSAH(accel,scene,MODE_HIGH_QUALITY);
+    if      (scene->device->tri_builder == "default"     ) builder = BVH4CacheBuilder(accel,scene,BVH4Triangle8SceneBuilderSAH(accel,scene,0));
+    else if (scene->device->tri_builder == "sah"         ) builder = BVH4CacheBuilder(accel,scene,BVH4Triangle8SceneBuilderSAH(accel,scene,0));
+    else if (scene->device->tri_builder == "sah_spatial" ) builder = BVH4CacheBuilder(accel,scene,BVH4Triangle8SceneBuilderSpatialSAH(accel,scene,0));
+    else if (scene->device->tri_builder == "sah_presplit") builder = BVH4CacheBuilder(accel,scene,BVH4Triangle8SceneBuilderSAH(accel,scene,MODE_HIGH_QUALITY));
     else if (scene->device->tri_builder == "dynamic"     ) builder = BVH4BuilderTwoLevelTriangleMeshSAH(accel,scene,&createTriangleMeshTriangle8);
     else if (scene->device->tri_builder == "morton"      ) builder = BVH4BuilderTwoLevelTriangleMeshSAH(accel,scene,&createTriangleMeshTriangle8Morton);
+    else if (scene->device->tri_builder == "morton.optimized") builder = BVH4BuilderTwoLevelTriangleMeshSAH(accel,scene,&createTriangleMeshTriangle8MortonOptimized);
     else throw_RTCError(RTC_INVALID_ARGUMENT,"unknown builder "+scene->device->tri_builder+" for BVH4<Triangle8>");
 
     return new AccelInstance(accel,builder,intersectors);
@@ -827,12 +975,13 @@ namespace embree
     else throw_RTCError(RTC_INVALID_ARGUMENT,"unknown traverser "+scene->device->tri_traverser+" for BVH4<Triangle4>");
 
     Builder* builder = nullptr;
-    if      (scene->device->tri_builder == "default"     ) builder = BVH4Triangle4vSceneBuilderSAH(accel,scene,0);
-    else if (scene->device->tri_builder == "sah"         ) builder = BVH4Triangle4vSceneBuilderSAH(accel,scene,0);
-    else if (scene->device->tri_builder == "sah_spatial" ) builder = BVH4Triangle4vSceneBuilderSpatialSAH(accel,scene,0);
-    else if (scene->device->tri_builder == "sah_presplit") builder = BVH4Triangle4vSceneBuilderSAH(accel,scene,MODE_HIGH_QUALITY);
+    if      (scene->device->tri_builder == "default"     ) builder = BVH4CacheBuilder(accel,scene,BVH4Triangle4vSceneBuilderSAH(accel,scene,0));
+    else if (scene->device->tri_builder == "sah"         ) builder = BVH4CacheBuilder(accel,scene,BVH4Triangle4vSceneBuilderSAH(accel,scene,0));
+    else if (scene->device->tri_builder == "sah_spatial" ) builder = BVH4CacheBuilder(accel,scene,BVH4Triangle4vSceneBuilderSpatialSAH(accel,scene,0));
+    else if (scene->device->tri_builder == "sah_presplit") builder = BVH4CacheBuilder(accel,scene,BVH4Triangle4vSceneBuilderSAH(accel,scene,MODE_HIGH_QUALITY));
     else if (scene->device->tri_builder == "dynamic"     ) builder = BVH4BuilderTwoLevelTriangleMeshSAH(accel,scene,&createTriangleMeshTriangle4v);
     else if (scene->device->tri_builder == "morton"      ) builder = BVH4BuilderTwoLevelTriangleMeshSAH(accel,scene,&createTriangleMeshTriangle4vMorton);
+    else if (scene->device->tri_builder == "morton.optimized") builder = BVH4BuilderTwoLevelTriangleMeshSAH(accel,scene,&createTriangleMeshTriangle4vMortonOptimized);
     else throw_RTCError(RTC_INVALID_ARGUMENT,"unknown builder "+scene->device->tri_builder+" for BVH4<Triangle4v>");
 
     return new AccelInstance(accel,builder,intersectors);
@@ -854,6 +1003,7 @@ namespace embree
     else if (scene->device->tri_builder == "sah_presplit") builder = BVH4Triangle4iSceneBuilderSAH(accel,scene,MODE_HIGH_QUALITY);
     else if (scene->device->tri_builder == "dynamic"     ) builder = BVH4BuilderTwoLevelTriangleMeshSAH(accel,scene,&createTriangleMeshTriangle4i);
     else if (scene->device->tri_builder == "morton"      ) builder = BVH4BuilderTwoLevelTriangleMeshSAH(accel,scene,&createTriangleMeshTriangle4iMorton);
+    else if (scene->device->tri_builder == "morton.optimized") builder = BVH4BuilderTwoLevelTriangleMeshSAH(accel,scene,&createTriangleMeshTriangle4iMortonOptimized);
     else throw_RTCError(RTC_INVALID_ARGUMENT,"unknown builder "+scene->device->tri_builder+" for BVH4<Triangle4i>");
 
     scene->needTriangleVertices = true;
@@ -870,8 +1020,8 @@ namespace embree
     else throw_RTCError(RTC_INVALID_ARGUMENT,"unknown traverser "+scene->device->tri_traverser+" for BVH4<Triangle4vMB>");
 
     Builder* builder = nullptr;
-    if       (scene->device->tri_builder_mb == "default"    ) builder = BVH4Triangle4vMBSceneBuilderSAH(accel,scene,0);
-    else  if (scene->device->tri_builder_mb == "sah") builder = BVH4Triangle4vMBSceneBuilderSAH(accel,scene,0);
+    if       (scene->device->tri_builder_mb == "default"    ) builder = BVH4CacheBuilder(accel,scene,BVH4Triangle4vMBSceneBuilderSAH(accel,scene,0));
+    else  if (scene->device->tri_builder_mb == "sah") builder = BVH4CacheBuilder(accel,scene,BVH4Triangle4vMBSceneBuilderSAH(accel,scene,0));
     else throw_RTCError(RTC_INVALID_ARGUMENT,"unknown builder "+scene->device->tri_builder_mb+" for BVH4<Triangle4vMB>");
     return new AccelInstance(accel,builder,intersectors);
   }
@@ -921,7 +1071,7 @@ namespace embree
   Accel* BVH4Factory::BVH4Triangle4SpatialSplit(Scene* scene)
   {
     BVH4* accel = new BVH4(Triangle4::type,scene);
-    Builder* builder = BVH4Triangle4SceneBuilderSpatialSAH(accel,scene,0);
+    Builder* builder = BVH4CacheBuilder(accel,scene,BVH4Triangle4SceneBuilderSpatialSAH(accel,scene,0));
     Accel::Intersectors intersectors = BVH4Triangle4IntersectorsHybrid(accel);
     return new AccelInstance(accel,builder,intersectors);
   }
@@ -930,7 +1080,7 @@ namespace embree
   Accel* BVH4Factory::BVH4Triangle8SpatialSplit(Scene* scene)
   {
     BVH4* accel = new BVH4(Triangle8::type,scene);
-    Builder* builder = BVH4Triangle8SceneBuilderSpatialSAH(accel,scene,0);
+    Builder* builder = BVH4CacheBuilder(accel,scene,BVH4Triangle8SceneBuilderSpatialSAH(accel,scene,0));
     Accel::Intersectors intersectors = BVH4Triangle8IntersectorsHybrid(accel);
     return new AccelInstance(accel,builder,intersectors);
   }
@@ -939,7 +1089,7 @@ namespace embree
   Accel* BVH4Factory::BVH4Triangle4ObjectSplit(Scene* scene)
   {
     BVH4* accel = new BVH4(Triangle4::type,scene);
-    Builder* builder = BVH4Triangle4SceneBuilderSAH(accel,scene,0);
+    Builder* builder = BVH4CacheBuilder(accel,scene,BVH4Triangle4SceneBuilderSAH(accel,scene,0));
     Accel::Intersectors intersectors = BVH4Triangle4IntersectorsHybrid(accel);
     return new AccelInstance(accel,builder,intersectors);
   }
@@ -948,7 +1098,7 @@ namespace embree
   Accel* BVH4Factory::BVH4Triangle8ObjectSplit(Scene* scene)
   {
     BVH4* accel = new BVH4(Triangle8::type,scene);
-    Builder* builder = BVH4Triangle8SceneBuilderSAH(accel,scene,0);
+    Builder* builder = BVH4CacheBuilder(accel,scene,BVH4Triangle8SceneBuilderSAH(accel,scene,0));
     Accel::Intersectors intersectors = BVH4Triangle8IntersectorsHybrid(accel);
     return new AccelInstance(accel,builder,intersectors);
   }
@@ -957,7 +1107,7 @@ namespace embree
   Accel* BVH4Factory::BVH4Triangle4vObjectSplit(Scene* scene)
   {
     BVH4* accel = new BVH4(Triangle4v::type,scene);
-    Builder* builder = BVH4Triangle4vSceneBuilderSAH(accel,scene,0);
+    Builder* builder = BVH4CacheBuilder(accel,scene,BVH4Triangle4vSceneBuilderSAH(accel,scene,0));
     Accel::Intersectors intersectors = BVH4Triangle4vIntersectorsHybrid(accel);
     return new AccelInstance(accel,builder,intersectors);
   }
@@ -999,6 +1149,19 @@ namespace embree
     return new AccelInstance(accel,builder,intersectors);
   }
 
+  Accel* BVH4Factory::BVH4Triangle4OutOfCore(Scene* scene)
+  {
+    BVH4* accel = new BVH4(PagedObject::type,scene);
+    Accel::Intersectors intersectors;
+    intersectors.ptr = accel;
+    intersectors.intersector1  = BVH4PagedObjectIntersector1;
+    intersectors.intersector4  = BVH4PagedObjectIntersector4Chunk;
+    intersectors.intersector8  = BVH4PagedObjectIntersector8Chunk;
+    intersectors.intersector16 = BVH4PagedObjectIntersector16Chunk;
+    Builder* builder = BVH4BuilderOutOfCoreTriangleMeshSAH(accel,scene,&createTriangleMeshTriangle4Paged);
+    return new AccelInstance(accel,builder,intersectors);
+  }
+
   Accel* BVH4Factory::BVH4UserGeometry(Scene* scene)
   {
     BVH4* accel = new BVH4(Object::type,scene);
@@ -1052,7 +1215,7 @@ namespace embree
   Accel* BVH4Factory::BVH4Quad4v(Scene* scene)
   {
     BVH4* accel = new BVH4(Quad4v::type,scene);
-    Builder* builder = BVH4Quad4vSceneBuilderSAH(accel,scene,0);
+    Builder* builder = BVH4CacheBuilder(accel,scene,BVH4Quad4vSceneBuilderSAH(accel,scene,0));
     Accel::Intersectors intersectors = BVH4Quad4vIntersectors(accel);
     return new AccelInstance(accel,builder,intersectors);
   }
@@ -1060,7 +1223,7 @@ namespace embree
   Accel* BVH4Factory::BVH4Quad4i(Scene* scene)
   {
     BVH4* accel = new BVH4(Quad4i::type,scene);
-    Builder* builder = BVH4Quad4iSceneBuilderSAH(accel,scene,0);
+    Builder* builder = BVH4CacheBuilder(accel,scene,BVH4Quad4iSceneBuilderSAH(accel,scene,0));
     Accel::Intersectors intersectors = BVH4Quad4iIntersectors(accel);
     scene->needQuadVertices = true;
     return new AccelInstance(accel,builder,intersectors);
@@ -1069,7 +1232,7 @@ namespace embree
   Accel* BVH4Factory::BVH4Quad4iMB(Scene* scene)
   {
     BVH4* accel = new BVH4(Quad4iMB::type,scene);
-    Builder* builder = BVH4Quad4iMBSceneBuilderSAH(accel,scene,0);
+    Builder* builder = BVH4CacheBuilder(accel,scene,BVH4Quad4iMBSceneBuilderSAH(accel,scene,0));
     Accel::Intersectors intersectors = BVH4Quad4iMBIntersectors(accel);
     scene->needQuadVertices = true;
     return new AccelInstance(accel,builder,intersectors);
@@ -44,6 +44,7 @@ namespace embree
     Accel* BVH4OBBBezier1iMB(Scene* scene, bool highQuality);
 
     Accel* BVH4Triangle4(Scene* scene);
+    Accel* BVH4QuantizedTriangle4(Scene* scene);
     Accel* BVH4Triangle8(Scene* scene);
     Accel* BVH4Triangle4v(Scene* scene);
     Accel* BVH4Triangle4i(Scene* scene);
@@ -64,6 +65,8 @@ namespace embree
     Accel* BVH4Triangle4vTwolevel(Scene* scene);
     Accel* BVH4Triangle4iTwolevel(Scene* scene);
 
+    Accel* BVH4Triangle4OutOfCore(Scene* scene);
+
     Accel* BVH4Triangle4SpatialSplit(Scene* scene);
     Accel* BVH4Triangle8SpatialSplit(Scene* scene);
     Accel* BVH4Triangle4ObjectSplit(Scene* scene);
@@ -87,6 +90,7 @@ namespace embree
     Accel::Intersectors BVH4Bezier1iMBIntersectors_OBB(BVH4* bvh);
     Accel::Intersectors BVH4Triangle4IntersectorsHybrid(BVH4* bvh);
     Accel::Intersectors BVH4Triangle4IntersectorsInstancing(BVH4* bvh);
+    Accel::Intersectors BVH4QuantizedTriangle4Intersectors(BVH4* bvh);
     Accel::Intersectors BVH4Triangle8IntersectorsHybrid(BVH4* bvh);
     Accel::Intersectors BVH4Triangle4vIntersectorsHybrid(BVH4* bvh);
     Accel::Intersectors BVH4Triangle4iIntersectorsHybrid(BVH4* bvh);
@@ -105,7 +109,15 @@ namespace embree
     static void createTriangleMeshTriangle4vMorton(TriangleMesh* mesh, AccelData*& accel, Builder*& builder);
     static void createTriangleMeshTriangle4iMorton(TriangleMesh* mesh, AccelData*& accel, Builder*& builder);
 
+    static void createTriangleMeshTriangle4MortonOptimized(TriangleMesh* mesh, AccelData*& accel, Builder*& builder);
+#if defined (__TARGET_AVX__)
+    static void createTriangleMeshTriangle8MortonOptimized(TriangleMesh* mesh, AccelData*& accel, Builder*& builder);
+#endif
+    static void createTriangleMeshTriangle4vMortonOptimized(TriangleMesh* mesh, AccelData*& accel, Builder*& builder);
+    static void createTriangleMeshTriangle4iMortonOptimized(TriangleMesh* mesh, AccelData*& accel, Builder*& builder);
+
     static void createTriangleMeshTriangle4(TriangleMesh* mesh, AccelData*& accel, Builder*& builder);
+    static void createTriangleMeshTriangle4Paged(TriangleMesh* mesh, AccelData*& accel, Builder*& builder);
 #if defined (__TARGET_AVX__)
     static void createTriangleMeshTriangle8(TriangleMesh* mesh, AccelData*& accel, Builder*& builder);
 #endif
@@ -124,8 +136,12 @@ namespace embree
     DEFINE_SYMBOL2(Accel::Intersector1,BVH4Bezier1iIntersector1_OBB);
     DEFINE_SYMBOL2(Accel::Intersector1,BVH4Bezier1iMBIntersector1_OBB);
     DEFINE_SYMBOL2(Accel::Intersector1,BVH4Triangle4Intersector1Moeller);
+    DEFINE_SYMBOL2(Accel::Intersector1,BVH4Triangle4Intersector1MoellerNoFilter);
+    DEFINE_SYMBOL2(Accel::Intersector1,BVH4QuantizedTriangle4Intersector1Moeller);
+    DEFINE_SYMBOL2(Accel::Intersector1,BVH4QuantizedTriangle4Intersector1MoellerNoFilter);
     DEFINE_SYMBOL2(Accel::Intersector1,BVH4XfmTriangle4Intersector1Moeller);
     DEFINE_SYMBOL2(Accel::Intersector1,BVH4Triangle8Intersector1Moeller);
+    DEFINE_SYMBOL2(Accel::Intersector1,BVH4Triangle8Intersector1MoellerNoFilter);
     DEFINE_SYMBOL2(Accel::Intersector1,BVH4Triangle4vIntersector1Pluecker);
     DEFINE_SYMBOL2(Accel::Intersector1,BVH4Triangle4iIntersector1Pluecker);
     DEFINE_SYMBOL2(Accel::Intersector1,BVH4Triangle4vMBIntersector1Moeller);
@@ -133,7 +149,9 @@ namespace embree
     DEFINE_SYMBOL2(Accel::Intersector1,BVH4GridAOSIntersector1);
     DEFINE_SYMBOL2(Accel::Intersector1,BVH4VirtualIntersector1);
     DEFINE_SYMBOL2(Accel::Intersector1,BVH4VirtualMBIntersector1);
+    DEFINE_SYMBOL2(Accel::Intersector1,BVH4PagedObjectIntersector1);
     DEFINE_SYMBOL2(Accel::Intersector1,BVH4Quad4vIntersector1Moeller);
+    DEFINE_SYMBOL2(Accel::Intersector1,BVH4Quad4vIntersector1MoellerNoFilter);
     DEFINE_SYMBOL2(Accel::Intersector1,BVH4Quad4iIntersector1Pluecker);
     DEFINE_SYMBOL2(Accel::Intersector1,BVH4Quad4iMBIntersector1Pluecker);
     
@@ -147,7 +165,9 @@ namespace embree
     DEFINE_SYMBOL2(Accel::Intersector4,BVH4Bezier1iIntersector4Single_OBB);
     DEFINE_SYMBOL2(Accel::Intersector4,BVH4Bezier1iMBIntersector4Single_OBB);
     DEFINE_SYMBOL2(Accel::Intersector4,BVH4Triangle4Intersector4HybridMoeller);
+    DEFINE_SYMBOL2(Accel::Intersector4,BVH4QuantizedTriangle4Intersector4HybridMoeller);
     DEFINE_SYMBOL2(Accel::Intersector4,BVH4Triangle4Intersector4HybridMoellerNoFilter);
+    DEFINE_SYMBOL2(Accel::Intersector4,BVH4QuantizedTriangle4Intersector4HybridMoellerNoFilter);
     DEFINE_SYMBOL2(Accel::Intersector4,BVH4Triangle8Intersector4HybridMoeller);
     DEFINE_SYMBOL2(Accel::Intersector4,BVH4Triangle8Intersector4HybridMoellerNoFilter);
     DEFINE_SYMBOL2(Accel::Intersector4,BVH4Triangle4vIntersector4HybridPluecker);
@@ -161,6 +181,8 @@ namespace embree
     DEFINE_SYMBOL2(Accel::Intersector4,BVH4GridAOSIntersector4);
     DEFINE_SYMBOL2(Accel::Intersector4,BVH4VirtualIntersector4Chunk);
     DEFINE_SYMBOL2(Accel::Intersector4,BVH4VirtualMBIntersector4Chunk);
+    DEFINE_SYMBOL2(Accel::Intersector4,BVH4PagedObjectIntersector4Chunk);
+    DEFINE_SYMBOL2(Accel::Intersector4,BVH4XfmTriangle4Intersector4Moeller);
     
     DEFINE_SYMBOL2(Accel::Intersector8,BVH4Line4iIntersector8);
     DEFINE_SYMBOL2(Accel::Intersector8,BVH4Line4iMBIntersector8);
@@ -172,7 +194,9 @@ namespace embree
     DEFINE_SYMBOL2(Accel::Intersector8,BVH4Bezier1iIntersector8Single_OBB);
     DEFINE_SYMBOL2(Accel::Intersector8,BVH4Bezier1iMBIntersector8Single_OBB);
     DEFINE_SYMBOL2(Accel::Intersector8,BVH4Triangle4Intersector8HybridMoeller);
+    DEFINE_SYMBOL2(Accel::Intersector8,BVH4QuantizedTriangle4Intersector8HybridMoeller);
     DEFINE_SYMBOL2(Accel::Intersector8,BVH4Triangle4Intersector8HybridMoellerNoFilter);
+    DEFINE_SYMBOL2(Accel::Intersector8,BVH4QuantizedTriangle4Intersector8HybridMoellerNoFilter);
     DEFINE_SYMBOL2(Accel::Intersector8,BVH4Triangle8Intersector8HybridMoeller);
     DEFINE_SYMBOL2(Accel::Intersector8,BVH4Triangle8Intersector8HybridMoellerNoFilter);
     DEFINE_SYMBOL2(Accel::Intersector8,BVH4Triangle4vIntersector8HybridPluecker);
@@ -186,6 +210,8 @@ namespace embree
     DEFINE_SYMBOL2(Accel::Intersector8,BVH4GridAOSIntersector8);
     DEFINE_SYMBOL2(Accel::Intersector8,BVH4VirtualIntersector8Chunk);
     DEFINE_SYMBOL2(Accel::Intersector8,BVH4VirtualMBIntersector8Chunk);
+    DEFINE_SYMBOL2(Accel::Intersector8,BVH4PagedObjectIntersector8Chunk);
+    DEFINE_SYMBOL2(Accel::Intersector8,BVH4XfmTriangle4Intersector8Moeller);
     
     DEFINE_SYMBOL2(Accel::Intersector16,BVH4Line4iIntersector16);
     DEFINE_SYMBOL2(Accel::Intersector16,BVH4Line4iMBIntersector16);
@@ -197,7 +223,9 @@ namespace embree
     DEFINE_SYMBOL2(Accel::Intersector16,BVH4Bezier1iIntersector16Single_OBB);
     DEFINE_SYMBOL2(Accel::Intersector16,BVH4Bezier1iMBIntersector16Single_OBB);
     DEFINE_SYMBOL2(Accel::Intersector16,BVH4Triangle4Intersector16HybridMoeller);
+    DEFINE_SYMBOL2(Accel::Intersector16,BVH4QuantizedTriangle4Intersector16HybridMoeller);
     DEFINE_SYMBOL2(Accel::Intersector16,BVH4Triangle4Intersector16HybridMoellerNoFilter);
+    DEFINE_SYMBOL2(Accel::Intersector16,BVH4QuantizedTriangle4Intersector16HybridMoellerNoFilter);
     DEFINE_SYMBOL2(Accel::Intersector16,BVH4Triangle8Intersector16HybridMoeller);
     DEFINE_SYMBOL2(Accel::Intersector16,BVH4Triangle8Intersector16HybridMoellerNoFilter);
     DEFINE_SYMBOL2(Accel::Intersector16,BVH4Triangle4vIntersector16HybridPluecker);
@@ -211,11 +239,25 @@ namespace embree
     DEFINE_SYMBOL2(Accel::Intersector16,BVH4GridAOSIntersector16);
     DEFINE_SYMBOL2(Accel::Intersector16,BVH4VirtualIntersector16Chunk);
     DEFINE_SYMBOL2(Accel::Intersector16,BVH4VirtualMBIntersector16Chunk);
+    DEFINE_SYMBOL2(Accel::Intersector16,BVH4PagedObjectIntersector16Chunk);
+    DEFINE_SYMBOL2(Accel::Intersector16,BVH4XfmTriangle4Intersector16Moeller);
+
+    DEFINE_SYMBOL2(Accel::PointQueryFunc,BVH4Triangle4PointQuery);
+    DEFINE_SYMBOL2(Accel::PointQueryFunc,BVH4QuantizedTriangle4PointQuery);
+    DEFINE_SYMBOL2(Accel::PointQueryFunc,BVH4Triangle4vPointQuery);
+    DEFINE_SYMBOL2(Accel::PointQueryFunc,BVH4Triangle4iPointQuery);
+    DEFINE_SYMBOL2(Accel::PointQueryFunc,BVH4Triangle8PointQuery);
+    DEFINE_SYMBOL2(Accel::PointQueryFunc,BVH4Quad4vPointQuery);
+    DEFINE_SYMBOL2(Accel::PointQueryFunc,BVH4Quad4iPointQuery);
+    DEFINE_SYMBOL2(Accel::PointQueryFunc,BVH4Line4iPointQuery);
+    DEFINE_SYMBOL2(Accel::PointQueryFunc,BVH4Point4iPointQuery);
     
     DEFINE_BUILDER2(void,Scene,const createLineSegmentsAccelTy,BVH4BuilderTwoLevelLineSegmentsSAH);
     DEFINE_BUILDER2(void,Scene,const createPointsAccelTy,BVH4BuilderTwoLevelPointsSAH);
     DEFINE_BUILDER2(void,Scene,const createTriangleMeshAccelTy,BVH4BuilderTwoLevelTriangleMeshSAH);
     DEFINE_BUILDER2(void,Scene,const createTriangleMeshAccelTy,BVH4BuilderInstancingTriangleMeshSAH);
+    DEFINE_BUILDER2(void,Scene,const createTriangleMeshAccelTy,BVH4BuilderOutOfCoreTriangleMeshSAH);
+    DEFINE_BUILDER2(void,Scene,Builder*,BVH4CacheBuilder);
     
     DEFINE_BUILDER2(void,Scene,size_t,BVH4Bezier1vBuilder_OBB_New);
     DEFINE_BUILDER2(void,Scene,size_t,BVH4Bezier1iBuilder_OBB_New);
@@ -43,11 +43,17 @@ namespace embree
   DECLARE_SYMBOL2(Accel::Intersector1,BVH8Bezier1iIntersector1_OBB);
   DECLARE_SYMBOL2(Accel::Intersector1,BVH8Bezier1iMBIntersector1_OBB);
   DECLARE_SYMBOL2(Accel::Intersector1,BVH8Triangle4Intersector1Moeller);
+  DECLARE_SYMBOL2(Accel::Intersector1,BVH8Triangle4Intersector1MoellerNoFilter);
+  DECLARE_SYMBOL2(Accel::Intersector1,BVH8QuantizedTriangle4Intersector1Moeller);
+  DECLARE_SYMBOL2(Accel::Intersector1,BVH8QuantizedTriangle4Intersector1MoellerNoFilter);
   DECLARE_SYMBOL2(Accel::Intersector1,BVH8Triangle8Intersector1Moeller);
+  DECLARE_SYMBOL2(Accel::Intersector1,BVH8Triangle8Intersector1MoellerNoFilter);
   DECLARE_SYMBOL2(Accel::Intersector1,BVH8Triangle4vMBIntersector1Moeller);
   DECLARE_SYMBOL2(Accel::Intersector1,BVH8GridAOSIntersector1);
   DECLARE_SYMBOL2(Accel::Intersector1,BVH8Quad4vIntersector1Moeller);
+  DECLARE_SYMBOL2(Accel::Intersector1,BVH8Quad4vIntersector1MoellerNoFilter);
   DECLARE_SYMBOL2(Accel::Intersector1,BVH8Quad4iIntersector1Pluecker);
+  DECLARE_SYMBOL2(Accel::Intersector1,BVH8Quad4iIntersector1PlueckerNoFilter);
   DECLARE_SYMBOL2(Accel::Intersector1,BVH8Quad4iMBIntersector1Pluecker);
 
   DECLARE_SYMBOL2(Accel::Intersector4,BVH8Line4iIntersector4);
@@ -58,7 +64,9 @@ namespace embree
   DECLARE_SYMBOL2(Accel::Intersector4,BVH8Bezier1iIntersector4Single_OBB);
   DECLARE_SYMBOL2(Accel::Intersector4,BVH8Bezier1iMBIntersector4Single_OBB);
   DECLARE_SYMBOL2(Accel::Intersector4,BVH8Triangle4Intersector4HybridMoeller);
+  DECLARE_SYMBOL2(Accel::Intersector4,BVH8QuantizedTriangle4Intersector4HybridMoeller);
   DECLARE_SYMBOL2(Accel::Intersector4,BVH8Triangle4Intersector4HybridMoellerNoFilter);
+  DECLARE_SYMBOL2(Accel::Intersector4,BVH8QuantizedTriangle4Intersector4HybridMoellerNoFilter);
   DECLARE_SYMBOL2(Accel::Intersector4,BVH8Triangle8Intersector4HybridMoeller);
   DECLARE_SYMBOL2(Accel::Intersector4,BVH8Triangle8Intersector4HybridMoellerNoFilter);
   DECLARE_SYMBOL2(Accel::Intersector4,BVH8Triangle4vMBIntersector4HybridMoeller);
@@ -77,7 +85,9 @@ namespace embree
   DECLARE_SYMBOL2(Accel::Intersector8,BVH8Bezier1iIntersector8Single_OBB);
   DECLARE_SYMBOL2(Accel::Intersector8,BVH8Bezier1iMBIntersector8Single_OBB);
   DECLARE_SYMBOL2(Accel::Intersector8,BVH8Triangle4Intersector8HybridMoeller);
+  DECLARE_SYMBOL2(Accel::Intersector8,BVH8QuantizedTriangle4Intersector8HybridMoeller);
   DECLARE_SYMBOL2(Accel::Intersector8,BVH8Triangle4Intersector8HybridMoellerNoFilter);
+  DECLARE_SYMBOL2(Accel::Intersector8,BVH8QuantizedTriangle4Intersector8HybridMoellerNoFilter);
   DECLARE_SYMBOL2(Accel::Intersector8,BVH8Triangle8Intersector8HybridMoeller);
   DECLARE_SYMBOL2(Accel::Intersector8,BVH8Triangle8Intersector8HybridMoellerNoFilter);
   DECLARE_SYMBOL2(Accel::Intersector8,BVH8Triangle4vMBIntersector8HybridMoeller);
@@ -96,7 +106,9 @@ namespace embree
   DECLARE_SYMBOL2(Accel::Intersector16,BVH8Bezier1iIntersector16Single_OBB);
   DECLARE_SYMBOL2(Accel::Intersector16,BVH8Bezier1iMBIntersector16Single_OBB);
   DECLARE_SYMBOL2(Accel::Intersector16,BVH8Triangle4Intersector16HybridMoeller);
+  DECLARE_SYMBOL2(Accel::Intersector16,BVH8QuantizedTriangle4Intersector16HybridMoeller);
   DECLARE_SYMBOL2(Accel::Intersector16,BVH8Triangle4Intersector16HybridMoellerNoFilter);
+  DECLARE_SYMBOL2(Accel::Intersector16,BVH8QuantizedTriangle4Intersector16HybridMoellerNoFilter);
   DECLARE_SYMBOL2(Accel::Intersector16,BVH8Triangle4Intersector16HybridMoeller2);
   DECLARE_SYMBOL2(Accel::Intersector16,BVH8Triangle4Intersector16HybridMoellerNoFilter2);
 
@@ -113,6 +125,14 @@ namespace embree
   DECLARE_SYMBOL2(Accel::Intersector16,BVH8Quad4vIntersector16HybridMoeller2);
   DECLARE_SYMBOL2(Accel::Intersector16,BVH8Quad4vIntersector16HybridMoellerNoFilter2);
 
+  DECLARE_SYMBOL2(Accel::PointQueryFunc,BVH8Triangle4PointQuery);
+  DECLARE_SYMBOL2(Accel::PointQueryFunc,BVH8QuantizedTriangle4PointQuery);
+  DECLARE_SYMBOL2(Accel::PointQueryFunc,BVH8Triangle8PointQuery);
+  DECLARE_SYMBOL2(Accel::PointQueryFunc,BVH8Quad4vPointQuery);
+  DECLARE_SYMBOL2(Accel::PointQueryFunc,BVH8Quad4iPointQuery);
+  DECLARE_SYMBOL2(Accel::PointQueryFunc,BVH8Line4iPointQuery);
+  DECLARE_SYMBOL2(Accel::PointQueryFunc,BVH8Point4iPointQuery);
+
   DECLARE_BUILDER2(void,Scene,size_t,BVH8Bezier1vBuilder_OBB_New);
   DECLARE_BUILDER2(void,Scene,size_t,BVH8Bezier1iBuilder_OBB_New);
   DECLARE_BUILDER2(void,Scene,size_t,BVH8Bezier1iMBBuilder_OBB_New);
@@ -135,6 +155,8 @@ namespace embree
 
   DECLARE_BUILDER2(void,Scene,size_t,BVH8SubdivGridEagerBuilderBinnedSAH);
 
+  DECLARE_BUILDER2(void,Scene,Builder*,BVH8CacheBuilder);
+
   BVH8Factory::BVH8Factory (int features)
   {
     /* select builders */
@@ -158,6 +180,8 @@ namespace embree
     SELECT_SYMBOL_INIT_AVX(features,BVH8Triangle4SceneBuilderSpatialSAH);
     SELECT_SYMBOL_INIT_AVX(features,BVH8Triangle8SceneBuilderSpatialSAH);
 
+    SELECT_SYMBOL_INIT_AVX(features,BVH8CacheBuilder);
+
     SELECT_SYMBOL_INIT_AVX(features,BVH8SubdivGridEagerBuilderBinnedSAH);
 
     /* select intersectors1 */
@@ -169,10 +193,16 @@ namespace embree
     SELECT_SYMBOL_INIT_AVX_AVX2_AVX512KNL(features,BVH8Bezier1iIntersector1_OBB);
     SELECT_SYMBOL_INIT_AVX_AVX2_AVX512KNL(features,BVH8Bezier1iMBIntersector1_OBB);
     SELECT_SYMBOL_INIT_AVX_AVX2_AVX512KNL(features,BVH8Triangle4Intersector1Moeller);
+    SELECT_SYMBOL_INIT_AVX_AVX2_AVX512KNL(features,BVH8Triangle4Intersector1MoellerNoFilter);
+    SELECT_SYMBOL_INIT_AVX_AVX2_AVX512KNL(features,BVH8QuantizedTriangle4Intersector1Moeller);
+    SELECT_SYMBOL_INIT_AVX_AVX2_AVX512KNL(features,BVH8QuantizedTriangle4Intersector1MoellerNoFilter);
     SELECT_SYMBOL_INIT_AVX_AVX2_AVX512KNL(features,BVH8Triangle8Intersector1Moeller);
+    SELECT_SYMBOL_INIT_AVX_AVX2_AVX512KNL(features,BVH8Triangle8Intersector1MoellerNoFilter);
     SELECT_SYMBOL_INIT_AVX_AVX2_AVX512KNL(features,BVH8Triangle4vMBIntersector1Moeller);
     SELECT_SYMBOL_INIT_AVX_AVX2_AVX512KNL(features,BVH8Quad4vIntersector1Moeller);
+    SELECT_SYMBOL_INIT_AVX_AVX2_AVX512KNL(features,BVH8Quad4vIntersector1MoellerNoFilter);
     SELECT_SYMBOL_INIT_AVX_AVX2_AVX512KNL(features,BVH8Quad4iIntersector1Pluecker);
+    SELECT_SYMBOL_INIT_AVX_AVX2_AVX512KNL(features,BVH8Quad4iIntersector1PlueckerNoFilter);
     SELECT_SYMBOL_INIT_AVX_AVX2_AVX512KNL(features,BVH8Quad4iMBIntersector1Pluecker);
     SELECT_SYMBOL_INIT_AVX_AVX2_AVX512KNL(features,BVH8GridAOSIntersector1);
 
@@ -187,7 +217,9 @@ namespace embree
     SELECT_SYMBOL_INIT_AVX_AVX2(features,BVH8Bezier1iIntersector4Single_OBB);
     SELECT_SYMBOL_INIT_AVX_AVX2(features,BVH8Bezier1iMBIntersector4Single_OBB);
     SELECT_SYMBOL_INIT_AVX_AVX2(features,BVH8Triangle4Intersector4HybridMoeller);
+    SELECT_SYMBOL_INIT_AVX_AVX2(features,BVH8QuantizedTriangle4Intersector4HybridMoeller);
     SELECT_SYMBOL_INIT_AVX_AVX2(features,BVH8Triangle4Intersector4HybridMoellerNoFilter);
+    SELECT_SYMBOL_INIT_AVX_AVX2(features,BVH8QuantizedTriangle4Intersector4HybridMoellerNoFilter);
     SELECT_SYMBOL_INIT_AVX_AVX2(features,BVH8Triangle8Intersector4HybridMoeller);
     SELECT_SYMBOL_INIT_AVX_AVX2(features,BVH8Triangle8Intersector4HybridMoellerNoFilter);
     SELECT_SYMBOL_INIT_AVX_AVX2(features,BVH8Triangle4vMBIntersector4HybridMoeller);
@@ -207,7 +239,9 @@ namespace embree
     SELECT_SYMBOL_INIT_AVX_AVX2(features,BVH8Bezier1iIntersector8Single_OBB);
     SELECT_SYMBOL_INIT_AVX_AVX2(features,BVH8Bezier1iMBIntersector8Single_OBB);
     SELECT_SYMBOL_INIT_AVX_AVX2(features,BVH8Triangle4Intersector8HybridMoeller);
+    SELECT_SYMBOL_INIT_AVX_AVX2(features,BVH8QuantizedTriangle4Intersector8HybridMoeller);
     SELECT_SYMBOL_INIT_AVX_AVX2(features,BVH8Triangle4Intersector8HybridMoellerNoFilter);
+    SELECT_SYMBOL_INIT_AVX_AVX2(features,BVH8QuantizedTriangle4Intersector8HybridMoellerNoFilter);
     SELECT_SYMBOL_INIT_AVX_AVX2(features,BVH8Triangle8Intersector8HybridMoeller);
     SELECT_SYMBOL_INIT_AVX_AVX2(features,BVH8Triangle8Intersector8HybridMoellerNoFilter);
     SELECT_SYMBOL_INIT_AVX_AVX2(features,BVH8Triangle4vMBIntersector8HybridMoeller);
@@ -227,7 +261,9 @@ namespace embree
     SELECT_SYMBOL_INIT_AVX512KNL(features,BVH8Bezier1iIntersector16Single_OBB);
     SELECT_SYMBOL_INIT_AVX512KNL(features,BVH8Bezier1iMBIntersector16Single_OBB);
     SELECT_SYMBOL_INIT_AVX512KNL(features,BVH8Triangle4Intersector16HybridMoeller);
+    SELECT_SYMBOL_INIT_AVX512KNL(features,BVH8QuantizedTriangle4Intersector16HybridMoeller);
     SELECT_SYMBOL_INIT_AVX512KNL(features,BVH8Triangle4Intersector16HybridMoellerNoFilter);
+    SELECT_SYMBOL_INIT_AVX512KNL(features,BVH8QuantizedTriangle4Intersector16HybridMoellerNoFilter);
     SELECT_SYMBOL_INIT_AVX512KNL(features,BVH8Triangle4Intersector16HybridMoeller2);
     SELECT_SYMBOL_INIT_AVX512KNL(features,BVH8Triangle4Intersector16HybridMoellerNoFilter2);
     SELECT_SYMBOL_INIT_AVX512KNL(features,BVH8Triangle4vMBIntersector16HybridMoeller);
@@ -241,6 +277,15 @@ namespace embree
     SELECT_SYMBOL_INIT_AVX512KNL(features,BVH8Quad4vIntersector16HybridMoellerNoFilter2);
 
 #endif
+
+    /* select point queries */
+    SELECT_SYMBOL_INIT_AVX(features,BVH8Triangle4PointQuery);
+    SELECT_SYMBOL_INIT_AVX(features,BVH8QuantizedTriangle4PointQuery);
+    SELECT_SYMBOL_INIT_AVX(features,BVH8Triangle8PointQuery);
+    SELECT_SYMBOL_INIT_AVX(features,BVH8Quad4vPointQuery);
+    SELECT_SYMBOL_INIT_AVX(features,BVH8Quad4iPointQuery);
+    SELECT_SYMBOL_INIT_AVX(features,BVH8Line4iPointQuery);
+    SELECT_SYMBOL_INIT_AVX(features,BVH8Point4iPointQuery);
   }
 
   Accel::Intersectors BVH8Factory::BVH8Bezier1vIntersectors_OBB(BVH8* bvh)
@@ -284,6 +329,7 @@ namespace embree
     intersectors.intersector4  = BVH8Line4iIntersector4;
     intersectors.intersector8  = BVH8Line4iIntersector8;
     intersectors.intersector16 = BVH8Line4iIntersector16;
+    intersectors.pointQuery    = BVH8Line4iPointQuery;
     return intersectors;
   }
 
@@ -306,6 +352,7 @@ namespace embree
     intersectors.intersector4  = BVH8Point4iIntersector4;
     intersectors.intersector8  = BVH8Point4iIntersector8;
     intersectors.intersector16 = BVH8Point4iIntersector16;
+    intersectors.pointQuery    = BVH8Point4iPointQuery;
 	return intersectors;
   }
 
@@ -325,6 +372,8 @@ namespace embree
     Accel::Intersectors intersectors;
     intersectors.ptr = bvh;
     intersectors.intersector1           = BVH8Triangle4Intersector1Moeller;
+    intersectors.intersector1_filter    = BVH8Triangle4Intersector1Moeller;
+    intersectors.intersector1_nofilter  = BVH8Triangle4Intersector1MoellerNoFilter;
     intersectors.intersector4_filter    = BVH8Triangle4Intersector4HybridMoeller;
     intersectors.intersector4_nofilter  = BVH8Triangle4Intersector4HybridMoellerNoFilter;
     intersectors.intersector8_filter    = BVH8Triangle4Intersector8HybridMoeller;
@@ -336,6 +385,24 @@ namespace embree
     intersectors.intersector16_filter   = BVH8Triangle4Intersector16HybridMoeller2;
     intersectors.intersector16_nofilter = BVH8Triangle4Intersector16HybridMoellerNoFilter2;
 #endif
+    intersectors.pointQuery             = BVH8Triangle4PointQuery;
+    return intersectors;
+  }
+
+  Accel::Intersectors BVH8Factory::BVH8QuantizedTriangle4Intersectors(BVH8* bvh)
+  {
+    Accel::Intersectors intersectors;
+    intersectors.ptr = bvh;
+    intersectors.intersector1           = BVH8QuantizedTriangle4Intersector1Moeller;
+    intersectors.intersector1_filter    = BVH8QuantizedTriangle4Intersector1Moeller;
+    intersectors.intersector1_nofilter  = BVH8QuantizedTriangle4Intersector1MoellerNoFilter;
+    intersectors.intersector4_filter    = BVH8QuantizedTriangle4Intersector4HybridMoeller;
+    intersectors.intersector4_nofilter  = BVH8QuantizedTriangle4Intersector4HybridMoellerNoFilter;
+    intersectors.intersector8_filter    = BVH8QuantizedTriangle4Intersector8HybridMoeller;
+    intersectors.intersector8_nofilter  = BVH8QuantizedTriangle4Intersector8HybridMoellerNoFilter;
+    intersectors.intersector16_filter   = BVH8QuantizedTriangle4Intersector16HybridMoeller;
+    intersectors.intersector16_nofilter = BVH8QuantizedTriangle4Intersector16HybridMoellerNoFilter;
+    intersectors.pointQuery             = BVH8QuantizedTriangle4PointQuery;
     return intersectors;
   }
 
@@ -344,12 +411,15 @@ namespace embree
     Accel::Intersectors intersectors;
     intersectors.ptr = bvh;
     intersectors.intersector1           = BVH8Triangle8Intersector1Moeller;
+    intersectors.intersector1_filter    = BVH8Triangle8Intersector1Moeller;
+    intersectors.intersector1_nofilter  = BVH8Triangle8Intersector1MoellerNoFilter;
     intersectors.intersector4_filter    = BVH8Triangle8Intersector4HybridMoeller;
     intersectors.intersector4_nofilter  = BVH8Triangle8Intersector4HybridMoellerNoFilter;
     intersectors.intersector8_filter    = BVH8Triangle8Intersector8HybridMoeller;
     intersectors.intersector8_nofilter  = BVH8Triangle8Intersector8HybridMoellerNoFilter;
     intersectors.intersector16_filter   = BVH8Triangle8Intersector16HybridMoeller;
     intersectors.intersector16_nofilter = BVH8Triangle8Intersector16HybridMoellerNoFilter;
+    intersectors.pointQuery             = BVH8Triangle8PointQuery;
     return intersectors;
   }
 
@@ -369,6 +439,8 @@ namespace embree
     Accel::Intersectors intersectors;
     intersectors.ptr = bvh;
     intersectors.intersector1           = BVH8Quad4vIntersector1Moeller;
+    intersectors.intersector1_filter    = BVH8Quad4vIntersector1Moeller;
+    intersectors.intersector1_nofilter  = BVH8Quad4vIntersector1MoellerNoFilter;
     intersectors.intersector4_filter    = BVH8Quad4vIntersector4HybridMoeller;
     intersectors.intersector4_nofilter  = BVH8Quad4vIntersector4HybridMoellerNoFilter;
     intersectors.intersector8_filter    = BVH8Quad4vIntersector8HybridMoeller;
@@ -380,6 +452,7 @@ namespace embree
     intersectors.intersector16_filter   = BVH8Quad4vIntersector16HybridMoeller2;
     intersectors.intersector16_nofilter = BVH8Quad4vIntersector16HybridMoellerNoFilter2;
 #endif
+    intersectors.pointQuery             = BVH8Quad4vPointQuery;
     return intersectors;
   }
 
@@ -388,12 +461,15 @@ namespace embree
     Accel::Intersectors intersectors;
     intersectors.ptr = bvh;
     intersectors.intersector1           = BVH8Quad4iIntersector1Pluecker;
+    intersectors.intersector1_filter    = BVH8Quad4iIntersector1Pluecker;
+    intersectors.intersector1_nofilter  = BVH8Quad4iIntersector1PlueckerNoFilter;
     intersectors.intersector4_filter    = BVH8Quad4iIntersector4HybridPluecker;
     intersectors.intersector4_nofilter  = BVH8Quad4iIntersector4HybridPlueckerNoFilter;
     intersectors.intersector8_filter    = BVH8Quad4iIntersector8HybridPluecker;
     intersectors.intersector8_nofilter  = BVH8Quad4iIntersector8HybridPlueckerNoFilter;
     intersectors.intersector16_filter   = BVH8Quad4iIntersector16HybridPluecker;
     intersectors.intersector16_nofilter = BVH8Quad4iIntersector16HybridPlueckerNoFilter;
+    intersectors.pointQuery             = BVH8Quad4iPointQuery;
     return intersectors;
   }
 
@@ -412,7 +488,7 @@ namespace embree
   {
     BVH8* accel = new BVH8(Bezier1v::type,scene);
     Accel::Intersectors intersectors = BVH8Bezier1vIntersectors_OBB(accel);
-    Builder* builder = BVH8Bezier1vBuilder_OBB_New(accel,scene,0);
+    Builder* builder = BVH8CacheBuilder(accel,scene,BVH8Bezier1vBuilder_OBB_New(accel,scene,0));
     return new AccelInstance(accel,builder,intersectors);
   }
 
@@ -420,7 +496,7 @@ namespace embree
   {
     BVH8* accel = new BVH8(Bezier1i::type,scene);
     Accel::Intersectors intersectors = BVH8Bezier1iIntersectors_OBB(accel);
-    Builder* builder = BVH8Bezier1iBuilder_OBB_New(accel,scene,0);
+    Builder* builder = BVH8CacheBuilder(accel,scene,BVH8Bezier1iBuilder_OBB_New(accel,scene,0));
     scene->needBezierVertices = true;
     return new AccelInstance(accel,builder,intersectors);
   }
@@ -429,7 +505,7 @@ namespace embree
   {
     BVH8* accel = new BVH8(Bezier1i::type,scene);
     Accel::Intersectors intersectors = BVH8Bezier1iMBIntersectors_OBB(accel);
-    Builder* builder = BVH8Bezier1iMBBuilder_OBB_New(accel,scene,0);
+    Builder* builder = BVH8CacheBuilder(accel,scene,BVH8Bezier1iMBBuilder_OBB_New(accel,scene,0));
     scene->needBezierVertices = true;
     return new AccelInstance(accel,builder,intersectors);
   }
@@ -439,7 +515,7 @@ namespace embree
     BVH8* accel = new BVH8(Line4i::type,scene);
     Accel::Intersectors intersectors = BVH8Line4iIntersectors(accel);
     Builder* builder = nullptr;
-    if      (scene->device->line_builder == "default"     ) builder = BVH8Line4iSceneBuilderSAH(accel,scene,0);
+    if      (scene->device->line_builder == "default"     ) builder = BVH8CacheBuilder(accel,scene,BVH8Line4iSceneBuilderSAH(accel,scene,0));
     else throw_RTCError(RTC_INVALID_ARGUMENT,"unknown builder "+scene->device->line_builder+" for BVH8<Line4i>");
     scene->needLineVertices = true;
     return new AccelInstance(accel,builder,intersectors);
@@ -450,7 +526,7 @@ namespace embree
     BVH8* accel = new BVH8(Line4i::type,scene);
     Accel::Intersectors intersectors = BVH8Line4iMBIntersectors(accel);
     Builder* builder = nullptr;
-    if      (scene->device->line_builder_mb == "default"     ) builder = BVH8Line4iMBSceneBuilderSAH(accel,scene,0);
+    if      (scene->device->line_builder_mb == "default"     ) builder = BVH8CacheBuilder(accel,scene,BVH8Line4iMBSceneBuilderSAH(accel,scene,0));
     else throw_RTCError(RTC_INVALID_ARGUMENT,"unknown builder "+scene->device->line_builder_mb+" for BVH8<Line4i>");
     scene->needLineVertices = true;
     return new AccelInstance(accel,builder,intersectors);
@@ -461,8 +537,8 @@ namespace embree
     BVH8* accel = new BVH8(Point4i::type,scene);
     Accel::Intersectors intersectors = BVH8Point4iIntersectors(accel);
     Builder* builder = nullptr;
-    if      (scene->device->line_builder == "default"     ) builder = BVH8Point4iSceneBuilderSAH(accel,scene,0);
-    else throw_RTCError(RTC_INVALID_ARGUMENT,"unknown builder "+scene->device->line_builder+" for BVH8<Point4i>");
+    if      (scene->device->point_builder == "default"    ) builder = BVH8CacheBuilder(accel,scene,BVH8Point4iSceneBuilderSAH(accel,scene,0));
+    else throw_RTCError(RTC_INVALID_ARGUMENT,"unknown builder "+scene->device->point_builder+" for BVH8<Point4i>");
     scene->needPointVertices = true;
     return new AccelInstance(accel,builder,intersectors);
   }
@@ -472,8 +548,8 @@ namespace embree
     BVH8* accel = new BVH8(Point4i::type,scene);
     Accel::Intersectors intersectors = BVH8Point4iMBIntersectors(accel);
     Builder* builder = nullptr;
-    if      (scene->device->line_builder_mb == "default"     ) builder = BVH8Point4iMBSceneBuilderSAH(accel,scene,0);
-    else throw_RTCError(RTC_INVALID_ARGUMENT,"unknown builder "+scene->device->line_builder_mb+" for BVH8<Point4i>");
+    if      (scene->device->point_builder_mb == "default"    ) builder = BVH8CacheBuilder(accel,scene,BVH8Point4iMBSceneBuilderSAH(accel,scene,0));
+    else throw_RTCError(RTC_INVALID_ARGUMENT,"unknown builder "+scene->device->point_builder_mb+" for BVH8<Point4i>");
     scene->needPointVertices = true;
     return new AccelInstance(accel,builder,intersectors);
   }
@@ -484,20 +560,34 @@ namespace embree
     Accel::Intersectors intersectors= BVH8Triangle4Intersectors(accel);
 
     Builder* builder = nullptr;
-    if      (scene->device->tri_builder == "default"     )  builder = BVH8Triangle4SceneBuilderSAH(accel,scene,0);
-    else if (scene->device->tri_builder == "sah"         )  builder = BVH8Triangle4SceneBuilderSAH(accel,scene,0);
-    else if (scene->device->tri_builder == "sah_spatial" )  builder = BVH8Triangle4SceneBuilderSpatialSAH(accel,scene,0);
-    else if (scene->device->tri_builder == "sah_presplit") builder = BVH8Triangle4SceneBuilderSAH(accel,scene,MODE_HIGH_QUALITY);
+    if      (scene->device->tri_builder == "default"     )  builder = BVH8CacheBuilder(accel,scene,BVH8Triangle4SceneBuilderSAH(accel,scene,0));
+    else if (scene->device->tri_builder == "sah"         )  builder = BVH8CacheBuilder(accel,scene,BVH8Triangle4SceneBuilderSAH(accel,scene,0));
+    else if (scene->device->tri_builder == "sah_spatial" )  builder = BVH8CacheBuilder(accel,scene,BVH8Triangle4SceneBuilderSpatialSAH(accel,scene,0));
+    else if (scene->device->tri_builder == "sah_presplit") builder = BVH8CacheBuilder(accel,scene,BVH8Triangle4SceneBuilderSAH(accel,scene,MODE_HIGH_QUALITY));
     else throw_RTCError(RTC_INVALID_ARGUMENT,"unknown builder "+scene->device->tri_builder+" for BVH8<Triangle4>");
 
     return new AccelInstance(accel,builder,intersectors);
   }
 
+  Accel* BVH8Factory::BVH8QuantizedTriangle4(Scene* scene)
+  {
+    BVH8* accel = new BVH8(Triangle4::type,scene);
+    Accel::Intersectors intersectors= BVH8QuantizedTriangle4Intersectors(accel);
+
+    Builder* builder = nullptr;
+    if      (scene->device->tri_builder == "default"     )  builder = BVH8CacheBuilder(accel,scene,BVH8Triangle4SceneBuilderSAH(accel,scene,MODE_QUANTIZED));
+    else if (scene->device->tri_builder == "sah"         )  builder = BVH8CacheBuilder(accel,scene,BVH8Triangle4SceneBuilderSAH(accel,scene,MODE_QUANTIZED));
+    else if (scene->device->tri_builder == "sah_presplit")  builder = BVH8CacheBuilder(accel,scene,BVH8Triangle4SceneBuilderSAH(accel,scene,MODE_HIGH_QUALITY | MODE_QUANTIZED));
+    else throw_RTCError(RTC_INVALID_ARGUMENT,"unknown builder "+scene->device->tri_builder+" for quantized BVH8<Triangle4>");
+
+    return new AccelInstance(accel,builder,intersectors);
+  }
+
   Accel* BVH8Factory::BVH8Triangle4ObjectSplit(Scene* scene)
   {
     BVH8* accel = new BVH8(Triangle4::type,scene);
     Accel::Intersectors intersectors= BVH8Triangle4Intersectors(accel);
-    Builder* builder = BVH8Triangle4SceneBuilderSAH(accel,scene,0);
+    Builder* builder = BVH8CacheBuilder(accel,scene,BVH8Triangle4SceneBuilderSAH(accel,scene,0));
     return new AccelInstance(accel,builder,intersectors);
   }
 
@@ -505,7 +595,7 @@ namespace embree
   {
     BVH8* accel = new BVH8(Triangle4::type,scene);
     Accel::Intersectors intersectors= BVH8Triangle4Intersectors(accel);
-    Builder* builder = BVH8Triangle4SceneBuilderSpatialSAH(accel,scene,0);
+    Builder* builder = BVH8CacheBuilder(accel,scene,BVH8Triangle4SceneBuilderSpatialSAH(accel,scene,0));
     return new AccelInstance(accel,builder,intersectors);
   }
 
@@ -515,10 +605,10 @@ namespace embree
     Accel::Intersectors intersectors= BVH8Triangle8Intersectors(accel);
 
     Builder* builder = nullptr;
-    if      (scene->device->tri_builder == "default"     ) builder = BVH8Triangle8SceneBuilderSAH(accel,scene,0);
-    else if (scene->device->tri_builder == "sah"         ) builder = BVH8Triangle8SceneBuilderSAH(accel,scene,0);
-    else if (scene->device->tri_builder == "sah_spatial" ) builder = BVH8Triangle8SceneBuilderSpatialSAH(accel,scene,0);
-    else if (scene->device->tri_builder == "sah_presplit") builder = BVH8Triangle8SceneBuilderSAH(accel,scene,MODE_HIGH_QUALITY);
+    if      (scene->device->tri_builder == "default"     ) builder = BVH8CacheBuilder(accel,scene,BVH8Triangle8SceneBuilderSAH(accel,scene,0));
+    else if (scene->device->tri_builder == "sah"         ) builder = BVH8CacheBuilder(accel,scene,BVH8Triangle8SceneBuilderSAH(accel,scene,0));
+    else if (scene->device->tri_builder == "sah_spatial" ) builder = BVH8CacheBuilder(accel,scene,BVH8Triangle8SceneBuilderSpatialSAH(accel,scene,0));
+    else if (scene->device->tri_builder == "sah_presplit") builder = BVH8CacheBuilder(accel,scene,BVH8Triangle8SceneBuilderSAH(accel,scene,MODE_HIGH_QUALITY));
     else throw_RTCError(RTC_INVALID_ARGUMENT,"unknown builder "+scene->device->tri_builder+" for BVH8<Triangle8>");
 
     return new AccelInstance(accel,builder,intersectors);
@@ -530,8 +620,8 @@ namespace embree
     Accel::Intersectors intersectors= BVH8Triangle4vMBIntersectors(accel);
 
     Builder* builder = nullptr;
-    if      (scene->device->tri_builder_mb == "default"     )  builder = BVH8Triangle4vMBSceneBuilderSAH(accel,scene,0);
-    else if (scene->device->tri_builder_mb == "sah"         )  builder = BVH8Triangle4vMBSceneBuilderSAH(accel,scene,0);
+    if      (scene->device->tri_builder_mb == "default"     )  builder = BVH8CacheBuilder(accel,scene,BVH8Triangle4vMBSceneBuilderSAH(accel,scene,0));
+    else if (scene->device->tri_builder_mb == "sah"         )  builder = BVH8CacheBuilder(accel,scene,BVH8Triangle4vMBSceneBuilderSAH(accel,scene,0));
     else throw_RTCError(RTC_INVALID_ARGUMENT,"unknown builder "+scene->device->tri_builder_mb+" for BVH8<Triangle4vMB>");
 
     return new AccelInstance(accel,builder,intersectors);
@@ -541,7 +631,7 @@ namespace embree
   {
     BVH8* accel = new BVH8(Triangle8::type,scene);
     Accel::Intersectors intersectors= BVH8Triangle8Intersectors(accel);
-    Builder* builder = BVH8Triangle8SceneBuilderSAH(accel,scene,0);
+    Builder* builder = BVH8CacheBuilder(accel,scene,BVH8Triangle8SceneBuilderSAH(accel,scene,0));
     return new AccelInstance(accel,builder,intersectors);
   }
 
@@ -549,7 +639,7 @@ namespace embree
   {
     BVH8* accel = new BVH8(Triangle8::type,scene);
     Accel::Intersectors intersectors= BVH8Triangle8Intersectors(accel);
-    Builder* builder = BVH8Triangle8SceneBuilderSpatialSAH(accel,scene,0);
+    Builder* builder = BVH8CacheBuilder(accel,scene,BVH8Triangle8SceneBuilderSpatialSAH(accel,scene,0));
     return new AccelInstance(accel,builder,intersectors);
   }
 
@@ -558,7 +648,7 @@ namespace embree
     BVH8* accel = new BVH8(Quad4v::type,scene);
     Accel::Intersectors intersectors = BVH8Quad4vIntersectors(accel);
     Builder* builder = nullptr;
-    if      (scene->device->quad_builder == "default"     ) builder = BVH8Quad4vSceneBuilderSAH(accel,scene,0);
+    if      (scene->device->quad_builder == "default"     ) builder = BVH8CacheBuilder(accel,scene,BVH8Quad4vSceneBuilderSAH(accel,scene,0));
     else throw_RTCError(RTC_INVALID_ARGUMENT,"unknown builder "+scene->device->quad_builder+" for BVH8<Quad4v>");
     return new AccelInstance(accel,builder,intersectors);
   }
@@ -568,7 +658,7 @@ namespace embree
     BVH8* accel = new BVH8(Quad4i::type,scene);
     Accel::Intersectors intersectors = BVH8Quad4iIntersectors(accel);
     Builder* builder = nullptr;
-    if      (scene->device->quad_builder == "default"     ) builder = BVH8Quad4iSceneBuilderSAH(accel,scene,0);
+    if      (scene->device->quad_builder == "default"     ) builder = BVH8CacheBuilder(accel,scene,BVH8Quad4iSceneBuilderSAH(accel,scene,0));
     else throw_RTCError(RTC_INVALID_ARGUMENT,"unknown builder "+scene->device->quad_builder+" for BVH8<Quad4i>");
     scene->needQuadVertices = true;
     return new AccelInstance(accel,builder,intersectors);
@@ -579,7 +669,7 @@ namespace embree
     BVH8* accel = new BVH8(Quad4iMB::type,scene);
     Accel::Intersectors intersectors = BVH8Quad4iMBIntersectors(accel);
     Builder* builder = nullptr;
-    if      (scene->device->quad_builder_mb == "default"     ) builder = BVH8Quad4iMBSceneBuilderSAH(accel,scene,0);
+    if      (scene->device->quad_builder_mb == "default"     ) builder = BVH8CacheBuilder(accel,scene,BVH8Quad4iMBSceneBuilderSAH(accel,scene,0));
     else throw_RTCError(RTC_INVALID_ARGUMENT,"unknown builder "+scene->device->quad_builder_mb+" for BVH8<Quad4i>");
     scene->needQuadVertices = true;
     return new AccelInstance(accel,builder,intersectors);
@@ -82,6 +82,30 @@ namespace embree
       bvh->layoutLargeNodes(pinfo.size()*0.005f);
     }
 
+    template<int N>
+    void BVHNBuilderQuantized<N>::BVHNBuilderV::build(BVH* bvh, BuildProgressMonitor& progress_in, PrimRef* prims, const PrimInfo& pinfo, const size_t blockSize, const size_t minLeafSize, const size_t maxLeafSize, const float travCost, const float intCost)
+    {
+      auto progressFunc = [&] (size_t dn) { 
+        progress_in(dn); 
+      };
+            
+      auto createLeafFunc = [&] (const BVHBuilderBinnedSAH::BuildRecord& current, Allocator* alloc) -> size_t {
+        return createLeaf(current,alloc);
+      };
+
+      /* quantized nodes get no tree rotations */
+      auto reduce = [] (QuantizedNode* node, const size_t* counts, const size_t num) -> size_t {
+        return 0;
+      };
+      
+      NodeRef root;
+      BVHBuilderBinnedSAH::build_reduce<NodeRef>
+        (root,typename BVH::CreateAlloc(bvh),size_t(0),typename BVH::CreateQuantizedNode(bvh),reduce,createLeafFunc,progressFunc,
+         prims,pinfo,N,BVH::maxBuildDepthLeaf,blockSize,minLeafSize,maxLeafSize,travCost,intCost);
+
+      bvh->set(root,pinfo.geomBounds,pinfo.size());
+    }
+
     template<int N>
       struct CreateNodeMB
     {
@@ -105,6 +129,27 @@ namespace embree
 
     template<int N>
     void BVHNBuilderMblur<N>::BVHNBuilderV::build(BVH* bvh, BuildProgressMonitor& progress_in, PrimRef* prims, const PrimInfo& pinfo, const size_t blockSize, const size_t minLeafSize, const size_t maxLeafSize, const float travCost, const float intCost)
+    {
+      NodeRef root;
+      build(root,bvh,progress_in,prims,pinfo,BBox1f(0.0f,1.0f),blockSize,minLeafSize,maxLeafSize,travCost,intCost);
+
+      bvh->set(root,pinfo.geomBounds,pinfo.size());
+      
+#if ROTATE_TREE
+      if (N == 4)
+      {
+        for (int i=0; i<ROTATE_TREE; i++)
+          BVHNRotate<N>::rotate(bvh->root);
+        bvh->clearBarrier(bvh->root);
+      }
+#endif
+      
+      //bvh->layoutLargeNodes(pinfo.size()*0.005f); // FIXME: implement for Mblur nodes and activate
+    }
+
+    template<int N>
+    std::pair<BBox3fa,BBox3fa> BVHNBuilderMblur<N>::BVHNBuilderV::build(NodeRef& root, BVH* bvh, BuildProgressMonitor& progress_in, PrimRef* prims, const PrimInfo& pinfo, const BBox1f& time_range,
+                                                                       const size_t blockSize, const size_t minLeafSize, const size_t maxLeafSize, const float travCost, const float intCost)
     {
       //bvh->alloc.init_estimate(pinfo.size()*sizeof(PrimRef));
 
@@ -113,11 +158,11 @@ namespace embree
       };
             
       auto createLeafFunc = [&] (const BVHBuilderBinnedSAH::BuildRecord& current, Allocator* alloc) -> std::pair<BBox3fa,BBox3fa> {
-        return createLeaf(current,alloc);
+        return createLeaf(current,alloc,time_range);
       };
 
       /* reduction function */
-      auto reduce = [] (NodeMB* node, const std::pair<BBox3fa,BBox3fa>* bounds, const size_t num) -> std::pair<BBox3fa,BBox3fa>
+      auto reduce = [&] (NodeMB* node, const std::pair<BBox3fa,BBox3fa>* bounds, const size_t num) -> std::pair<BBox3fa,BBox3fa>
       {
         assert(num <= N);
         BBox3fa bounds0 = empty;
@@ -125,7 +170,7 @@ namespace embree
         for (size_t i=0; i<num; i++) {
           const BBox3fa b0 = bounds[i].first;
           const BBox3fa b1 = bounds[i].second;
-          node->set(i,b0,b1);
+          node->set(i,b0,b1,time_range);
           bounds0 = merge(bounds0,b0);
           bounds1 = merge(bounds1,b1);
         }
@@ -133,23 +178,9 @@ namespace embree
       };
       auto identity = std::make_pair(BBox3fa(empty),BBox3fa(empty));
       
-      NodeRef root;
-      BVHBuilderBinnedSAH::build_reduce<NodeRef>
+      return BVHBuilderBinnedSAH::build_reduce<NodeRef>
         (root,typename BVH::CreateAlloc(bvh),identity,CreateNodeMB<N>(bvh),reduce,createLeafFunc,progressFunc,
          prims,pinfo,N,BVH::maxBuildDepthLeaf,blockSize,minLeafSize,maxLeafSize,travCost,intCost);
-
-      bvh->set(root,pinfo.geomBounds,pinfo.size());
-      
-#if ROTATE_TREE
-      if (N == 4)
-      {
-        for (int i=0; i<ROTATE_TREE; i++)
-          BVHNRotate<N>::rotate(bvh->root);
-        bvh->clearBarrier(bvh->root);
-      }
-#endif
-      
-      //bvh->layoutLargeNodes(pinfo.size()*0.005f); // FIXME: implement for Mblur nodes and activate
     }
 
     template<int N>
@@ -191,13 +222,20 @@ namespace embree
     }
 
     template struct BVHNBuilder<4>;
+    template struct BVHNBuilderQuantized<4>;
     template struct BVHNBuilderMblur<4>;    
     template struct BVHNBuilderSpatial<4>;
 
 #if defined(__AVX__)
     template struct BVHNBuilder<8>;
+    template struct BVHNBuilderQuantized<8>;
     template struct BVHNBuilderMblur<8>;
     template struct BVHNBuilderSpatial<8>;
 #endif
+
+#if defined(__AVX512F__)
+    template struct BVHNBuilder<16>;
+    template struct BVHNBuilderQuantized<16>;
+#endif
   }
 }
@@ -55,6 +55,41 @@ namespace embree
       }
     };
 
+    template<int N>
+      struct BVHNBuilderQuantized
+    {
+      typedef BVHN<N> BVH;
+      typedef typename BVH::QuantizedNode QuantizedNode;
+      typedef typename BVH::NodeRef NodeRef;
+      typedef FastAllocator::ThreadLocal2 Allocator;
+      
+      struct BVHNBuilderV {
+        void build(BVH* bvh, BuildProgressMonitor& progress, PrimRef* prims, const PrimInfo& pinfo, 
+                   const size_t blockSize, const size_t minLeafSize, const size_t maxLeafSize, const float travCost, const float intCost);
+        virtual size_t createLeaf (const BVHBuilderBinnedSAH::BuildRecord& current, Allocator* alloc) = 0;
+      };
+
+      template<typename CreateLeafFunc>
+      struct BVHNBuilderT : public BVHNBuilderV
+      {
+        BVHNBuilderT (CreateLeafFunc createLeafFunc)
+          : createLeafFunc(createLeafFunc) {}
+
+        size_t createLeaf (const BVHBuilderBinnedSAH::BuildRecord& current, Allocator* alloc) {
+          return createLeafFunc(current,alloc);
+        }
+
+      private:
+        CreateLeafFunc createLeafFunc;
+      };
+
+      template<typename CreateLeafFunc>
+      static void build(BVH* bvh, CreateLeafFunc createLeaf, BuildProgressMonitor& progress, PrimRef* prims, const PrimInfo& pinfo, 
+                        const size_t blockSize, const size_t minLeafSize, const size_t maxLeafSize, const float travCost, const float intCost) {
+        BVHNBuilderT<CreateLeafFunc>(createLeaf).build(bvh,progress,prims,pinfo,blockSize,minLeafSize,maxLeafSize,travCost,intCost);
+      }
+    };
+
     template<int N>
       struct BVHNBuilderMblur
     {
@@ -66,7 +101,9 @@ namespace embree
       struct BVHNBuilderV {
         void build(BVH* bvh, BuildProgressMonitor& progress, PrimRef* prims, const PrimInfo& pinfo, 
                    const size_t blockSize, const size_t minLeafSize, const size_t maxLeafSize, const float travCost, const float intCost);
-        virtual std::pair<BBox3fa,BBox3fa> createLeaf (const BVHBuilderBinnedSAH::BuildRecord& current, Allocator* alloc) = 0;
+        std::pair<BBox3fa,BBox3fa> build(NodeRef& root, BVH* bvh, BuildProgressMonitor& progress, PrimRef* prims, const PrimInfo& pinfo, const BBox1f& time_range,
+                                         const size_t blockSize, const size_t minLeafSize, const size_t maxLeafSize, const float travCost, const float intCost);
+        virtual std::pair<BBox3fa,BBox3fa> createLeaf (const BVHBuilderBinnedSAH::BuildRecord& current, Allocator* alloc, const BBox1f& time_range) = 0;
       };
 
       template<typename CreateLeafFunc>
@@ -75,8 +112,8 @@ namespace embree
         BVHNBuilderT (CreateLeafFunc createLeafFunc)
           : createLeafFunc(createLeafFunc) {}
 
-        std::pair<BBox3fa,BBox3fa> createLeaf (const BVHBuilderBinnedSAH::BuildRecord& current, Allocator* alloc) {
-          return createLeafFunc(current,alloc);
+        std::pair<BBox3fa,BBox3fa> createLeaf (const BVHBuilderBinnedSAH::BuildRecord& current, Allocator* alloc, const BBox1f& time_range) {
+          return createLeafFunc(current,alloc,time_range);
         }
 
       private:
@@ -88,6 +125,15 @@ namespace embree
                         const size_t blockSize, const size_t minLeafSize, const size_t maxLeafSize, const float travCost, const float intCost) {
         BVHNBuilderT<CreateLeafFunc>(createLeaf).build(bvh,progress,prims,pinfo,blockSize,minLeafSize,maxLeafSize,travCost,intCost);
       }
+
+      /*! builds a subtree that is only valid inside the specified time
+       *  range, returns the bounds at the begin and end of the time range
+       *  without setting the root of the BVH */
+      template<typename CreateLeafFunc>
+      static std::pair<BBox3fa,BBox3fa> build(NodeRef& root, BVH* bvh, CreateLeafFunc createLeaf, BuildProgressMonitor& progress, PrimRef* prims, const PrimInfo& pinfo, const BBox1f& time_range,
+                                              const size_t blockSize, const size_t minLeafSize, const size_t maxLeafSize, const float travCost, const float intCost) {
+        return BVHNBuilderT<CreateLeafFunc>(createLeaf).build(root,bvh,progress,prims,pinfo,time_range,blockSize,minLeafSize,maxLeafSize,travCost,intCost);
+      }
     };
 
     template<int N>
@@ -69,19 +69,6 @@ namespace embree
       return 0;
     }
     
-    template<int N>
-    const BBox3fa xfmDeepBounds(const AffineSpace3fa& xfm, const BBox3fa& bounds, typename BVHN<N>::NodeRef ref, size_t depth)
-    {
-      if (ref == BVHN<N>::emptyNode) return empty;
-      if (depth == 0 || !ref.isNode()) return xfmBounds(xfm,bounds);
-      typename BVHN<N>::Node* node = ref.node();
-
-      BBox3fa box = empty;
-      for (size_t i=0; i<N; i++)
-        box.extend(xfmDeepBounds<N>(xfm,node->bounds(i),node->child(i),depth-1));
-      return box;
-    }
-
     template<int N>
     void BVHNBuilderInstancing<N>::build(size_t threadIndex, size_t threadCount)
     {
@@ -184,11 +171,23 @@ namespace embree
             if (!(geom->getType() & Geometry::INSTANCE)) continue;
             GeometryInstance* instance = (GeometryInstance*) geom;
             if (!instance->isEnabled()) continue;
-            BVH* object = objects[instance->geom->id];
+
+            /* nested instances get flattened by concatenating the transformations down to the instanced geometry */
+            AffineSpace3fa local2world = instance->local2world;
+            unsigned mask = instance->mask;
+            Geometry* base = instance->geom;
+            while (base->getType() & Geometry::INSTANCE) {
+              GeometryInstance* inner = (GeometryInstance*) base;
+              local2world = local2world * inner->local2world;
+              mask &= inner->mask;
+              base = inner->geom;
+            }
+            
+            BVH* object = objects[base->id];
             if (object == nullptr) continue;
             if (object->bounds.empty()) continue;
-            int s = slot(geom->getType() & ~Geometry::INSTANCE, geom->numTimeSteps);
-            refs[nextRef++] = BVHNBuilderInstancing::BuildRef(instance->local2world,object->bounds,object->root,instance->mask,objectID,hash(instance->local2world),s);
+            int s = slot(base->getType(), base->numTimeSteps);
+            refs[nextRef++] = BVHNBuilderInstancing::BuildRef(local2world,object->bounds,object->root,mask,objectID,hash(local2world),s);
           }
         });
       refs.resize(nextRef);
@@ -237,14 +236,7 @@ namespace embree
       if (pinfo.size() == 0)
         bvh->set(BVH::emptyNode,empty,0);
       
-      else if (pinfo.size() == 1) {
-        BuildRef* ref = (BuildRef*) prims[0].ID();
-        //const BBox3fa bounds = xfmBounds(ref->local2world,ref->localBounds);
-        const BBox3fa bounds = xfmDeepBounds<N>(ref->local2world,ref->localBounds,ref->node,2);
-        bvh->set(ref->node,bounds,numPrimitives);
-      }
-
-      /* otherwise build toplevel hierarchy */
+      /* otherwise build toplevel hierarchy, a single instance also needs its transform node */
       else
       {
         NodeRef root;
@@ -269,7 +261,6 @@ namespace embree
             new (node) TransformNode(ref->local2world,ref->localBounds,ref->node,ref->mask,ref->instID,ref->xfmID,ref->type); // FIXME: rcp should be precalculated somewhere
             *current.parent = BVH::encodeNode(node);
             //*current.parent = ref->node;
-            ((NodeRef*)current.parent)->setBarrier();
             return 1;
           },
            [&] (size_t dn) { bvh->scene->progressMonitor(0); },
@@ -95,6 +95,213 @@ namespace embree
       }
     };
 
+    /*! Restructures small treelets bottom-up for optimal SAH cost in
+     *  the style of TRBVH. The treelet of some node consists of the
+     *  node and its inner children of largest surface area, the
+     *  optimal topology over the treelet leaves is found by dynamic
+     *  programming over all leaf subsets. */
+    template<int N>
+    struct BVHNTreeletOptimizer
+    {
+      typedef BVHN<N> BVH;
+      typedef typename BVH::Node Node;
+      typedef typename BVH::NodeRef NodeRef;
+
+      static const size_t MAX_TREELET_LEAVES = 8;
+      static const size_t MAX_TREELET_SUBSETS = size_t(1) << MAX_TREELET_LEAVES;
+      static const size_t PARALLEL_DEPTH = 4;
+
+      __forceinline BVHNTreeletOptimizer (BVH* bvh) : bvh(bvh) {}
+
+      /*! optimizes the subtree at the specified depth and returns its height */
+      size_t optimize(NodeRef ref, size_t depth = 0)
+      {
+        if (!ref.isNode()) return 0;
+        Node* node = ref.node();
+
+        /* optimize all subtrees first, the bounds of a subtree do not change */
+        size_t heights[N];
+        if (depth < PARALLEL_DEPTH) {
+          parallel_for(size_t(N), [&] (const size_t i) { heights[i] = optimize(node->child(i),depth+1); });
+        } else {
+          for (size_t i=0; i<N; i++) heights[i] = optimize(node->child(i),depth+1);
+        }
+        return restructure(node,depth,heights);
+      }
+
+    private:
+
+      /*! restructures the treelet of the root node at the specified
+       *  depth, a treelet is kept if the new topology would exceed the
+       *  maximal build depth, returns the height of the subtree */
+      __noinline size_t restructure(Node* root, size_t depth, const size_t* childHeights)
+      {
+        NodeRef items[MAX_TREELET_LEAVES];
+        BBox3fa bounds[MAX_TREELET_LEAVES];
+        size_t heights[MAX_TREELET_LEAVES];
+        Node* nodes[MAX_TREELET_LEAVES];
+        size_t numItems = 0, numNodes = 0;
+
+        /* form treelet by expanding the inner nodes of largest area */
+        size_t origHeight = 0;
+        nodes[numNodes++] = root;
+        for (size_t i=0; i<N; i++) {
+          if (root->child(i) == BVH::emptyNode) continue;
+          items[numItems] = root->child(i);
+          bounds[numItems] = root->bounds(i);
+          heights[numItems] = childHeights[i];
+          origHeight = max(origHeight,1+childHeights[i]);
+          numItems++;
+        }
+        float origCost = halfArea(root->bounds());
+
+        while (numNodes < MAX_TREELET_LEAVES)
+        {
+          ssize_t best = -1; float bestArea = neg_inf;
+          for (size_t i=0; i<numItems; i++)
+          {
+            if (!items[i].isNode()) continue;
+            const Node* node = items[i].node();
+            size_t numChildren = 0;
+            for (size_t j=0; j<N; j++) numChildren += node->child(j) != BVH::emptyNode;
+            if (numItems-1+numChildren > MAX_TREELET_LEAVES) continue;
+            const float area = halfArea(bounds[i]);
+            if (area > bestArea) { best = i; bestArea = area; }
+          }
+          if (best == -1) break;
+
+          Node* node = items[best].node();
+          const size_t height = heights[best];
+          nodes[numNodes++] = node;
+          origCost += bestArea;
+          numItems--;
+          items[best] = items[numItems];
+          bounds[best] = bounds[numItems];
+          heights[best] = heights[numItems];
+          for (size_t j=0; j<N; j++) {
+            if (node->child(j) == BVH::emptyNode) continue;
+            items[numItems] = node->child(j);
+            bounds[numItems] = node->bounds(j);
+            heights[numItems] = height-1; // conservative, the child subtrees are at most that high
+            numItems++;
+          }
+        }
+        if (numNodes == 1) return origHeight;
+
+        /* cost[s] is the SAH cost of the optimal subtree over leaf set s,
+         * part[k][s] the optimal cost to split s into at most k+1 subtrees */
+        Treelet t;
+        const size_t full = (size_t(1) << numItems)-1;
+        t.bounds[0] = empty;
+        for (size_t s=1; s<=full; s++)
+          t.bounds[s] = merge(t.bounds[s & (s-1)],bounds[__bsf(s)]);
+
+        for (size_t s=1; s<=full; s++)
+        {
+          const size_t lowest = s & (0-s);
+          if (s == lowest) {
+            t.cost[s] = 0.0f;
+            for (size_t k=0; k<N; k++) { t.part[k][s] = 0.0f; t.partSplit[k][s] = (unsigned char) s; }
+            continue;
+          }
+
+          /* the subtree containing the lowest leaf gets enumerated first */
+          float bestCost[N]; size_t bestSplit[N];
+          for (size_t k=0; k<N; k++) { bestCost[k] = pos_inf; bestSplit[k] = s; }
+          const size_t rest = s ^ lowest;
+          for (size_t q=(rest-1) & rest;; q=(q-1) & rest)
+          {
+            const size_t p = q | lowest;
+            for (size_t k=1; k<N; k++) {
+              const float c = t.cost[p] + t.part[k-1][s^p];
+              if (c < bestCost[k]) { bestCost[k] = c; bestSplit[k] = p; }
+            }
+            if (q == 0) break;
+          }
+
+          t.cost[s] = halfArea(t.bounds[s]) + bestCost[N-1];
+          t.split[s] = (unsigned char) bestSplit[N-1];
+          t.part[0][s] = t.cost[s];
+          t.partSplit[0][s] = (unsigned char) s;
+          for (size_t k=1; k<N; k++) {
+            const bool single = t.cost[s] <= bestCost[k];
+            t.part[k][s] = single ? t.cost[s] : bestCost[k];
+            t.partSplit[k][s] = (unsigned char) (single ? s : bestSplit[k]);
+          }
+        }
+
+        /* keep the treelet if the optimal topology is not significantly better */
+        if (!(t.cost[full] < 0.999f*origCost)) return origHeight;
+
+        /* the traversal stack only supports hierarchies of limited depth */
+        const size_t newHeight = height(t,full,heights);
+        if (depth+newHeight > BVH::maxBuildDepth) return origHeight;
+
+        size_t nextNode = 0;
+        emit(t,full,items,bounds,nodes,numNodes,nextNode);
+        return newHeight;
+      }
+
+      struct Treelet
+      {
+        BBox3fa bounds[MAX_TREELET_SUBSETS];
+        float cost[MAX_TREELET_SUBSETS];
+        float part[N][MAX_TREELET_SUBSETS];
+        unsigned char split[MAX_TREELET_SUBSETS];
+        unsigned char partSplit[N][MAX_TREELET_SUBSETS];
+      };
+
+      /*! returns the height of the optimal subtree over leaf set s */
+      size_t height(const Treelet& t, size_t s, const size_t* heights)
+      {
+        if ((s & (s-1)) == 0) return heights[__bsf(s)];
+
+        size_t h = 0;
+        size_t p = t.split[s];
+        size_t rest = s;
+        for (ssize_t k=N-2;; k--)
+        {
+          h = max(h,1+height(t,p,heights));
+          rest ^= p;
+          if (rest == 0) break;
+          assert(k >= 0);
+          p = t.partSplit[k][rest];
+        }
+        return h;
+      }
+
+      Node* emit(const Treelet& t, size_t s, const NodeRef* items, const BBox3fa* bounds, Node** nodes, size_t numNodes, size_t& nextNode)
+      {
+        /* reuse the nodes of the treelet, the first one is its root */
+        Node* node = nullptr;
+        if (nextNode < numNodes) node = nodes[nextNode++];
+        else node = (Node*) bvh->alloc.threadLocal2()->alloc0.malloc(sizeof(Node),BVH::byteNodeAlignment);
+        node->clear();
+
+        size_t slot = 0;
+        size_t p = t.split[s];
+        size_t rest = s;
+        for (ssize_t k=N-2;; k--)
+        {
+          if ((p & (p-1)) == 0) {
+            const size_t i = __bsf(p);
+            node->set(slot++,bounds[i],items[i]);
+          } else {
+            Node* child = emit(t,p,items,bounds,nodes,numNodes,nextNode);
+            node->set(slot++,t.bounds[p],BVH::encodeNode(child));
+          }
+          rest ^= p;
+          if (rest == 0) break;
+          assert(k >= 0);
+          p = t.partSplit[k][rest];
+        }
+        return node;
+      }
+
+    private:
+      BVH* bvh;
+    };
+
     template<int N, typename Primitive>
     struct CreateMortonLeaf;
 
@@ -353,8 +560,8 @@ namespace embree
 
     public:
       
-      BVHNMeshBuilderMorton (BVH* bvh, Mesh* mesh, const size_t minLeafSize, const size_t maxLeafSize)
-        : bvh(bvh), mesh(mesh), minLeafSize(minLeafSize), maxLeafSize(maxLeafSize), morton(bvh->device), numPrimitives(0) {}
+      BVHNMeshBuilderMorton (BVH* bvh, Mesh* mesh, const size_t minLeafSize, const size_t maxLeafSize, const size_t mode = 0)
+        : bvh(bvh), mesh(mesh), minLeafSize(minLeafSize), maxLeafSize(maxLeafSize), mode(mode), morton(bvh->device), numPrimitives(0) {}
       
       /*! Destruction */
       ~BVHNMeshBuilderMorton () {
@@ -450,6 +657,10 @@ namespace embree
         }
 #endif
 
+        /* optionally restructure treelets to recover SAH quality */
+        if (mode & MODE_TREELET_OPTIMIZE)
+          BVHNTreeletOptimizer<N>(bvh).optimize(bvh->root);
+
         /* clear temporary data for static geometry */
         if (mesh->isStatic()) 
         {
@@ -468,16 +679,17 @@ namespace embree
       Mesh* mesh;
       const size_t minLeafSize;
       const size_t maxLeafSize;
+      const size_t mode;
       size_t numPrimitives;
       mvector<MortonID32Bit> morton;
     };
     
-    Builder* BVH4Triangle4MeshBuilderMortonGeneral  (void* bvh, TriangleMesh* mesh, size_t mode) { return new class BVHNMeshBuilderMorton<4,TriangleMesh,Triangle4> ((BVH4*)bvh,mesh,4,4*BVH4::maxLeafBlocks); }
+    Builder* BVH4Triangle4MeshBuilderMortonGeneral  (void* bvh, TriangleMesh* mesh, size_t mode) { return new class BVHNMeshBuilderMorton<4,TriangleMesh,Triangle4> ((BVH4*)bvh,mesh,4,4*BVH4::maxLeafBlocks,mode); }
 #if defined(__AVX__)
-    Builder* BVH4Triangle8MeshBuilderMortonGeneral  (void* bvh, TriangleMesh* mesh, size_t mode) { return new class BVHNMeshBuilderMorton<4,TriangleMesh,Triangle8> ((BVH4*)bvh,mesh,8,8*BVH4::maxLeafBlocks); }
+    Builder* BVH4Triangle8MeshBuilderMortonGeneral  (void* bvh, TriangleMesh* mesh, size_t mode) { return new class BVHNMeshBuilderMorton<4,TriangleMesh,Triangle8> ((BVH4*)bvh,mesh,8,8*BVH4::maxLeafBlocks,mode); }
 #endif
-    Builder* BVH4Triangle4vMeshBuilderMortonGeneral (void* bvh, TriangleMesh* mesh, size_t mode) { return new class BVHNMeshBuilderMorton<4,TriangleMesh,Triangle4v>((BVH4*)bvh,mesh,4,4*BVH4::maxLeafBlocks); }
-    Builder* BVH4Triangle4iMeshBuilderMortonGeneral (void* bvh, TriangleMesh* mesh, size_t mode) { return new class BVHNMeshBuilderMorton<4,TriangleMesh,Triangle4i>((BVH4*)bvh,mesh,4,4*BVH4::maxLeafBlocks); }
+    Builder* BVH4Triangle4vMeshBuilderMortonGeneral (void* bvh, TriangleMesh* mesh, size_t mode) { return new class BVHNMeshBuilderMorton<4,TriangleMesh,Triangle4v>((BVH4*)bvh,mesh,4,4*BVH4::maxLeafBlocks,mode); }
+    Builder* BVH4Triangle4iMeshBuilderMortonGeneral (void* bvh, TriangleMesh* mesh, size_t mode) { return new class BVHNMeshBuilderMorton<4,TriangleMesh,Triangle4i>((BVH4*)bvh,mesh,4,4*BVH4::maxLeafBlocks,mode); }
   }
 }
 
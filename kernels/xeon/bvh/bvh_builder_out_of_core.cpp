@@ -0,0 +1,224 @@
+// ======================================================================== //
+// Copyright 2009-2015 Intel Corporation                                    //
+//                                                                          //
+// Licensed under the Apache License, Version 2.0 (the "License");          //
+// you may not use this file except in compliance with the License.         //
+// You may obtain a copy of the License at                                  //
+//                                                                          //
+//     http://www.apache.org/licenses/LICENSE-2.0                           //
+//                                                                          //
+// Unless required by applicable law or agreed to in writing, software      //
+// distributed under the License is distributed on an "AS IS" BASIS,        //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. //
+// See the License for the specific language governing permissions and      //
+// limitations under the License.                                           //
+// ======================================================================== //
+
+#include "bvh_builder_out_of_core.h"
+#include "bvh_cache.h"
+#include "../builders/bvh_builder_sah.h"
+#include "../geometry/paged_object.h"
+#include "../../common/scene_triangle_mesh.h"
+
+#include <iomanip>
+#include <sstream>
+
+namespace embree
+{
+  namespace isa
+  {
+    template<int N, typename Mesh>
+    BVHNBuilderOutOfCore<N,Mesh>::Object::Object (OutOfCoreCache* cache, Accel* accel, const FileName& fileName)
+      : OutOfCoreCache::Entry(cache), accel(accel), bvh((BVH*)accel->intersectors.ptr), fileName(fileName), key(0), bounds(empty), stored(false) 
+    {
+      intersectors = accel->intersectors;
+    }
+
+    template<int N, typename Mesh>
+    BVHNBuilderOutOfCore<N,Mesh>::Object::~Object ()
+    {
+      cache->remove(this);
+      if (stored) std::remove(fileName.c_str());
+      delete accel;
+    }
+
+    template<int N, typename Mesh>
+    void BVHNBuilderOutOfCore<N,Mesh>::Object::build(uint64_t key)
+    {
+      /* the BVH has to stay resident during the build */
+      cache->remove(this);
+      accel->build(0,0);
+      this->key = key;
+      bounds = bvh->root == BVH::emptyNode ? BBox3fa(empty) : bvh->bounds;
+
+      /* objects that cannot be written to disk stay resident */
+      stored = BVHNCache<N>::store(bvh,fileName,key);
+      cache->insert(this,bvh->alloc.getAllocatedBytes(),!stored);
+    }
+
+    template<int N, typename Mesh>
+    size_t BVHNBuilderOutOfCore<N,Mesh>::Object::pageIn()
+    {
+      if (!BVHNCache<N>::load(bvh,fileName,key)) return 0;
+      return max(bvh->alloc.getAllocatedBytes(),size_t(1));
+    }
+
+    template<int N, typename Mesh>
+    void BVHNBuilderOutOfCore<N,Mesh>::Object::pageOut() {
+      bvh->clear();
+    }
+
+    template<int N, typename Mesh>
+    BVHNBuilderOutOfCore<N,Mesh>::BVHNBuilderOutOfCore (BVH* bvh, Scene* scene, const createMeshAccelTy createMeshAccel)
+      : bvh(bvh), scene(scene), cache(scene->device->out_of_core_cache), createMeshAccel(createMeshAccel), prims(scene->device), generation(0) 
+    {
+      if (cache == nullptr)
+        throw_RTCError(RTC_INVALID_OPERATION,"out of core mode requires out_of_core_dir to be set");
+
+      baseKey = (uint64_t(1E6*getSeconds()) << 16) ^ uint64_t(size_t(this));
+    }
+    
+    template<int N, typename Mesh>
+    BVHNBuilderOutOfCore<N,Mesh>::~BVHNBuilderOutOfCore ()
+    {
+      for (size_t i=0; i<objects.size(); i++) 
+	delete objects[i];
+    }
+
+    template<int N, typename Mesh>
+    void BVHNBuilderOutOfCore<N,Mesh>::build(size_t threadIndex, size_t threadCount)
+    {
+      /* delete some objects */
+      size_t num = scene->size();
+      for (size_t i=num; i<objects.size(); i++) {
+        delete objects[i]; objects[i] = nullptr;
+      }
+
+      /* skip build for empty scene */
+      const size_t numPrimitives = scene->getNumPrimitives<Mesh,1>();
+      if (numPrimitives == 0) {
+        bvh->alloc.reset();
+        prims.resize(0);
+        bvh->set(BVH::emptyNode,empty,0);
+        return;
+      }
+
+      double t0 = bvh->preBuild(TOSTRING(isa) "::BVH" + toString(N) + "BuilderOutOfCore");
+
+      if (objects.size() < num) objects.resize(num,nullptr);
+      generation++;
+
+      /* build modified objects, which pages them out if the cache exceeds its budget */
+      parallel_for(size_t(0), num, [&] (const range<size_t>& r)
+      {
+        for (size_t objectID=r.begin(); objectID<r.end(); objectID++)
+        {
+          Mesh* mesh = scene->getSafe<Mesh>(objectID);
+          if (mesh == nullptr || mesh->numTimeSteps != 1) {
+            assert(objects[objectID] == nullptr);
+            continue;
+          }
+          if (!mesh->isEnabled())
+            continue;
+
+          if (objects[objectID] == nullptr) 
+          {
+            AccelData* accel = nullptr; Builder* builder = nullptr;
+            createMeshAccel(mesh,accel,builder);
+            assert(builder == nullptr);
+
+            std::stringstream name;
+            name << "ooc" << N << "." << std::hex << std::setw(16) << std::setfill('0') << baseKey << "." << std::dec << objectID << ".bin";
+            objects[objectID] = new Object(cache,(Accel*)accel,FileName(scene->device->out_of_core_dir) + name.str());
+          }
+          else if (!mesh->isModified())
+            continue;
+
+          objects[objectID]->build(baseKey + 0x9e3779b97f4a7c15ull*generation + objectID);
+        }
+      });
+
+      /* only the bounds of the objects are required for the toplevel hierarchy */
+      prims.resize(num);
+      PrimInfo pinfo(empty);
+      const bool masks = scene->hasGeometryMasks();
+      for (size_t objectID=0; objectID<num; objectID++)
+      {
+        Mesh* mesh = scene->getSafe<Mesh>(objectID);
+        Object* object = objects[objectID];
+        if (mesh == nullptr || object == nullptr || !mesh->isEnabled() || object->bounds.empty()) 
+          continue;
+        
+        object->intersectors.select(masks || scene->numIntersectionFilters1,
+                                    masks || scene->numIntersectionFilters4,
+                                    masks || scene->numIntersectionFilters8,
+                                    masks || scene->numIntersectionFilters16);
+        prims[pinfo.size()] = PrimRef(object->bounds,objectID);
+        pinfo.add(object->bounds);
+      }
+
+      bvh->alloc.reset();
+
+      /* skip if all objects where empty */
+      if (pinfo.size() == 0)
+        bvh->set(BVH::emptyNode,empty,0);
+
+      /* otherwise build toplevel hierarchy with one paged object per leaf */
+      else
+      {
+        NodeRef root;
+        BVHBuilderBinnedSAH::build<NodeRef>
+          (root,
+           [&] { return bvh->alloc.threadLocal2(); },
+           [&] (const isa::BVHBuilderBinnedSAH::BuildRecord& current, BVHBuilderBinnedSAH::BuildRecord* children, const size_t n, FastAllocator::ThreadLocal2* alloc) -> int
+           {
+             Node* node = (Node*) alloc->alloc0.malloc(sizeof(Node)); node->clear();
+             for (size_t i=0; i<n; i++) {
+               node->set(i,children[i].pinfo.geomBounds);
+               children[i].parent = (size_t*)&node->child(i);
+             }
+             *current.parent = bvh->encodeNode(node);
+             return 0;
+           },
+           [&] (const BVHBuilderBinnedSAH::BuildRecord& current, FastAllocator::ThreadLocal2* alloc) -> int
+           {
+             assert(current.prims.size() == 1);
+             PagedObject* leaf = (PagedObject*) alloc->alloc1.malloc(sizeof(PagedObject));
+             new (leaf) PagedObject(objects[prims[current.prims.begin()].ID()]);
+             *current.parent = bvh->encodeLeaf((char*)leaf,1);
+             return 1;
+           },
+           [&] (size_t dn) { bvh->scene->progressMonitor(0); },
+           prims.data(),pinfo,N,BVH::maxBuildDepthLeaf,N,1,1,1.0f,1.0f);
+        
+        bvh->set(root,pinfo.geomBounds,numPrimitives);
+      }
+
+      bvh->alloc.cleanup();
+      bvh->postBuild(t0);
+
+      if (bvh->device->verbosity(2))
+        cache->print();
+    }
+
+    template<int N, typename Mesh>
+    void BVHNBuilderOutOfCore<N,Mesh>::deleteGeometry(size_t geomID)
+    {
+      if (geomID >= objects.size()) return;
+      delete objects[geomID]; objects[geomID] = nullptr;
+    }
+
+    template<int N, typename Mesh>
+    void BVHNBuilderOutOfCore<N,Mesh>::clear()
+    {
+      for (size_t i=0; i<objects.size(); i++) {
+        delete objects[i]; objects[i] = nullptr;
+      }
+      prims.clear();
+    }
+
+    Builder* BVH4BuilderOutOfCoreTriangleMeshSAH (void* bvh, Scene* scene, const createTriangleMeshAccelTy createMeshAccel) {
+      return new BVHNBuilderOutOfCore<4,TriangleMesh>((BVH4*)bvh,scene,createMeshAccel);
+    }
+  }
+}
@@ -0,0 +1,89 @@
+// ======================================================================== //
+// Copyright 2009-2015 Intel Corporation                                    //
+//                                                                          //
+// Licensed under the Apache License, Version 2.0 (the "License");          //
+// you may not use this file except in compliance with the License.         //
+// You may obtain a copy of the License at                                  //
+//                                                                          //
+//     http://www.apache.org/licenses/LICENSE-2.0                           //
+//                                                                          //
+// Unless required by applicable law or agreed to in writing, software      //
+// distributed under the License is distributed on an "AS IS" BASIS,        //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. //
+// See the License for the specific language governing permissions and      //
+// limitations under the License.                                           //
+// ======================================================================== //
+
+#pragma once
+
+#include "bvh.h"
+#include "../../common/out_of_core_cache.h"
+
+namespace embree
+{
+  namespace isa
+  {
+    /*! Two level builder for scenes that do not fit into memory. The
+     *  BVH of each object is stored to a file after its build and
+     *  paged in on demand through the out of core cache of the
+     *  device. Only the toplevel hierarchy over the object bounds
+     *  stays resident. The create function has to return an Accel
+     *  that builds and traverses the BVH of a single mesh. */
+    template<int N, typename Mesh>
+    class BVHNBuilderOutOfCore : public Builder
+    {
+      ALIGNED_CLASS;
+
+      typedef BVHN<N> BVH;
+      typedef typename BVH::Node Node;
+      typedef typename BVH::NodeRef NodeRef;
+
+    public:
+
+      typedef void (*createMeshAccelTy)(Mesh* mesh, AccelData*& accel, Builder*& builder);
+
+      /*! BVH of some object that is backed by a file */
+      class Object : public OutOfCoreCache::Entry
+      {
+      public:
+        Object (OutOfCoreCache* cache, Accel* accel, const FileName& fileName);
+        ~Object ();
+
+        /*! builds the BVH of the object and pages it out if possible */
+        void build(uint64_t key);
+
+        size_t pageIn();
+        void pageOut();
+
+      public:
+        Accel* accel;        //!< acceleration structure of the object
+        BVH* bvh;            //!< BVH of the object, empty while paged out
+        FileName fileName;   //!< file the BVH gets paged out to
+        uint64_t key;        //!< key to verify the file content
+        BBox3fa bounds;      //!< bounds of the object, always resident
+        bool stored;         //!< true if the file got written
+      };
+      
+      /*! Constructor. */
+      BVHNBuilderOutOfCore (BVH* bvh, Scene* scene, const createMeshAccelTy createMeshAccel);
+      
+      /*! Destructor */
+      ~BVHNBuilderOutOfCore ();
+      
+      /*! builder entry point */
+      void build(size_t threadIndex, size_t threadCount);
+      void deleteGeometry(size_t geomID);
+      void clear();
+
+    public:
+      BVH* bvh;
+      Scene* scene;
+      OutOfCoreCache* cache;
+      createMeshAccelTy createMeshAccel;
+      std::vector<Object*> objects;
+      mvector<PrimRef> prims;
+      uint64_t baseKey;      //!< unique per builder, keeps file names of different scenes apart
+      size_t generation;     //!< incremented on every build to detect outdated files
+    };
+  }
+}
@@ -87,14 +87,15 @@ namespace embree
       const size_t minLeafSize;
       const size_t maxLeafSize;
       const float presplitFactor;
+      const bool quantized;
 
       BVHNBuilderSAH (BVH* bvh, Scene* scene, const size_t sahBlockSize, const float intCost, const size_t minLeafSize, const size_t maxLeafSize, const size_t mode)
         : bvh(bvh), scene(scene), mesh(nullptr), prims(scene->device), sahBlockSize(sahBlockSize), intCost(intCost), minLeafSize(minLeafSize), maxLeafSize(min(maxLeafSize,Primitive::max_size()*BVH::maxLeafBlocks)),
-          presplitFactor((mode & MODE_HIGH_QUALITY) ? 1.5f : 1.0f) {}
+          presplitFactor((mode & MODE_HIGH_QUALITY) ? 1.5f : 1.0f), quantized(mode & MODE_QUANTIZED) {}
 
       BVHNBuilderSAH (BVH* bvh, Mesh* mesh, const size_t sahBlockSize, const float intCost, const size_t minLeafSize, const size_t maxLeafSize, const size_t mode)
         : bvh(bvh), scene(nullptr), mesh(mesh), prims(bvh->device), sahBlockSize(sahBlockSize), intCost(intCost), minLeafSize(minLeafSize), maxLeafSize(min(maxLeafSize,Primitive::max_size()*BVH::maxLeafBlocks)),
-          presplitFactor((mode & MODE_HIGH_QUALITY) ? 1.5f : 1.0f) {}
+          presplitFactor((mode & MODE_HIGH_QUALITY) ? 1.5f : 1.0f), quantized(mode & MODE_QUANTIZED) {}
 
       // FIXME: shrink bvh->alloc in destructor here and in other builders too
 
@@ -124,10 +125,15 @@ namespace embree
         /* perform pre-splitting */
         if (presplitFactor > 1.0f) 
           pinfo = presplit<Mesh>(scene, pinfo, prims);
+        bvh->endBuildPhase(bvh->buildTimes.primrefs);
         
         /* call BVH builder */
         bvh->alloc.init_estimate(pinfo.size()*sizeof(PrimRef));
-        BVHNBuilder<N>::build(bvh,CreateLeaf<N,Primitive>(bvh,prims.data()),bvh->scene->progressInterface,prims.data(),pinfo,sahBlockSize,minLeafSize,maxLeafSize,travCost,intCost);
+        if (quantized)
+          BVHNBuilderQuantized<N>::build(bvh,CreateLeaf<N,Primitive>(bvh,prims.data()),bvh->scene->progressInterface,prims.data(),pinfo,sahBlockSize,minLeafSize,maxLeafSize,travCost,intCost);
+        else
+          BVHNBuilder<N>::build(bvh,CreateLeaf<N,Primitive>(bvh,prims.data()),bvh->scene->progressInterface,prims.data(),pinfo,sahBlockSize,minLeafSize,maxLeafSize,travCost,intCost);
+        bvh->endBuildPhase(bvh->buildTimes.hierarchy);
 
 #if PROFILE
           }); 
@@ -140,6 +146,7 @@ namespace embree
           bvh->shrink();
         }
 	bvh->cleanup();
+        bvh->endBuildPhase(bvh->buildTimes.finalize);
         bvh->postBuild(t0);
       }
 
@@ -174,6 +181,10 @@ namespace embree
     Builder* BVH8Quad4iSceneBuilderSAH     (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderSAH<8,QuadMesh,Quad4i>((BVH8*)bvh,scene,4,1.0f,4,inf,mode); }
 #endif
 
+#if defined(__AVX512F__)
+    Builder* BVH16Triangle4SceneBuilderSAH (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderSAH<16,TriangleMesh,Triangle4>((BVH16*)bvh,scene,4,1.0f,4,inf,mode); }
+#endif
+
     /* entry functions for the mesh builders */
     Builder* BVH4Line4iMeshBuilderSAH     (void* bvh, LineSegments* mesh, size_t mode) { return new BVHNBuilderSAH<4,LineSegments,Line4i>((BVH4*)bvh,mesh,4,1.0f,4,inf,mode); }
     Builder* BVH4Point4iMeshBuilderSAH    (void* bvh, Points* mesh, size_t mode)       { return new BVHNBuilderSAH<4,Points,Point4i>((BVH4*)bvh,mesh,4,1.0f,4,inf,mode); }
@@ -293,6 +304,7 @@ namespace embree
           }
           return num;
         },std::plus<size_t>());
+        bvh->endBuildPhase(bvh->buildTimes.primrefs);
         
         /* function that splits a primitive at some position and dimension */
         auto splitPrimitive = [&] (const PrimRef& prim, int dim, float pos, PrimRef& left_o, PrimRef& right_o) {
@@ -308,10 +320,12 @@ namespace embree
         bvh->alloc.init_estimate(pinfo.size()*sizeof(PrimRef));
         BVHNBuilderSpatial<N>::build(bvh,splitPrimitive,CreateListLeaf<N,Primitive>(bvh),bvh->scene->progressInterface,prims,pinfo,
                                     sahBlockSize,minLeafSize,maxLeafSize,travCost,intCost);
+        bvh->endBuildPhase(bvh->buildTimes.hierarchy);
         
         /* clear temporary data for static geometry */
 	if (scene->isStatic()) bvh->shrink();
 	bvh->cleanup();
+        bvh->endBuildPhase(bvh->buildTimes.finalize);
         bvh->postBuild(t0);
       }
 
@@ -340,7 +354,7 @@ namespace embree
       typedef BVHN<N> BVH;
       __forceinline CreateLeafMB (BVH* bvh, PrimRef* prims) : bvh(bvh), prims(prims) {}
       
-      __forceinline std::pair<BBox3fa,BBox3fa> operator() (const BVHBuilderBinnedSAH::BuildRecord& current, Allocator* alloc)
+      __forceinline std::pair<BBox3fa,BBox3fa> operator() (const BVHBuilderBinnedSAH::BuildRecord& current, Allocator* alloc, const BBox1f& time_range)
       {
         size_t items = Primitive::blocks(current.prims.size());
         size_t start = current.prims.begin();
@@ -349,7 +363,7 @@ namespace embree
 	BBox3fa bounds0 = empty;
 	BBox3fa bounds1 = empty;
         for (size_t i=0; i<items; i++) {
-          auto bounds = accel[i].fill_mblur(prims,start,current.prims.end(),bvh->scene,false);
+          auto bounds = accel[i].fill_mblur(prims,start,current.prims.end(),bvh->scene,false,time_range);
 	  bounds0.extend(bounds.first);
 	  bounds1.extend(bounds.second);
         }
@@ -365,6 +379,8 @@ namespace embree
     struct BVHNBuilderMblurSAH : public Builder
     {
       typedef BVHN<N> BVH;
+      typedef typename BVH::NodeRef NodeRef;
+      typedef typename BVH::NodeMB4D NodeMB4D;
       BVH* bvh;
       Scene* scene;
       Mesh* mesh;
@@ -380,6 +396,94 @@ namespace embree
       BVHNBuilderMblurSAH (BVH* bvh, Mesh* mesh, const size_t sahBlockSize, const float intCost, const size_t minLeafSize, const size_t maxLeafSize)
         : bvh(bvh), scene(nullptr), mesh(mesh), prims(mesh->parent->device), sahBlockSize(sahBlockSize), intCost(intCost), minLeafSize(minLeafSize), maxLeafSize(min(maxLeafSize,Primitive::max_size()*BVH::maxLeafBlocks)) {}
 
+      /*! returns the sorted times of all time steps of the geometry */
+      std::vector<float> timeSteps()
+      {
+        std::vector<float> times;
+        auto add = [&] (Mesh* mesh) {
+          const size_t numTimeSegments = mesh->numTimeSteps-1;
+          for (size_t i=0; i<=numTimeSegments; i++)
+            times.push_back(float(i)/float(numTimeSegments));
+        };
+        if (mesh) add(mesh);
+        else {
+          Scene::Iterator<Mesh,2> iter(scene);
+          for (size_t i=0; i<iter.size(); i++)
+            if (Mesh* mesh = iter.at(i)) add(mesh);
+        }
+        std::sort(times.begin(),times.end());
+        times.erase(std::unique(times.begin(),times.end()),times.end());
+        return times;
+      }
+
+      /*! creates the primitive references for the specified time range */
+      PrimInfo createPrimRefs(const BBox1f& time_range)
+      {
+        return mesh ? 
+          createPrimRefArrayMB<Mesh>(mesh,time_range,prims,bvh->scene->progressInterface) : 
+          createPrimRefArrayMB<Mesh>(scene,time_range,prims,bvh->scene->progressInterface);
+      }
+
+      /*! SAH cost of the primitives inside the specified time range, weighted by the length of the time range */
+      float primSAH(const BBox1f& time_range, BBox3fa& bounds)
+      {
+        const PrimInfo pinfo = createPrimRefs(time_range);
+        const float A = parallel_reduce(size_t(0),pinfo.size(),size_t(1024),0.0f,[&](const range<size_t>& r) -> float {
+            float A = 0.0f;
+            for (size_t i=r.begin(); i<r.end(); i++) A += halfArea(prims[i].bounds());
+            return A;
+          }, std::plus<float>());
+        bounds = pinfo.geomBounds;
+        return time_range.size()*intCost*A;
+      }
+
+      /*! recursively splits the time interval at time steps, builds a
+       *  BVH for each time range, and links these BVHs through nodes with
+       *  time ranges, returns linear bounds over the time range */
+      std::pair<BBox3fa,BBox3fa> recurse(NodeRef& root, const std::vector<float>& times, const size_t begin, const size_t end)
+      {
+        const BBox1f time_range(times[begin],times[end]);
+        
+        /* decide how to split the time range into up to N time ranges of equal number of time segments */
+        const size_t numSegments = end-begin;
+        const size_t numChildren = min(size_t(N),numSegments);
+        bool split = numSegments > 1 && Primitive::singleTimeSegment();
+        if (numSegments > 1 && !split) 
+        {
+          BBox3fa bounds; 
+          const float noSplitCost = primSAH(time_range,bounds);
+          float splitCost = time_range.size()*travCost*halfArea(bounds);
+          for (size_t i=0; i<numChildren; i++) {
+            BBox3fa cbounds;
+            splitCost += primSAH(BBox1f(times[begin+(i+0)*numSegments/numChildren],times[begin+(i+1)*numSegments/numChildren]),cbounds);
+          }
+          split = splitCost < noSplitCost;
+        }
+
+        /* build a single BVH for the time range */
+        if (!split) 
+        {
+          const PrimInfo pinfo = createPrimRefs(time_range);
+          return BVHNBuilderMblur<N>::build(root,bvh,CreateLeafMB<N,Primitive>(bvh,prims.data()),bvh->scene->progressInterface,prims.data(),pinfo,time_range,
+                                            sahBlockSize,minLeafSize,maxLeafSize,travCost,intCost);
+        }
+
+        /* otherwise link BVHs of smaller time ranges together */
+        NodeMB4D* node = (NodeMB4D*) bvh->alloc.threadLocal2()->alloc0.malloc(sizeof(NodeMB4D),BVH::byteNodeAlignment); node->clear();
+        BBox3fa bounds = empty;
+        for (size_t i=0; i<numChildren; i++)
+        {
+          const size_t cbegin = begin+(i+0)*numSegments/numChildren;
+          const size_t cend   = begin+(i+1)*numSegments/numChildren;
+          NodeRef child; const std::pair<BBox3fa,BBox3fa> cbounds = recurse(child,times,cbegin,cend);
+          node->set(i,cbounds.first,cbounds.second,BBox1f(times[cbegin],times[cend]));
+          node->set(i,child);
+          bounds.extend(merge(cbounds.first,cbounds.second));
+        }
+        root = BVH::encodeNode(node);
+        return std::make_pair(bounds,bounds);
+      }
+
       void build(size_t, size_t) 
       {
 	/* skip build for empty scene */
@@ -395,15 +499,27 @@ namespace embree
 	    
         //bvh->alloc.init_estimate(numPrimitives*sizeof(PrimRef));
         prims.resize(numPrimitives);
+
+        /* geometry with more than 2 time steps requires building over multiple time ranges */
+        const std::vector<float> times = timeSteps();
+        if (times.size() > 2)
+        {
+          bvh->alloc.init_estimate(numPrimitives*sizeof(PrimRef));
+          NodeRef root; 
+          const std::pair<BBox3fa,BBox3fa> bounds = recurse(root,times,0,times.size()-1);
+          bvh->set(root,merge(bounds.first,bounds.second),numPrimitives);
+        }
+        else
+        {
+          const PrimInfo pinfo = mesh ? 
+            createPrimRefArray<Mesh>(mesh,prims,bvh->scene->progressInterface) : 
+            createPrimRefArray<Mesh,2>(scene,prims,bvh->scene->progressInterface);
         
-        const PrimInfo pinfo = mesh ? 
-          createPrimRefArray<Mesh>(mesh,prims,bvh->scene->progressInterface) : 
-          createPrimRefArray<Mesh,2>(scene,prims,bvh->scene->progressInterface);
-        
-        /* call BVH builder */
-        bvh->alloc.init_estimate(pinfo.size()*sizeof(PrimRef));
-        BVHNBuilderMblur<N>::build(bvh,CreateLeafMB<N,Primitive>(bvh,prims.data()),bvh->scene->progressInterface,prims.data(),pinfo,
-                                  sahBlockSize,minLeafSize,maxLeafSize,travCost,intCost);
+          /* call BVH builder */
+          bvh->alloc.init_estimate(pinfo.size()*sizeof(PrimRef));
+          BVHNBuilderMblur<N>::build(bvh,CreateLeafMB<N,Primitive>(bvh,prims.data()),bvh->scene->progressInterface,prims.data(),pinfo,
+                                    sahBlockSize,minLeafSize,maxLeafSize,travCost,intCost);
+        }
         
 	/* clear temporary data for static geometry */
 	bool staticGeom = mesh ? mesh->isStatic() : scene->isStatic();
@@ -17,6 +17,7 @@
 #include "bvh.h"
 #include "bvh_refit.h"
 #include "bvh_builder.h"
+#include "bvh_cache.h"
 
 #include "../builders/primrefgen.h"
 #include "../builders/bvh_builder_sah.h"
@@ -31,12 +32,190 @@
 #include "../geometry/grid_aos.h"
 #include "../geometry/grid_soa.h"
 
+#include <iomanip>
+#include <sstream>
+#include <fstream>
+
 namespace embree
 {
   namespace isa
   {
     typedef FastAllocator::ThreadLocal2 Allocator;
 
+    /*! Persistent on-disk cache for the grids of the eager
+     *  subdivision builder. The file stores the grids of all
+     *  subpatches in build order together with the offset of the
+     *  first grid of each subpatch. Grids store no pointers, thus
+     *  loading just maps the file and copies the grids. */
+    class SubdivGridCache
+    {
+      /*! version of the file format, increase on every layout change */
+      static const unsigned VERSION = 1;
+
+      /*! file header */
+      struct Header
+      {
+        char magic[8];             //!< magic identifier "EMBRGRD"
+        unsigned version;          //!< file format version
+        unsigned gridBytes;        //!< size of the grid header
+        uint64_t key;              //!< hash of the geometry and build settings
+        uint64_t numSubPatches;    //!< number of subpatches
+        uint64_t bytes;            //!< size of the grid section
+      };
+
+      static __forceinline size_t offsetsOffset() { return (sizeof(Header)+63) & ~size_t(63); }
+      static __forceinline size_t gridsOffset(size_t numSubPatches) { return (offsetsOffset()+(numSubPatches+1)*sizeof(uint64_t)+63) & ~size_t(63); }
+
+    public:
+
+      SubdivGridCache () 
+        : file(nullptr), fileBytes(0), offsets(nullptr), grids(nullptr) {}
+
+      ~SubdivGridCache () {
+        if (file) os_unmap_file((void*)file,fileBytes);
+      }
+
+      /*! calculates the cache key from the subdivision meshes and build settings, returns 0 if the grids cannot be cached */
+      static uint64_t key(const Scene* scene, bool compress)
+      {
+        CacheHash hash;
+        hash.add(std::string("subdiv.grid.eager"));
+        hash.add(compress);
+        hash.add(offsetof(GridAOS,P));
+        hash.add(sizeof(GridAOS::CompressedPoint));
+
+        size_t numGeometries = 0;
+        for (size_t i=0; i<scene->size(); i++)
+        {
+          const Geometry* geom = scene->get(i);
+          if (geom == nullptr || geom->getType() != Geometry::SUBDIV_MESH || !geom->isEnabled()) continue;
+          const SubdivMesh* mesh = (const SubdivMesh*) geom;
+          numGeometries++;
+
+          /* the output of displacement functions is unknown to the cache */
+          if (mesh->displFunc) return 0;
+
+          hash.add(i);
+          hash.add(mesh->size());
+          hash.add(mesh->getBoundaryMode());
+          hash.add(mesh->faceVertices,sizeof(int));
+          hash.add(mesh->vertexIndices,sizeof(unsigned));
+          hash.add(mesh->getVertexBuffer(),sizeof(Vec3f));
+          hash.add(mesh->levels,sizeof(float));
+          hash.add(mesh->holes,sizeof(unsigned));
+          hash.add(mesh->edge_creases,sizeof(SubdivMesh::Edge));
+          hash.add(mesh->edge_crease_weights,sizeof(float));
+          hash.add(mesh->vertex_creases,sizeof(unsigned));
+          hash.add(mesh->vertex_crease_weights,sizeof(float));
+        }
+        if (numGeometries == 0) return 0;
+        return hash.h;
+      }
+
+      /*! returns the name of the cache file for some key */
+      static FileName fileName(const Scene* scene, uint64_t key)
+      {
+        std::stringstream name;
+        name << "subdiv.grids." << std::hex << std::setw(16) << std::setfill('0') << key << ".bin";
+        return FileName(scene->device->bvh_cache_dir) + name.str();
+      }
+
+      /*! maps the cache file, returns false if the file is missing or does not match */
+      bool load(const FileName& fileName, uint64_t key, size_t numSubPatches)
+      {
+        file = (const char*) os_map_file(fileName.c_str(),fileBytes);
+        if (file == nullptr) return false;
+
+        const Header& header = *(const Header*) file;
+        const size_t dataOffset = gridsOffset(numSubPatches);
+        bool valid = fileBytes >= dataOffset;
+        valid = valid && strncmp(header.magic,"EMBRGRD",sizeof(header.magic)) == 0;
+        valid = valid && header.version == VERSION && header.gridBytes == offsetof(GridAOS,P);
+        valid = valid && header.key == key && header.numSubPatches == numSubPatches;
+        valid = valid && header.bytes == fileBytes-dataOffset;
+        
+        /* offsets have to be increasing and stay inside the grid section */
+        offsets = (const uint64_t*) (file+offsetsOffset());
+        grids = file+dataOffset;
+        for (size_t i=0; valid && i<numSubPatches; i++)
+          valid = offsets[i] <= offsets[i+1];
+        valid = valid && offsets[0] == 0 && offsets[numSubPatches] == header.bytes;
+
+        if (!valid) {
+          os_unmap_file((void*)file,fileBytes);
+          file = nullptr; fileBytes = 0;
+          offsets = nullptr; grids = nullptr;
+        }
+        return valid;
+      }
+
+      /*! stores the grids referenced by the eager leaves, firstPrim contains the first leaf of each subpatch */
+      static bool store(const FileName& fileName, uint64_t key, const PrimRef* prims, const std::vector<size_t>& firstPrim, size_t align_mask)
+      {
+        const size_t numSubPatches = firstPrim.size()-1;
+        Header header;
+        memset(&header,0,sizeof(Header));
+        strncpy(header.magic,"EMBRGRD",sizeof(header.magic));
+        header.version = VERSION;
+        header.gridBytes = offsetof(GridAOS,P);
+        header.key = key;
+        header.numSubPatches = numSubPatches;
+
+        /* neighboring leaves of a subpatch share their grid */
+        std::vector<uint64_t> offsets(numSubPatches+1);
+        std::vector<const GridAOS*> grids;
+        size_t bytes = 0;
+        for (size_t i=0; i<numSubPatches; i++) 
+        {
+          offsets[i] = bytes;
+          const GridAOS* last = nullptr;
+          for (size_t j=firstPrim[i]; j<firstPrim[i+1]; j++) 
+          {
+            const GridAOS::EagerLeaf* leaf = (const GridAOS::EagerLeaf*) (prims[j].ID() & ~align_mask);
+            if (&leaf->grid == last) continue;
+            last = &leaf->grid;
+            grids.push_back(last);
+            bytes += GridAOS::bytes(last->width,last->height,last->compressed);
+          }
+        }
+        offsets[numSubPatches] = bytes;
+        header.bytes = bytes;
+
+        /* write to temporary file first and rename it, such that
+         * concurrent processes never see partially written files */
+        const std::string tmpName = fileName.str() + ".tmp" + toString(size_t(1E6*getSeconds()));
+        std::ofstream file(tmpName.c_str(), std::ios::out | std::ios::binary);
+        if (!file.is_open()) return false;
+
+        file.write((char*)&header,sizeof(Header));
+        while (file.tellp() < std::streampos(offsetsOffset())) { char c = 0; file.write(&c,1); }
+        file.write((char*)offsets.data(),offsets.size()*sizeof(uint64_t));
+        while (file.tellp() < std::streampos(gridsOffset(numSubPatches))) { char c = 0; file.write(&c,1); }
+        for (size_t i=0; i<grids.size(); i++)
+          file.write((const char*)grids[i],GridAOS::bytes(grids[i]->width,grids[i]->height,grids[i]->compressed));
+        file.close();
+
+        if (!file || std::rename(tmpName.c_str(),fileName.c_str()) != 0) {
+          std::remove(tmpName.c_str());
+          return false;
+        }
+        return true;
+      }
+
+      /*! returns true if the cache file got loaded */
+      __forceinline bool loaded() const { return file != nullptr; }
+
+      /*! returns the stored grids of subpatch i */
+      __forceinline const char* begin(size_t i) const { return grids+offsets[i+0]; }
+      __forceinline const char* end  (size_t i) const { return grids+offsets[i+1]; }
+
+    private:
+      const char* file;
+      size_t fileBytes;
+      const uint64_t* offsets;
+      const char* grids;
+    };
+
     template<int N>
     struct BVHNSubdivGridEagerBuilderBinnedSAHClass : public Builder
     {
@@ -52,6 +231,26 @@ namespace embree
       BVHNSubdivGridEagerBuilderBinnedSAHClass (BVH* bvh, Scene* scene)
         : bvh(bvh), scene(scene), prims(scene->device) {}
 
+      /*! Bounds the grid vertices of a mesh get quantized to. The limit
+       *  surface stays inside the bounds of the control vertices. */
+      static bool quantizationFrame(const SubdivMesh* mesh, BBox3fa& frame)
+      {
+        const BufferT<Vec3fa>& vertices = mesh->getVertexBuffer();
+        frame = parallel_reduce(size_t(0),vertices.size(),size_t(4096),BBox3fa(empty),[&](const range<size_t>& r) -> BBox3fa
+        {
+          BBox3fa bounds = empty;
+          for (size_t i=r.begin(); i<r.end(); i++) bounds.extend(vertices[i]);
+          return bounds;
+        }, [](const BBox3fa& a, const BBox3fa& b) { return merge(a,b); });
+
+        /* displaced vertices can only be quantized if the displacement is bounded */
+        if (mesh->displFunc) {
+          if (mesh->displBounds.empty()) return false;
+          frame = BBox3fa(frame.lower+mesh->displBounds.lower,frame.upper+mesh->displBounds.upper);
+        }
+        return !frame.empty() && is_finite(frame);
+      }
+
       void build(size_t, size_t) 
       {
         /* initialize all half edge structures */
@@ -110,9 +309,34 @@ namespace embree
           return;
         }
 
+        /* all grids of a mesh get quantized to the same bounds to keep the surface watertight */
+        const bool compress = scene->device->subdiv_grid_compression;
+        std::vector<BBox3fa> frames;
+        std::vector<bool> quantize;
+        if (compress) 
+        {
+          frames.resize(scene->size());
+          quantize.resize(scene->size(),false);
+          for (size_t i=0; i<iter.size(); i++)
+            if (iter[i]) quantize[iter[i]->id] = quantizationFrame(iter[i],frames[iter[i]->id]);
+        }
+
+        /* grids of static scenes get loaded from the persistent cache if possible */
+        SubdivGridCache cache;
+        const uint64_t key = (scene->device->bvh_cache_dir != "" && scene->isStatic()) ? SubdivGridCache::key(scene,compress) : 0;
+        const FileName cacheFile = key ? SubdivGridCache::fileName(scene,key) : FileName();
+        if (key) {
+          double t1 = getSeconds();
+          if (cache.load(cacheFile,key,numSubPatches) && scene->device->verbosity(1))
+            std::cout << "loading subdivision grids from " << cacheFile << " ... [DONE]  " << 1000.0f*(getSeconds()-t1) << "ms" << std::endl;
+        }
+        std::vector<size_t> firstPrim;
+        if (key && !cache.loaded()) firstPrim.resize(numSubPatches+1);
+
         PrimInfo pinfo3 = parallel_for_for_prefix_sum( pstate, iter, PrimInfo(empty), [&](SubdivMesh* mesh, const range<size_t>& r, size_t k, const PrimInfo& base) -> PrimInfo
         {
           FastAllocator::ThreadLocal& alloc = *bvh->alloc.threadLocal();
+          const BBox3fa* frame = (compress && quantize[mesh->id]) ? &frames[mesh->id] : nullptr;
           
           PrimInfo s(empty);
           for (size_t f=r.begin(); f!=r.end(); ++f) {
@@ -121,8 +345,20 @@ namespace embree
             patch_eval_subdivision(mesh->getHalfEdge(f),[&](const Vec2f uv[4], const int subdiv[4], const float edge_level[4], int subPatch)
             {
               SubdivPatch1Base patch(mesh->id,f,subPatch,mesh,uv,edge_level,subdiv,VSIZEX);
-              size_t num = GridAOS::createEager<N>(patch,scene,mesh,f,alloc,&prims[base.end+s.end]);
+              const size_t patchIndex = base.begin+s.begin;
+              size_t num = 0;
+
+              /* evaluate the patch again if its stored grids do not match */
+              if (cache.loaded()) {
+                const char* data = cache.begin(patchIndex);
+                num = GridAOS::loadEager<N>(patch,mesh,f,data,cache.end(patchIndex),alloc,&prims[base.end+s.end]);
+                if (data != cache.end(patchIndex)) num = 0;
+              }
+              if (num == 0)
+                num = GridAOS::createEager<N>(patch,scene,mesh,f,alloc,&prims[base.end+s.end],frame);
               assert(num == GridAOS::getNumEagerLeaves(patch.grid_u_res-1,patch.grid_v_res-1));
+
+              if (firstPrim.size()) firstPrim[patchIndex] = base.end+s.end;
               for (size_t i=0; i<num; i++)
                 s.add(prims[base.end+s.end].bounds());
               s.begin++;
@@ -131,6 +367,18 @@ namespace embree
           return s;
         }, [](const PrimInfo& a, const PrimInfo& b) -> PrimInfo { return PrimInfo::merge(a, b); });
 
+        /* the BVH build reorders the leaves, thus store the grids before */
+        if (firstPrim.size()) 
+        {
+          firstPrim[numSubPatches] = pinfo3.end;
+          double t1 = getSeconds();
+          const bool stored = SubdivGridCache::store(cacheFile,key,prims.data(),firstPrim,BVH::align_mask);
+          if (scene->device->verbosity(1)) {
+            if (stored) std::cout << "storing subdivision grids to " << cacheFile << " ... [DONE]  " << 1000.0f*(getSeconds()-t1) << "ms" << std::endl;
+            else        std::cout << "storing subdivision grids to " << cacheFile << " ... [FAILED]" << std::endl;
+          }
+        }
+
         PrimInfo pinfo(pinfo3.end,pinfo3.geomBounds,pinfo3.centBounds);
         
         auto createLeaf =  [&] (const BVHBuilderBinnedSAH::BuildRecord& current, Allocator* alloc) -> int {
@@ -22,6 +22,7 @@
 
 #define PROFILE 0
 #define MAX_OPEN_SIZE 10000
+#define MAX_UPDATE_SAH_DEGRADATION 1.3f
 
 namespace embree
 {
@@ -29,7 +30,7 @@ namespace embree
   {
     template<int N, typename Mesh>
     BVHNBuilderTwoLevel<N,Mesh>::BVHNBuilderTwoLevel (BVH* bvh, Scene* scene, const createMeshAccelTy createMeshAccel)
-      : bvh(bvh), objects(bvh->objects), scene(scene), createMeshAccel(createMeshAccel), refs(scene->device), prims(scene->device) {}
+      : bvh(bvh), objects(bvh->objects), scene(scene), createMeshAccel(createMeshAccel), refs(scene->device), prims(scene->device), dirty(scene->device), topSAH(0.0f), topSAHBuild(0.0f) {}
     
     template<int N, typename Mesh>
     BVHNBuilderTwoLevel<N,Mesh>::~BVHNBuilderTwoLevel ()
@@ -44,6 +45,7 @@ namespace embree
       /* delete some objects */
       size_t num = scene->size();
       if (num < objects.size()) {
+        topNodes.clear();
         parallel_for(num, objects.size(), [&] (const range<size_t>& r) {
             for (size_t i=r.begin(); i<r.end(); i++) {
               delete builders[i]; builders[i] = nullptr;
@@ -52,12 +54,11 @@ namespace embree
           });
       }
 
-      /* reset memory allocator */
-      bvh->alloc.reset();
-      
       /* skip build for empty scene */
       const size_t numPrimitives = scene->getNumPrimitives<Mesh,1>();
       if (numPrimitives == 0) {
+        bvh->alloc.reset();
+        topNodes.clear();
         prims.resize(0);
         bvh->set(BVH::emptyNode,empty,0);
         return;
@@ -74,7 +75,11 @@ namespace embree
       if (objects.size()  < num) objects.resize(num);
       if (builders.size() < num) builders.resize(num);
       if (refs.size()     < num) refs.resize(num);
+      if (dirty.size()    < num) dirty.resize(num);
+      objectRoots.resize(num,BVH::emptyNode);
+      objectSlots.resize(num);
       nextRef = 0;
+      nextDirty = 0;
       
       /* create of acceleration structures */
       parallel_for(size_t(0), num, [&] (const range<size_t>& r)
@@ -103,8 +108,11 @@ namespace embree
         {
           /* ignore if no triangle mesh or not enabled */
           Mesh* mesh = scene->getSafe<Mesh>(objectID);
-          if (mesh == nullptr || !mesh->isEnabled() || mesh->numTimeSteps != 1) 
+          if (mesh == nullptr || !mesh->isEnabled() || mesh->numTimeSteps != 1) {
+            if (objectRoots[objectID] != BVH::emptyNode)
+              dirty[nextDirty++] = BVHNBuilderTwoLevel::BuildRef(empty,BVH::emptyNode,objectID);
             continue;
+          }
         
           BVH*     object  = objects [objectID]; assert(object);
           Builder* builder = builders[objectID]; assert(builder);
@@ -116,10 +124,31 @@ namespace embree
             builder->build(0,0);
           
           /* create build primitive */
-          if (!object->bounds.empty())
-            refs[nextRef++] = BVHNBuilderTwoLevel::BuildRef(object->bounds,object->root);
+          const NodeRef root = object->bounds.empty() ? NodeRef(BVH::emptyNode) : object->root;
+          if (root != BVH::emptyNode)
+            refs[nextRef++] = BVHNBuilderTwoLevel::BuildRef(object->bounds,root,objectID);
+
+          /* remember objects the toplevel hierarchy has to get updated for */
+          if (mesh->isModified() || root != objectRoots[objectID])
+            dirty[nextDirty++] = BVHNBuilderTwoLevel::BuildRef(object->bounds,root,objectID);
         }
       });
+
+      /* try to update the toplevel hierarchy in place for the dirty objects only */
+      if (update(numPrimitives)) {
+        bvh->alloc.cleanup();
+        bvh->postBuild(t0);
+        return;
+      }
+
+      /* reset memory allocator */
+      bvh->alloc.reset();
+      topNodes.clear();
+
+      /* remember which root of each object the toplevel hierarchy references */
+      refs.resize(nextRef);
+      for (size_t i=0; i<objectRoots.size(); i++) objectRoots[i] = BVH::emptyNode;
+      for (size_t i=0; i<refs.size(); i++) objectRoots[refs[i].objectID] = refs[i].node;
       
       /* fast path for single geometry scenes */
       if (nextRef == 1) { 
@@ -128,7 +157,6 @@ namespace embree
       }
 
       /* open all large nodes */
-      refs.resize(nextRef);
       open_sequential(numPrimitives); 
       
       /* fast path for small geometries */
@@ -144,7 +172,7 @@ namespace embree
         PrimInfo pinfo(empty);
         for (size_t i=r.begin(); i<r.end(); i++) {
           pinfo.add(refs[i].bounds());
-          prims[i] = PrimRef(refs[i].bounds(),(size_t)refs[i].node);
+          prims[i] = PrimRef(refs[i].bounds(),i);
         }
         return pinfo;
       }, [] (const PrimInfo& a, const PrimInfo& b) { return PrimInfo::merge(a,b); });
@@ -173,13 +201,14 @@ namespace embree
            [&] (const BVHBuilderBinnedSAH::BuildRecord& current, FastAllocator::ThreadLocal2* alloc) -> int
            {
              assert(current.prims.size() == 1);
-             *current.parent = (NodeRef) prims[current.prims.begin()].ID();
+             *current.parent = refs[prims[current.prims.begin()].ID()].node;
              return 1;
            },
            [&] (size_t dn) { bvh->scene->progressMonitor(0); },
            prims.data(),pinfo,N,BVH::maxBuildDepthLeaf,N,1,1,1.0f,1.0f);
         
         bvh->set(root,pinfo.geomBounds,numPrimitives);
+        recordTopLevel(root);
       }
 
 #if PROFILE
@@ -194,6 +223,7 @@ namespace embree
     void BVHNBuilderTwoLevel<N,Mesh>::deleteGeometry(size_t geomID)
     {
       if (geomID >= objects.size()) return;
+      topNodes.clear();
       delete builders[geomID]; builders[geomID] = nullptr;
       delete objects [geomID]; objects [geomID] = nullptr;
     }
@@ -208,6 +238,103 @@ namespace embree
 	if (builders[i]) builders[i]->clear();
 
       refs.clear();
+      topNodes.clear();
+    }
+
+    template<int N, typename Mesh>
+    bool BVHNBuilderTwoLevel<N,Mesh>::update(size_t numPrimitives)
+    {
+      if (topNodes.empty())
+        return false;
+
+      /* objects that got not referenced by the last full build require a rebuild */
+      for (size_t i=0; i<nextDirty; i++)
+        if (dirty[i].node != BVH::emptyNode && objectSlots[dirty[i].objectID].size() == 0)
+          return false;
+
+      /* replace the first slot of each dirty object and clear all other slots, as opened subtrees got invalid */
+      for (size_t i=0; i<nextDirty; i++)
+      {
+        const BuildRef& ref = dirty[i];
+        const std::vector<ObjectSlot>& slots = objectSlots[ref.objectID];
+        for (size_t j=0; j<slots.size(); j++) {
+          if (j == 0) setTopLevelSlot(slots[j].node,slots[j].slot,ref.bounds(),ref.node);
+          else        setTopLevelSlot(slots[j].node,slots[j].slot,empty,BVH::emptyNode);
+        }
+        objectRoots[ref.objectID] = ref.node;
+      }
+
+      /* rebuild if quality of the toplevel hierarchy degraded too much */
+      const BBox3fa bounds = topNodes[0].node->bounds();
+      if (bounds.empty() || topSAH > MAX_UPDATE_SAH_DEGRADATION*topSAHBuild*halfArea(bounds))
+        return false;
+
+      bvh->set(bvh->root,bounds,numPrimitives);
+      return true;
+    }
+
+    template<int N, typename Mesh>
+    void BVHNBuilderTwoLevel<N,Mesh>::setTopLevelSlot(size_t nodeID, size_t slot, const BBox3fa& bounds, NodeRef child)
+    {
+      Node* node = topNodes[nodeID].node;
+      node->child(slot) = child;
+
+      /* update child bounds and refit ancestors until bounds do not change anymore */
+      BBox3fa b = bounds;
+      while (true)
+      {
+        const BBox3fa old = node->bounds(slot);
+        if (old.lower == b.lower && old.upper == b.upper) 
+          break;
+
+        topSAH += (b.empty() ? 0.0f : halfArea(b)) - (old.empty() ? 0.0f : halfArea(old));
+        node->set(slot,b);
+
+        const TopNode& top = topNodes[nodeID];
+        if (top.parent == size_t(-1)) break;
+        b = top.node->bounds();
+        nodeID = top.parent;
+        slot = top.slot;
+        node = topNodes[nodeID].node;
+      }
+    }
+
+    template<int N, typename Mesh>
+    void BVHNBuilderTwoLevel<N,Mesh>::recordTopLevel(NodeRef root)
+    {
+      topNodes.clear();
+      for (size_t i=0; i<objectSlots.size(); i++)
+        objectSlots[i].clear();
+
+      /* sorted list of references to identify the leaves of the toplevel hierarchy */
+      std::vector<std::pair<size_t,size_t> > leaves(refs.size());
+      for (size_t i=0; i<refs.size(); i++)
+        leaves[i] = std::make_pair((size_t)refs[i].node,refs[i].objectID);
+      std::sort(leaves.begin(),leaves.end());
+
+      topSAH = 0.0f;
+      std::vector<TopNode> stack;
+      stack.push_back(TopNode(root.node(),size_t(-1),0));
+      while (!stack.empty())
+      {
+        const size_t nodeID = topNodes.size();
+        topNodes.push_back(stack.back()); stack.pop_back();
+        Node* node = topNodes[nodeID].node;
+        
+        for (size_t i=0; i<N; i++) 
+        {
+          NodeRef child = node->child(i);
+          if (child == BVH::emptyNode) continue;
+          topSAH += halfArea(node->bounds(i));
+
+          auto leaf = std::lower_bound(leaves.begin(),leaves.end(),std::make_pair((size_t)child,size_t(0)));
+          if (leaf != leaves.end() && leaf->first == (size_t)child)
+            objectSlots[leaf->second].push_back(ObjectSlot(nodeID,i));
+          else
+            stack.push_back(TopNode(child.node(),nodeID,i));
+        }
+      }
+      topSAHBuild = topSAH/halfArea(bvh->bounds);
     }
 
     template<int N, typename Mesh>
@@ -225,12 +352,13 @@ namespace embree
         std::pop_heap (refs.begin(),refs.end()); 
         NodeRef ref = refs.back().node;
         if (ref.isLeaf()) break;
+        const size_t objectID = refs.back().objectID;
         refs.pop_back();    
         
         Node* node = ref.node();
         for (size_t i=0; i<N; i++) {
           if (node->child(i) == BVH::emptyNode) continue;
-          refs.push_back(BuildRef(node->bounds(i),node->child(i)));
+          refs.push_back(BuildRef(node->bounds(i),node->child(i),objectID));
           std::push_heap (refs.begin(),refs.end()); 
         }
       }
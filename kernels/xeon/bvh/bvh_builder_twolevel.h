@@ -40,8 +40,8 @@ namespace embree
       public:
         __forceinline BuildRef () {}
 
-        __forceinline BuildRef (const BBox3fa& bounds, NodeRef node)
-          : lower(bounds.lower), upper(bounds.upper), node(node)
+        __forceinline BuildRef (const BBox3fa& bounds, NodeRef node, size_t objectID)
+          : lower(bounds.lower), upper(bounds.upper), node(node), objectID(objectID)
         {
           if (node.isLeaf())
             lower.w = 0.0f;
@@ -61,6 +61,30 @@ namespace embree
         Vec3fa lower;
         Vec3fa upper;
         NodeRef node;
+        size_t objectID;
+      };
+
+      /*! node of the toplevel hierarchy, used for incremental updates */
+      struct TopNode
+      {
+        __forceinline TopNode (Node* node, size_t parent, size_t slot)
+          : node(node), parent(parent), slot(slot) {}
+
+      public:
+        Node* node;     //!< pointer to the node
+        size_t parent;  //!< index of parent node, or -1 for the root
+        size_t slot;    //!< child slot inside parent node
+      };
+
+      /*! child slot of the toplevel hierarchy that references some object */
+      struct ObjectSlot
+      {
+        __forceinline ObjectSlot (size_t node, size_t slot)
+          : node(node), slot(slot) {}
+
+      public:
+        size_t node;    //!< index of toplevel node
+        size_t slot;    //!< child slot inside that node
       };
       
       /*! Constructor. */
@@ -75,6 +99,17 @@ namespace embree
       void clear();
 
       void open_sequential(size_t numPrimitives);
+
+    private:
+
+      /*! updates the toplevel hierarchy in place for all dirty objects, returns false if a full rebuild is required */
+      bool update(size_t numPrimitives);
+
+      /*! records the toplevel hierarchy after a full build to enable incremental updates */
+      void recordTopLevel(NodeRef root);
+
+      /*! sets bounds and child of a toplevel node slot and refits all ancestors */
+      void setTopLevelSlot(size_t nodeID, size_t slot, const BBox3fa& bounds, NodeRef child);
       
     public:
       BVH* bvh;
@@ -88,6 +123,15 @@ namespace embree
       mvector<BuildRef> refs;
       mvector<PrimRef> prims;
       AlignedAtomicCounter32 nextRef;
+
+      /* state for incremental updates of the toplevel hierarchy */
+      mvector<BuildRef> dirty;                           //!< objects whose toplevel reference changed
+      AlignedAtomicCounter32 nextDirty;
+      std::vector<NodeRef> objectRoots;                  //!< root of each object as referenced by the toplevel hierarchy
+      std::vector<std::vector<ObjectSlot> > objectSlots; //!< toplevel slots of each object
+      std::vector<TopNode> topNodes;                     //!< toplevel nodes, empty if no incremental update is possible
+      float topSAH;                                      //!< sum of child areas of all toplevel nodes
+      float topSAHBuild;                                 //!< normalized SAH cost after the last full build
     };
   }
 }
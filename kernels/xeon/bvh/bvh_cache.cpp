@@ -0,0 +1,349 @@
+// ======================================================================== //
+// Copyright 2009-2015 Intel Corporation                                    //
+//                                                                          //
+// Licensed under the Apache License, Version 2.0 (the "License");          //
+// you may not use this file except in compliance with the License.         //
+// You may obtain a copy of the License at                                  //
+//                                                                          //
+//     http://www.apache.org/licenses/LICENSE-2.0                           //
+//                                                                          //
+// Unless required by applicable law or agreed to in writing, software      //
+// distributed under the License is distributed on an "AS IS" BASIS,        //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. //
+// See the License for the specific language governing permissions and      //
+// limitations under the License.                                           //
+// ======================================================================== //
+
+
+#include "bvh_cache.h"
+#include "../../algorithms/parallel_for.h"
+
+#include <iomanip>
+#include <sstream>
+#include <fstream>
+
+namespace embree
+{
+  namespace isa
+  {
+    template<int N>
+    int BVHNCache<N>::geometryType(const BVH* bvh)
+    {
+      /* only primitive types that store no pointers can be cached */
+      const std::string& name = bvh->primTy.name;
+      if (name == "triangle4" || name == "triangle4v" || name == "triangle4vmb" || name == "triangle8") return Geometry::TRIANGLE_MESH;
+      if (name == "quad4v" || name == "quad4i" || name == "quad4imb") return Geometry::QUAD_MESH;
+      if (name == "bezier1v" || name == "bezier1i") return Geometry::BEZIER_CURVES;
+      if (name == "line4i" ) return Geometry::LINE_SEGMENTS;
+      if (name == "point4i") return Geometry::POINTS;
+      return 0;
+    }
+
+    template<int N>
+    uint64_t BVHNCache<N>::key(const BVH* bvh, int geomType)
+    {
+      const Scene* scene = bvh->scene;
+      const Device* device = bvh->device;
+
+      CacheHash hash;
+      hash.add(N);
+      hash.add(bvh->primTy.name);
+      hash.add(scene->flags);
+
+      /* acceleration structure selection determines the node format */
+      hash.add(device->tri_accel);
+      hash.add(device->tri_accel_mb);
+      hash.add(device->quad_accel);
+      hash.add(device->quad_accel_mb);
+      hash.add(device->line_accel);
+      hash.add(device->line_accel_mb);
+      hash.add(device->point_accel);
+      hash.add(device->point_accel_mb);
+      hash.add(device->hair_accel);
+      hash.add(device->hair_accel_mb);
+
+      /* build settings that influence the BVH */
+      hash.add(device->tri_builder);
+      hash.add(device->tri_builder_mb);
+      hash.add(device->tri_builder_replication_factor);
+      hash.add(device->quad_builder);
+      hash.add(device->quad_builder_mb);
+      hash.add(device->line_builder);
+      hash.add(device->line_builder_mb);
+      hash.add(device->point_builder);
+      hash.add(device->point_builder_mb);
+      hash.add(device->hair_builder);
+      hash.add(device->hair_builder_replication_factor);
+
+      /* geometry the BVH is build over */
+      size_t numGeometries = 0;
+      for (size_t i=0; i<scene->size(); i++)
+      {
+        const Geometry* geom = scene->get(i);
+        if (geom == nullptr || geom->getType() != geomType || !geom->isEnabled()) continue;
+        numGeometries++;
+
+        hash.add(i);
+        hash.add(geom->numTimeSteps);
+        hash.add(geom->mask);
+        hash.add(geom->size());
+
+        switch (geomType) 
+        {
+        case Geometry::TRIANGLE_MESH: {
+          const TriangleMesh* mesh = (const TriangleMesh*) geom;
+          hash.add(mesh->triangles,sizeof(TriangleMesh::Triangle));
+          for (size_t t=0; t<mesh->numTimeSteps; t++) hash.add(mesh->vertices[t],sizeof(Vec3f));
+          break;
+        }
+        case Geometry::QUAD_MESH: {
+          const QuadMesh* mesh = (const QuadMesh*) geom;
+          hash.add(mesh->quads,sizeof(QuadMesh::Quad));
+          for (size_t t=0; t<mesh->numTimeSteps; t++) hash.add(mesh->vertices[t],sizeof(Vec3f));
+          break;
+        }
+        case Geometry::BEZIER_CURVES: {
+          const BezierCurves* curves = (const BezierCurves*) geom;
+          hash.add(curves->curves,sizeof(int));
+          for (size_t t=0; t<curves->numTimeSteps; t++) hash.add(curves->vertices[t],sizeof(Vec3fa));
+          break;
+        }
+        case Geometry::LINE_SEGMENTS: {
+          const LineSegments* lines = (const LineSegments*) geom;
+          hash.add(lines->segments,sizeof(int));
+          for (size_t t=0; t<lines->numTimeSteps; t++) hash.add(lines->vertices[t],sizeof(Vec3fa));
+          break;
+        }
+        case Geometry::POINTS: {
+          const Points* points = (const Points*) geom;
+          for (size_t t=0; t<points->numTimeSteps; t++) hash.add(points->vertices[t],sizeof(Vec3fa));
+          break;
+        }
+        }
+      }
+
+      /* nothing to cache if the scene contains no such geometry */
+      if (numGeometries == 0) return 0;
+      return hash.h;
+    }
+
+    template<int N>
+    FileName BVHNCache<N>::fileName(const BVH* bvh, uint64_t key)
+    {
+      std::stringstream name;
+      name << "bvh" << N << "." << bvh->primTy.name << "." << std::hex << std::setw(16) << std::setfill('0') << key << ".bin";
+      return FileName(bvh->device->bvh_cache_dir) + name.str();
+    }
+
+    template<int N>
+    void BVHNCache<N>::initHeader(Header& header, const BVH* bvh, uint64_t key)
+    {
+      memset(&header,0,sizeof(Header));
+      strncpy(header.magic,"EMBRBVH",sizeof(header.magic));
+      header.version = VERSION;
+      header.branchingFactor = N;
+      strncpy(header.primTy,bvh->primTy.name.c_str(),sizeof(header.primTy)-1);
+      header.primBytes = bvh->primTy.bytes;
+      header.nodeBytes[0] = sizeof(typename BVH::Node);
+      header.nodeBytes[1] = sizeof(typename BVH::NodeMB);
+      header.nodeBytes[2] = sizeof(typename BVH::UnalignedNode);
+      header.nodeBytes[3] = sizeof(typename BVH::UnalignedNodeMB);
+      header.nodeBytes[4] = sizeof(typename BVH::TransformNode);
+      header.nodeBytes[5] = sizeof(typename BVH::QuantizedNode);
+      header.nodeBytes[6] = sizeof(typename BVH::NodeMB4D);
+      header.key = key;
+    }
+
+    template<int N>
+    size_t BVHNCache<N>::nodeBytes(const BVH* bvh, NodeRef ref)
+    {
+      if (ref.isLeaf()) {
+        size_t num; ref.leaf(num);
+        return num*bvh->primTy.bytes;
+      }
+      switch (ref.type()) {
+      case BVH::tyNode           : return sizeof(typename BVH::Node);
+      case BVH::tyNodeMB         : return sizeof(typename BVH::NodeMB);
+      case BVH::tyUnalignedNode  : return sizeof(typename BVH::UnalignedNode);
+      case BVH::tyUnalignedNodeMB: return sizeof(typename BVH::UnalignedNodeMB);
+      case BVH::tyTransformNode  : return sizeof(typename BVH::TransformNode);
+      case BVH::tyQuantizedNode  : return sizeof(typename BVH::QuantizedNode);
+      case BVH::tyNodeMB4D       : return sizeof(typename BVH::NodeMB4D);
+      default                    : return 0;
+      }
+    }
+
+    template<int N>
+    size_t BVHNCache<N>::serialize(const BVH* bvh, NodeRef ref, std::vector<char>& data)
+    {
+      /* empty leaves reference no memory */
+      const size_t bytes = nodeBytes(bvh,ref);
+      if (bytes == 0) return ref;
+
+      const size_t ofs = (data.size()+dataAlignment-1) & ~(dataAlignment-1);
+      const char* ptr = (const char*) (size_t(ref) & ~BVH::align_mask);
+      data.resize(ofs+bytes);
+      memcpy(&data[ofs],ptr,bytes);
+
+      /* all node types store their child references at the beginning of the node */
+      if (!ref.isLeaf()) 
+      {
+        const size_t numChildren = ref.isTransformNode() ? 1 : N;
+        for (size_t i=0; i<numChildren; i++) {
+          const size_t child = serialize(bvh,((const NodeRef*)ptr)[i],data);
+          memcpy(&data[ofs+i*sizeof(NodeRef)],&child,sizeof(NodeRef));
+        }
+      }
+      return ofs | (size_t(ref) & BVH::align_mask);
+    }
+
+    template<int N>
+    bool BVHNCache<N>::relocate(const BVH* bvh, NodeRef& ref, char* base, size_t bytes, size_t depth)
+    {
+      if (ref.isLeaf()) {
+        size_t num; ref.leaf(num);
+        if (num == 0) return true;
+      }
+
+      /* reject references outside the data section */
+      const size_t size = nodeBytes(bvh,ref);
+      const size_t ofs = size_t(ref) & ~BVH::align_mask;
+      if (size == 0 || ofs > bytes || size > bytes-ofs || depth > BVH::maxDepth) 
+        return false;
+
+      ref = NodeRef(size_t(base+ofs) | (size_t(ref) & BVH::align_mask));
+      if (ref.isLeaf()) return true;
+
+      NodeRef* children = (NodeRef*) (base+ofs);
+      const size_t numChildren = ref.isTransformNode() ? 1 : N;
+      for (size_t i=0; i<numChildren; i++)
+        if (!relocate(bvh,children[i],base,bytes,depth+1)) return false;
+      
+      return true;
+    }
+
+    template<int N>
+    bool BVHNCache<N>::load(BVH* bvh, const FileName& fileName, uint64_t key)
+    {
+      size_t fileBytes = 0;
+      const char* file = (const char*) os_map_file(fileName.c_str(),fileBytes);
+      if (file == nullptr) return false;
+
+      /* verify that file matches the BVH layout of this build */
+      Header expected; initHeader(expected,bvh,key);
+      const Header& header = *(const Header*) file;
+      const size_t dataOffset = (sizeof(Header)+63) & ~size_t(63);
+      if (fileBytes < dataOffset || memcmp(&header,&expected,offsetof(Header,bounds)) != 0 || 
+          header.bytes == 0 || header.bytes != fileBytes-dataOffset) 
+      {
+        os_unmap_file((void*)file,fileBytes);
+        return false;
+      }
+
+      /* copy data section into BVH memory */
+      const size_t bytes = header.bytes;
+      bvh->alloc.clear();
+      char* data = (char*) bvh->alloc.mallocBlock(bytes);
+      parallel_for(size_t(0), bytes, size_t(4*1024*1024), [&](const range<size_t>& r) {
+          memcpy(data+r.begin(),file+dataOffset+r.begin(),r.size());
+        });
+
+      NodeRef root = header.root;
+      const BBox3fa bounds(Vec3fa(header.bounds[0],header.bounds[1],header.bounds[2]),
+                           Vec3fa(header.bounds[3],header.bounds[4],header.bounds[5]));
+      const size_t numPrimitives = header.numPrimitives;
+      const size_t numVertices = header.numVertices;
+      os_unmap_file((void*)file,fileBytes);
+
+      /* translate offsets into pointers */
+      if (!relocate(bvh,root,data,bytes,0)) {
+        bvh->alloc.clear();
+        return false;
+      }
+      bvh->set(root,bounds,numPrimitives);
+      bvh->numVertices = numVertices;
+      return true;
+    }
+
+    template<int N>
+    bool BVHNCache<N>::store(const BVH* bvh, const FileName& fileName, uint64_t key)
+    {
+      Header header; initHeader(header,bvh,key);
+      header.bounds[0] = bvh->bounds.lower.x; header.bounds[1] = bvh->bounds.lower.y; header.bounds[2] = bvh->bounds.lower.z;
+      header.bounds[3] = bvh->bounds.upper.x; header.bounds[4] = bvh->bounds.upper.y; header.bounds[5] = bvh->bounds.upper.z;
+      header.numPrimitives = bvh->numPrimitives;
+      header.numVertices = bvh->numVertices;
+
+      std::vector<char> data;
+      header.root = serialize(bvh,bvh->root,data);
+      header.bytes = data.size();
+      if (header.bytes == 0) return false;
+
+      /* write to temporary file first and rename it, such that
+       * concurrent processes never see partially written files */
+      const std::string tmpName = fileName.str() + ".tmp" + toString(size_t(1E6*getSeconds()));
+      std::ofstream file(tmpName.c_str(), std::ios::out | std::ios::binary);
+      if (!file.is_open()) return false;
+      
+      const size_t dataOffset = (sizeof(Header)+63) & ~size_t(63);
+      file.write((char*)&header,sizeof(Header));
+      while (file.tellp() < std::streampos(dataOffset)) { char c = 0; file.write(&c,1); }
+      file.write(data.data(),data.size());
+      file.close();
+
+      if (!file || std::rename(tmpName.c_str(),fileName.c_str()) != 0) {
+        std::remove(tmpName.c_str());
+        return false;
+      }
+      return true;
+    }
+
+    template<int N>
+    void BVHNCacheBuilder<N>::build(size_t threadIndex, size_t threadCount)
+    {
+      /* only BVHs of static scenes get cached */
+      const int geomType = BVHNCache<N>::geometryType(bvh);
+      const uint64_t key = (bvh->device->bvh_cache_dir != "" && bvh->scene->isStatic() && geomType) ? BVHNCache<N>::key(bvh,geomType) : 0;
+      if (key == 0) {
+        builder->build(threadIndex,threadCount);
+        return;
+      }
+
+      const FileName fileName = BVHNCache<N>::fileName(bvh,key);
+      double t0 = getSeconds();
+      if (BVHNCache<N>::load(bvh,fileName,key)) 
+      {
+        if (bvh->device->verbosity(1))
+          std::cout << "loading BVH" << N << "<" << bvh->primTy.name << "> from " << fileName << " ... [DONE]  " << 1000.0f*(getSeconds()-t0) << "ms" << std::endl;
+        return;
+      }
+
+      builder->build(threadIndex,threadCount);
+      if (bvh->root == BVH::emptyNode) return;
+
+      /* failing to write the cache is not an error */
+      t0 = getSeconds();
+      const bool stored = BVHNCache<N>::store(bvh,fileName,key);
+      if (bvh->device->verbosity(1)) {
+        if (stored) std::cout << "storing BVH" << N << "<" << bvh->primTy.name << "> to " << fileName << " ... [DONE]  " << 1000.0f*(getSeconds()-t0) << "ms" << std::endl;
+        else        std::cout << "storing BVH" << N << "<" << bvh->primTy.name << "> to " << fileName << " ... [FAILED]" << std::endl;
+      }
+    }
+
+    template class BVHNCache<4>;
+    template class BVHNCacheBuilder<4>;
+
+    Builder* BVH4CacheBuilder(void* bvh, Scene* scene, Builder* builder) { 
+      return new BVHNCacheBuilder<4>((BVH4*)bvh,builder); 
+    }
+
+#if defined(__AVX__)
+    template class BVHNCache<8>;
+    template class BVHNCacheBuilder<8>;
+
+    Builder* BVH8CacheBuilder(void* bvh, Scene* scene, Builder* builder) { 
+      return new BVHNCacheBuilder<8>((BVH8*)bvh,builder); 
+    }
+#endif
+  }
+}
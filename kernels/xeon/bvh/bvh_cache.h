@@ -0,0 +1,159 @@
+// ======================================================================== //
+// Copyright 2009-2015 Intel Corporation                                    //
+//                                                                          //
+// Licensed under the Apache License, Version 2.0 (the "License");          //
+// you may not use this file except in compliance with the License.         //
+// You may obtain a copy of the License at                                  //
+//                                                                          //
+//     http://www.apache.org/licenses/LICENSE-2.0                           //
+//                                                                          //
+// Unless required by applicable law or agreed to in writing, software      //
+// distributed under the License is distributed on an "AS IS" BASIS,        //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. //
+// See the License for the specific language governing permissions and      //
+// limitations under the License.                                           //
+// ======================================================================== //
+
+
+#pragma once
+
+#include "../bvh/bvh.h"
+#include "../../common/builder.h"
+
+namespace embree
+{
+  namespace isa
+  {
+    /*! 64 bit FNV-1a hash that processes the data in 4 byte words */
+    struct CacheHash
+    {
+      __forceinline CacheHash () 
+        : h(0xcbf29ce484222325ull) {}
+
+      __forceinline void add(const void* ptr, size_t bytes) 
+      {
+        const char* p = (const char*) ptr;
+        size_t i=0;
+        for (; i+4<=bytes; i+=4) {
+          unsigned w; memcpy(&w,p+i,4);
+          h = (h ^ w) * 0x100000001b3ull;
+        }
+        for (; i<bytes; i++) 
+          h = (h ^ (unsigned char)p[i]) * 0x100000001b3ull;
+      }
+
+      template<typename T>
+      __forceinline void add(const T& v) { 
+        add(&v,sizeof(T)); 
+      }
+
+      __forceinline void add(const std::string& str) {
+        add(str.size());
+        add(str.c_str(),str.size());
+      }
+
+      /*! hashes the first 'bytes' bytes of each buffer element */
+      __forceinline void add(const Buffer& buffer, size_t bytes) 
+      {
+        add(buffer.size());
+        for (size_t i=0; i<buffer.size(); i++)
+          add(buffer.getPtr(i),bytes);
+      }
+
+    public:
+      uint64_t h;
+    };
+
+    /*! Persistent on-disk cache for BVHs of static scenes. A cached
+     *  BVH is stored in a versioned file with all node and leaf
+     *  references encoded as offsets into the data section, which
+     *  makes the file position independent. Loading maps the file and
+     *  relocates these offsets. */
+    template<int N>
+    class BVHNCache
+    {
+      /*! Type shortcuts */
+      typedef BVHN<N> BVH;
+      typedef typename BVH::NodeRef NodeRef;
+
+      /*! version of the file format, increase on every layout change */
+      static const unsigned VERSION = 3;
+
+      /*! alignment of the nodes and leaves inside the data section */
+      static const size_t dataAlignment = 32;
+
+      /*! file header */
+      struct Header
+      {
+        char magic[8];             //!< magic identifier "EMBRBVH"
+        unsigned version;          //!< file format version
+        unsigned branchingFactor;  //!< branching factor of the BVH
+        char primTy[32];           //!< name of the primitive type
+        uint64_t primBytes;        //!< size of one primitive block
+        uint64_t nodeBytes[7];     //!< size of each node type, used to detect layout changes
+        uint64_t key;              //!< hash of the geometry and build settings
+        float bounds[6];           //!< bounds of the BVH
+        uint64_t numPrimitives;    //!< number of primitives in the BVH
+        uint64_t numVertices;      //!< number of vertices referenced by the BVH
+        uint64_t root;             //!< root reference relative to the data section
+        uint64_t bytes;            //!< size of the data section
+      };
+
+    public:
+
+      /*! returns the geometry type the BVH is build over, or 0 if the primitive type cannot be cached */
+      static int geometryType(const BVH* bvh);
+
+      /*! calculates the cache key of the BVH from the scene geometry and build settings */
+      static uint64_t key(const BVH* bvh, int geomType);
+
+      /*! returns the name of the cache file for some key */
+      static FileName fileName(const BVH* bvh, uint64_t key);
+
+      /*! loads the BVH from the cache file, returns false if the file is missing or does not match */
+      static bool load(BVH* bvh, const FileName& fileName, uint64_t key);
+
+      /*! stores the BVH into the cache file, returns false on failure */
+      static bool store(const BVH* bvh, const FileName& fileName, uint64_t key);
+
+    private:
+      static void initHeader(Header& header, const BVH* bvh, uint64_t key);
+      static size_t nodeBytes(const BVH* bvh, NodeRef ref);
+      static size_t serialize(const BVH* bvh, NodeRef ref, std::vector<char>& data);
+      static bool relocate(const BVH* bvh, NodeRef& ref, char* base, size_t bytes, size_t depth);
+    };
+
+    /*! Builder that loads the BVH from the persistent cache and only
+     *  invokes the wrapped builder on a cache miss. */
+    template<int N>
+    class BVHNCacheBuilder : public Builder
+    {
+      ALIGNED_CLASS;
+
+      /*! Type shortcuts */
+      typedef BVHN<N> BVH;
+
+    public:
+      BVHNCacheBuilder (BVH* bvh, Builder* builder)
+        : bvh(bvh), builder(builder) {}
+
+      ~BVHNCacheBuilder() {
+        delete builder;
+      }
+
+      void build(size_t threadIndex, size_t threadCount);
+
+      void deleteGeometry(size_t geomID) {
+        builder->deleteGeometry(geomID);
+      }
+
+      void clear() {
+        builder->clear();
+      }
+
+    private:
+      BVH* bvh;
+      Builder* builder;
+    };
+  }
+}
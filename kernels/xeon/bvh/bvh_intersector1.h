@@ -46,5 +46,19 @@ namespace embree
       static void intersect(const BVH* This, Ray& ray);
       static void occluded (const BVH* This, Ray& ray);
     };
+
+    /*! BVH packet intersector that traces each active ray of the
+     *  packet with the single ray intersector. Used for BVHs with
+     *  transform nodes, as each ray of the packet may enter a
+     *  different instance. */
+    template<int N, int K, int types, bool robust, typename PrimitiveIntersector1>
+      class BVHNIntersectorKFrom1
+    {
+      typedef BVHN<N> BVH;
+
+    public:
+      static void intersect(vint<K>* valid, BVH* bvh, RayK<K>& ray);
+      static void occluded (vint<K>* valid, BVH* bvh, RayK<K>& ray);
+    };
   }
 }
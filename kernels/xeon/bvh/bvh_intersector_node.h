@@ -266,6 +266,24 @@ namespace embree
       dist = tNear;
       return mask;
     }
+
+    template<>
+      __forceinline size_t intersectNode<16,16>(const typename BVH16::Node* node, const TravRay<16,16>& ray, const vfloat16& tnear, const vfloat16& tfar, vfloat16& dist)
+    {
+      const vfloat16 tNearX = msub(vfloat16::load((float*)((const char*)&node->lower_x+ray.nearX)), ray.rdir.x, ray.org_rdir.x);
+      const vfloat16 tNearY = msub(vfloat16::load((float*)((const char*)&node->lower_x+ray.nearY)), ray.rdir.y, ray.org_rdir.y);
+      const vfloat16 tNearZ = msub(vfloat16::load((float*)((const char*)&node->lower_x+ray.nearZ)), ray.rdir.z, ray.org_rdir.z);
+      const vfloat16 tFarX  = msub(vfloat16::load((float*)((const char*)&node->lower_x+ray.farX )), ray.rdir.x, ray.org_rdir.x);
+      const vfloat16 tFarY  = msub(vfloat16::load((float*)((const char*)&node->lower_x+ray.farY )), ray.rdir.y, ray.org_rdir.y);
+      const vfloat16 tFarZ  = msub(vfloat16::load((float*)((const char*)&node->lower_x+ray.farZ )), ray.rdir.z, ray.org_rdir.z);
+
+      const vfloat16 tNear  = max(tNearX,tNearY,tNearZ,tnear);
+      const vfloat16 tFar   = min(tFarX ,tFarY ,tFarZ ,tfar);
+      const vbool16 vmask   = tNear <= tFar;
+      const size_t mask     = movemask(vmask);
+      dist = tNear;
+      return mask;
+    }
     
 #endif
 
@@ -376,6 +394,71 @@ namespace embree
       return lhit;
     }
 
+    /*! intersection with single ray, children whose time range does not contain the ray time are culled */
+    template<int N>
+      __forceinline size_t intersectNode(const typename BVHN<N>::NodeMB4D* node, const TravRay<N,N>& ray, const vfloat<N>& tnear, const vfloat<N>& tfar, const float time, vfloat<N>& dist)
+    {
+      const size_t mask = intersectNode<N>((const typename BVHN<N>::NodeMB*)node,ray,tnear,tfar,time,dist);
+      const vbool<N> tmask = (node->lower_t <= vfloat<N>(time)) & (vfloat<N>(time) <= node->upper_t);
+      return mask & movemask(tmask);
+    }
+
+    /*! intersection with ray packet of size K, children whose time range does not contain the ray time are culled */
+    template<int N, int K>
+    __forceinline vbool<K> intersectNode(const typename BVHN<N>::NodeMB4D* node, const size_t i, const Vec3<vfloat<K>>& org, const Vec3<vfloat<K>>& rdir, const Vec3<vfloat<K>>& org_rdir,
+                                         const vfloat<K>& tnear, const vfloat<K>& tfar, const vfloat<K>& time, vfloat<K>& dist)
+    {
+      const vbool<K> vmask = intersectNode<N,K>((const typename BVHN<N>::NodeMB*)node,i,org,rdir,org_rdir,tnear,tfar,time,dist);
+      return vmask & (vfloat<K>(node->lower_t[i]) <= time) & (time <= vfloat<K>(node->upper_t[i]));
+    }
+
+    /*! intersection of single ray with quantized node, the near and far
+     *  plane offsets of the ray are scaled from float to byte arrays */
+    template<int N>
+      __forceinline size_t intersectNode(const typename BVHN<N>::QuantizedNode* node, const TravRay<N,N>& ray, const vfloat<N>& tnear, const vfloat<N>& tfar, vfloat<N>& dist)
+    {
+      const unsigned char* q = node->lower_x;
+      const vfloat<N> startX(node->start.x), startY(node->start.y), startZ(node->start.z);
+      const vfloat<N> scaleX(node->scale.x), scaleY(node->scale.y), scaleZ(node->scale.z);
+      const vfloat<N> nearX = startX + scaleX*vfloat<N>::load(q+ray.nearX/sizeof(float));
+      const vfloat<N> nearY = startY + scaleY*vfloat<N>::load(q+ray.nearY/sizeof(float));
+      const vfloat<N> nearZ = startZ + scaleZ*vfloat<N>::load(q+ray.nearZ/sizeof(float));
+      const vfloat<N> farX  = startX + scaleX*vfloat<N>::load(q+ray.farX /sizeof(float));
+      const vfloat<N> farY  = startY + scaleY*vfloat<N>::load(q+ray.farY /sizeof(float));
+      const vfloat<N> farZ  = startZ + scaleZ*vfloat<N>::load(q+ray.farZ /sizeof(float));
+
+      const vfloat<N> tNearX = (nearX - ray.org.x) * ray.rdir.x;
+      const vfloat<N> tNearY = (nearY - ray.org.y) * ray.rdir.y;
+      const vfloat<N> tNearZ = (nearZ - ray.org.z) * ray.rdir.z;
+      const vfloat<N> tFarX  = (farX  - ray.org.x) * ray.rdir.x;
+      const vfloat<N> tFarY  = (farY  - ray.org.y) * ray.rdir.y;
+      const vfloat<N> tFarZ  = (farZ  - ray.org.z) * ray.rdir.z;
+      const vfloat<N> tNear = max(tNearX,tNearY,tNearZ,tnear);
+      const vfloat<N> tFar  = min(tFarX ,tFarY ,tFarZ ,tfar);
+      const vbool<N> vmask = tNear <= tFar;
+      dist = tNear;
+      return movemask(vmask);
+    }
+
+    /*! intersection of ray packet of size K with quantized node */
+    template<int N, int K>
+      __forceinline vbool<K> intersectNode(const typename BVHN<N>::QuantizedNode* node, size_t i, const Vec3<vfloat<K>>& org, const Vec3<vfloat<K>>& rdir, const Vec3<vfloat<K>>& org_rdir,
+                                           const vfloat<K>& tnear, const vfloat<K>& tfar, vfloat<K>& dist)
+    {
+      const BBox3fa bounds = node->bounds(i);
+      const vfloat<K> lclipMinX = (bounds.lower.x - org.x) * rdir.x;
+      const vfloat<K> lclipMinY = (bounds.lower.y - org.y) * rdir.y;
+      const vfloat<K> lclipMinZ = (bounds.lower.z - org.z) * rdir.z;
+      const vfloat<K> lclipMaxX = (bounds.upper.x - org.x) * rdir.x;
+      const vfloat<K> lclipMaxY = (bounds.upper.y - org.y) * rdir.y;
+      const vfloat<K> lclipMaxZ = (bounds.upper.z - org.z) * rdir.z;
+      const vfloat<K> lnearP = maxi(maxi(mini(lclipMinX, lclipMaxX), mini(lclipMinY, lclipMaxY)), mini(lclipMinZ, lclipMaxZ));
+      const vfloat<K> lfarP  = mini(mini(maxi(lclipMinX, lclipMaxX), maxi(lclipMinY, lclipMaxY)), maxi(lclipMinZ, lclipMaxZ));
+      const vbool<K> lhit    = maxi(lnearP,tnear) <= mini(lfarP,tfar);
+      dist = lnearP;
+      return lhit;
+    }
+
     /*! intersect N OBBs with single ray */
     template<int N>
       __forceinline size_t intersectNode(const typename BVHN<N>::UnalignedNode* node, const TravRay<N,N>& ray, const vfloat<N>& tnear, const vfloat<N>& tfar, vfloat<N>& dist)
@@ -462,7 +545,18 @@ namespace embree
     {
       static __forceinline bool intersect(const typename BVHN<N>::NodeRef& node, const TravRay<N,Nx>& ray, const vfloat<N>& tnear, const vfloat<N>& tfar, const float time, vfloat<N>& dist, size_t& mask)
       {
-        mask = intersectNode<N>(node.nodeMB(),ray,tnear,tfar,time,dist);
+        if (likely(node.isNodeMB())) mask = intersectNode<N>(node.nodeMB(),ray,tnear,tfar,time,dist);
+        else                         mask = intersectNode<N>(node.nodeMB4D(),ray,tnear,tfar,time,dist);
+        return true;
+      }
+    };
+
+    template<int N, int Nx>
+      struct BVHNNodeIntersector1<N,Nx,BVH_QN1,false>
+    {
+      static __forceinline bool intersect(const typename BVHN<N>::NodeRef& node, const TravRay<N,Nx>& ray, const vfloat<N>& tnear, const vfloat<N>& tfar, const float time, vfloat<N>& dist, size_t& mask)
+      {
+        mask = intersectNode<N>(node.quantizedNode(),ray,tnear,tfar,dist);
         return true;
       }
     };
@@ -534,10 +628,21 @@ namespace embree
       static __forceinline bool intersect(const typename BVHN<N>::NodeRef& node, const size_t i, const Vec3<vfloat<K>>& org, const Vec3<vfloat<K>>& rdir, const Vec3<vfloat<K>>& org_rdir,
                                           const vfloat<K>& tnear, const vfloat<K>& tfar, const vfloat<K>& time, vfloat<K>& dist, vbool<K>& vmask)
       {
-        vmask = intersectNode<N,K>(node.nodeMB(),i,org,rdir,org_rdir,tnear,tfar,time,dist);
+        if (likely(node.isNodeMB())) vmask = intersectNode<N,K>(node.nodeMB(),i,org,rdir,org_rdir,tnear,tfar,time,dist);
+        else                         vmask = intersectNode<N,K>(node.nodeMB4D(),i,org,rdir,org_rdir,tnear,tfar,time,dist);
+        return true;
+      }
+    };
+
+    template<int N, int K>
+    struct BVHNNodeIntersectorK<N,K,BVH_QN1,false>
+    {
+      static __forceinline bool intersect(const typename BVHN<N>::NodeRef& node, const size_t i, const Vec3<vfloat<K>>& org, const Vec3<vfloat<K>>& rdir, const Vec3<vfloat<K>>& org_rdir,
+                                          const vfloat<K>& tnear, const vfloat<K>& tfar, const vfloat<K>& time, vfloat<K>& dist, vbool<K>& vmask)
+      {
+        vmask = intersectNode<N,K>(node.quantizedNode(),i,org,rdir,org_rdir,tnear,tfar,dist);
         return true;
       }
     };
   }
 }
-
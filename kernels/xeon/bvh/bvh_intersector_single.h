@@ -91,6 +91,7 @@ namespace embree
             /*! stop if we found a leaf node */
             if (unlikely(cur.isLeaf())) break;
             STAT3(normal.trav_nodes,1,1,1);
+            TRAVSTAT(normal.nodes,1);
 
             /* intersect node */
             BVHNNodeIntersector1<N,Nx,types,robust>::intersect(cur,vray,ray_near,ray_far,ray.time[k],tNear,mask);
@@ -107,6 +108,7 @@ namespace embree
           assert(cur != BVH::emptyNode);
 	  STAT3(normal.trav_leaves, 1, 1, 1);
 	  size_t num; Primitive* prim = (Primitive*)cur.leaf(num);
+          TRAVSTAT(normal.leaves,1); TRAVSTAT(normal.prims,num);
 
           size_t lazy_node = 0;
           PrimitiveIntersectorK::intersect(pre, ray, k, prim, num, bvh->scene, lazy_node);
@@ -151,6 +153,7 @@ namespace embree
             /*! stop if we found a leaf node */
             if (unlikely(cur.isLeaf())) break;
             STAT3(shadow.trav_nodes,1,1,1);
+            TRAVSTAT(shadow.nodes,1);
 
             /* intersect node */
             BVHNNodeIntersector1<N,Nx,types,robust>::intersect(cur,vray,ray_near,ray_far,ray.time[k],tNear,mask);
@@ -167,6 +170,7 @@ namespace embree
           assert(cur != BVH::emptyNode);
 	  STAT3(shadow.trav_leaves,1,1,1);
 	  size_t num; Primitive* prim = (Primitive*) cur.leaf(num);
+          TRAVSTAT(shadow.leaves,1); TRAVSTAT(shadow.prims,num);
 
           size_t lazy_node = 0;
           if (PrimitiveIntersectorK::occluded(pre,ray,k,prim,num,bvh->scene,lazy_node)) {
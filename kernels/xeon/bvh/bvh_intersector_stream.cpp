@@ -0,0 +1,142 @@
+// ======================================================================== //
+// Copyright 2009-2015 Intel Corporation                                    //
+//                                                                          //
+// Licensed under the Apache License, Version 2.0 (the "License");          //
+// you may not use this file except in compliance with the License.         //
+// You may obtain a copy of the License at                                  //
+//                                                                          //
+//     http://www.apache.org/licenses/LICENSE-2.0                           //
+//                                                                          //
+// Unless required by applicable law or agreed to in writing, software      //
+// distributed under the License is distributed on an "AS IS" BASIS,        //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. //
+// See the License for the specific language governing permissions and      //
+// limitations under the License.                                           //
+// ======================================================================== //
+
+
+#include "bvh_intersector_stream.h"
+#include "../../algorithms/sort.h"
+
+namespace embree
+{
+  namespace isa
+  {
+    template<int K>
+    __forceinline void intersectPacket(Scene* scene, vint<K>* valid, RayK<K>& ray);
+    template<int K>
+    __forceinline void occludedPacket(Scene* scene, vint<K>* valid, RayK<K>& ray);
+
+#if defined (__SSE__)
+    template<> __forceinline void intersectPacket<4>(Scene* scene, vint4* valid, Ray4& ray) { scene->intersect4(valid,(RTCRay4&)ray); }
+    template<> __forceinline void occludedPacket <4>(Scene* scene, vint4* valid, Ray4& ray) { scene->occluded4 (valid,(RTCRay4&)ray); }
+#endif
+#if defined (__AVX__)
+    template<> __forceinline void intersectPacket<8>(Scene* scene, vint8* valid, Ray8& ray) { scene->intersect8(valid,(RTCRay8&)ray); }
+    template<> __forceinline void occludedPacket <8>(Scene* scene, vint8* valid, Ray8& ray) { scene->occluded8 (valid,(RTCRay8&)ray); }
+#endif
+#if defined (__AVX512F__)
+    template<> __forceinline void intersectPacket<16>(Scene* scene, vint16* valid, Ray16& ray) { scene->intersect16(valid,(RTCRay16&)ray); }
+    template<> __forceinline void occludedPacket <16>(Scene* scene, vint16* valid, Ray16& ray) { scene->occluded16 (valid,(RTCRay16&)ray); }
+#endif
+
+    template<int K>
+    template<typename RayStream>
+    void RayStreamFilter<K>::computeKeys(const RayStream& stream, const size_t begin, const size_t n, RayKey* keys)
+    {
+      /* compute bounds of all ray origins */
+      BBox3fa bounds = empty;
+      for (size_t i=0; i<n; i++)
+        bounds.extend(stream.getOrg(begin+i));
+
+      const Vec3fa diag = bounds.size();
+      const float lattice = float(ORG_LATTICE_SIZE_PER_DIM) * 0.99f;
+      const float scalex = diag.x > 1E-19f ? lattice / diag.x : 0.0f;
+      const float scaley = diag.y > 1E-19f ? lattice / diag.y : 0.0f;
+      const float scalez = diag.z > 1E-19f ? lattice / diag.z : 0.0f;
+
+      /* sort key is the direction octant followed by the morton code of the ray origin */
+      for (size_t i=0; i<n; i++)
+      {
+        const Vec3fa org = stream.getOrg(begin+i);
+        const Vec3fa dir = stream.getDir(begin+i);
+        const unsigned int octant = (dir.x < 0.0f ? 1 : 0) | (dir.y < 0.0f ? 2 : 0) | (dir.z < 0.0f ? 4 : 0);
+        const unsigned int ox = (unsigned int) max(0.0f,min(lattice,(org.x-bounds.lower.x)*scalex));
+        const unsigned int oy = (unsigned int) max(0.0f,min(lattice,(org.y-bounds.lower.y)*scaley));
+        const unsigned int oz = (unsigned int) max(0.0f,min(lattice,(org.z-bounds.lower.z)*scalez));
+        keys[i].code  = (octant << (3*ORG_BITS_PER_DIM)) | bitInterleave(ox,oy,oz);
+        keys[i].index = (unsigned int)(begin+i);
+      }
+    }
+
+    template<int K>
+    template<typename RayStream>
+    void RayStreamFilter<K>::tracePackets(Scene* scene, const RayStream& stream, const RayKey* keys, const size_t n, const bool intersect)
+    {
+      for (size_t i=0; i<n; )
+      {
+        const unsigned int octant = keys[i].octant();
+        size_t m = 1;
+        while (m < K && i+m < n && keys[i+m].octant() == octant) m++;
+
+        /* packets with low utilization are traced as single rays */
+        if (4*m <= K)
+        {
+          for (size_t j=0; j<m; j++)
+            stream.trace1(scene,keys[i+j].index,intersect);
+        }
+        else
+        {
+          RayK<K> ray; vint<K> valid(zero);
+          for (size_t j=0; j<K; j++)
+            stream.gather(ray,j,keys[i+min(j,m-1)].index);
+          for (size_t j=0; j<m; j++)
+            valid[j] = -1;
+
+          if (intersect) intersectPacket<K>(scene,&valid,ray);
+          else           occludedPacket <K>(scene,&valid,ray);
+
+          for (size_t j=0; j<m; j++)
+            stream.scatter(ray,j,keys[i+j].index,intersect);
+        }
+        i += m;
+      }
+    }
+
+    template<int K>
+    template<typename RayStream>
+    void RayStreamFilter<K>::filter(Scene* scene, const RayStream& stream, const size_t N, const bool intersect)
+    {
+      /* with ray sorting enabled, large streams get sorted as a whole
+       * using a parallel radix sort to extract more coherent packets */
+      if (scene->device->ray_sorting && N > MAX_RAYS_PER_CHUNK)
+      {
+        std::vector<RayKey> keys(N), tmp(N);
+        computeKeys(stream,0,N,keys.data());
+        radix_sort_u32(keys.data(),tmp.data(),N);
+        tracePackets(scene,stream,keys.data(),N,intersect);
+        return;
+      }
+
+      __aligned(64) RayKey keys[MAX_RAYS_PER_CHUNK];
+
+      for (size_t s=0; s<N; s+=MAX_RAYS_PER_CHUNK)
+      {
+        const size_t n = min(N-s,MAX_RAYS_PER_CHUNK);
+        computeKeys(stream,s,n,keys);
+        std::sort(keys,keys+n);
+        tracePackets(scene,stream,keys,n,intersect);
+      }
+    }
+
+    void rayStreamFilterAOS(Scene* scene, RTCRay* rays, const size_t M, const size_t stride, const bool intersect) {
+      RayStreamFilter<VSIZEX>::filter(scene,RayStreamAOS(rays,stride),M,intersect);
+    }
+
+    void rayStreamFilterSOP(Scene* scene, const RTCRayNp& rays, const size_t N, const bool intersect) {
+      RayStreamFilter<VSIZEX>::filter(scene,RayStreamSOP(rays),N,intersect);
+    }
+
+    RayStreamFilterFuncs rayStreamFilters(rayStreamFilterAOS,rayStreamFilterSOP);
+  }
+}
@@ -0,0 +1,195 @@
+// ======================================================================== //
+// Copyright 2009-2015 Intel Corporation                                    //
+//                                                                          //
+// Licensed under the Apache License, Version 2.0 (the "License");          //
+// you may not use this file except in compliance with the License.         //
+// You may obtain a copy of the License at                                  //
+//                                                                          //
+//     http://www.apache.org/licenses/LICENSE-2.0                           //
+//                                                                          //
+// Unless required by applicable law or agreed to in writing, software      //
+// distributed under the License is distributed on an "AS IS" BASIS,        //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. //
+// See the License for the specific language governing permissions and      //
+// limitations under the License.                                           //
+// ======================================================================== //
+
+
+#pragma once
+
+#include "../../common/ray_stream.h"
+#include "../../common/ray.h"
+#include "../../common/scene.h"
+#include "../../../include/embree2/rtcore_ray.h"
+
+namespace embree
+{
+  namespace isa
+  {
+    /*! Accessor for a stream of rays in array of structures layout. */
+    struct RayStreamAOS
+    {
+      __forceinline RayStreamAOS(RTCRay* rays, const size_t stride)
+        : ptr((char*)rays), stride(stride) {}
+
+      __forceinline RTCRay& get(const size_t i) const {
+        return *(RTCRay*)(ptr + i*stride);
+      }
+
+      __forceinline Vec3fa getOrg(const size_t i) const {
+        const RTCRay& ray = get(i); return Vec3fa(ray.org[0],ray.org[1],ray.org[2]);
+      }
+
+      __forceinline Vec3fa getDir(const size_t i) const {
+        const RTCRay& ray = get(i); return Vec3fa(ray.dir[0],ray.dir[1],ray.dir[2]);
+      }
+
+      /*! copies ray i into lane k of a ray packet */
+      template<int K>
+      __forceinline void gather(RayK<K>& ray, const size_t k, const size_t i) const
+      {
+        const RTCRay& r = get(i);
+        ray.org.x[k] = r.org[0]; ray.org.y[k] = r.org[1]; ray.org.z[k] = r.org[2];
+        ray.dir.x[k] = r.dir[0]; ray.dir.y[k] = r.dir[1]; ray.dir.z[k] = r.dir[2];
+        ray.tnear[k] = r.tnear; ray.tfar[k] = r.tfar; ray.time[k] = r.time; ray.mask[k] = r.mask;
+        ray.geomID[k] = r.geomID; ray.primID[k] = r.primID; ray.instID[k] = r.instID;
+      }
+
+      /*! copies the hit of lane k of a ray packet back to ray i */
+      template<int K>
+      __forceinline void scatter(const RayK<K>& ray, const size_t k, const size_t i, const bool intersect) const
+      {
+        RTCRay& r = get(i);
+        r.geomID = ray.geomID[k];
+        if (!intersect) return;
+        r.tfar = ray.tfar[k];
+        r.Ng[0] = ray.Ng.x[k]; r.Ng[1] = ray.Ng.y[k]; r.Ng[2] = ray.Ng.z[k];
+        r.u = ray.u[k]; r.v = ray.v[k];
+        r.primID = ray.primID[k]; r.instID = ray.instID[k];
+      }
+
+      /*! traces ray i through the single ray path */
+      __forceinline void trace1(Scene* scene, const size_t i, const bool intersect) const
+      {
+        if (intersect) scene->intersect(get(i));
+        else           scene->occluded (get(i));
+      }
+
+    private:
+      char* ptr;
+      size_t stride;
+    };
+
+    /*! Accessor for a stream of rays in structure of pointers layout. */
+    struct RayStreamSOP
+    {
+      __forceinline RayStreamSOP(const RTCRayNp& rays)
+        : rays(rays) {}
+
+      __forceinline Vec3fa getOrg(const size_t i) const {
+        return Vec3fa(rays.orgx[i],rays.orgy[i],rays.orgz[i]);
+      }
+
+      __forceinline Vec3fa getDir(const size_t i) const {
+        return Vec3fa(rays.dirx[i],rays.diry[i],rays.dirz[i]);
+      }
+
+      /*! copies ray i into lane k of a ray packet */
+      template<int K>
+      __forceinline void gather(RayK<K>& ray, const size_t k, const size_t i) const
+      {
+        ray.org.x[k] = rays.orgx[i]; ray.org.y[k] = rays.orgy[i]; ray.org.z[k] = rays.orgz[i];
+        ray.dir.x[k] = rays.dirx[i]; ray.dir.y[k] = rays.diry[i]; ray.dir.z[k] = rays.dirz[i];
+        ray.tnear[k] = rays.tnear ? rays.tnear[i] : 0.0f;
+        ray.tfar [k] = rays.tfar[i];
+        ray.time [k] = rays.time ? rays.time[i] : 0.0f;
+        ray.mask [k] = rays.mask ? rays.mask[i] : -1;
+        ray.geomID[k] = rays.geomID[i]; ray.primID[k] = rays.primID[i];
+        ray.instID[k] = rays.instID ? rays.instID[i] : -1;
+      }
+
+      /*! copies the hit of lane k of a ray packet back to ray i */
+      template<int K>
+      __forceinline void scatter(const RayK<K>& ray, const size_t k, const size_t i, const bool intersect) const
+      {
+        rays.geomID[i] = ray.geomID[k];
+        if (!intersect) return;
+        rays.tfar[i] = ray.tfar[k];
+        if (rays.Ngx) rays.Ngx[i] = ray.Ng.x[k];
+        if (rays.Ngy) rays.Ngy[i] = ray.Ng.y[k];
+        if (rays.Ngz) rays.Ngz[i] = ray.Ng.z[k];
+        rays.u[i] = ray.u[k]; rays.v[i] = ray.v[k];
+        rays.primID[i] = ray.primID[k];
+        if (rays.instID) rays.instID[i] = ray.instID[k];
+      }
+
+      /*! traces ray i through the single ray path */
+      __forceinline void trace1(Scene* scene, const size_t i, const bool intersect) const
+      {
+        Ray ray(getOrg(i),getDir(i),
+                rays.tnear ? rays.tnear[i] : 0.0f, rays.tfar[i],
+                rays.time ? rays.time[i] : 0.0f, rays.mask ? rays.mask[i] : -1);
+        ray.geomID = rays.geomID[i]; ray.primID = rays.primID[i];
+        ray.instID = rays.instID ? rays.instID[i] : -1;
+        if (intersect) scene->intersect((RTCRay&)ray);
+        else           scene->occluded ((RTCRay&)ray);
+
+        rays.geomID[i] = ray.geomID;
+        if (!intersect) return;
+        rays.tfar[i] = ray.tfar;
+        if (rays.Ngx) rays.Ngx[i] = ray.Ng.x;
+        if (rays.Ngy) rays.Ngy[i] = ray.Ng.y;
+        if (rays.Ngz) rays.Ngz[i] = ray.Ng.z;
+        rays.u[i] = ray.u; rays.v[i] = ray.v;
+        rays.primID[i] = ray.primID;
+        if (rays.instID) rays.instID[i] = ray.instID;
+      }
+
+    private:
+      const RTCRayNp& rays;
+    };
+
+    /*! Sorts the rays of a stream by direction octant and origin,
+     *  and traces them as packets of K rays. */
+    template<int K>
+    class RayStreamFilter
+    {
+      /* number of rays that get sorted together */
+      static const size_t MAX_RAYS_PER_CHUNK = 256;
+
+      /* number of bits per dimension used to quantize the ray origins */
+      static const size_t ORG_BITS_PER_DIM = 9;
+      static const size_t ORG_LATTICE_SIZE_PER_DIM = size_t(1) << ORG_BITS_PER_DIM;
+
+      /* sort key of a ray */
+      struct __aligned(8) RayKey
+      {
+        __forceinline unsigned int octant() const { return code >> (3*ORG_BITS_PER_DIM); }
+        __forceinline bool operator<(const RayKey& other) const { return code < other.code; }
+        __forceinline operator unsigned() const { return code; }
+
+        unsigned int code;
+        unsigned int index;
+      };
+
+      /* computes the sort keys of rays [begin,begin+n) relative to the bounds of their origins */
+      template<typename RayStream>
+      static void computeKeys(const RayStream& stream, const size_t begin, const size_t n, RayKey* keys);
+
+      /* traces sorted rays as packets of rays of the same octant */
+      template<typename RayStream>
+      static void tracePackets(Scene* scene, const RayStream& stream, const RayKey* keys, const size_t n, const bool intersect);
+
+    public:
+
+      template<typename RayStream>
+      static void filter(Scene* scene, const RayStream& stream, const size_t N, const bool intersect);
+    };
+
+    /*! stream function for rays in array of structures layout */
+    void rayStreamFilterAOS(Scene* scene, RTCRay* rays, const size_t M, const size_t stride, const bool intersect);
+
+    /*! stream function for rays in structure of pointers layout */
+    void rayStreamFilterSOP(Scene* scene, const RTCRayNp& rays, const size_t N, const bool intersect);
+  }
+}
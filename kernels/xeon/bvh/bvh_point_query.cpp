@@ -0,0 +1,157 @@
+// ======================================================================== //
+// Copyright 2009-2015 Intel Corporation                                    //
+//                                                                          //
+// Licensed under the Apache License, Version 2.0 (the "License");          //
+// you may not use this file except in compliance with the License.         //
+// You may obtain a copy of the License at                                  //
+//                                                                          //
+//     http://www.apache.org/licenses/LICENSE-2.0                           //
+//                                                                          //
+// Unless required by applicable law or agreed to in writing, software      //
+// distributed under the License is distributed on an "AS IS" BASIS,        //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. //
+// See the License for the specific language governing permissions and      //
+// limitations under the License.                                           //
+// ======================================================================== //
+
+
+#include "bvh_point_query.h"
+#include "../../common/stack_item.h"
+
+#include "../geometry/triangle.h"
+#include "../geometry/trianglev.h"
+#include "../geometry/trianglei.h"
+#include "../geometry/quadv.h"
+#include "../geometry/quadi.h"
+#include "../geometry/linei.h"
+#include "../geometry/pointi.h"
+#include "../geometry/point_query.h"
+
+namespace embree
+{ 
+  namespace isa
+  {
+    /*! squared distance of a point to the N child bounds of a node */
+    template<int N>
+      __forceinline vfloat<N> pointQueryDistance(const Vec3<vfloat<N>>& p, 
+                                                 const vfloat<N>& lowerX, const vfloat<N>& lowerY, const vfloat<N>& lowerZ,
+                                                 const vfloat<N>& upperX, const vfloat<N>& upperY, const vfloat<N>& upperZ)
+    {
+      const vfloat<N> dx = max(lowerX-p.x,vfloat<N>(zero),p.x-upperX);
+      const vfloat<N> dy = max(lowerY-p.y,vfloat<N>(zero),p.y-upperY);
+      const vfloat<N> dz = max(lowerZ-p.z,vfloat<N>(zero),p.z-upperZ);
+      return dx*dx + dy*dy + dz*dz;
+    }
+
+    template<int N>
+      __forceinline vfloat<N> pointQueryDistance(const typename BVHN<N>::Node* node, const Vec3<vfloat<N>>& p) {
+      return pointQueryDistance<N>(p,node->lower_x,node->lower_y,node->lower_z,node->upper_x,node->upper_y,node->upper_z);
+    }
+
+    template<int N>
+      __forceinline vfloat<N> pointQueryDistance(const typename BVHN<N>::QuantizedNode* node, const Vec3<vfloat<N>>& p)
+    {
+      const vfloat<N> startX(node->start.x), startY(node->start.y), startZ(node->start.z);
+      const vfloat<N> scaleX(node->scale.x), scaleY(node->scale.y), scaleZ(node->scale.z);
+      return pointQueryDistance<N>(p,
+                                   startX + scaleX*vfloat<N>::load(node->lower_x),
+                                   startY + scaleY*vfloat<N>::load(node->lower_y),
+                                   startZ + scaleZ*vfloat<N>::load(node->lower_z),
+                                   startX + scaleX*vfloat<N>::load(node->upper_x),
+                                   startY + scaleY*vfloat<N>::load(node->upper_y),
+                                   startZ + scaleZ*vfloat<N>::load(node->upper_z));
+    }
+
+    template<int N, int types, typename PrimitivePointQuery>
+    void BVHNPointQuery<N,types,PrimitivePointQuery>::pointQuery(const BVH* __restrict__ bvh, PointQueryContext* context)
+    {
+      /*! early out for empty BVH */
+      if (bvh->root == BVH::emptyNode) return;
+
+      /*! stack state */
+      StackItemT<NodeRef> stack[stackSize];           //!< stack of nodes 
+      StackItemT<NodeRef>* stackPtr = stack+1;        //!< current stack pointer
+      stack[0].ptr  = bvh->root;
+      stack[0].dist = 0;
+
+      const Vec3fa p = context->p();
+      const Vec3<vfloat<N>> vp(p.x,p.y,p.z);
+
+      /* pop loop */
+      while (stackPtr != stack)
+      {
+        /*! pop next node */
+        stackPtr--;
+        NodeRef cur = NodeRef(stackPtr->ptr);
+        
+        /*! if the search radius shrank in the meantime we may cull this node */
+        const float radius = context->radius();
+        if (unlikely(*(float*)&stackPtr->dist > radius*radius))
+          continue;
+
+        /*! process leaf */
+        if (cur.isLeaf()) 
+        {
+          size_t num; Primitive* prim = (Primitive*) cur.leaf(num);
+          PrimitivePointQuery::pointQuery(context,prim,num);
+          continue;
+        }
+
+        /*! compute distance to child bounds */
+        vfloat<N> dist2;
+        if (likely(cur.isNode()))
+          dist2 = pointQueryDistance<N>(cur.node(),vp);
+        else if ((types & BVH_FLAG_QUANTIZED_NODE) && cur.isQuantizedNode())
+          dist2 = pointQueryDistance<N>(cur.quantizedNode(),vp);
+        else {
+          assert(false);
+          continue;
+        }
+
+        /*! push children inside the search radius, nearest child ends up on top */
+        StackItemT<NodeRef>* stackBegin = stackPtr;
+        for (size_t i=0; i<N; i++) 
+        {
+          const NodeRef child = cur.isNode() ? cur.node()->child(i) : cur.quantizedNode()->child(i);
+          if (child == BVH::emptyNode) continue;
+          if (dist2[i] > radius*radius) continue;
+          stackPtr->ptr  = child;
+          stackPtr->dist = *(unsigned int*)&dist2[i];
+          stackPtr++;
+        }
+        if (stackPtr-stackBegin > 1) sort(stackBegin,stackPtr);
+      }
+      AVX_ZERO_UPPER();
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////
+    /// BVH4PointQuery Definitions
+    ////////////////////////////////////////////////////////////////////////////////
+
+    DEFINE_POINT_QUERY(BVH4Triangle4PointQuery,BVHNPointQuery<4 COMMA BVH_AN1 COMMA ArrayPointQuery<TrianglePointQuery<Triangle4> > >);
+    DEFINE_POINT_QUERY(BVH4QuantizedTriangle4PointQuery,BVHNPointQuery<4 COMMA BVH_QN1 COMMA ArrayPointQuery<TrianglePointQuery<Triangle4> > >);
+    DEFINE_POINT_QUERY(BVH4Triangle4vPointQuery,BVHNPointQuery<4 COMMA BVH_AN1 COMMA ArrayPointQuery<TrianglePointQuery<Triangle4v> > >);
+    DEFINE_POINT_QUERY(BVH4Triangle4iPointQuery,BVHNPointQuery<4 COMMA BVH_AN1 COMMA ArrayPointQuery<TrianglePointQuery<Triangle4i> > >);
+#if defined(__AVX__)
+    DEFINE_POINT_QUERY(BVH4Triangle8PointQuery,BVHNPointQuery<4 COMMA BVH_AN1 COMMA ArrayPointQuery<TrianglePointQuery<Triangle8> > >);
+#endif
+    DEFINE_POINT_QUERY(BVH4Quad4vPointQuery,BVHNPointQuery<4 COMMA BVH_AN1 COMMA ArrayPointQuery<QuadPointQuery<Quad4v> > >);
+    DEFINE_POINT_QUERY(BVH4Quad4iPointQuery,BVHNPointQuery<4 COMMA BVH_AN1 COMMA ArrayPointQuery<QuadPointQuery<Quad4i> > >);
+    DEFINE_POINT_QUERY(BVH4Line4iPointQuery,BVHNPointQuery<4 COMMA BVH_AN1 COMMA ArrayPointQuery<LinePointQuery<Line4i> > >);
+    DEFINE_POINT_QUERY(BVH4Point4iPointQuery,BVHNPointQuery<4 COMMA BVH_AN1 COMMA ArrayPointQuery<SpherePointQuery<Point4i> > >);
+
+    ////////////////////////////////////////////////////////////////////////////////
+    /// BVH8PointQuery Definitions
+    ////////////////////////////////////////////////////////////////////////////////
+
+#if defined(__AVX__)
+    DEFINE_POINT_QUERY(BVH8Triangle4PointQuery,BVHNPointQuery<8 COMMA BVH_AN1 COMMA ArrayPointQuery<TrianglePointQuery<Triangle4> > >);
+    DEFINE_POINT_QUERY(BVH8QuantizedTriangle4PointQuery,BVHNPointQuery<8 COMMA BVH_QN1 COMMA ArrayPointQuery<TrianglePointQuery<Triangle4> > >);
+    DEFINE_POINT_QUERY(BVH8Triangle8PointQuery,BVHNPointQuery<8 COMMA BVH_AN1 COMMA ArrayPointQuery<TrianglePointQuery<Triangle8> > >);
+    DEFINE_POINT_QUERY(BVH8Quad4vPointQuery,BVHNPointQuery<8 COMMA BVH_AN1 COMMA ArrayPointQuery<QuadPointQuery<Quad4v> > >);
+    DEFINE_POINT_QUERY(BVH8Quad4iPointQuery,BVHNPointQuery<8 COMMA BVH_AN1 COMMA ArrayPointQuery<QuadPointQuery<Quad4i> > >);
+    DEFINE_POINT_QUERY(BVH8Line4iPointQuery,BVHNPointQuery<8 COMMA BVH_AN1 COMMA ArrayPointQuery<LinePointQuery<Line4i> > >);
+    DEFINE_POINT_QUERY(BVH8Point4iPointQuery,BVHNPointQuery<8 COMMA BVH_AN1 COMMA ArrayPointQuery<SpherePointQuery<Point4i> > >);
+#endif
+  }
+}
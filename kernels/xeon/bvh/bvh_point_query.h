@@ -0,0 +1,46 @@
+// ======================================================================== //
+// Copyright 2009-2015 Intel Corporation                                    //
+//                                                                          //
+// Licensed under the Apache License, Version 2.0 (the "License");          //
+// you may not use this file except in compliance with the License.         //
+// You may obtain a copy of the License at                                  //
+//                                                                          //
+//     http://www.apache.org/licenses/LICENSE-2.0                           //
+//                                                                          //
+// Unless required by applicable law or agreed to in writing, software      //
+// distributed under the License is distributed on an "AS IS" BASIS,        //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. //
+// See the License for the specific language governing permissions and      //
+// limitations under the License.                                           //
+// ======================================================================== //
+
+
+#pragma once
+
+#include "bvh.h"
+#include "../../common/point_query.h"
+
+namespace embree
+{
+  namespace isa
+  {
+    /*! BVH point query. Traverses the BVH front to back by distance
+     *  to the query position and culls subtrees outside the current
+     *  search radius. */
+    template<int N, int types, typename PrimitivePointQuery>
+      class BVHNPointQuery
+    {
+      /* shortcuts for frequently used types */
+      typedef typename PrimitivePointQuery::Primitive Primitive;
+      typedef BVHN<N> BVH;
+      typedef typename BVH::NodeRef NodeRef;
+      typedef typename BVH::Node Node;
+      typedef typename BVH::QuantizedNode QuantizedNode;
+
+      static const size_t stackSize = 1+(N-1)*BVH::maxDepth;
+
+    public:
+      static void pointQuery(const BVH* This, PointQueryContext* context);
+    };
+  }
+}
@@ -16,6 +16,8 @@
 
 #include "bvh_refit.h"
 #include "bvh_statistics.h"
+#include "bvh_rotate.h"
+#include "../../algorithms/parallel_reduce.h"
 
 #include "../geometry/linei.h"
 #include "../geometry/pointi.h"
@@ -127,9 +129,19 @@ namespace embree
     }
 #endif
 
+    /* sum of the surface areas of all non-empty children of a node */
+    template<int N>
+    __forceinline double childArea(const BBox3fa* bounds)
+    {
+      double area = 0.0;
+      for (size_t i=0; i<N; i++)
+        if (!bounds[i].empty()) area += halfArea(bounds[i]);
+      return area;
+    }
+
     template<int N>
     BVHNRefitter<N>::BVHNRefitter (BVH* bvh, const LeafBoundsInterface& leafBounds)
-      : bvh(bvh), leafBounds(leafBounds), numSubTrees(0)
+      : bvh(bvh), leafBounds(leafBounds), numSubTrees(0), sahCost(0.0), baselineQuality(0.0)
     {
 #if STATIC_SUBTREE_EXTRACTION
 
@@ -144,9 +156,15 @@ namespace embree
     template<int N>
     void BVHNRefitter<N>::refit()
     {
+      /* the referenced vertices may have changed with a full update */
+      subtreeRanges.clear();
+
+      /* the SAH cost gets recalculated while refitting */
+      double cost = 0.0;
+
 #if STATIC_SUBTREE_EXTRACTION
       if (bvh->numPrimitives <= block_size) {
-        bvh->bounds = recurse_bottom(bvh->root);
+        bvh->bounds = recurse_bottom(bvh->root,cost);
       }
       else
       {
@@ -154,39 +172,282 @@ namespace embree
         gather_subtree_refs(bvh->root,numSubTrees,0);
 
         if (numSubTrees)
-          parallel_for(size_t(0), numSubTrees, [&] (const range<size_t>& r) {
+          cost = parallel_reduce(size_t(0), numSubTrees, 0.0, [&] (const range<size_t>& r) -> double {
+              double c = 0.0;
               for (size_t i=r.begin(); i<r.end(); i++) {
                 NodeRef& ref = subTrees[i];
-                recurse_bottom(ref);
+                recurse_bottom(ref,c);
               }
-            });
+              return c;
+            }, std::plus<double>());
 
         numSubTrees = 0;        
-        bvh->bounds = refit_toplevel(bvh->root,numSubTrees,0);
+        bvh->bounds = refit_toplevel(bvh->root,numSubTrees,cost,0);
       }
 #else
       /* single threaded fallback */
       size_t numRoots = roots.size();
       if (numRoots <= 1) {
-        bvh->bounds = recurse_bottom(bvh->root);
+        bvh->bounds = recurse_bottom(bvh->root,cost);
       }
 
       /* parallel refit */
       else 
       {
 
-        parallel_for(size_t(0), roots.size(), [&] (const range<size_t>& r) {
+        cost = parallel_reduce(size_t(0), roots.size(), 0.0, [&] (const range<size_t>& r) -> double {
+            double c = 0.0;
             for (size_t i=r.begin(); i<r.end(); i++) {
               NodeRef& ref = *roots[i];
-              recurse_bottom(ref);
+              recurse_bottom(ref,c);
               ref.setBarrier();
             }
-          });
-        bvh->bounds = recurse_top(bvh->root);
+            return c;
+          }, std::plus<double>());
+        bvh->bounds = recurse_top(bvh->root,cost);
       }
 #endif
-    
-  }
+      sahCost = cost;
+      restore_quality();
+    }
+
+    template<int N>
+    void BVHNRefitter<N>::refit(const std::vector<range<size_t>>& modified)
+    {
+      /* the referenced vertex ranges of all subtrees are calculated once as the BVH structure does not change */
+      if (subtreeRanges.empty())
+        annotate_subtree_ranges(bvh->root);
+
+      /* sort and merge modified ranges */
+      modifiedRanges = modified;
+      std::sort(modifiedRanges.begin(),modifiedRanges.end(),
+                [] (const range<size_t>& a, const range<size_t>& b) { return a.begin() < b.begin(); });
+      size_t numModified = 0;
+      size_t numModifiedVertices = 0;
+      for (size_t i=0; i<modifiedRanges.size(); i++)
+      {
+        const range<size_t>& r = modifiedRanges[i];
+        if (r.size() == 0) continue;
+        if (numModified && r.begin() <= modifiedRanges[numModified-1].end())
+          modifiedRanges[numModified-1]._end = max(modifiedRanges[numModified-1].end(),r.end());
+        else
+          modifiedRanges[numModified++] = r;
+      }
+      modifiedRanges.resize(numModified);
+      for (size_t i=0; i<numModified; i++) 
+        numModifiedVertices += modifiedRanges[i].size();
+
+      if (numModified == 0 || !isModified(subtreeRanges[0]))
+        return;
+
+      /* the SAH cost gets updated incrementally by the change of the refitted bounds */
+      double delta = 0.0;
+
+      /* refit small updates single threaded */
+      if (numModifiedVertices <= block_size) {
+        bvh->bounds = refit_modified(bvh->root,0,0,std::numeric_limits<size_t>::max(),delta);
+      }
+
+      /* refit modified subtrees in parallel, then propagate their bounds to the root */
+      else
+      {
+        modifiedSubTrees.clear();
+        gather_modified_subtrees(bvh->root,0,0);
+
+        delta = parallel_reduce(size_t(0), modifiedSubTrees.size(), 0.0, [&] (const range<size_t>& r) -> double {
+            double d = 0.0;
+            for (size_t i=r.begin(); i<r.end(); i++)
+              refit_modified(modifiedSubTrees[i].first,modifiedSubTrees[i].second,0,std::numeric_limits<size_t>::max(),d);
+            return d;
+          }, std::plus<double>());
+
+        bvh->bounds = refit_modified(bvh->root,0,0,MAX_SUB_TREE_EXTRACTION_DEPTH,delta);
+      }
+
+      sahCost += delta;
+      restore_quality();
+    }
+
+    template<int N>
+    double BVHNRefitter<N>::subtree_cost(NodeRef ref)
+    {
+      if (!ref.isNode()) return 0.0;
+      Node* node = ref.node();
+      double cost = 0.0;
+      for (size_t i=0; i<N; i++) {
+        if (node->child(i) == BVH::emptyNode) continue;
+        cost += halfArea(node->bounds(i));
+        cost += subtree_cost(node->child(i));
+      }
+      return cost;
+    }
+
+    template<int N>
+    void BVHNRefitter<N>::restore_quality()
+    {
+      /* quality is the SAH cost relative to the surface area of the root */
+      const float rootArea = halfArea(bvh->bounds);
+      if (!(rootArea > 0.0f)) return;
+      const double quality = sahCost/double(rootArea);
+
+      /* the first refit after the build gives the reference quality */
+      if (baselineQuality == 0.0) {
+        baselineQuality = quality;
+        return;
+      }
+      
+      const float threshold = bvh->device->refit_quality_threshold;
+      if (!BVHNRotate<N>::enabled || threshold <= 0.0f || quality <= threshold*baselineQuality)
+        return;
+
+      double t0 = 0.0;
+      if (bvh->device->verbosity(2)) {
+        std::cout << "restoring BVH" << N << " quality ... " << std::flush;
+        t0 = getSeconds();
+      }
+
+      /* rotate the subtrees of worst SAH cost relative to their surface area */
+      std::vector<std::pair<NodeRef,size_t>> subtrees;
+      numSubTrees = 0;
+      gather_subtree_refs(bvh->root,numSubTrees,0);
+      for (size_t i=0; i<numSubTrees; i++)
+        subtrees.push_back(std::make_pair(subTrees[i],MAX_SUB_TREE_EXTRACTION_DEPTH+1));
+      if (subtrees.empty() && bvh->root.isNode())
+        subtrees.push_back(std::make_pair(bvh->root,size_t(1)));
+      numSubTrees = 0;
+
+      std::vector<std::pair<double,size_t>> costs(subtrees.size());
+      parallel_for(size_t(0), subtrees.size(), [&] (const range<size_t>& r) {
+          for (size_t i=r.begin(); i<r.end(); i++) {
+            const double area = halfArea(subtrees[i].first.node()->bounds());
+            costs[i] = std::make_pair(subtree_cost(subtrees[i].first)/max(area,double(min_rcp_input)),i);
+          }
+        });
+      std::sort(costs.begin(),costs.end(),std::greater<std::pair<double,size_t>>());
+      const size_t numRotate = (costs.size()+3)/4;
+
+      const double delta = parallel_reduce(size_t(0), numRotate, 0.0, [&] (const range<size_t>& r) -> double {
+          double d = 0.0;
+          for (size_t i=r.begin(); i<r.end(); i++) {
+            NodeRef ref = subtrees[costs[i].second].first;
+            const double cost0 = subtree_cost(ref);
+            BVHNRotate<N>::rotate(ref,subtrees[costs[i].second].second);
+            d += subtree_cost(ref)-cost0;
+          }
+          return d;
+        }, std::plus<double>());
+      sahCost += delta;
+
+      /* rotations change the BVH structure */
+      subtreeRanges.clear();
+
+      /* accept the restored quality as new reference if rotations could not fully restore the original one */
+      const double restoredQuality = sahCost/double(rootArea);
+      baselineQuality = max(baselineQuality,restoredQuality);
+
+      if (bvh->device->verbosity(2)) 
+      {
+        double t1 = getSeconds();
+        std::cout << "[DONE]" << std::endl;
+        std::cout << "  dt = " << 1000.0f*(t1-t0) << "ms, rotated subtrees = " << numRotate << "/" << costs.size()
+                  << ", quality = " << quality << " -> " << restoredQuality << std::endl;
+      }
+    }
+
+    template<int N>
+    size_t BVHNRefitter<N>::annotate_subtree_ranges(NodeRef& ref)
+    {
+      const size_t index = subtreeRanges.size();
+      subtreeRanges.push_back(SubtreeRange());
+
+      range<size_t> r(std::numeric_limits<size_t>::max(),0);
+      if (ref.isNode())
+      {
+        Node* node = ref.node();
+        for (size_t i=0; i<N; i++) {
+          NodeRef& child = node->child(i);
+          if (child == BVH::emptyNode) continue;
+          const SubtreeRange& c = subtreeRanges[annotate_subtree_ranges(child)];
+          r._begin = min(r.begin(),size_t(c.lower));
+          r._end   = max(r.end()  ,size_t(c.upper));
+        }
+      }
+      else
+        r = leafBounds.leafVertexRange(ref);
+
+      SubtreeRange& s = subtreeRanges[index];
+      s.lower = (unsigned) min(r.begin(),size_t(std::numeric_limits<unsigned>::max()));
+      s.upper = (unsigned) min(r.end()  ,size_t(std::numeric_limits<unsigned>::max()));
+      s.size  = (unsigned) (subtreeRanges.size()-index);
+      return index;
+    }
+
+    template<int N>
+    void BVHNRefitter<N>::gather_modified_subtrees(NodeRef& ref, const size_t index, const size_t depth)
+    {
+      if (!ref.isNode()) 
+        return;
+
+      if (depth >= MAX_SUB_TREE_EXTRACTION_DEPTH) {
+        modifiedSubTrees.push_back(std::make_pair(ref,index));
+        return;
+      }
+
+      Node* node = ref.node();
+      size_t childIndex = index+1;
+      for (size_t i=0; i<N; i++) 
+      {
+        NodeRef& child = node->child(i);
+        if (child == BVH::emptyNode) continue;
+        const SubtreeRange& r = subtreeRanges[childIndex];
+        if (isModified(r)) gather_modified_subtrees(child,childIndex,depth+1);
+        childIndex += r.size;
+      }
+    }
+
+    template<int N>
+    BBox3fa BVHNRefitter<N>::refit_modified(NodeRef& ref, const size_t index, const size_t depth, const size_t maxDepth, double& delta)
+    {
+      /* this is a leaf node */
+      if (unlikely(ref.isLeaf()))
+        return leafBounds.leafBounds(ref);
+
+      /* subtrees below maxDepth got already refitted */
+      Node* node = ref.node();
+      if (depth >= maxDepth)
+        return node->bounds();
+
+      /* only recurse into children that reference modified vertices */
+      BBox3fa bounds[N];
+      size_t childIndex = index+1;
+      for (size_t i=0; i<N; i++)
+      {
+        NodeRef& child = node->child(i);
+        if (unlikely(child == BVH::emptyNode)) { bounds[i] = empty; continue; }
+        const SubtreeRange& r = subtreeRanges[childIndex];
+        if (isModified(r)) {
+          bounds[i] = refit_modified(child,childIndex,depth+1,maxDepth,delta);
+          delta += double(halfArea(bounds[i])) - double(halfArea(node->bounds(i)));
+        }
+        else 
+          bounds[i] = node->bounds(i);
+        childIndex += r.size;
+      }
+
+      /* AOS to SOA transform */
+      BBox<Vec3<vfloat<N>>> boundsT = transpose<N>(bounds);
+      
+      /* set new bounds */
+      node->lower_x = boundsT.lower.x;
+      node->lower_y = boundsT.lower.y;
+      node->lower_z = boundsT.lower.z;
+      node->upper_x = boundsT.upper.x;
+      node->upper_y = boundsT.upper.y;
+      node->upper_z = boundsT.upper.z;
+
+      /* return merged bounds */
+      return merge<N>(bounds);
+    }
 
     template<int N>
     size_t BVHNRefitter<N>::annotate_tree_sizes(NodeRef& ref)
@@ -237,6 +498,7 @@ namespace embree
     template<int N>
     BBox3fa BVHNRefitter<N>::refit_toplevel(NodeRef& ref,
                                             size_t &subtrees,
+                                            double& cost,
                                             const size_t depth)
     {
       if (ref.isNode())
@@ -244,10 +506,12 @@ namespace embree
         Node* node = ref.node();
         BBox3fa bounds[N];
 
+        /* subtrees got already refitted in parallel */
         if (depth >= MAX_SUB_TREE_EXTRACTION_DEPTH) 
         {
           assert(subtrees < MAX_NUM_SUB_TREES);
           assert(subTrees[subtrees++] == ref);
+          return node->bounds();
         }
 
         for (size_t i=0; i<N; i++)
@@ -256,12 +520,9 @@ namespace embree
           bounds[i] = BBox3fa(empty);
 
           if (unlikely(child == BVH::emptyNode)) continue;
-
-          if (depth >= MAX_SUB_TREE_EXTRACTION_DEPTH) 
-            bounds[i] = node->bounds();
-          else
-            bounds[i] = refit_toplevel(child,subtrees,depth+1); 
+          bounds[i] = refit_toplevel(child,subtrees,cost,depth+1); 
         }
+        cost += childArea<N>(bounds);
         
         BBox<Vec3<vfloat<N>>> boundsT = transpose<N>(bounds);
       
@@ -306,7 +567,7 @@ namespace embree
     }
     
     template<int N>
-    BBox3fa BVHNRefitter<N>::recurse_bottom(NodeRef& ref)
+    BBox3fa BVHNRefitter<N>::recurse_bottom(NodeRef& ref, double& cost)
     {
       /* this is a leaf node */
       if (unlikely(ref.isLeaf()))
@@ -323,7 +584,8 @@ namespace embree
 
       #pragma unroll
       for (size_t i=0; i<N; i++)
-        bounds[i] = recurse_bottom(node->child(i));
+        bounds[i] = recurse_bottom(node->child(i),cost);
+      cost += childArea<N>(bounds);
       
       /* AOS to SOA transform */
       BBox<Vec3<vfloat<N>>> boundsT = transpose<N>(bounds);
@@ -341,7 +603,7 @@ namespace embree
     }
     
     template<int N>
-    BBox3fa BVHNRefitter<N>::recurse_top(NodeRef& ref)
+    BBox3fa BVHNRefitter<N>::recurse_top(NodeRef& ref, double& cost)
     {
       /* stop here if we encounter a barrier */
       if (unlikely(ref.isBarrier())) {
@@ -359,7 +621,8 @@ namespace embree
 
       #pragma unroll
       for (size_t i=0; i<N; i++)
-        bounds[i] = recurse_top(node->child(i));
+        bounds[i] = recurse_top(node->child(i),cost);
+      cost += childArea<N>(bounds);
       
       /* AOS to SOA transform */
       BBox<Vec3<vfloat<N>>> boundsT = transpose<N>(bounds);
@@ -410,7 +673,10 @@ namespace embree
         t0 = getSeconds();
       }
       
-      refitter->refit();
+      if (mesh->isPartiallyModified()) 
+        refitter->refit(mesh->getModifiedRanges());
+      else
+        refitter->refit();
 
       if (bvh->device->verbosity(2)) 
       {
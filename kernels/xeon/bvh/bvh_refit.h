@@ -34,6 +34,17 @@ namespace embree
 
       struct LeafBoundsInterface {
         virtual const BBox3fa leafBounds(NodeRef& ref) const = 0;
+
+        /* vertices referenced by the primitives of a leaf, used to find the leaves affected by a partial update */
+        virtual const range<size_t> leafVertexRange(NodeRef& ref) const { return range<size_t>(0,std::numeric_limits<size_t>::max()); }
+      };
+
+      /* range of vertices referenced by a subtree */
+      struct SubtreeRange 
+      {
+        unsigned lower;  //!< first vertex referenced
+        unsigned upper;  //!< one past last vertex referenced
+        unsigned size;   //!< number of subtree ranges of this subtree including this one
       };
 
     public:
@@ -44,7 +55,28 @@ namespace embree
       /*! refits the BVH */
       void refit();
 
+      /*! refits only the subtrees that reference some of the modified vertex ranges */
+      void refit(const std::vector<range<size_t>>& modified);
+
     private:
+      size_t annotate_subtree_ranges(NodeRef& ref);
+
+      __forceinline bool isModified(const SubtreeRange& r) const
+      {
+        /* modified ranges are sorted and disjoint, thus also sorted by their end */
+        auto i = std::upper_bound(modifiedRanges.begin(),modifiedRanges.end(),size_t(r.lower),
+                                  [] (const size_t v, const range<size_t>& m) { return v < m.end(); });
+        return i != modifiedRanges.end() && i->begin() < size_t(r.upper);
+      }
+
+      void gather_modified_subtrees(NodeRef& ref, const size_t index, const size_t depth);
+      BBox3fa refit_modified(NodeRef& ref, const size_t index, const size_t depth, const size_t maxDepth, double& delta);
+
+      /* SAH cost of a subtree as sum of the surface areas of all its nodes */
+      double subtree_cost(NodeRef ref);
+
+      /* rotates the worst subtrees if the SAH cost degraded too much since the build */
+      void restore_quality();
       size_t annotate_tree_sizes(NodeRef& ref);
       void calculate_refit_roots ();
 
@@ -55,6 +87,7 @@ namespace embree
 
       BBox3fa refit_toplevel(NodeRef& ref,
                              size_t &subtrees,
+                             double& cost,
                              const size_t depth = 0);
 
       
@@ -67,8 +100,8 @@ namespace embree
           return leafBounds.leafBounds(ref);
       }
 
-      BBox3fa recurse_bottom(NodeRef& ref);
-      BBox3fa recurse_top(NodeRef& ref);
+      BBox3fa recurse_bottom(NodeRef& ref, double& cost);
+      BBox3fa recurse_top(NodeRef& ref, double& cost);
       
     public:
       BVH* bvh;                              //!< BVH to refit
@@ -79,8 +112,37 @@ namespace embree
       static const size_t MAX_NUM_SUB_TREES             = (N==4) ? 1024 : (N==8) ? 4096 : N*N*N; // N ^ MAX_SUB_TREE_EXTRACTION_DEPTH
       size_t numSubTrees;
       NodeRef subTrees[MAX_NUM_SUB_TREES];
+
+      std::vector<SubtreeRange> subtreeRanges;                //!< referenced vertices of each subtree in depth first order
+      std::vector<range<size_t>> modifiedRanges;              //!< sorted and merged modified vertex ranges
+      std::vector<std::pair<NodeRef,size_t>> modifiedSubTrees; //!< modified subtrees and their index into subtreeRanges
+
+      double sahCost;                                         //!< sum of surface areas of all nodes, updated during refit
+      double baselineQuality;                                 //!< SAH cost relative to root surface area after the build
     };
 
+    /* extends a vertex range by the vertices of some primitive */
+    __forceinline void extendVertexRange(const TriangleMesh* mesh, const size_t primID, range<size_t>& r)
+    {
+      const TriangleMesh::Triangle& tri = mesh->triangle(primID);
+      r._begin = min(r._begin,size_t(tri.v[0]),size_t(tri.v[1]),size_t(tri.v[2]));
+      r._end   = max(r._end  ,size_t(tri.v[0])+1,size_t(tri.v[1])+1,size_t(tri.v[2])+1);
+    }
+
+    __forceinline void extendVertexRange(const LineSegments* mesh, const size_t primID, range<size_t>& r)
+    {
+      const size_t v = mesh->segment(primID);
+      r._begin = min(r._begin,v);
+      r._end   = max(r._end  ,v+2);
+    }
+
+    __forceinline void extendVertexRange(const Points* mesh, const size_t primID, range<size_t>& r)
+    {
+      const size_t v = mesh->point(primID);
+      r._begin = min(r._begin,v);
+      r._end   = max(r._end  ,v+1);
+    }
+
     template<int N, typename Mesh, typename Primitive>
     class BVHNRefitT : public Builder, public BVHNRefitter<N>::LeafBoundsInterface
     {
@@ -109,6 +171,20 @@ namespace embree
             bounds.extend(((Primitive*)prim)[i].update(mesh));
         return bounds;
       }
+
+      virtual const range<size_t> leafVertexRange (NodeRef& ref) const
+      {
+        range<size_t> r(std::numeric_limits<size_t>::max(),0);
+        size_t num; char* prim = ref.leaf(num);
+        if (unlikely(ref == BVH::emptyNode)) return r;
+        for (size_t i=0; i<num; i++) 
+        {
+          const Primitive& p = ((Primitive*)prim)[i];
+          for (size_t j=0; j<Primitive::max_size(); j++) 
+            if (p.valid(j)) extendVertexRange(mesh,p.primID(j),r);
+        }
+        return r;
+      }
       
     private:
       Mesh* mesh;
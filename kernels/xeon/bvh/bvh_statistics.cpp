@@ -30,12 +30,15 @@ namespace embree
     numAlignedNodes = numUnalignedNodes = 0;
     numAlignedNodesMB = numUnalignedNodesMB = 0;
     numTransformNodes = 0;
+    numQuantizedNodes = childrenQuantizedNodes = 0;
+    numAlignedNodesMB4D = childrenAlignedNodesMB4D = 0;
     numLeaves = numPrims = numPrimBlocks = depth = 0;
     childrenAlignedNodes = childrenUnalignedNodes = 0;
     childrenAlignedNodesMB = childrenUnalignedNodesMB = 0;
     bvhSAH = 0.0f; leafSAH = 0.0f;
+    for (size_t i=0; i<RTC_MAX_STATISTICS_DEPTH; i++) leafDepths[i] = 0;
     float A = max(0.0f,halfArea(bvh->bounds));
-    statistics(bvh->root,A,depth);
+    statistics(bvh->root,A,0,depth);
     bvhSAH /= halfArea(bvh->bounds);
     leafSAH /= halfArea(bvh->bounds);
     assert(depth <= BVH::maxDepth);
@@ -49,10 +52,53 @@ namespace embree
     size_t bytesAlignedNodesMB = numAlignedNodesMB*sizeof(AlignedNodeMB);
     size_t bytesUnalignedNodesMB = numUnalignedNodesMB*sizeof(UnalignedNodeMB);
     size_t bytesTransformNodes = numTransformNodes*sizeof(TransformNode);
+    size_t bytesQuantizedNodes = numQuantizedNodes*sizeof(QuantizedNode);
+    size_t bytesAlignedNodesMB4D = numAlignedNodesMB4D*sizeof(AlignedNodeMB4D);
     size_t bytesPrims  = numPrimBlocks*bvh->primTy.bytes;
     size_t numVertices = bvh->numVertices;
     size_t bytesVertices = numVertices*sizeof(Vec3fa); 
-    return bytesAlignedNodes+bytesUnalignedNodes+bytesAlignedNodesMB+bytesUnalignedNodesMB+bytesTransformNodes+bytesPrims+bytesVertices;
+    return bytesAlignedNodes+bytesUnalignedNodes+bytesAlignedNodesMB+bytesUnalignedNodesMB+bytesTransformNodes+bytesQuantizedNodes+bytesAlignedNodesMB4D+bytesPrims+bytesVertices;
+  }
+  
+  template<int N>
+  void BVHNStatistics<N>::fill(RTCAccelStatistics& stats) const
+  {
+    const size_t numNodes = numAlignedNodes+numUnalignedNodes+numAlignedNodesMB+numUnalignedNodesMB+numAlignedNodesMB4D+numQuantizedNodes;
+    const size_t numChildren = childrenAlignedNodes+childrenUnalignedNodes+childrenAlignedNodesMB+childrenUnalignedNodesMB+childrenAlignedNodesMB4D+childrenQuantizedNodes;
+
+    stats.primitiveType = bvh->primTy.name.c_str();
+    stats.branchingFactor = N;
+    stats.numPrimitives = bvh->numPrimitives;
+    stats.numVertices = bvh->numVertices;
+
+    stats.numAlignedNodes = numAlignedNodes;
+    stats.numUnalignedNodes = numUnalignedNodes;
+    stats.numAlignedNodesMB = numAlignedNodesMB;
+    stats.numUnalignedNodesMB = numUnalignedNodesMB;
+    stats.numAlignedNodesMB4D = numAlignedNodesMB4D;
+    stats.numQuantizedNodes = numQuantizedNodes;
+    stats.numTransformNodes = numTransformNodes;
+    stats.numLeaves = numLeaves;
+    stats.numPrimBlocks = numPrimBlocks;
+
+    stats.nodeFillRate = numNodes ? float(double(numChildren)/double(N*numNodes)) : 0.0f;
+    stats.leafFillRate = numPrimBlocks ? float(double(numPrims)/double(bvh->primTy.blockSize*numPrimBlocks)) : 0.0f;
+
+    stats.sah = bvhSAH+leafSAH;
+    stats.sahNodes = bvhSAH;
+    stats.sahLeaves = leafSAH;
+
+    stats.depth = depth;
+    for (size_t i=0; i<RTC_MAX_STATISTICS_DEPTH; i++)
+      stats.leafDepthHistogram[i] = leafDepths[i];
+
+    stats.bytesNodes = numAlignedNodes*sizeof(AlignedNode) + numUnalignedNodes*sizeof(UnalignedNode) 
+      + numAlignedNodesMB*sizeof(AlignedNodeMB) + numUnalignedNodesMB*sizeof(UnalignedNodeMB) 
+      + numAlignedNodesMB4D*sizeof(AlignedNodeMB4D) + numQuantizedNodes*sizeof(QuantizedNode) 
+      + numTransformNodes*sizeof(TransformNode);
+    stats.bytesLeaves = numPrimBlocks*bvh->primTy.bytes;
+    stats.bytesVertices = bvh->numVertices*sizeof(Vec3fa);
+    stats.bytesAllocated = bvh->alloc.getAllocatedBytes();
   }
   
   template<int N>
@@ -64,10 +110,12 @@ namespace embree
     size_t bytesAlignedNodesMB = numAlignedNodesMB*sizeof(AlignedNodeMB);
     size_t bytesUnalignedNodesMB = numUnalignedNodesMB*sizeof(UnalignedNodeMB);
     size_t bytesTransformNodes = numTransformNodes*sizeof(TransformNode);
+    size_t bytesQuantizedNodes = numQuantizedNodes*sizeof(QuantizedNode);
+    size_t bytesAlignedNodesMB4D = numAlignedNodesMB4D*sizeof(AlignedNodeMB4D);
     size_t bytesPrims  = numPrimBlocks*bvh->primTy.bytes;
     size_t numVertices = bvh->numVertices;
     size_t bytesVertices = numVertices*sizeof(Vec3fa); 
-    size_t bytesTotal = bytesAlignedNodes+bytesUnalignedNodes+bytesAlignedNodesMB+bytesUnalignedNodesMB+bytesTransformNodes+bytesPrims+bytesVertices;
+    size_t bytesTotal = bytesAlignedNodes+bytesUnalignedNodes+bytesAlignedNodesMB+bytesUnalignedNodesMB+bytesTransformNodes+bytesQuantizedNodes+bytesAlignedNodesMB4D+bytesPrims+bytesVertices;
     //size_t bytesTotalAllocated = bvh->alloc.bytes();
     stream.setf(std::ios::fixed, std::ios::floatfield);
     stream << "  primitives = " << bvh->numPrimitives << ", vertices = " << bvh->numVertices << std::endl;
@@ -112,6 +160,20 @@ namespace embree
 	     << "(" << 100.0*double(bytesTransformNodes)/double(bytesTotal) << "% of total)"
 	     << std::endl;
     }
+    if (numAlignedNodesMB4D) {
+      stream << "  alignedNodesMB4D = "  << numAlignedNodesMB4D << " "
+             << "(" << 100.0*double(childrenAlignedNodesMB4D)/double(N*numAlignedNodesMB4D) << "% filled) "
+	     << "(" << bytesAlignedNodesMB4D/1E6  << " MB) " 
+	     << "(" << 100.0*double(bytesAlignedNodesMB4D)/double(bytesTotal) << "% of total)"
+	     << std::endl;
+    }
+    if (numQuantizedNodes) {
+      stream << "  quantizedNodes = "  << numQuantizedNodes << " "
+             << "(" << 100.0*double(childrenQuantizedNodes)/double(N*numQuantizedNodes) << "% filled) "
+	     << "(" << bytesQuantizedNodes/1E6  << " MB) " 
+	     << "(" << 100.0*double(bytesQuantizedNodes)/double(bytesTotal) << "% of total)"
+	     << std::endl;
+    }
     stream << "  leaves = " << numLeaves << " "
            << "(" << bytesPrims/1E6  << " MB) "
            << "(" << 100.0*double(bytesPrims)/double(bytesTotal) << "% of total)"
@@ -126,7 +188,7 @@ namespace embree
   }
   
   template<int N>
-  void BVHNStatistics<N>::statistics(NodeRef node, const float A, size_t& depth)
+  void BVHNStatistics<N>::statistics(NodeRef node, const float A, size_t level, size_t& depth)
   {
     if (node.isNode())
     {
@@ -138,7 +200,7 @@ namespace embree
         if (n->child(i) == BVH::emptyNode) continue;
         childrenAlignedNodes++;
         const float Ai = max(0.0f,halfArea(n->extend(i)));
-        size_t cdepth; statistics(n->child(i),Ai,cdepth); 
+        size_t cdepth; statistics(n->child(i),Ai,level+1,cdepth); 
         depth=max(depth,cdepth);
       }
       depth++;
@@ -154,7 +216,7 @@ namespace embree
         if (n->child(i) == BVH::emptyNode) continue;
         childrenUnalignedNodes++;
         const float Ai = max(0.0f,halfArea(n->extend(i)));
-        size_t cdepth; statistics(n->child(i),Ai,cdepth); 
+        size_t cdepth; statistics(n->child(i),Ai,level+1,cdepth); 
         depth=max(depth,cdepth);
       }
       depth++;
@@ -170,7 +232,25 @@ namespace embree
         if (n->child(i) == BVH::emptyNode) continue;
         childrenAlignedNodesMB++;
         const float Ai = max(0.0f,halfArea(n->extend0(i)));
-        size_t cdepth; statistics(n->child(i),Ai,cdepth); 
+        size_t cdepth; statistics(n->child(i),Ai,level+1,cdepth); 
+        depth=max(depth,cdepth);
+      }
+      depth++;
+    }
+    else if (node.isNodeMB4D())
+    {
+      numAlignedNodesMB4D++;
+      AlignedNodeMB4D* n = node.nodeMB4D();
+      bvhSAH += A*travCostAligned;
+      
+      depth = 0;
+      for (size_t i=0; i<N; i++) {
+        if (n->child(i) == BVH::emptyNode) continue;
+        childrenAlignedNodesMB4D++;
+        /* bounds are only valid inside the time range of the child */
+        const BBox1f dt = n->timeRange(i);
+        const float Ai = dt.size()*max(0.0f,halfArea(lerp(n->bounds0(i),n->bounds1(i),dt.center())));
+        size_t cdepth; statistics(n->child(i),Ai,level+1,cdepth); 
         depth=max(depth,cdepth);
       }
       depth++;
@@ -186,7 +266,23 @@ namespace embree
         if (n->child(i) == BVH::emptyNode) continue;
         childrenUnalignedNodesMB++;
         const float Ai = max(0.0f,halfArea(n->extend0(i)));
-        size_t cdepth; statistics(n->child(i),Ai,cdepth); 
+        size_t cdepth; statistics(n->child(i),Ai,level+1,cdepth); 
+        depth=max(depth,cdepth);
+      }
+      depth++;
+    }
+    else if (node.isQuantizedNode())
+    {
+      numQuantizedNodes++;
+      QuantizedNode* n = node.quantizedNode();
+      bvhSAH += A*travCostAligned;
+      
+      depth = 0;
+      for (size_t i=0; i<N; i++) {
+        if (n->child(i) == BVH::emptyNode) continue;
+        childrenQuantizedNodes++;
+        const float Ai = max(0.0f,halfArea(n->extend(i)));
+        size_t cdepth; statistics(n->child(i),Ai,level+1,cdepth); 
         depth=max(depth,cdepth);
       }
       depth++;
@@ -200,7 +296,7 @@ namespace embree
       depth = 0;
       const BBox3fa worldBounds = xfmBounds(n->local2world,n->localBounds);
       const float Ai = max(0.0f,halfArea(worldBounds));
-      //size_t cdepth; statistics(n->child,Ai,cdepth); 
+      //size_t cdepth; statistics(n->child,Ai,level+1,cdepth); 
       //depth=max(depth,cdepth)+1;
     }
     else
@@ -210,6 +306,7 @@ namespace embree
       if (!num) return;
       
       numLeaves++;
+      leafDepths[min(level,size_t(RTC_MAX_STATISTICS_DEPTH-1))]++;
       numPrimBlocks += num;
       for (size_t i=0; i<num; i++)
         numPrims += bvh->primTy.size(tri+i*bvh->primTy.bytes);
@@ -219,7 +316,9 @@ namespace embree
     }
   } 
 
-#if defined(__AVX__)
+#if defined(__AVX512F__)
+  template class BVHNStatistics<16>;
+#elif defined(__AVX__)
   template class BVHNStatistics<8>;
 #else
   template class BVHNStatistics<4>;
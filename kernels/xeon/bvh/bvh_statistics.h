@@ -27,8 +27,10 @@ namespace embree
     typedef typename BVH::Node AlignedNode;
     typedef typename BVH::UnalignedNode UnalignedNode;
     typedef typename BVH::NodeMB AlignedNodeMB;
+    typedef typename BVH::NodeMB4D AlignedNodeMB4D;
     typedef typename BVH::UnalignedNodeMB UnalignedNodeMB;
     typedef typename BVH::TransformNode TransformNode;
+    typedef typename BVH::QuantizedNode QuantizedNode;
     typedef typename BVH::NodeRef NodeRef;
 
   public:
@@ -43,8 +45,11 @@ namespace embree
 
     size_t bytesUsed() const;
 
+    /*! Fills statistics into the API structure. */
+    void fill(RTCAccelStatistics& stats) const;
+
   private:
-    void statistics(NodeRef node, const float A, size_t& depth);
+    void statistics(NodeRef node, const float A, size_t level, size_t& depth);
 
   private:
     BVH* bvh;
@@ -55,14 +60,19 @@ namespace embree
     size_t numAlignedNodesMB;          //!< Number of aligned internal nodes.
     size_t numUnalignedNodesMB;        //!< Number of unaligned internal nodes.
     size_t numTransformNodes;          //!< Number of transformation nodes;
+    size_t numQuantizedNodes;          //!< Number of quantized internal nodes.
+    size_t numAlignedNodesMB4D;        //!< Number of aligned internal nodes with time range.
     size_t childrenAlignedNodes;       //!< Number of children of aligned nodes
     size_t childrenUnalignedNodes;     //!< Number of children of unaligned internal nodes.
     size_t childrenAlignedNodesMB;     //!< Number of children of aligned nodes
     size_t childrenUnalignedNodesMB;   //!< Number of children of unaligned internal nodes.
+    size_t childrenQuantizedNodes;     //!< Number of children of quantized internal nodes.
+    size_t childrenAlignedNodesMB4D;   //!< Number of children of aligned internal nodes with time range.
     size_t numLeaves;                  //!< Number of leaf nodes.
     size_t numPrims;                   //!< Number of primitives.
     size_t numPrimBlocks;              //!< Number of primitive blocks.
     size_t depth;                      //!< Depth of the tree.
+    size_t leafDepths[RTC_MAX_STATISTICS_DEPTH]; //!< Number of leaves per depth.
   };
 
   typedef BVHNStatistics<4> BVH4Statistics;
@@ -450,6 +450,120 @@ namespace embree
       }
     };
 
+    /* Specialization for BVH16. All 16 children get tested by a
+     * single node intersection, thus more children are hit on
+     * average and the fallback paths sort larger stack segments. */
+    template<int types>
+      class BVHNNodeTraverser1Hit<16,16,types>
+    {
+      typedef BVH16 BVH;
+      typedef BVH16::NodeRef NodeRef;
+      typedef BVH16::BaseNode BaseNode;
+
+    public:
+      /* Traverses a node with at least one hit child. Optimized for finding the closest hit (intersection). */
+      static __forceinline void traverseClosestHit(NodeRef& cur,
+                                                   size_t mask,
+                                                   const vfloat16& tNear,
+                                                   StackItemT<NodeRef>*& stackPtr,
+                                                   StackItemT<NodeRef>* stackEnd)
+      {
+        assert(mask != 0);
+        const BaseNode* node = cur.baseNode(types);
+
+        /*! one child is hit, continue with that child */
+        size_t r = __bscf(mask);
+        cur = node->child(r); cur.prefetch(types);
+        if (likely(mask == 0)) {
+          assert(cur != BVH::emptyNode);
+          return;
+        }
+
+        /*! two children are hit, push far child, and continue with closer child */
+        NodeRef c0 = cur; const unsigned int d0 = ((unsigned int*)&tNear)[r];
+        r = __bscf(mask);
+        NodeRef c1 = node->child(r); c1.prefetch(types); const unsigned int d1 = ((unsigned int*)&tNear)[r];
+        assert(c0 != BVH::emptyNode);
+        assert(c1 != BVH::emptyNode);
+        if (likely(mask == 0)) {
+          assert(stackPtr < stackEnd);
+          if (d0 < d1) { stackPtr->ptr = c1; stackPtr->dist = d1; stackPtr++; cur = c0; return; }
+          else         { stackPtr->ptr = c0; stackPtr->dist = d0; stackPtr++; cur = c1; return; }
+        }
+
+        /*! Here starts the slow path for 3 or more hit children. We push
+         *  all nodes onto the stack to sort them there. */
+        assert(stackPtr < stackEnd);
+        stackPtr->ptr = c0; stackPtr->dist = d0; stackPtr++;
+        assert(stackPtr < stackEnd);
+        stackPtr->ptr = c1; stackPtr->dist = d1; stackPtr++;
+
+        /*! three children are hit, push all onto stack and sort 3 stack items, continue with closest child */
+        assert(stackPtr < stackEnd);
+        r = __bscf(mask);
+        NodeRef c = node->child(r); c.prefetch(types); unsigned int d = ((unsigned int*)&tNear)[r]; stackPtr->ptr = c; stackPtr->dist = d; stackPtr++;
+        assert(c != BVH::emptyNode);
+        if (likely(mask == 0)) {
+          sort(stackPtr[-1],stackPtr[-2],stackPtr[-3]);
+          cur = (NodeRef) stackPtr[-1].ptr; stackPtr--;
+          return;
+        }
+
+        /*! four children are hit, push all onto stack and sort 4 stack items, continue with closest child */
+        assert(stackPtr < stackEnd);
+        r = __bscf(mask);
+        c = node->child(r); c.prefetch(types); d = ((unsigned int*)&tNear)[r]; stackPtr->ptr = c; stackPtr->dist = d; stackPtr++;
+        assert(c != BVH::emptyNode);
+        if (likely(mask == 0)) {
+          sort(stackPtr[-1],stackPtr[-2],stackPtr[-3],stackPtr[-4]);
+          cur = (NodeRef) stackPtr[-1].ptr; stackPtr--;
+          return;
+        }
+
+        /*! fallback case if more than 4 children are hit */
+        StackItemT<NodeRef>* stackFirst = stackPtr-4;
+        while (1)
+        {
+          assert(stackPtr < stackEnd);
+          r = __bscf(mask);
+          c = node->child(r); c.prefetch(types); d = ((unsigned int*)&tNear)[r]; stackPtr->ptr = c; stackPtr->dist = d; stackPtr++;
+          assert(c != BVH::emptyNode);
+          if (unlikely(mask == 0)) break;
+        }
+        sort(stackFirst,stackPtr);
+        cur = (NodeRef) stackPtr[-1].ptr; stackPtr--;
+      }
+
+      /* Traverses a node with at least one hit child. Optimized for finding any hit (occlusion). */
+      static __forceinline void traverseAnyHit(NodeRef& cur,
+                                               size_t mask,
+                                               const vfloat16& tNear,
+                                               NodeRef*& stackPtr,
+                                               NodeRef* stackEnd)
+      {
+        assert(mask != 0);
+        const BaseNode* node = cur.baseNode(types);
+
+        /*! one child is hit, continue with that child */
+        size_t r = __bscf(mask);
+        cur = node->child(r); cur.prefetch(types);
+        assert(cur != BVH::emptyNode);
+        if (likely(mask == 0))
+          return;
+
+        /*! push all other hit children, the last one gets traversed next */
+        while (1)
+        {
+          assert(stackPtr < stackEnd);
+          *stackPtr = cur; stackPtr++;
+          r = __bscf(mask);
+          cur = node->child(r); cur.prefetch(types);
+          assert(cur != BVH::emptyNode);
+          if (unlikely(mask == 0)) break;
+        }
+      }
+    };
+
     // ====================================================================================
     // ====================================================================================
     // ====================================================================================
@@ -747,6 +861,13 @@ namespace embree
         return false;
       }
 
+      /* Restores the toplevel ray when traversal terminates inside some instance. */
+      __forceinline void restoreTransform(Ray& ray)
+      {
+        ray.org = ((TravRay<N,Nx>&)tlray).org_xyz;
+        ray.dir = ((TravRay<N,Nx>&)tlray).dir_xyz;
+      }
+
     private:
       TravRay<N,Nx> tlray;
 
@@ -788,6 +909,8 @@ namespace embree
       {
         return false;
       }
+
+      __forceinline void restoreTransform(Ray& ray) {}
     };
 
     /*! BVH node traversal for single rays. */
@@ -52,6 +52,7 @@ namespace embree
       ray.Ng = Ng;
       
       /* invoke filter function */
+      TRAVSTAT(normal.filters,1);
       AVX_ZERO_UPPER();
       geometry->intersectionFilter1(geometry->userPtr,(RTCRay&)ray);
       
@@ -84,6 +85,7 @@ namespace embree
       ray.Ng = Ng;
       
       /* invoke filter function */
+      TRAVSTAT(shadow.filters,1);
       AVX_ZERO_UPPER();
       geometry->occlusionFilter1(geometry->userPtr,(RTCRay&)ray);
       
@@ -113,6 +115,7 @@ namespace embree
       const vfloat4 ray_Ng_z = ray.Ng.z;     vfloat4::store(valid,&ray.Ng.z,Ng.z);
       
       /* invoke filter function */
+      TRAVSTAT(normal.filters,popcnt(valid));
       RTCFilterFunc4  filter4 = geometry->intersectionFilter4;
       AVX_ZERO_UPPER();
       if (geometry->ispcIntersectionFilter4) ((ISPCFilterFunc4)filter4)(geometry->userPtr,(RTCRay4&)ray,valid);
@@ -155,6 +158,7 @@ namespace embree
       vfloat4::store(valid,&ray.Ng.z,Ng.z);
       
       /* invoke filter function */
+      TRAVSTAT(shadow.filters,popcnt(valid));
       RTCFilterFunc4 filter4 = geometry->occlusionFilter4;
       AVX_ZERO_UPPER();
       if (geometry->ispcOcclusionFilter4) ((ISPCFilterFunc4)filter4)(geometry->userPtr,(RTCRay4&)ray,valid);
@@ -184,6 +188,7 @@ namespace embree
       const vfloat4 ray_Ng_z = ray.Ng.z;     ray.Ng.z[k] = Ng.z;
       
       /* invoke filter function */
+      TRAVSTAT(normal.filters,1);
       const vbool4 valid(1 << k);
       RTCFilterFunc4  filter4 = geometry->intersectionFilter4;
       AVX_ZERO_UPPER();
@@ -223,6 +228,7 @@ namespace embree
       ray.Ng.z[k] = Ng.z;
       
       /* invoke filter function */
+      TRAVSTAT(shadow.filters,1);
       const vbool4 valid(1 << k);
       RTCFilterFunc4  filter4 = geometry->occlusionFilter4;
       AVX_ZERO_UPPER();
@@ -255,6 +261,7 @@ namespace embree
       const vfloat8 ray_Ng_z = ray.Ng.z;     vfloat8::store(valid,&ray.Ng.z,Ng.z);
       
       /* invoke filter function */
+      TRAVSTAT(normal.filters,popcnt(valid));
       RTCFilterFunc8  filter8 = geometry->intersectionFilter8;
       if (geometry->ispcIntersectionFilter8) ((ISPCFilterFunc8)filter8)(geometry->userPtr,(RTCRay8&)ray,valid);
       else { const vbool8 valid_temp = valid; filter8(&valid_temp,geometry->userPtr,(RTCRay8&)ray); }
@@ -296,6 +303,7 @@ namespace embree
       vfloat8::store(valid,&ray.Ng.z,Ng.z);
       
       /* invoke filter function */
+      TRAVSTAT(shadow.filters,popcnt(valid));
       RTCFilterFunc8 filter8 = geometry->occlusionFilter8;
       if (geometry->ispcOcclusionFilter8) ((ISPCFilterFunc8)filter8)(geometry->userPtr,(RTCRay8&)ray,valid);
       else { const vbool8 valid_temp = valid; filter8(&valid_temp,geometry->userPtr,(RTCRay8&)ray); }
@@ -324,6 +332,7 @@ namespace embree
       const vfloat8 ray_Ng_z = ray.Ng.z;     ray.Ng.z[k] = Ng.z;
       
       /* invoke filter function */
+      TRAVSTAT(normal.filters,1);
       const vbool8 valid(1 << k);
       RTCFilterFunc8  filter8 = geometry->intersectionFilter8;
       if (geometry->ispcIntersectionFilter8) ((ISPCFilterFunc8)filter8)(geometry->userPtr,(RTCRay8&)ray,valid);
@@ -364,6 +373,7 @@ namespace embree
       ray.Ng.z[k] = Ng.z;
       
       /* invoke filter function */
+      TRAVSTAT(shadow.filters,1);
       const vbool8 valid(1 << k);
       RTCFilterFunc8 filter8 = geometry->occlusionFilter8;
       if (geometry->ispcOcclusionFilter8) ((ISPCFilterFunc8)filter8)(geometry->userPtr,(RTCRay8&)ray,valid);
@@ -398,6 +408,7 @@ namespace embree
       const vfloat16 ray_Ng_z = ray.Ng.z;     vfloat16::store(valid,&ray.Ng.z,Ng.z);
       
       /* invoke filter function */
+      TRAVSTAT(normal.filters,popcnt(valid));
       RTCFilterFunc16  filter16 = geometry->intersectionFilter16;
       if (geometry->ispcIntersectionFilter16) ((ISPCFilterFunc16)filter16)(geometry->userPtr,(RTCRay16&)ray,valid.mask8());
       else { const vint16 mask = valid.mask32(); filter16(&mask,geometry->userPtr,(RTCRay16&)ray); }
@@ -439,6 +450,7 @@ namespace embree
       vfloat16::store(valid,&ray.Ng.z,Ng.z);
       
       /* invoke filter function */
+      TRAVSTAT(shadow.filters,popcnt(valid));
       RTCFilterFunc16 filter16 = geometry->occlusionFilter16;
       if (geometry->ispcOcclusionFilter16) ((ISPCFilterFunc16)filter16)(geometry->userPtr,(RTCRay16&)ray,valid.mask8());
       else { const vint16 mask = valid.mask32(); filter16(&mask,geometry->userPtr,(RTCRay16&)ray); }
@@ -467,6 +479,7 @@ namespace embree
       const vfloat16 ray_Ng_z = ray.Ng.z;     ray.Ng.z[k] = Ng.z;
       
       /* invoke filter function */
+      TRAVSTAT(normal.filters,1);
       const vbool16 valid(1 << k);
       RTCFilterFunc16  filter16 = geometry->intersectionFilter16;
       if (geometry->ispcIntersectionFilter16) ((ISPCFilterFunc16)filter16)(geometry->userPtr,(RTCRay16&)ray,valid.mask8());
@@ -507,6 +520,7 @@ namespace embree
       ray.Ng.z[k] = Ng.z;
       
       /* invoke filter function */
+      TRAVSTAT(shadow.filters,1);
       const vbool16 valid(1 << k);
       RTCFilterFunc16 filter16 = geometry->occlusionFilter16;
       if (geometry->ispcOcclusionFilter16) ((ISPCFilterFunc16)filter16)(geometry->userPtr,(RTCRay16&)ray,valid.mask8());
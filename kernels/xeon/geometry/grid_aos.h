@@ -445,22 +445,72 @@ namespace embree
         const GridAOS& grid;
       };
       
+      /*! Grid vertex with position quantized to 21 bits per
+       *  dimension. All grids of a mesh quantize relative to the same
+       *  bounds, thus shared vertices of neighboring grids stay
+       *  identical. */
+      struct CompressedPoint
+      {
+        unsigned xyz[2];   //!< x in bits 0-20, y in bits 21-41, z in bits 42-62
+        unsigned uv;       //!< u in lower and v in upper 16 bits
+      };
+
+      static const unsigned QUANTIZATION_MAX = (1 << 21)-1;
+
     public:
       
-      __forceinline GridAOS(unsigned width, unsigned height, unsigned geomID, unsigned primID)
-        : width(width), height(height), geomID(geomID), primID(primID) 
+      __forceinline GridAOS(unsigned width, unsigned height, unsigned geomID, unsigned primID, const BBox3fa* frame)
+        : width(width), height(height), primID(primID), geomID(geomID), compressed(frame != nullptr)
       {
         assert(width <= 17);
         assert(height <= 17);
+        if (frame) {
+          offset = frame->lower;
+          scale = max(Vec3fa(1E-20f),frame->size()/float(QUANTIZATION_MAX));
+        } else {
+          offset = scale = Vec3fa(zero);
+        }
+      }
+
+      /*! number of bytes of a grid, padded to keep consecutive grids aligned */
+      static __forceinline size_t bytes(const size_t width, const size_t height, const bool compressed) {
+        const size_t pointBytes = compressed ? sizeof(CompressedPoint) : sizeof(Vec3fa);
+        return (offsetof(GridAOS,P)+width*height*pointBytes+15) & ~size_t(15);
       }
       
       template<typename Allocator>
-      static __forceinline GridAOS* create(Allocator& alloc, const size_t width, const size_t height, const unsigned geomID, const unsigned primID) {
-        return new (alloc(sizeof(GridAOS)-17*17*sizeof(Vec3fa)+width*height*sizeof(Vec3fa))) GridAOS(width,height,geomID,primID);
+      static __forceinline GridAOS* create(Allocator& alloc, const size_t width, const size_t height, const unsigned geomID, const unsigned primID, const BBox3fa* frame) {
+        return new (alloc(bytes(width,height,frame != nullptr))) GridAOS(width,height,geomID,primID,frame);
       }
       
-      __forceinline       Vec3fa& point(const size_t x, const size_t y)       { assert(y*width+x < width*height); return P[y*width+x]; }
-      __forceinline const Vec3fa& point(const size_t x, const size_t y) const { assert(y*width+x < width*height); return P[y*width+x]; }
+      /*! returns the vertex at some grid location, the w component stores the packed uv coordinates */
+      __forceinline Vec3fa point(const size_t x, const size_t y) const 
+      { 
+        const size_t i = y*width+x;
+        assert(i < width*height); 
+        if (likely(!compressed)) return P[i];
+
+        const CompressedPoint& c = ((const CompressedPoint*)P)[i];
+        const uint64_t q = uint64_t(c.xyz[0]) | (uint64_t(c.xyz[1]) << 32);
+        const vint4 qi(int(q & QUANTIZATION_MAX), int((q >> 21) & QUANTIZATION_MAX), int(q >> 42), 0);
+        Vec3fa p(madd(vfloat4(qi),vfloat4(scale),vfloat4(offset)));
+        p.u = c.uv;
+        return p;
+      }
+
+      /*! stores the vertex with index i, the w component has to contain the packed uv coordinates */
+      __forceinline void set(const size_t i, const Vec3fa& p)
+      {
+        assert(i < width*height); 
+        if (likely(!compressed)) { P[i] = p; return; }
+
+        const Vec3fa q = clamp(floor((p-offset)/scale+Vec3fa(0.5f)),Vec3fa(zero),Vec3fa(float(QUANTIZATION_MAX)));
+        const uint64_t v = uint64_t(q.x) | (uint64_t(q.y) << 21) | (uint64_t(q.z) << 42);
+        CompressedPoint& c = ((CompressedPoint*)P)[i];
+        c.xyz[0] = unsigned(v);
+        c.xyz[1] = unsigned(v >> 32);
+        c.uv = p.u;
+      }
       
       BBox3fa bounds() const
       {
@@ -520,10 +570,10 @@ namespace embree
           const vfloat4 uv = asFloat((vi << 16) | ui);
           vfloat4 xyzuv0, xyzuv1, xyzuv2, xyzuv3;
           transpose(xi,yi,zi,uv,xyzuv0, xyzuv1, xyzuv2, xyzuv3);
-          P[i+0] = Vec3fa(xyzuv0); 
-          P[i+1] = Vec3fa(xyzuv1); 
-          P[i+2] = Vec3fa(xyzuv2);
-          P[i+3] = Vec3fa(xyzuv3);
+          set(i+0,Vec3fa(xyzuv0)); 
+          set(i+1,Vec3fa(xyzuv1)); 
+          set(i+2,Vec3fa(xyzuv2));
+          set(i+3,Vec3fa(xyzuv3));
         }
         for (; i<dwidth*dheight; i++) 
         {
@@ -532,13 +582,14 @@ namespace embree
           const float zi = grid_z[i];
           const int   ui = clamp(grid_u[i] * 0xFFFF, 0.0f, float(0xFFFF)); 
           const int   vi = clamp(grid_v[i] * 0xFFFF, 0.0f, float(0xFFFF)); 
-          P[i] = Vec3fa(xi,yi,zi);
-          P[i].a = (vi << 16) | ui;
+          Vec3fa p(xi,yi,zi);
+          p.a = (vi << 16) | ui;
+          set(i,p);
         }
       }
       
       template<int N, typename Allocator>
-      static size_t createEager(const SubdivPatch1Base& patch, Scene* scene, SubdivMesh* mesh, size_t primID, Allocator& alloc, PrimRef* prims)
+      static size_t createEager(const SubdivPatch1Base& patch, Scene* scene, SubdivMesh* mesh, size_t primID, Allocator& alloc, PrimRef* prims, const BBox3fa* frame = nullptr)
       {
         size_t num = 0;
         const size_t x0 = 0, x1 = patch.grid_u_res-1;
@@ -550,7 +601,7 @@ namespace embree
           {
             const size_t lx0 = x, lx1 = min(lx0+16,x1);
             const size_t ly0 = y, ly1 = min(ly0+16,y1);
-            GridAOS* leaf = GridAOS::create(alloc,lx1-lx0+1,ly1-ly0+1,mesh->id,primID);
+            GridAOS* leaf = GridAOS::create(alloc,lx1-lx0+1,ly1-ly0+1,mesh->id,primID,frame);
             leaf->build(scene,mesh,primID,patch,lx0,lx1,ly0,ly1);
             size_t n = leaf->createEagerPrims<N>(alloc,prims,lx0,lx1,ly0,ly1);
             prims += n;
@@ -559,6 +610,39 @@ namespace embree
         }
         return num;
       }
+
+      /*! Creates the eager leaves of a patch from grids stored by
+       *  createEager before. Advances data over the consumed grids
+       *  and returns 0 if the stored grids do not match the patch. */
+      template<int N, typename Allocator>
+      static size_t loadEager(const SubdivPatch1Base& patch, SubdivMesh* mesh, size_t primID, const char*& data, const char* end, Allocator& alloc, PrimRef* prims)
+      {
+        size_t num = 0;
+        const size_t x0 = 0, x1 = patch.grid_u_res-1;
+        const size_t y0 = 0, y1 = patch.grid_v_res-1;
+        
+        for (size_t y=y0; y<y1; y+=16)
+        {
+          for (size_t x=x0; x<x1; x+=16) 
+          {
+            const size_t lx0 = x, lx1 = min(lx0+16,x1);
+            const size_t ly0 = y, ly1 = min(ly0+16,y1);
+            if (size_t(end-data) < offsetof(GridAOS,P)) return 0;
+            const GridAOS* src = (const GridAOS*) data;
+            if (src->width != lx1-lx0+1 || src->height != ly1-ly0+1 || src->geomID != mesh->id || src->primID != primID || src->compressed > 1) return 0;
+            const size_t bytes = GridAOS::bytes(src->width,src->height,src->compressed);
+            if (size_t(end-data) < bytes) return 0;
+
+            GridAOS* leaf = (GridAOS*) alloc(bytes);
+            memcpy(leaf,src,bytes);
+            data += bytes;
+            size_t n = leaf->createEagerPrims<N>(alloc,prims,lx0,lx1,ly0,ly1);
+            prims += n;
+            num += n;
+          }
+        }
+        return num;
+      }
       
       template<int N, typename Allocator>
       static void* create(SubdivPatch1Base* const patch, Scene* scene, Allocator& alloc)
@@ -574,7 +658,10 @@ namespace embree
       unsigned height;
       unsigned primID;
       unsigned geomID;
-      Vec3fa P[17*17];
+      unsigned compressed;  //!< vertices are stored as CompressedPoint
+      Vec3fa offset;        //!< lower bounds of quantized vertices
+      Vec3fa scale;         //!< distance of quantization steps
+      Vec3fa P[17*17];      //!< vertices, stored as CompressedPoint for compressed grids
     };
   }
 }
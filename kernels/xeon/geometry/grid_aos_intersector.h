@@ -226,28 +226,28 @@ namespace embree
           const size_t ofs = prim.quads[i].ofs;
           switch (prim.quads[i].type) {
           case GridAOS::EagerLeaf::Quads::QUAD1X1: {
-            const Vec3fa& v00 = prim.grid.point(ofs,0), v10 = (&v00)[1];
-            const Vec3fa& v01 = prim.grid.point(ofs,1), v11 = (&v01)[1];
+            const Vec3fa v00 = prim.grid.point(ofs,0), v10 = prim.grid.point(ofs+1,0);
+            const Vec3fa v01 = prim.grid.point(ofs,1), v11 = prim.grid.point(ofs+1,1);
             intersectQuad(pre,ray,k, v00,v10,v01,v11, prim, scene);
             break;
           }
           case GridAOS::EagerLeaf::Quads::QUAD1X2: {
-            const Vec3fa& v00 = prim.grid.point(ofs,0), v10 = (&v00)[1];
-            const Vec3fa& v01 = prim.grid.point(ofs,1), v11 = (&v01)[1];
-            const Vec3fa& v02 = prim.grid.point(ofs,2), v12 = (&v02)[1];
+            const Vec3fa v00 = prim.grid.point(ofs,0), v10 = prim.grid.point(ofs+1,0);
+            const Vec3fa v01 = prim.grid.point(ofs,1), v11 = prim.grid.point(ofs+1,1);
+            const Vec3fa v02 = prim.grid.point(ofs,2), v12 = prim.grid.point(ofs+1,2);
             intersectQuads(pre,ray,k, v10,v11,v12, v00,v01,v02, prim, scene);
             break;
           }
           case GridAOS::EagerLeaf::Quads::QUAD2X1: {
-            const Vec3fa& v00 = prim.grid.point(ofs,0), v10 = (&v00)[1], v20 = (&v00)[2];
-            const Vec3fa& v01 = prim.grid.point(ofs,1), v11 = (&v01)[1], v21 = (&v01)[2];
+            const Vec3fa v00 = prim.grid.point(ofs,0), v10 = prim.grid.point(ofs+1,0), v20 = prim.grid.point(ofs+2,0);
+            const Vec3fa v01 = prim.grid.point(ofs,1), v11 = prim.grid.point(ofs+1,1), v21 = prim.grid.point(ofs+2,1);
             intersectQuads(pre,ray,k, v00,v10,v20,v01,v11,v21, prim, scene);
             break;
           }
           case GridAOS::EagerLeaf::Quads::QUAD2X2: {
-            const Vec3fa& v00 = prim.grid.point(ofs,0), v10 = (&v00)[1], v20 = (&v00)[2];
-            const Vec3fa& v01 = prim.grid.point(ofs,1), v11 = (&v01)[1], v21 = (&v01)[2];
-            const Vec3fa& v02 = prim.grid.point(ofs,2), v12 = (&v02)[1], v22 = (&v02)[2];
+            const Vec3fa v00 = prim.grid.point(ofs,0), v10 = prim.grid.point(ofs+1,0), v20 = prim.grid.point(ofs+2,0);
+            const Vec3fa v01 = prim.grid.point(ofs,1), v11 = prim.grid.point(ofs+1,1), v21 = prim.grid.point(ofs+2,1);
+            const Vec3fa v02 = prim.grid.point(ofs,2), v12 = prim.grid.point(ofs+1,2), v22 = prim.grid.point(ofs+2,2);
             intersectQuads(pre,ray,k, v00,v10,v20,v01,v11,v21,v02,v12,v22, prim, scene);
             break;
           }
@@ -427,28 +427,28 @@ namespace embree
           const size_t ofs = prim.quads[i].ofs;
           switch (prim.quads[i].type) {
           case GridAOS::EagerLeaf::Quads::QUAD1X1: {
-            const Vec3fa& v00 = prim.grid.point(ofs,0), v10 = (&v00)[1];
-            const Vec3fa& v01 = prim.grid.point(ofs,1), v11 = (&v01)[1];
+            const Vec3fa v00 = prim.grid.point(ofs,0), v10 = prim.grid.point(ofs+1,0);
+            const Vec3fa v01 = prim.grid.point(ofs,1), v11 = prim.grid.point(ofs+1,1);
             if (occludedQuad(pre,ray,k, v00,v10,v01,v11, prim, scene)) return true;
             break;
           }
           case GridAOS::EagerLeaf::Quads::QUAD1X2: {
-            const Vec3fa& v00 = prim.grid.point(ofs,0), v10 = (&v00)[1];
-            const Vec3fa& v01 = prim.grid.point(ofs,1), v11 = (&v01)[1];
-            const Vec3fa& v02 = prim.grid.point(ofs,2), v12 = (&v02)[1];
+            const Vec3fa v00 = prim.grid.point(ofs,0), v10 = prim.grid.point(ofs+1,0);
+            const Vec3fa v01 = prim.grid.point(ofs,1), v11 = prim.grid.point(ofs+1,1);
+            const Vec3fa v02 = prim.grid.point(ofs,2), v12 = prim.grid.point(ofs+1,2);
             if (occludedQuads(pre,ray,k, v10,v11,v12,v00,v01,v02,  prim,scene)) return true;
             break;
           }
           case GridAOS::EagerLeaf::Quads::QUAD2X1: {
-            const Vec3fa& v00 = prim.grid.point(ofs,0), v10 = (&v00)[1], v20 = (&v00)[2];
-            const Vec3fa& v01 = prim.grid.point(ofs,1), v11 = (&v01)[1], v21 = (&v01)[2];
+            const Vec3fa v00 = prim.grid.point(ofs,0), v10 = prim.grid.point(ofs+1,0), v20 = prim.grid.point(ofs+2,0);
+            const Vec3fa v01 = prim.grid.point(ofs,1), v11 = prim.grid.point(ofs+1,1), v21 = prim.grid.point(ofs+2,1);
             if (occludedQuads(pre,ray,k, v00,v10,v20,v01,v11,v21, prim,scene)) return true;
             break;
           }
           case GridAOS::EagerLeaf::Quads::QUAD2X2: {
-            const Vec3fa& v00 = prim.grid.point(ofs,0), v10 = (&v00)[1], v20 = (&v00)[2];
-            const Vec3fa& v01 = prim.grid.point(ofs,1), v11 = (&v01)[1], v21 = (&v01)[2];
-            const Vec3fa& v02 = prim.grid.point(ofs,2), v12 = (&v02)[1], v22 = (&v02)[2];
+            const Vec3fa v00 = prim.grid.point(ofs,0), v10 = prim.grid.point(ofs+1,0), v20 = prim.grid.point(ofs+2,0);
+            const Vec3fa v01 = prim.grid.point(ofs,1), v11 = prim.grid.point(ofs+1,1), v21 = prim.grid.point(ofs+2,1);
+            const Vec3fa v02 = prim.grid.point(ofs,2), v12 = prim.grid.point(ofs+1,2), v22 = prim.grid.point(ofs+2,2);
             if (occludedQuads(pre,ray,k, v00,v10,v20,v01,v11,v21,v02,v12,v22, prim,scene)) return true;
             break;
           }
@@ -23,6 +23,12 @@ namespace embree
 {
   namespace isa
   {
+    /* The filter parameter of the epilogs enables geometry mask tests
+     * and filter function calls. The variants without them get selected
+     * at commit time for scenes that use neither (see
+     * Scene::selectIntersectors). As all geometries then have the
+     * default mask of -1, these variants only reject rays with mask 0. */
+
     template<int M>
       struct UVIdentity
       {
@@ -54,8 +60,6 @@ namespace embree
           hit.finalize();          
           size_t i = select_min(valid,hit.vt);
           int geomID = geomIDs[i];
-          int instID = geomID_to_instID ? geomID_to_instID[0] : geomID;
-          //int instID = geomID_to_instID ? (int)(size_t)geomID_to_instID : geomID;
           
           /* intersection filter test */
 #if defined(RTCORE_INTERSECTION_FILTER) || defined(RTCORE_RAY_MASK)
@@ -66,13 +70,12 @@ namespace embree
             i = select_min(valid,hit.vt);
 
             geomID = geomIDs[i];
-            instID = geomID_to_instID ? geomID_to_instID[0] : geomID;
           entry:
             Geometry* geometry = scene->get(geomID);
             
 #if defined(RTCORE_RAY_MASK)
             /* goto next hit if mask test fails */
-            if ((geometry->mask & ray.mask) == 0) {
+            if ((filter ? geometry->mask & ray.mask : ray.mask) == 0) {
               clear(valid,i);
               continue;
             }
@@ -83,7 +86,10 @@ namespace embree
             if (filter) {
               if (unlikely(geometry->hasIntersectionFilter1())) {
                 const Vec2f uv = hit.uv(i);
-                if (runIntersectionFilter1(geometry,ray,uv.x,uv.y,hit.t(i),hit.Ng(i),instID,primIDs[i])) return true;
+                const unsigned ray_instID = ray.instID;
+                if (geomID_to_instID) ray.instID = geomID_to_instID[0];
+                if (runIntersectionFilter1(geometry,ray,uv.x,uv.y,hit.t(i),hit.Ng(i),geomID,primIDs[i])) return true;
+                ray.instID = ray_instID;
                 clear(valid,i);
                 continue;
               }
@@ -101,8 +107,9 @@ namespace embree
           ray.Ng.x = hit.vNg.x[i];
           ray.Ng.y = hit.vNg.y[i];
           ray.Ng.z = hit.vNg.z[i];
-          ray.geomID = instID;
+          ray.geomID = geomID;
           ray.primID = primIDs[i];
+          if (geomID_to_instID) ray.instID = geomID_to_instID[0];
           return true;
         }
       };
@@ -141,12 +148,11 @@ namespace embree
             hit.finalize(); // FIXME: executed too often
 
             const int geomID = geomIDs[i];
-            const int instID = geomID_to_instID ? geomID_to_instID[0] : geomID;
             Geometry* geometry = scene->get(geomID);
             
 #if defined(RTCORE_RAY_MASK)
             /* goto next hit if mask test fails */
-            if ((geometry->mask & ray.mask) == 0) {
+            if ((filter ? geometry->mask & ray.mask : ray.mask) == 0) {
               m=__btc(m,i);
               continue;
             }
@@ -159,7 +165,10 @@ namespace embree
               {
                 //const Vec3fa Ngi = Vec3fa(Ng.x[i],Ng.y[i],Ng.z[i]);
                 const Vec2f uv = hit.uv(i);
-                if (runOcclusionFilter1(geometry,ray,uv.x,uv.y,hit.t(i),hit.Ng(i),instID,primIDs[i])) return true;
+                const unsigned ray_instID = ray.instID;
+                if (geomID_to_instID) ray.instID = geomID_to_instID[0];
+                if (runOcclusionFilter1(geometry,ray,uv.x,uv.y,hit.t(i),hit.Ng(i),geomID,primIDs[i])) return true;
+                ray.instID = ray_instID;
                 m=__btc(m,i);
                 continue;
               }
@@ -195,7 +204,7 @@ namespace embree
           /* ray mask test */
           Geometry* geometry = scene->get(geomID);
 #if defined(RTCORE_RAY_MASK)
-          if ((geometry->mask & ray.mask) == 0) return false;
+          if ((filter ? geometry->mask & ray.mask : ray.mask) == 0) return false;
 #endif
           
           vbool<M> valid = valid_i;
@@ -258,7 +267,7 @@ namespace embree
           /* ray mask test */
           Geometry* geometry = scene->get(geomID);
 #if defined(RTCORE_RAY_MASK)
-          if ((geometry->mask & ray.mask) == 0) return false;
+          if ((filter ? geometry->mask & ray.mask : ray.mask) == 0) return false;
 #endif
           
           /* intersection filter test */
@@ -309,7 +318,7 @@ namespace embree
           
           /* ray masking test */
 #if defined(RTCORE_RAY_MASK)
-          valid &= (geometry->mask & ray.mask) != 0;
+          valid &= (filter ? geometry->mask & ray.mask : ray.mask) != 0;
           if (unlikely(none(valid))) return false;
 #endif
           
@@ -363,7 +372,7 @@ namespace embree
           const int primID = primIDs[i];
           Geometry* geometry = scene->get(geomID);
 #if defined(RTCORE_RAY_MASK)
-          valid &= (geometry->mask & ray.mask) != 0;
+          valid &= (filter ? geometry->mask & ray.mask : ray.mask) != 0;
           if (unlikely(none(valid))) return valid;
 #endif
           
@@ -412,7 +421,7 @@ namespace embree
           
           /* ray masking test */
 #if defined(RTCORE_RAY_MASK)
-          valid &= (geometry->mask & ray.mask) != 0;
+          valid &= (filter ? geometry->mask & ray.mask : ray.mask) != 0;
           if (unlikely(none(valid))) return false;
 #endif
           
@@ -461,7 +470,7 @@ namespace embree
           Geometry* geometry = scene->get(geomID);
           
 #if defined(RTCORE_RAY_MASK)
-          valid &= (geometry->mask & ray.mask) != 0;
+          valid &= (filter ? geometry->mask & ray.mask : ray.mask) != 0;
           if (unlikely(none(valid))) return false;
 #endif
           
@@ -525,7 +534,7 @@ namespace embree
             
 #if defined(RTCORE_RAY_MASK)
             /* goto next hit if mask test fails */
-            if ((geometry->mask & ray.mask[k]) == 0) {
+            if ((filter ? geometry->mask & ray.mask[k] : ray.mask[k]) == 0) {
               clear(valid,i);
               continue;
             }
@@ -598,7 +607,7 @@ namespace embree
             
 #if defined(RTCORE_RAY_MASK)
             /* goto next hit if mask test fails */
-            if ((geometry->mask & ray.mask[k]) == 0) {
+            if ((filter ? geometry->mask & ray.mask[k] : ray.mask[k]) == 0) {
               m=__btc(m,i);
               continue;
             }
@@ -645,7 +654,7 @@ namespace embree
           Geometry* geometry = scene->get(geomID);
 #if defined(RTCORE_RAY_MASK)
           /* ray mask test */
-          if ((geometry->mask & ray.mask[k]) == 0) 
+          if ((filter ? geometry->mask & ray.mask[k] : ray.mask[k]) == 0) 
             return false;
 #endif
 
@@ -708,7 +717,7 @@ namespace embree
           Geometry* geometry = scene->get(geomID);
 #if defined(RTCORE_RAY_MASK)
           /* ray mask test */
-          if ((geometry->mask & ray.mask[k]) == 0) 
+          if ((filter ? geometry->mask & ray.mask[k] : ray.mask[k]) == 0) 
             return false;
 #endif
 
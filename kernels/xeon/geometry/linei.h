@@ -41,6 +41,9 @@ namespace embree
     /* Returns required number of primitive blocks for N line segments */
     static __forceinline size_t blocks(size_t N) { return (N+max_size()-1)/max_size(); }
 
+    /* Returns true if a primitive block can only store the motion of a single time segment */
+    static __forceinline bool singleTimeSegment() { return false; }
+
   public:
 
     /* Default constructor */
@@ -159,11 +162,25 @@ namespace embree
       new (this) LineMi(v0,geomID,primID); // FIXME: use non temporal store
     }
 
+    /* Calculate the linear bounds of the line segments over the specified time range */
+    __forceinline std::pair<BBox3fa,BBox3fa> linearBounds(const Scene* scene, const BBox1f& time_range) const
+    {
+      BBox3fa bounds0 = empty, bounds1 = empty;
+      for (size_t i=0; i<M && valid(i); i++)
+      {
+        const LineSegments* geom = scene->getLineSegments(geomID(i));
+        const std::pair<BBox3fa,BBox3fa> b = geom->linearBounds(primID(i),time_range);
+        bounds0.extend(b.first);
+        bounds1.extend(b.second);
+      }
+      return std::make_pair(bounds0,bounds1);
+    }
+
     /* Fill line segment from line segment list */
-    __forceinline std::pair<BBox3fa,BBox3fa> fill_mblur(const PrimRef* prims, size_t& begin, size_t end, Scene* scene, const bool list)
+    __forceinline std::pair<BBox3fa,BBox3fa> fill_mblur(const PrimRef* prims, size_t& begin, size_t end, Scene* scene, const bool list, const BBox1f& time_range)
     {
       fill(prims,begin,end,scene,list);
-      return bounds(scene);
+      return linearBounds(scene,time_range);
     }
 
     /* Updates the primitive */
@@ -213,14 +230,27 @@ namespace embree
   template<>
   __forceinline void LineMi<4>::gather(Vec4vf4& p0, Vec4vf4& p1, const Scene* scene, float t) const
   {
-    const vfloat4 t0 = 1.0f - t;
-    const vfloat4 t1 = t;
-    Vec4vf4 a0,a1;
-    gather(a0,a1,scene,(size_t)0);
-    Vec4vf4 b0,b1;
-    gather(b0,b1,scene,(size_t)1);
-    p0 = t0 * a0 + t1 * b0;
-    p1 = t0 * a1 + t1 * b1;
+    const LineSegments* geom0 = scene->getLineSegments(geomIDs[0]);
+    const LineSegments* geom1 = scene->getLineSegments(geomIDs[1]);
+    const LineSegments* geom2 = scene->getLineSegments(geomIDs[2]);
+    const LineSegments* geom3 = scene->getLineSegments(geomIDs[3]);
+
+    /* each segment may come from a geometry with a different number of time steps */
+    float ftime0; const size_t itime0 = geom0->timeSegment(t,ftime0);
+    float ftime1; const size_t itime1 = geom1->timeSegment(t,ftime1);
+    float ftime2; const size_t itime2 = geom2->timeSegment(t,ftime2);
+    float ftime3; const size_t itime3 = geom3->timeSegment(t,ftime3);
+
+    auto lerpVertex = [] (const LineSegments* geom, const int v, const size_t itime, const float ftime) -> vfloat4 {
+      const vfloat4 a = vfloat4::loadu(geom->vertexPtr(v,itime+0));
+      const vfloat4 b = vfloat4::loadu(geom->vertexPtr(v,itime+1));
+      return madd(vfloat4(ftime),b-a,a);
+    };
+
+    transpose(lerpVertex(geom0,v0[0]+0,itime0,ftime0),lerpVertex(geom1,v0[1]+0,itime1,ftime1),
+              lerpVertex(geom2,v0[2]+0,itime2,ftime2),lerpVertex(geom3,v0[3]+0,itime3,ftime3),p0.x,p0.y,p0.z,p0.w);
+    transpose(lerpVertex(geom0,v0[0]+1,itime0,ftime0),lerpVertex(geom1,v0[1]+1,itime1,ftime1),
+              lerpVertex(geom2,v0[2]+1,itime2,ftime2),lerpVertex(geom3,v0[3]+1,itime3,ftime3),p1.x,p1.y,p1.z,p1.w);
   }
 
   template<int M>
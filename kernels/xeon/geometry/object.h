@@ -37,6 +37,9 @@ namespace embree
     /* Returns required number of primitive blocks for N primitives */
     static __forceinline size_t blocks(size_t N) { return N; }
 
+    /* Returns true if a primitive block can only store the motion of a single time segment */
+    static __forceinline bool singleTimeSegment() { return false; }
+
   public:
 
     /*! constructs a virtual object */
@@ -51,14 +54,14 @@ namespace embree
     }
 
     /*! fill triangle from triangle list */
-    __forceinline std::pair<BBox3fa,BBox3fa> fill_mblur(const PrimRef* prims, size_t& i, size_t end, Scene* scene, const bool list)
+    __forceinline std::pair<BBox3fa,BBox3fa> fill_mblur(const PrimRef* prims, size_t& i, size_t end, Scene* scene, const bool list, const BBox1f& time_range)
     {
       const PrimRef& prim = prims[i]; i++;
       const size_t geomID = prim.geomID();
       const size_t primID = prim.primID();
       new (this) Object(geomID, primID);
       AccelSet* accel = (AccelSet*) scene->get(geomID);
-      return accel->bounds_mblur(primID);
+      return accel->linearBounds(primID,time_range);
     }
 
   public:
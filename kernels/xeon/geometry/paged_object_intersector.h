@@ -0,0 +1,116 @@
+// ======================================================================== //
+// Copyright 2009-2015 Intel Corporation                                    //
+//                                                                          //
+// Licensed under the Apache License, Version 2.0 (the "License");          //
+// you may not use this file except in compliance with the License.         //
+// You may obtain a copy of the License at                                  //
+//                                                                          //
+//     http://www.apache.org/licenses/LICENSE-2.0                           //
+//                                                                          //
+// Unless required by applicable law or agreed to in writing, software      //
+// distributed under the License is distributed on an "AS IS" BASIS,        //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. //
+// See the License for the specific language governing permissions and      //
+// limitations under the License.                                           //
+// ======================================================================== //
+
+#pragma once
+
+#include "paged_object.h"
+#include "../../common/ray.h"
+
+namespace embree
+{
+  namespace isa
+  {
+    /*! Pages in the acceleration structure of the object and traverses it. */
+    struct PagedObjectIntersector1
+    {
+      typedef PagedObject Primitive;
+      
+      struct Precalculations {
+        __forceinline Precalculations (const Ray& ray, const void *ptr) {}
+      };
+      
+      static __forceinline void intersect(const Precalculations& pre, Ray& ray, const Primitive& prim, Scene* scene, const unsigned* geomID_to_instID) 
+      {
+        OutOfCoreCache::Entry* entry = prim.entry;
+        entry->acquire();
+        entry->intersectors.intersector1.intersect(entry->intersectors.ptr,(RTCRay&)ray);
+        entry->release();
+      }
+      
+      static __forceinline bool occluded(const Precalculations& pre, Ray& ray, const Primitive& prim, Scene* scene, const unsigned* geomID_to_instID) 
+      {
+        OutOfCoreCache::Entry* entry = prim.entry;
+        entry->acquire();
+        entry->intersectors.intersector1.occluded(entry->intersectors.ptr,(RTCRay&)ray);
+        entry->release();
+        return ray.geomID == 0;
+      }
+    };
+
+    template<int K>
+    struct PagedObjectIntersectorK
+    {
+      typedef PagedObject Primitive;
+      
+      struct Precalculations {
+        __forceinline Precalculations (const vbool<K>& valid, const RayK<K>& ray) {}
+      };
+      
+      static __forceinline void intersect(const vbool<K>& valid, const Precalculations& pre, RayK<K>& ray, const Primitive& prim, Scene* scene)
+      {
+        vint<K> mask = select(valid,vint<K>(-1),vint<K>(0));
+        OutOfCoreCache::Entry* entry = prim.entry;
+        entry->acquire();
+        intersect(&mask,entry->intersectors,ray);
+        entry->release();
+      }
+
+      static __forceinline vbool<K> occluded(const vbool<K>& valid, const Precalculations& pre, RayK<K>& ray, const Primitive& prim, Scene* scene)
+      {
+        vint<K> mask = select(valid,vint<K>(-1),vint<K>(0));
+        OutOfCoreCache::Entry* entry = prim.entry;
+        entry->acquire();
+        occluded(&mask,entry->intersectors,ray);
+        entry->release();
+        return valid & (ray.geomID == 0);
+      }
+
+    private:
+
+      static __forceinline void intersect(vint4* valid, const Accel::Intersectors& intersectors, Ray4& ray) {
+        intersectors.intersector4.intersect(valid,intersectors.ptr,(RTCRay4&)ray);
+      }
+
+      static __forceinline void occluded(vint4* valid, const Accel::Intersectors& intersectors, Ray4& ray) {
+        intersectors.intersector4.occluded(valid,intersectors.ptr,(RTCRay4&)ray);
+      }
+
+#if defined(__AVX__)
+      static __forceinline void intersect(vint8* valid, const Accel::Intersectors& intersectors, Ray8& ray) {
+        intersectors.intersector8.intersect(valid,intersectors.ptr,(RTCRay8&)ray);
+      }
+
+      static __forceinline void occluded(vint8* valid, const Accel::Intersectors& intersectors, Ray8& ray) {
+        intersectors.intersector8.occluded(valid,intersectors.ptr,(RTCRay8&)ray);
+      }
+#endif
+
+#if defined(__AVX512F__)
+      static __forceinline void intersect(vint16* valid, const Accel::Intersectors& intersectors, Ray16& ray) {
+        intersectors.intersector16.intersect(valid,intersectors.ptr,(RTCRay16&)ray);
+      }
+
+      static __forceinline void occluded(vint16* valid, const Accel::Intersectors& intersectors, Ray16& ray) {
+        intersectors.intersector16.occluded(valid,intersectors.ptr,(RTCRay16&)ray);
+      }
+#endif
+    };
+
+    typedef PagedObjectIntersectorK<4>  PagedObjectIntersector4;
+    typedef PagedObjectIntersectorK<8>  PagedObjectIntersector8;
+    typedef PagedObjectIntersectorK<16> PagedObjectIntersector16;
+  }
+}
@@ -0,0 +1,178 @@
+// ======================================================================== //
+// Copyright 2009-2015 Intel Corporation                                    //
+//                                                                          //
+// Licensed under the Apache License, Version 2.0 (the "License");          //
+// you may not use this file except in compliance with the License.         //
+// You may obtain a copy of the License at                                  //
+//                                                                          //
+//     http://www.apache.org/licenses/LICENSE-2.0                           //
+//                                                                          //
+// Unless required by applicable law or agreed to in writing, software      //
+// distributed under the License is distributed on an "AS IS" BASIS,        //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. //
+// See the License for the specific language governing permissions and      //
+// limitations under the License.                                           //
+// ======================================================================== //
+
+
+#pragma once
+
+#include "../../common/scene.h"
+#include "../../common/point_query.h"
+
+namespace embree
+{
+  namespace isa
+  {
+    /*! closest point to p on the triangle a,b,c */
+    __forceinline Vec3fa closestPointTriangle(const Vec3fa& p, const Vec3fa& a, const Vec3fa& b, const Vec3fa& c)
+    {
+      const Vec3fa ab = b-a, ac = c-a, ap = p-a;
+      const float d1 = dot(ab,ap), d2 = dot(ac,ap);
+      if (d1 <= 0.0f && d2 <= 0.0f) return a;
+
+      const Vec3fa bp = p-b;
+      const float d3 = dot(ab,bp), d4 = dot(ac,bp);
+      if (d3 >= 0.0f && d4 <= d3) return b;
+
+      const Vec3fa cp = p-c;
+      const float d5 = dot(ab,cp), d6 = dot(ac,cp);
+      if (d6 >= 0.0f && d5 <= d6) return c;
+
+      const float vc = d1*d4 - d3*d2;
+      if (vc <= 0.0f && d1 >= 0.0f && d3 <= 0.0f) return a + d1/(d1-d3)*ab;
+      
+      const float vb = d5*d2 - d1*d6;
+      if (vb <= 0.0f && d2 >= 0.0f && d6 <= 0.0f) return a + d2/(d2-d6)*ac;
+      
+      const float va = d3*d6 - d5*d4;
+      if (va <= 0.0f && (d4-d3) >= 0.0f && (d5-d6) >= 0.0f) return b + (d4-d3)/((d4-d3)+(d5-d6))*(c-b);
+
+      const float denom = rcp(va+vb+vc);
+      return a + (vb*denom)*ab + (vc*denom)*ac;
+    }
+
+    /*! parameter of the closest point to p on the segment a,b */
+    __forceinline float closestPointSegment(const Vec3fa& p, const Vec3fa& a, const Vec3fa& b)
+    {
+      const Vec3fa ab = b-a;
+      const float l2 = dot(ab,ab);
+      if (l2 == 0.0f) return 0.0f;
+      return clamp(dot(p-a,ab)/l2,0.0f,1.0f);
+    }
+
+    /*! closest point to p on the surface of a sphere */
+    __forceinline Vec3fa closestPointSphere(const Vec3fa& p, const Vec3fa& c, const float r, float& dist)
+    {
+      const Vec3fa d = p-c;
+      const float l = length(d);
+      if (l <= r) { dist = 0.0f; return p; }
+      dist = l-r;
+      return c + (r/l)*d;
+    }
+
+    /*! point query for triangles stored in a triangle mesh */
+    template<typename Prim>
+      struct TrianglePointQuery
+      {
+        typedef Prim Primitive;
+
+        static __forceinline void pointQuery(PointQueryContext* context, const Primitive& prim)
+        {
+          const Vec3fa p = context->p();
+          for (size_t i=0; i<Primitive::max_size(); i++)
+          {
+            if (!prim.valid(i)) break;
+            const unsigned geomID = prim.geomID(i), primID = prim.primID(i);
+            const TriangleMesh* mesh = context->scene->getTriangleMesh(geomID);
+            const TriangleMesh::Triangle& tri = mesh->triangle(primID);
+            const Vec3fa q = closestPointTriangle(p,mesh->vertex(tri.v[0]),mesh->vertex(tri.v[1]),mesh->vertex(tri.v[2]));
+            context->report(q,length(q-p),geomID,primID);
+          }
+        }
+      };
+
+    /*! point query for quads stored in a quad mesh, the quad is split into the triangles (v0,v1,v3) and (v2,v3,v1) */
+    template<typename Prim>
+      struct QuadPointQuery
+      {
+        typedef Prim Primitive;
+
+        static __forceinline void pointQuery(PointQueryContext* context, const Primitive& prim)
+        {
+          const Vec3fa p = context->p();
+          for (size_t i=0; i<Primitive::max_size(); i++)
+          {
+            if (!prim.valid(i)) break;
+            const unsigned geomID = prim.geomID(i), primID = prim.primID(i);
+            const QuadMesh* mesh = context->scene->getQuadMesh(geomID);
+            const QuadMesh::Quad& quad = mesh->quad(primID);
+            const Vec3fa v0 = mesh->vertex(quad.v[0]), v1 = mesh->vertex(quad.v[1]);
+            const Vec3fa v2 = mesh->vertex(quad.v[2]), v3 = mesh->vertex(quad.v[3]);
+            const Vec3fa q0 = closestPointTriangle(p,v0,v1,v3);
+            const Vec3fa q1 = closestPointTriangle(p,v2,v3,v1);
+            const float d0 = length(q0-p), d1 = length(q1-p);
+            if (d0 <= d1) context->report(q0,d0,geomID,primID);
+            else          context->report(q1,d1,geomID,primID);
+          }
+        }
+      };
+
+    /*! point query for line segments, treated as capsules with linearly interpolated radius */
+    template<typename Prim>
+      struct LinePointQuery
+      {
+        typedef Prim Primitive;
+
+        static __forceinline void pointQuery(PointQueryContext* context, const Primitive& prim)
+        {
+          const Vec3fa p = context->p();
+          for (size_t i=0; i<Primitive::max_size(); i++)
+          {
+            if (!prim.valid(i)) break;
+            const unsigned geomID = prim.geomID(i), primID = prim.primID(i);
+            const LineSegments* geom = context->scene->getLineSegments(geomID);
+            const int index = geom->segment(primID);
+            const Vec3fa a = geom->vertex(index+0), b = geom->vertex(index+1);
+            const float t = closestPointSegment(p,a,b);
+            float dist; const Vec3fa q = closestPointSphere(p,a+t*(b-a),a.w+t*(b.w-a.w),dist);
+            context->report(q,dist,geomID,primID);
+          }
+        }
+      };
+
+    /*! point query for points, treated as spheres */
+    template<typename Prim>
+      struct SpherePointQuery
+      {
+        typedef Prim Primitive;
+
+        static __forceinline void pointQuery(PointQueryContext* context, const Primitive& prim)
+        {
+          const Vec3fa p = context->p();
+          for (size_t i=0; i<Primitive::max_size(); i++)
+          {
+            if (!prim.valid(i)) break;
+            const unsigned geomID = prim.geomID(i), primID = prim.primID(i);
+            const Points* geom = context->scene->getPoints(geomID);
+            const Vec3fa c = geom->vertex(geom->point(primID));
+            float dist; const Vec3fa q = closestPointSphere(p,c,c.w,dist);
+            context->report(q,dist,geomID,primID);
+          }
+        }
+      };
+
+    /*! processes all primitive blocks of a leaf */
+    template<typename PrimitivePointQuery>
+      struct ArrayPointQuery
+      {
+        typedef typename PrimitivePointQuery::Primitive Primitive;
+
+        static __forceinline void pointQuery(PointQueryContext* context, const Primitive* prim, size_t num)
+        {
+          for (size_t i=0; i<num; i++)
+            PrimitivePointQuery::pointQuery(context,prim[i]);
+        }
+      };
+  }
+}
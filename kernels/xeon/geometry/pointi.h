@@ -41,6 +41,9 @@ namespace embree
     /* Returns required number of primitive blocks for N points */
     static __forceinline size_t blocks(size_t N) { return (N+max_size()-1)/max_size(); }
 
+    /* Returns true if a primitive block can only store the motion of a single time segment */
+    static __forceinline bool singleTimeSegment() { return false; }
+
   public:
 
     /* Default constructor */
@@ -159,10 +162,11 @@ namespace embree
     }
 
     /* Fill point from point list */
-    __forceinline std::pair<BBox3fa,BBox3fa> fill_mblur(const PrimRef* prims, size_t& begin, size_t end, Scene* scene, const bool list)
+    __forceinline std::pair<BBox3fa,BBox3fa> fill_mblur(const PrimRef* prims, size_t& begin, size_t end, Scene* scene, const bool list, const BBox1f& time_range)
     {
       fill(prims,begin,end,scene,list);
-      return bounds(scene);
+      const std::pair<BBox3fa,BBox3fa> b = bounds(scene);
+      return std::make_pair(lerp(b.first,b.second,time_range.lower),lerp(b.first,b.second,time_range.upper));
     }
 
     /* Updates the primitive */
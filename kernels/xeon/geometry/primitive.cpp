@@ -28,6 +28,7 @@
 #include "quadi_mb.h"
 #include "subdivpatch1cached.h"
 #include "object.h"
+#include "paged_object.h"
 
 namespace embree
 {
@@ -229,6 +230,19 @@ namespace embree
 
   Object::Type Object::type;
 #endif
+
+  /********************** Paged Object **************************/
+
+#if !defined(__AVX__)
+  PagedObject::Type::Type () 
+    : PrimitiveType("pagedobject",sizeof(PagedObject),1) {} 
+
+  size_t PagedObject::Type::size(const char* This) const {
+    return 1;
+  }
+
+  PagedObject::Type PagedObject::type;
+#endif
 }
 
 
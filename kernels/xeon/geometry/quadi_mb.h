@@ -42,6 +42,9 @@ namespace embree
     
     /* Returns required number of primitive blocks for N primitives */
     static __forceinline size_t blocks(size_t N) { return (N+max_size()-1)/max_size(); }
+
+    /* Returns true if a primitive block can only store the motion of a single time segment */
+    static __forceinline bool singleTimeSegment() { return false; }
   
   public:
 
@@ -86,11 +89,30 @@ namespace embree
      __forceinline Vec3<T> getVertex(const vint<M> &v, const size_t index, const Scene *const scene, const T& time) const
     {
       const QuadMesh* mesh = scene->getQuadMesh(geomID(index));
-      const Vec3fa v0  = *(Vec3fa*)mesh->vertexPtr(v[index],0);
-      const Vec3fa v1  = *(Vec3fa*)mesh->vertexPtr(v[index],1);
-      const Vec3<T> p0(v0.x,v0.y,v0.z);
-      const Vec3<T> p1(v1.x,v1.y,v1.z);
-      return (T(one)-time)*p0 + time*p1;
+      if (likely(mesh->numTimeSteps == 2))
+      {
+        const Vec3fa v0  = *(Vec3fa*)mesh->vertexPtr(v[index],0);
+        const Vec3fa v1  = *(Vec3fa*)mesh->vertexPtr(v[index],1);
+        const Vec3<T> p0(v0.x,v0.y,v0.z);
+        const Vec3<T> p1(v1.x,v1.y,v1.z);
+        return (T(one)-time)*p0 + time*p1;
+      }
+
+      /* select the time segment of each ray */
+      const T numTimeSegments = T(float(mesh->numTimeSteps-1));
+      const T timeScaled = time*numTimeSegments;
+      const T itimef = min(max(floor(timeScaled),T(zero)),numTimeSegments-T(one));
+      const T ftime = timeScaled-itimef;
+      Vec3<T> p0, p1;
+      for (size_t k=0; k<T::size; k++) 
+      {
+        const size_t itime = size_t(itimef[k]);
+        const Vec3fa v0 = *(Vec3fa*)mesh->vertexPtr(v[index],itime+0);
+        const Vec3fa v1 = *(Vec3fa*)mesh->vertexPtr(v[index],itime+1);
+        p0.x[k] = v0.x; p0.y[k] = v0.y; p0.z[k] = v0.z;
+        p1.x[k] = v1.x; p1.y[k] = v1.y; p1.z[k] = v1.z;
+      }
+      return (T(one)-ftime)*p0 + ftime*p1;
     }
 
     /* gather the quads */
@@ -146,8 +168,22 @@ namespace embree
     }
 
     
+    /* Calculate the linear bounds of the quads over the specified time range */
+    __forceinline std::pair<BBox3fa,BBox3fa> linearBounds(const Scene *const scene, const BBox1f& time_range) const
+    {
+      BBox3fa bounds0 = empty, bounds1 = empty;
+      for (size_t i=0; i<M && valid(i); i++)
+      {
+        const QuadMesh* mesh = scene->getQuadMesh(geomID(i));
+        const std::pair<BBox3fa,BBox3fa> b = mesh->linearBounds(primID(i),time_range);
+        bounds0.extend(b.first);
+        bounds1.extend(b.second);
+      }
+      return std::make_pair(bounds0,bounds1);
+    }
+    
     /* Fill quad from quad list */
-    __forceinline std::pair<BBox3fa,BBox3fa> fill_mblur(const PrimRef* prims, size_t& begin, size_t end, Scene* scene, const bool list)
+    __forceinline std::pair<BBox3fa,BBox3fa> fill_mblur(const PrimRef* prims, size_t& begin, size_t end, Scene* scene, const bool list, const BBox1f& time_range)
     {
       vint<M> geomID = -1, primID = -1;
       vint<M> v0 = zero, v1 = zero, v2 = zero, v3 = zero;
@@ -178,7 +214,7 @@ namespace embree
       }
       
       new (this) QuadMiMB(v0,v1,v2,v3,geomID,primID); // FIXME: use non temporal store
-      return bounds(scene);
+      return linearBounds(scene,time_range);
     }
     
     /* Updates the primitive */
@@ -261,16 +297,31 @@ namespace embree
                                            const Scene *const scene,
                                            const float t) const
   {
-    const vfloat4 t0 = 1.0f - t;
-    const vfloat4 t1 = t;
-    Vec3vf4 a0,a1,a2,a3;
-    gather(a0,a1,a2,a3,scene,(size_t)0);
-    Vec3vf4 b0,b1,b2,b3;
-    gather(b0,b1,b2,b3,scene,(size_t)1);
-    p0 = t0 * a0 + t1 * b0;
-    p1 = t0 * a1 + t1 * b1;
-    p2 = t0 * a2 + t1 * b2;
-    p3 = t0 * a3 + t1 * b3;
+    const QuadMesh* mesh0 = scene->getQuadMesh(geomIDs[0]);
+    const QuadMesh* mesh1 = scene->getQuadMesh(geomIDs[1]);
+    const QuadMesh* mesh2 = scene->getQuadMesh(geomIDs[2]);
+    const QuadMesh* mesh3 = scene->getQuadMesh(geomIDs[3]);
+
+    /* each quad may come from a mesh with a different number of time steps */
+    float ftime0; const size_t itime0 = mesh0->timeSegment(t,ftime0);
+    float ftime1; const size_t itime1 = mesh1->timeSegment(t,ftime1);
+    float ftime2; const size_t itime2 = mesh2->timeSegment(t,ftime2);
+    float ftime3; const size_t itime3 = mesh3->timeSegment(t,ftime3);
+
+    auto lerpVertex = [] (const QuadMesh* mesh, const int v, const size_t itime, const float ftime) -> vfloat4 {
+      const vfloat4 a = vfloat4::loadu(mesh->vertexPtr(v,itime+0));
+      const vfloat4 b = vfloat4::loadu(mesh->vertexPtr(v,itime+1));
+      return madd(vfloat4(ftime),b-a,a);
+    };
+
+    transpose(lerpVertex(mesh0,v0[0],itime0,ftime0),lerpVertex(mesh1,v0[1],itime1,ftime1),
+              lerpVertex(mesh2,v0[2],itime2,ftime2),lerpVertex(mesh3,v0[3],itime3,ftime3),p0.x,p0.y,p0.z);
+    transpose(lerpVertex(mesh0,v1[0],itime0,ftime0),lerpVertex(mesh1,v1[1],itime1,ftime1),
+              lerpVertex(mesh2,v1[2],itime2,ftime2),lerpVertex(mesh3,v1[3],itime3,ftime3),p1.x,p1.y,p1.z);
+    transpose(lerpVertex(mesh0,v2[0],itime0,ftime0),lerpVertex(mesh1,v2[1],itime1,ftime1),
+              lerpVertex(mesh2,v2[2],itime2,ftime2),lerpVertex(mesh3,v2[3],itime3,ftime3),p2.x,p2.y,p2.z);
+    transpose(lerpVertex(mesh0,v3[0],itime0,ftime0),lerpVertex(mesh1,v3[1],itime1,ftime1),
+              lerpVertex(mesh2,v3[2],itime2,ftime2),lerpVertex(mesh3,v3[3],itime3,ftime3),p3.x,p3.y,p3.z);
   }
 
   template<int M>
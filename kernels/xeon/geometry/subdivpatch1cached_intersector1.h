@@ -36,8 +36,8 @@ namespace embree
       {
         Primitive* prim = (Primitive*) prim_i;
         if (pre.grid) SharedLazyTessellationCache::sharedLazyTessellationCache.unlock();
-        GridSOA* grid = (GridSOA*) SharedLazyTessellationCache::lookup(prim->entry(),scene->commitCounterSubdiv,[&] () {
-            auto alloc = [] (const size_t bytes) { return SharedLazyTessellationCache::sharedLazyTessellationCache.malloc(bytes); };
+        GridSOA* grid = (GridSOA*) SharedLazyTessellationCache::lookup(prim->entry(),*scene->tessellationPartition,scene->commitCounterSubdiv,[&] () {
+            auto alloc = [&] (const size_t bytes) { return SharedLazyTessellationCache::malloc(*scene->tessellationPartition,bytes); };
             return GridSOA::create(prim,scene,alloc);
           });
         //GridSOA* grid = (GridSOA*) prim->root_ref.data;
@@ -78,8 +78,8 @@ namespace embree
       {
         Primitive* prim = (Primitive*) prim_i;
         if (pre.grid) SharedLazyTessellationCache::sharedLazyTessellationCache.unlock();
-        GridSOA* grid = (GridSOA*) SharedLazyTessellationCache::lookup(prim->entry(),scene->commitCounterSubdiv,[&] () {
-            auto alloc = [] (const size_t bytes) { return SharedLazyTessellationCache::sharedLazyTessellationCache.malloc(bytes); };
+        GridSOA* grid = (GridSOA*) SharedLazyTessellationCache::lookup(prim->entry(),*scene->tessellationPartition,scene->commitCounterSubdiv,[&] () {
+            auto alloc = [&] (const size_t bytes) { return SharedLazyTessellationCache::malloc(*scene->tessellationPartition,bytes); };
             return GridSOA::create(prim,scene,alloc);
           });
         lazy_node = grid->root;
@@ -42,6 +42,9 @@ namespace embree
     
     /* Returns required number of primitive blocks for N primitives */
     static __forceinline size_t blocks(size_t N) { return (N+max_size()-1)/max_size(); }
+
+    /* Returns true if a primitive block can only store the motion of a single time segment */
+    static __forceinline bool singleTimeSegment() { return true; }
    
   public:
 
@@ -107,6 +110,25 @@ namespace embree
 		     Vec3fa(reduce_max(upper.x),reduce_max(upper.y),reduce_max(upper.z)));
     }
 
+    /* Calculate the bounds of the triangles at the specified time */
+    __forceinline BBox3fa bounds(const float t) const 
+    {
+      const Vec3vfM p0 = v0+vfloat<M>(t)*dv0;
+      const Vec3vfM p1 = v1+vfloat<M>(t)*dv1;
+      const Vec3vfM p2 = v2+vfloat<M>(t)*dv2;
+      Vec3vfM lower = min(p0,p1,p2);
+      Vec3vfM upper = max(p0,p1,p2);
+      const vbool<M> mask = valid();
+      lower.x = select(mask,lower.x,vfloat<M>(pos_inf));
+      lower.y = select(mask,lower.y,vfloat<M>(pos_inf));
+      lower.z = select(mask,lower.z,vfloat<M>(pos_inf));
+      upper.x = select(mask,upper.x,vfloat<M>(neg_inf));
+      upper.y = select(mask,upper.y,vfloat<M>(neg_inf));
+      upper.z = select(mask,upper.z,vfloat<M>(neg_inf));
+      return BBox3fa(Vec3fa(reduce_min(lower.x),reduce_min(lower.y),reduce_min(lower.z)),
+		     Vec3fa(reduce_max(upper.x),reduce_max(upper.y),reduce_max(upper.z)));
+    }
+
     /* Calculate primitive bounds */
     __forceinline std::pair<BBox3fa,BBox3fa> bounds() {
       return std::make_pair(bounds0(),bounds1());
@@ -144,16 +166,14 @@ namespace embree
       new (this) TriangleMvMB(va0,va1,vb0,vb1,vc0,vc1,vgeomID,vprimID); // FIXME: store_nt
     }
     
-    /* Fill triangle from triangle list */
-    __forceinline std::pair<BBox3fa,BBox3fa> fill_mblur(const PrimRef* prims, size_t& begin, size_t end, Scene* scene, const bool list)
+    /* Fill triangle from triangle list, the time range has to lie
+     * inside a single time segment of each referenced mesh */
+    __forceinline std::pair<BBox3fa,BBox3fa> fill_mblur(const PrimRef* prims, size_t& begin, size_t end, Scene* scene, const bool list, const BBox1f& time_range)
     {
       vint<M> vgeomID = -1, vprimID = -1;
       Vec3vfM va0 = zero, vb0 = zero, vc0 = zero;
       Vec3vfM va1 = zero, vb1 = zero, vc1 = zero;
 
-      BBox3fa bounds0 = empty;
-      BBox3fa bounds1 = empty;
-      
       for (size_t i=0; i<M && begin<end; i++, begin++)
       {
 	const PrimRef& prim = prims[begin];
@@ -161,12 +181,20 @@ namespace embree
         const size_t primID = prim.primID();
         const TriangleMesh* __restrict__ const mesh = scene->getTriangleMesh(geomID);
         const TriangleMesh::Triangle& tri = mesh->triangle(primID);
-	const Vec3fa& a0 = mesh->vertex(tri.v[0],0); bounds0.extend(a0);
-	const Vec3fa& a1 = mesh->vertex(tri.v[0],1); bounds1.extend(a1);
-        const Vec3fa& b0 = mesh->vertex(tri.v[1],0); bounds0.extend(b0);
-	const Vec3fa& b1 = mesh->vertex(tri.v[1],1); bounds1.extend(b1);
-        const Vec3fa& c0 = mesh->vertex(tri.v[2],0); bounds0.extend(c0);
-	const Vec3fa& c1 = mesh->vertex(tri.v[2],1); bounds1.extend(c1);
+
+        /* the vertices of the time segment get extrapolated to time 0 and 1, 
+         * which gives the linear motion the intersector expects */
+        float ftime; const size_t itime = mesh->timeSegment(time_range.center(),ftime);
+        const float s0 = float(itime), s1 = float(mesh->numTimeSteps-2-itime);
+        auto extrapolate = [&] (const size_t v, Vec3fa& p0, Vec3fa& p1) {
+          const Vec3fa k0 = mesh->vertex(v,itime+0);
+          const Vec3fa k1 = mesh->vertex(v,itime+1);
+          p0 = k0 - s0*(k1-k0);
+          p1 = k1 + s1*(k1-k0);
+        };
+        Vec3fa a0,a1; extrapolate(tri.v[0],a0,a1);
+        Vec3fa b0,b1; extrapolate(tri.v[1],b0,b1);
+        Vec3fa c0,c1; extrapolate(tri.v[2],c0,c1);
         vgeomID [i] = geomID;
         vprimID [i] = primID;
         va0.x[i] = a0.x; va0.y[i] = a0.y; va0.z[i] = a0.z;
@@ -177,16 +205,16 @@ namespace embree
 	vc1.x[i] = c1.x; vc1.y[i] = c1.y; vc1.z[i] = c1.z;
       }
       new (this) TriangleMvMB(va0,va1,vb0,vb1,vc0,vc1,vgeomID,vprimID);
-      return std::make_pair(bounds0,bounds1);
+      return std::make_pair(bounds(time_range.lower),bounds(time_range.upper));
     }
    
   public:
     Vec3vfM v0;      // 1st vertex of the triangles
     Vec3vfM v1;      // 2nd vertex of the triangles
     Vec3vfM v2;      // 3rd vertex of the triangles
-    Vec3vfM dv0;     // difference vector between time steps t0 and t1 for first vertex
-    Vec3vfM dv1;     // difference vector between time steps t0 and t1 for second vertex
-    Vec3vfM dv2;     // difference vector between time steps t0 and t1 for third vertex
+    Vec3vfM dv0;     // difference vector between time 0 and 1 for first vertex
+    Vec3vfM dv1;     // difference vector between time 0 and 1 for second vertex
+    Vec3vfM dv2;     // difference vector between time 0 and 1 for third vertex
     vint<M> geomIDs; // geometry ID
     vint<M> primIDs; // primitive ID
   };
@@ -259,6 +259,7 @@ namespace embree
 
     size_t initLocalLazySubdivTreeCompact(const SubdivPatch1 &patch,
                                           ThreadWorkState *const t_state,
+                                          SharedLazyTessellationCache::Partition& partition,
                                           const SubdivMesh* const geom)
     {
       __aligned(64) float local_grid_u[(patch.grid_size_simd_blocks+1)*16]; // for unaligned access
@@ -283,7 +284,7 @@ namespace embree
       SharedLazyTessellationCache::sharedLazyTessellationCache.lockThreadLoop(t_state);
 
       /* allocate memory */
-      size_t block_index = SharedLazyTessellationCache::sharedLazyTessellationCache.allocIndexLoop(t_state,patch.grid_subtree_size_64b_blocks);
+      size_t block_index = SharedLazyTessellationCache::sharedLazyTessellationCache.allocIndexLoop(t_state,partition,patch.grid_subtree_size_64b_blocks);
 
       vfloat16* lazymem   = (vfloat16*)SharedLazyTessellationCache::sharedLazyTessellationCache.getBlockPtr(block_index);
       
@@ -352,28 +353,28 @@ namespace embree
         
         SubdivPatch1* subdiv_patch = &patches[patchIndex];
         
-        const size_t index = SharedLazyTessellationCache::lookupIndex(&subdiv_patch->root_ref,globalTime);
+        const size_t index = SharedLazyTessellationCache::lookupIndex(*scene->tessellationPartition,&subdiv_patch->root_ref,globalTime);
         if (index != -1) return index;
 
         SharedLazyTessellationCache::sharedLazyTessellationCache.unlockThread(t_state);		  
         
         subdiv_patch->write_lock();
-        if (!SharedLazyTessellationCache::validTag(subdiv_patch->root_ref,globalTime)) 
+        if (!SharedLazyTessellationCache::validTag(*scene->tessellationPartition,subdiv_patch->root_ref,globalTime)) 
         {
           const SubdivMesh* const geom = (SubdivMesh*)scene->get(subdiv_patch->geom); 
 
           /* generate vertex grid, lock and allocate memory in the cache */
-          size_t new_root_ref = initLocalLazySubdivTreeCompact(*subdiv_patch,t_state,geom);
+          size_t new_root_ref = initLocalLazySubdivTreeCompact(*subdiv_patch,t_state,*scene->tessellationPartition,geom);
 
           /* get current commit index */
-          const size_t combinedTime = SharedLazyTessellationCache::sharedLazyTessellationCache.getTime(globalTime);
+          const size_t combinedTime = SharedLazyTessellationCache::sharedLazyTessellationCache.getTime(*scene->tessellationPartition,globalTime);
           __memory_barrier();
           
           CACHE_STATS(SharedTessellationCacheStats::incPatchBuild(patchIndex,bvh->numPrimitives));
           
           subdiv_patch->root_ref = SharedLazyTessellationCache::Tag((void*)new_root_ref,combinedTime);
           subdiv_patch->write_unlock();
-          return SharedLazyTessellationCache::lookupIndex(&subdiv_patch->root_ref,globalTime);
+          return SharedLazyTessellationCache::lookupIndex(*scene->tessellationPartition,&subdiv_patch->root_ref,globalTime);
         }
         subdiv_patch->write_unlock();
       }     
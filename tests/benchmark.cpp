@@ -18,7 +18,9 @@
 #include "../include/embree2/rtcore_ray.h"
 #include "../kernels/common/default.h"
 #include "../kernels/algorithms/parallel_for.h"
+#include "../common/sys/filename.h"
 #include <vector>
+#include <fstream>
 
 #if defined(RTCORE_RAY_PACKETS) && !defined(__MIC__)
 #  define HAS_INTERSECT4 1
@@ -1525,6 +1527,473 @@ namespace embree
 
 
   
+  ////////////////////////////////////////////////////////////////////////////////
+  /// Ray Tracing Suite
+  ////////////////////////////////////////////////////////////////////////////////
+
+#if !defined(__MIC__)
+
+  /* configuration of the ray tracing suite */
+  static std::vector<std::string> g_suite_obj_files;
+  static std::string g_suite_json = "";
+  static std::string g_suite_filter = "";
+  static size_t g_suite_width = 1024;
+  static size_t g_suite_height = 1024;
+  static size_t g_suite_runs = 3;
+
+  /*! scene of the ray tracing suite */
+  struct SuiteScene
+  {
+    SuiteScene (const std::string& name) 
+      : name(name) {}
+
+    /*! number of primitives the accels of some geometry type get built over */
+    size_t numPrimitives(const std::string& type) const 
+    {
+      if (type == "tri" || type == "quad") return mesh.triangles.size();
+      if (type == "line" ) return hair.lines.size();
+      if (type == "point") return hair.vertices.size();
+      return 0;
+    }
+
+  public:
+    std::string name;
+    Mesh mesh;            //!< triangles of the scene
+    LineSegments hair;    //!< line segments of the scene
+  };
+
+  /*! accel and builder combination of the ray tracing suite */
+  struct SuiteAccel
+  {
+    const char* type;     //!< geometry type the accel is configured for (tri, quad, line or point)
+    bool mb;              //!< accel for motion blurred geometry
+    const char* accel;    //!< acceleration structure
+    const char* builder;  //!< builder
+    int isa;              //!< minimal ISA required
+  };
+
+  /* all accel and builder combinations registered in the BVH4, BVH8 and BVH16 factories */
+  static const SuiteAccel g_suite_accels[] = {
+    { "tri"  , false, "bvh4.triangle4"   , "sah"              , SSE2 },
+    { "tri"  , false, "bvh4.triangle4"   , "sah_spatial"      , SSE2 },
+    { "tri"  , false, "bvh4.triangle4"   , "sah_presplit"     , SSE2 },
+    { "tri"  , false, "bvh4.triangle4"   , "dynamic"          , SSE2 },
+    { "tri"  , false, "bvh4.triangle4"   , "morton"           , SSE2 },
+    { "tri"  , false, "bvh4.triangle4"   , "morton.optimized" , SSE2 },
+    { "tri"  , false, "bvh4.triangle4v"  , "sah"              , SSE2 },
+    { "tri"  , false, "bvh4.triangle4v"  , "sah_spatial"      , SSE2 },
+    { "tri"  , false, "bvh4.triangle4v"  , "sah_presplit"     , SSE2 },
+    { "tri"  , false, "bvh4.triangle4v"  , "dynamic"          , SSE2 },
+    { "tri"  , false, "bvh4.triangle4v"  , "morton"           , SSE2 },
+    { "tri"  , false, "bvh4.triangle4v"  , "morton.optimized" , SSE2 },
+    { "tri"  , false, "bvh4.triangle4i"  , "sah"              , SSE2 },
+    { "tri"  , false, "bvh4.triangle4i"  , "sah_spatial"      , SSE2 },
+    { "tri"  , false, "bvh4.triangle4i"  , "sah_presplit"     , SSE2 },
+    { "tri"  , false, "bvh4.triangle4i"  , "dynamic"          , SSE2 },
+    { "tri"  , false, "bvh4.triangle4i"  , "morton"           , SSE2 },
+    { "tri"  , false, "bvh4.triangle4i"  , "morton.optimized" , SSE2 },
+    { "tri"  , false, "bvh4q.triangle4"  , "sah"              , SSE2 },
+    { "tri"  , false, "bvh4q.triangle4"  , "sah_presplit"     , SSE2 },
+    { "tri"  , false, "bvh4.triangle8"   , "sah"              , AVX  },
+    { "tri"  , false, "bvh4.triangle8"   , "sah_spatial"      , AVX  },
+    { "tri"  , false, "bvh4.triangle8"   , "sah_presplit"     , AVX  },
+    { "tri"  , false, "bvh4.triangle8"   , "dynamic"          , AVX  },
+    { "tri"  , false, "bvh4.triangle8"   , "morton"           , AVX  },
+    { "tri"  , false, "bvh4.triangle8"   , "morton.optimized" , AVX  },
+    { "tri"  , false, "bvh8.triangle4"   , "sah"              , AVX  },
+    { "tri"  , false, "bvh8.triangle4"   , "sah_spatial"      , AVX  },
+    { "tri"  , false, "bvh8.triangle4"   , "sah_presplit"     , AVX  },
+    { "tri"  , false, "bvh8.triangle8"   , "sah"              , AVX  },
+    { "tri"  , false, "bvh8.triangle8"   , "sah_spatial"      , AVX  },
+    { "tri"  , false, "bvh8.triangle8"   , "sah_presplit"     , AVX  },
+    { "tri"  , false, "bvh8q.triangle4"  , "sah"              , AVX  },
+    { "tri"  , false, "bvh8q.triangle4"  , "sah_presplit"     , AVX  },
+#if defined(__TARGET_AVX512KNL__)
+    { "tri"  , false, "bvh16.triangle4"  , "sah"              , AVX512KNL },
+#endif
+#if defined(__TARGET_AVX512SKX__)
+    { "tri"  , false, "bvh16.triangle4"  , "sah"              , AVX512SKX },
+#endif
+    { "tri"  , true , "bvh4.triangle4vmb", "sah"              , SSE2 },
+    { "tri"  , true , "bvh8.triangle4vmb", "sah"              , AVX  },
+    { "quad" , false, "bvh4.quad4v"      , "default"          , SSE2 },
+    { "quad" , false, "bvh4.quad4i"      , "default"          , SSE2 },
+    { "quad" , false, "bvh8.quad4v"      , "default"          , AVX  },
+    { "quad" , false, "bvh8.quad4i"      , "default"          , AVX  },
+    { "quad" , true , "default"          , "default"          , SSE2 },
+    { "line" , false, "bvh4.line4i"      , "sah"              , SSE2 },
+    { "line" , false, "bvh4.line4i"      , "dynamic"          , SSE2 },
+    { "line" , false, "bvh8.line4i"      , "default"          , AVX  },
+    { "line" , true , "bvh4.line4imb"    , "default"          , SSE2 },
+    { "line" , true , "bvh8.line4imb"    , "default"          , AVX  },
+    { "point", false, "bvh4.point4i"     , "sah"              , SSE2 },
+    { "point", false, "bvh4.point4i"     , "dynamic"          , SSE2 },
+    { "point", false, "bvh8.point4i"     , "default"          , AVX  },
+    { "point", true , "bvh4.point4imb"   , "default"          , SSE2 },
+    { "point", true , "bvh8.point4imb"   , "default"          , AVX  },
+  };
+
+  /*! result of one accel and builder combination for one scene */
+  struct SuiteResult
+  {
+    std::string scene;
+    std::string type;     //!< geometry type the accel got built over
+    std::string accel;
+    std::string builder;
+    size_t numPrimitives;
+    double buildTime;     //!< build time in seconds
+    double primary;       //!< Mrays/s of primary rays
+    double diffuse;       //!< Mrays/s of diffuse bounce rays
+    double shadow;        //!< Mrays/s of shadow rays
+  };
+
+  /*! loads the triangles of an OBJ file, polygons get triangulated as fans */
+  bool loadOBJ(const std::string& fileName, Mesh& mesh_o)
+  {
+    FILE* file = fopen(fileName.c_str(),"r");
+    if (!file) return false;
+
+    char line[4096];
+    while (fgets(line,sizeof(line),file))
+    {
+      if (line[0] == 'v' && line[1] == ' ') {
+        Vertex v; v.a = 0.0f;
+        if (sscanf(line+2,"%f %f %f",&v.x,&v.y,&v.z) == 3) mesh_o.vertices.push_back(v);
+      }
+      else if (line[0] == 'f' && line[1] == ' ') 
+      {
+        std::vector<int> face;
+        const char* tok = line+2;
+        while (true) 
+        {
+          while (*tok == ' ' || *tok == '\t') tok++;
+          int id = 0; if (sscanf(tok,"%d",&id) != 1) break;
+          face.push_back(id < 0 ? int(mesh_o.vertices.size())+id : id-1);
+          while (*tok && *tok != ' ' && *tok != '\t') tok++;
+        }
+        for (size_t i=2; i<face.size(); i++) {
+          Triangle tri = { face[0], face[i-1], face[i] };
+          mesh_o.triangles.push_back(tri);
+        }
+      }
+    }
+    fclose(file);
+    return mesh_o.triangles.size() > 0;
+  }
+
+  /*! creates the procedural scenes and loads the OBJ scenes of the suite */
+  void createSuiteScenes(std::vector<SuiteScene*>& scenes)
+  {
+    /* single finely tessellated sphere */
+    SuiteScene* sphere = new SuiteScene("sphere_1M");
+    createSphereMesh(Vec3f(0.0f),1.0f,501,sphere->mesh);
+    scenes.push_back(sphere);
+
+    /* grid of 1000 spheres */
+    SuiteScene* spheres = new SuiteScene("spheres_1k");
+    for (size_t i=0; i<1000; i++) {
+      Mesh mesh; createSphereMesh(Vec3f(3.0f*float(i%10),3.0f*float((i/10)%10),3.0f*float(i/100)),1.0f,16,mesh);
+      const int base = int(spheres->mesh.vertices.size());
+      spheres->mesh.vertices.insert(spheres->mesh.vertices.end(),mesh.vertices.begin(),mesh.vertices.end());
+      for (size_t j=0; j<mesh.triangles.size(); j++) {
+        Triangle tri = { mesh.triangles[j].v0+base, mesh.triangles[j].v1+base, mesh.triangles[j].v2+base };
+        spheres->mesh.triangles.push_back(tri);
+      }
+    }
+    scenes.push_back(spheres);
+
+    /* hairball of line segments */
+    SuiteScene* hairball = new SuiteScene("hairball_1M");
+    createHairball(zero,1.0f,1000*1000,hairball->hair);
+    scenes.push_back(hairball);
+
+    /* scenes loaded from OBJ files */
+    for (size_t i=0; i<g_suite_obj_files.size(); i++) 
+    {
+      SuiteScene* obj = new SuiteScene(FileName(g_suite_obj_files[i]).name());
+      if (!loadOBJ(g_suite_obj_files[i],obj->mesh)) {
+        std::cerr << "cannot load OBJ file " << g_suite_obj_files[i] << std::endl;
+        delete obj; continue;
+      }
+      scenes.push_back(obj);
+    }
+  }
+
+  /*! copies the vertices into all time steps of a geometry, so that motion blurred accels trace the same geometry */
+  void setSuiteVertices(RTCScene scene, unsigned geom, const void* vertices, size_t bytes, size_t numTimeSteps)
+  {
+    for (size_t t=0; t<numTimeSteps; t++) {
+      const RTCBufferType buffer = (RTCBufferType) (RTC_VERTEX_BUFFER0+t);
+      memcpy(rtcMapBuffer(scene,geom,buffer),vertices,bytes);
+      rtcUnmapBuffer(scene,geom,buffer);
+    }
+  }
+
+  /*! adds the geometry of a suite scene as the geometry type of an accel to an Embree scene */
+  void addSuiteScene(RTCScene scene, const SuiteScene* in, const SuiteAccel& accel)
+  {
+    const std::string type = accel.type;
+    const size_t numTimeSteps = accel.mb ? 2 : 1;
+    if (type == "tri") 
+    {
+      unsigned geom = rtcNewTriangleMesh (scene, RTC_GEOMETRY_STATIC, in->mesh.triangles.size(), in->mesh.vertices.size(), numTimeSteps);
+      setSuiteVertices(scene,geom,&in->mesh.vertices[0],in->mesh.vertices.size()*sizeof(Vertex),numTimeSteps);
+      memcpy(rtcMapBuffer(scene,geom,RTC_INDEX_BUFFER), &in->mesh.triangles[0], in->mesh.triangles.size()*sizeof(Triangle));
+      rtcUnmapBuffer(scene,geom,RTC_INDEX_BUFFER);
+    }
+    else if (type == "quad") 
+    {
+      /* triangles get stored as degenerated quads */
+      unsigned geom = rtcNewQuadMesh (scene, RTC_GEOMETRY_STATIC, in->mesh.triangles.size(), in->mesh.vertices.size(), numTimeSteps);
+      setSuiteVertices(scene,geom,&in->mesh.vertices[0],in->mesh.vertices.size()*sizeof(Vertex),numTimeSteps);
+      int* quads = (int*) rtcMapBuffer(scene,geom,RTC_INDEX_BUFFER);
+      for (size_t i=0; i<in->mesh.triangles.size(); i++) {
+        const Triangle& tri = in->mesh.triangles[i];
+        quads[4*i+0] = tri.v0; quads[4*i+1] = tri.v1; quads[4*i+2] = tri.v2; quads[4*i+3] = tri.v2;
+      }
+      rtcUnmapBuffer(scene,geom,RTC_INDEX_BUFFER);
+    }
+    else if (type == "line") 
+    {
+      unsigned geom = rtcNewLineSegments (scene, RTC_GEOMETRY_STATIC, in->hair.lines.size(), in->hair.vertices.size(), numTimeSteps);
+      setSuiteVertices(scene,geom,&in->hair.vertices[0],in->hair.vertices.size()*sizeof(Vec3fa),numTimeSteps);
+      memcpy(rtcMapBuffer(scene,geom,RTC_INDEX_BUFFER), &in->hair.lines[0], in->hair.lines.size()*sizeof(int));
+      rtcUnmapBuffer(scene,geom,RTC_INDEX_BUFFER);
+    }
+    else if (type == "point") 
+    {
+      /* the vertices of the line segments get used as points */
+      unsigned geom = rtcNewPoints (scene, RTC_GEOMETRY_STATIC, in->hair.vertices.size(), numTimeSteps);
+      setSuiteVertices(scene,geom,&in->hair.vertices[0],in->hair.vertices.size()*sizeof(Vec3fa),numTimeSteps);
+    }
+  }
+
+  /*! traces all rays in parallel and returns the time required */
+  double traceSuiteRays(RTCScene scene, avector<RTCRay>& rays, bool occluded)
+  {
+    double t0 = getSeconds();
+    parallel_for(size_t(0),rays.size(),size_t(1024),[&](const range<size_t>& r) {
+        for (size_t i=r.begin(); i<r.end(); i++) {
+          if (occluded) rtcOccluded (scene,rays[i]);
+          else          rtcIntersect(scene,rays[i]);
+        }
+      });
+    return getSeconds()-t0;
+  }
+
+  /*! measures build time and ray throughput of one accel and builder combination */
+  bool runSuite(const SuiteScene* in, const SuiteAccel& accel, SuiteResult& result)
+  {
+    const std::string type = accel.type, suffix = accel.mb ? "_mb" : "";
+    std::string cfg = g_rtcore + (g_rtcore != "" ? "," : "");
+    cfg += type + "_accel" + suffix + "=" + accel.accel + "," + type + "_builder" + suffix + "=" + accel.builder;
+    RTCDevice device = rtcNewDevice(cfg.c_str());
+    if (rtcDeviceGetError(device) != RTC_NO_ERROR) {
+      rtcDeleteDevice(device);
+      return false;
+    }
+
+    result.scene = in->name;
+    result.type = std::string(accel.type) + (accel.mb ? "_mb" : "");
+    result.accel = accel.accel;
+    result.builder = accel.builder;
+    result.numPrimitives = in->numPrimitives(accel.type);
+    result.buildTime = inf;
+    result.primary = result.diffuse = result.shadow = 0.0f;
+
+    /* measure build time */
+    RTCScene scene = nullptr;
+    for (size_t i=0; i<g_suite_runs; i++)
+    {
+      if (scene) rtcDeleteScene(scene);
+      scene = rtcDeviceNewScene(device,RTC_SCENE_STATIC,RTC_INTERSECT1);
+      addSuiteScene(scene,in,accel);
+      double t0 = getSeconds();
+      rtcCommit (scene);
+      double t1 = getSeconds();
+      if (rtcDeviceGetError(device) != RTC_NO_ERROR) {
+        rtcDeleteScene(scene);
+        rtcDeleteDevice(device);
+        return false;
+      }
+      result.buildTime = min(result.buildTime,t1-t0);
+    }
+
+    /* place camera in front of the scene and a point light above it */
+    Vec3f lower(pos_inf), upper(neg_inf);
+    for (size_t i=0; i<in->mesh.vertices.size(); i++) {
+      const Vertex& v = in->mesh.vertices[i];
+      lower = min(lower,Vec3f(v.x,v.y,v.z)); upper = max(upper,Vec3f(v.x,v.y,v.z));
+    }
+    for (size_t i=0; i<in->hair.vertices.size(); i++) {
+      lower = min(lower,Vec3f(in->hair.vertices[i])); upper = max(upper,Vec3f(in->hair.vertices[i]));
+    }
+    const Vec3f center = 0.5f*(lower+upper);
+    const float radius = 0.5f*length(upper-lower);
+    const Vec3f eye = center + Vec3f(0.3f,0.4f,-1.6f)*radius;
+    const Vec3f light = center + Vec3f(0.5f,2.0f,-0.5f)*radius;
+    const Vec3f vz = normalize(center-eye);
+    const Vec3f vx = normalize(cross(Vec3f(0,1,0),vz));
+    const Vec3f vy = cross(vz,vx);
+
+    const size_t width = g_suite_width, height = g_suite_height;
+    avector<RTCRay> primary(width*height);
+    avector<RTCRay> hits(width*height);
+    for (size_t y=0; y<height; y++) {
+      for (size_t x=0; x<width; x++) {
+        const float fx = 2.0f*(float(x)+0.5f)/float(width)-1.0f;
+        const float fy = 2.0f*(float(y)+0.5f)/float(height)-1.0f;
+        primary[y*width+x] = makeRay(eye,normalize(fx*vx + fy*vy + vz));
+      }
+    }
+
+    /* primary rays */
+    double primaryTime = inf;
+    for (size_t i=0; i<g_suite_runs; i++) {
+      for (size_t j=0; j<primary.size(); j++) hits[j] = primary[j];
+      primaryTime = min(primaryTime,traceSuiteRays(scene,hits,false));
+    }
+    result.primary = 1E-6*double(hits.size())/primaryTime;
+
+    /* diffuse bounce and shadow rays start at the hit points of the primary rays */
+    avector<RTCRay> diffuse, shadow;
+    unsigned int state = 1;
+    for (size_t j=0; j<hits.size(); j++) 
+    {
+      const RTCRay& hit = hits[j];
+      if (hit.geomID == RTC_INVALID_GEOMETRY_ID) continue;
+      const Vec3f dir(hit.dir[0],hit.dir[1],hit.dir[2]);
+      const Vec3f P = Vec3f(hit.org[0],hit.org[1],hit.org[2]) + hit.tfar*dir;
+      Vec3f Ng = normalize(Vec3f(hit.Ng[0],hit.Ng[1],hit.Ng[2]));
+      if (dot(Ng,dir) > 0.0f) Ng = -Ng;
+      const float eps = 1E-4f*radius;
+      
+      Vec3f d = Vec3f(uniformSampleSphere(rngFloat(state),rngFloat(state)));
+      if (dot(d,Ng) < 0.0f) d = -d;
+      diffuse.push_back(makeRay(P,d,eps,inf));
+      shadow.push_back(makeRay(P,light-P,eps,1.0f-eps));
+    }
+
+    double diffuseTime = inf, shadowTime = inf;
+    avector<RTCRay> rays;
+    for (size_t i=0; i<g_suite_runs && diffuse.size(); i++) {
+      rays = diffuse; diffuseTime = min(diffuseTime,traceSuiteRays(scene,rays,false));
+      rays = shadow;  shadowTime  = min(shadowTime ,traceSuiteRays(scene,rays,true));
+    }
+    if (diffuse.size()) {
+      result.diffuse = 1E-6*double(diffuse.size())/diffuseTime;
+      result.shadow  = 1E-6*double(shadow.size())/shadowTime;
+    }
+
+    rtcDeleteScene(scene);
+    rtcDeleteDevice(device);
+    return true;
+  }
+
+  /*! quotes and escapes a string for JSON output */
+  std::string jsonString(const std::string& str)
+  {
+    std::string out = "\"";
+    for (size_t i=0; i<str.size(); i++) 
+    {
+      const char c = str[i];
+      if      (c == '"' ) out += "\\\"";
+      else if (c == '\\') out += "\\\\";
+      else if (c == '\n') out += "\\n";
+      else if (c == '\r') out += "\\r";
+      else if (c == '\t') out += "\\t";
+      else if ((unsigned char)c < 0x20) {
+        char hex[8]; sprintf(hex,"\\u%04x",(unsigned char)c); out += hex;
+      }
+      else out += c;
+    }
+    return out + "\"";
+  }
+
+  /*! writes the results of the suite in JSON format */
+  void writeSuiteJSON(const std::string& fileName, const std::vector<SuiteResult>& results)
+  {
+    std::ofstream file(fileName.c_str());
+    if (!file) {
+      std::cerr << "cannot write " << fileName << std::endl;
+      return;
+    }
+
+    file << "{" << std::endl;
+    file << "  \"context\": {" << std::endl;
+    file << "    \"rtcore\": " << jsonString(g_rtcore) << "," << std::endl;
+    file << "    \"cpu\": " << jsonString(stringOfCPUModel(getCPUModel())) << "," << std::endl;
+    file << "    \"isa\": " << jsonString(stringOfCPUFeatures(getCPUFeatures())) << "," << std::endl;
+    file << "    \"threads\": " << getNumberOfLogicalThreads() << "," << std::endl;
+    file << "    \"width\": " << g_suite_width << "," << std::endl;
+    file << "    \"height\": " << g_suite_height << std::endl;
+    file << "  }," << std::endl;
+    file << "  \"benchmarks\": [" << std::endl;
+    for (size_t i=0; i<results.size(); i++) 
+    {
+      const SuiteResult& r = results[i];
+      file << "    {";
+      file << " \"scene\": " << jsonString(r.scene) << ",";
+      file << " \"type\": " << jsonString(r.type) << ",";
+      file << " \"accel\": " << jsonString(r.accel) << ",";
+      file << " \"builder\": " << jsonString(r.builder) << ",";
+      file << " \"primitives\": " << r.numPrimitives << ",";
+      file << " \"build_time_ms\": " << 1000.0*r.buildTime << ",";
+      file << " \"build_mprims_per_s\": " << 1E-6*double(r.numPrimitives)/r.buildTime << ",";
+      file << " \"primary_mrays_per_s\": " << r.primary << ",";
+      file << " \"diffuse_mrays_per_s\": " << r.diffuse << ",";
+      file << " \"shadow_mrays_per_s\": " << r.shadow;
+      file << " }" << (i+1 < results.size() ? "," : "") << std::endl;
+    }
+    file << "  ]" << std::endl;
+    file << "}" << std::endl;
+  }
+
+  /*! runs all accel and builder combinations on all scenes of the suite */
+  void run_suite()
+  {
+    std::vector<SuiteScene*> scenes;
+    createSuiteScenes(scenes);
+
+    std::vector<SuiteResult> results;
+    size_t numFailed = 0;
+    for (size_t i=0; i<scenes.size(); i++) 
+    {
+      for (size_t j=0; j<sizeof(g_suite_accels)/sizeof(SuiteAccel); j++)
+      {
+        const SuiteAccel& accel = g_suite_accels[j];
+        if (!hasISA(accel.isa)) continue;
+        if (scenes[i]->numPrimitives(accel.type) == 0) continue;
+        
+        const std::string name = scenes[i]->name + "." + accel.type + (accel.mb ? "_mb." : ".") + accel.accel + "." + accel.builder;
+        if (g_suite_filter != "" && name.find(g_suite_filter) == std::string::npos) continue;
+
+        SuiteResult result;
+        if (!runSuite(scenes[i],accel,result)) {
+          printf("%50s ... [FAILED]\n",name.c_str());
+          numFailed++;
+          continue;
+        }
+        printf("%50s ... build %8.2f ms, primary %7.2f, diffuse %7.2f, shadow %7.2f Mrays/s\n",
+               name.c_str(),1000.0*result.buildTime,result.primary,result.diffuse,result.shadow);
+        fflush(stdout);
+        results.push_back(result);
+      }
+    }
+
+    if (g_suite_json != "") 
+      writeSuiteJSON(g_suite_json,results);
+
+    for (size_t i=0; i<scenes.size(); i++) 
+      delete scenes[i];
+
+    /* every listed combination is registered, thus failing to create or build one is an error */
+    if (numFailed) 
+      THROW_RUNTIME_ERROR(std::to_string((long long)numFailed)+" accel and builder combinations failed");
+  }
+
+#endif
+
   std::vector<Benchmark*> benchmarks;
 
   void create_benchmarks()
@@ -1782,6 +2251,32 @@ namespace embree
 	g_num_threads_init = atoi(argv[++i]);
       }
 
+#if !defined(__MIC__)
+      /* ray tracing suite options */
+      else if (tag == "-suite_obj" && i+1<argc) {
+        g_suite_obj_files.push_back(argv[++i]);
+      }
+      else if (tag == "-suite_json" && i+1<argc) {
+        g_suite_json = argv[++i];
+      }
+      else if (tag == "-suite_filter" && i+1<argc) {
+        g_suite_filter = argv[++i];
+      }
+      else if (tag == "-suite_size" && i+2<argc) {
+        g_suite_width  = atoi(argv[++i]);
+        g_suite_height = atoi(argv[++i]);
+      }
+      else if (tag == "-suite_runs" && i+1<argc) {
+        g_suite_runs = max(1,atoi(argv[++i]));
+      }
+
+      /* runs the ray tracing suite */
+      else if (tag == "-suite") {
+        run_suite();
+        executed_benchmarks = true;
+      }
+#endif
+
       /* skip unknown command line parameter */
       else {
         std::cerr << "unknown command line parameter: " << tag << " ";
@@ -20,6 +20,11 @@
 #include <vector>
 #include <cstddef>
 
+#if !defined(__WIN32__)
+#include <dirent.h>
+#include <unistd.h>
+#endif
+
 #define DEFAULT_STACK_SIZE 4*1024*1024
 //#define DEFAULT_STACK_SIZE 2*1024*1024
 //#define DEFAULT_STACK_SIZE 512*1024
@@ -1511,6 +1516,395 @@ namespace embree
     return true;
   }
 
+  bool rtcore_update_range()
+  {
+    ClearBuffers clear_before_return;
+    RTCSceneRef scene0 = rtcDeviceNewScene(g_device,RTC_SCENE_DYNAMIC,aflags);
+    RTCSceneRef scene1 = rtcDeviceNewScene(g_device,RTC_SCENE_DYNAMIC,aflags);
+    const size_t numPhi = 50;
+    unsigned geom0 = addSphere(scene0,RTC_GEOMETRY_DEFORMABLE,zero,1.0f,numPhi);
+    unsigned geom1 = addSphere(scene1,RTC_GEOMETRY_DEFORMABLE,zero,1.0f,numPhi);
+    rtcCommit (scene0);
+    rtcCommit (scene1);
+    AssertNoError();
+
+    /* a large update of overlapping ranges followed by a small one */
+    const size_t ranges[3][2] = { { 1000, 2200 }, { 2000, 3000 }, { 4000, 4200 } };
+    bool passed = true;
+    for (size_t k=0; k<2; k++)
+    {
+      const float scale = k == 0 ? 1.5f : 0.5f;
+      Vertex3f* vertices0 = (Vertex3f*) rtcMapBuffer(scene0,geom0,RTC_VERTEX_BUFFER); 
+      Vertex3f* vertices1 = (Vertex3f*) rtcMapBuffer(scene1,geom1,RTC_VERTEX_BUFFER); 
+      for (size_t r = k == 0 ? 0 : 2; r < (k == 0 ? 2 : 3); r++) {
+        for (size_t i=ranges[r][0]; i<ranges[r][1]; i++) {
+          vertices0[i] = scale*vertices0[i];
+          vertices1[i] = scale*vertices1[i];
+        }
+        rtcUpdateBufferRange(scene0,geom0,RTC_VERTEX_BUFFER,ranges[r][0],ranges[r][1]-ranges[r][0]);
+      }
+      rtcUnmapBuffer(scene0,geom0,RTC_VERTEX_BUFFER);
+      rtcUnmapBuffer(scene1,geom1,RTC_VERTEX_BUFFER);
+      rtcUpdate(scene1,geom1);
+      rtcCommit (scene0);
+      rtcCommit (scene1);
+      AssertNoError();
+
+      /* partial refit has to give the same hits as full refit */
+      for (size_t i=0; i<1000; i++) 
+      {
+        Vec3fa org(2.0f*drand48()-1.0f,2.0f*drand48()-1.0f,2.0f*drand48()-1.0f);
+        Vec3fa dir(2.0f*drand48()-1.0f,2.0f*drand48()-1.0f,2.0f*drand48()-1.0f);
+        RTCRay ray0 = makeRay(4.0f*org,dir); rtcIntersect(scene0,ray0);
+        RTCRay ray1 = makeRay(4.0f*org,dir); rtcIntersect(scene1,ray1);
+        passed &= ray0.geomID == ray1.geomID;
+        passed &= ray0.primID == ray1.primID;
+        passed &= ray0.tfar == ray1.tfar;
+      }
+    }
+    return passed;
+  }
+
+  bool rtcore_refit_quality()
+  {
+    /* a low threshold forces tree rotations after most refits */
+    std::string cfg = g_rtcore + (g_rtcore != "" ? "," : "") + "refit_quality_threshold=1.01";
+    RTCDevice device = rtcNewDevice(cfg.c_str());
+    if (rtcDeviceGetError(device) != RTC_NO_ERROR) return false;
+
+    bool passed = true;
+    {
+      ClearBuffers clear_before_return;
+      RTCSceneRef scene0 = rtcDeviceNewScene(device,RTC_SCENE_DYNAMIC,aflags);
+      RTCSceneRef scene1 = rtcDeviceNewScene(g_device,RTC_SCENE_DYNAMIC,aflags);
+      const size_t numPhi = 50;
+      const size_t numVertices = 2*numPhi*(numPhi+1);
+      unsigned geom0 = addSphere(scene0,RTC_GEOMETRY_DEFORMABLE,zero,1.0f,numPhi);
+      unsigned geom1 = addSphere(scene1,RTC_GEOMETRY_DYNAMIC,zero,1.0f,numPhi);
+      rtcCommit (scene0);
+      rtcCommit (scene1);
+      passed &= rtcDeviceGetError(device) == RTC_NO_ERROR;
+
+      for (size_t k=0; k<8; k++)
+      {
+        /* swapping vertices degrades the quality of the refitted BVH */
+        Vertex3f* vertices0 = (Vertex3f*) rtcMapBuffer(scene0,geom0,RTC_VERTEX_BUFFER); 
+        Vertex3f* vertices1 = (Vertex3f*) rtcMapBuffer(scene1,geom1,RTC_VERTEX_BUFFER); 
+        for (size_t i=0; i<numVertices/8; i++) {
+          const size_t a = size_t(drand48()*numVertices) % numVertices;
+          const size_t b = size_t(drand48()*numVertices) % numVertices;
+          std::swap(vertices0[a],vertices0[b]);
+          std::swap(vertices1[a],vertices1[b]);
+        }
+        rtcUnmapBuffer(scene0,geom0,RTC_VERTEX_BUFFER);
+        rtcUnmapBuffer(scene1,geom1,RTC_VERTEX_BUFFER);
+        rtcUpdate(scene0,geom0);
+        rtcUpdate(scene1,geom1);
+        rtcCommit (scene0);
+        rtcCommit (scene1);
+        passed &= rtcDeviceGetError(device) == RTC_NO_ERROR;
+
+        /* the rotated BVH has to give the same hits as a rebuilt one */
+        for (size_t i=0; i<1000; i++) 
+        {
+          Vec3fa org(2.0f*drand48()-1.0f,2.0f*drand48()-1.0f,2.0f*drand48()-1.0f);
+          Vec3fa dir(2.0f*drand48()-1.0f,2.0f*drand48()-1.0f,2.0f*drand48()-1.0f);
+          RTCRay ray0 = makeRay(4.0f*org,dir); rtcIntersect(scene0,ray0);
+          RTCRay ray1 = makeRay(4.0f*org,dir); rtcIntersect(scene1,ray1);
+          passed &= ray0.geomID == ray1.geomID;
+          passed &= ray0.tfar == ray1.tfar;
+        }
+      }
+    }
+
+    rtcDeleteDevice(device);
+    return passed;
+  }
+
+  /*! returns the SAH cost and depth of the first acceleration structure of a scene */
+  std::pair<float,size_t> sceneSAH(RTCScene scene)
+  {
+    RTCAccelStatistics stats;
+    if (rtcGetSceneStatistics(scene,&stats,1) == 0) return std::make_pair(0.0f,size_t(0));
+    return std::make_pair(stats.sah,stats.depth);
+  }
+
+  bool rtcore_morton_optimized()
+  {
+    /* treelet restructuring must not change the hits of the morton builder, 
+     * only the BVH4 triangle accel supports the morton builders */
+    std::string cfg0 = g_rtcore + (g_rtcore != "" ? "," : "") + "tri_accel=bvh4.triangle4,tri_builder=morton.optimized";
+    std::string cfg1 = g_rtcore + (g_rtcore != "" ? "," : "") + "tri_accel=bvh4.triangle4,tri_builder=morton";
+    RTCDevice device0 = rtcNewDevice(cfg0.c_str());
+    RTCDevice device1 = rtcNewDevice(cfg1.c_str());
+    if (rtcDeviceGetError(device0) != RTC_NO_ERROR || rtcDeviceGetError(device1) != RTC_NO_ERROR) {
+      rtcDeleteDevice(device0);
+      rtcDeleteDevice(device1);
+      return false;
+    }
+
+    bool passed = true;
+    {
+      ClearBuffers clear_before_return;
+      RTCSceneRef scene0 = rtcDeviceNewScene(device0,RTC_SCENE_STATIC,aflags);
+      RTCSceneRef scene1 = rtcDeviceNewScene(device1,RTC_SCENE_STATIC,aflags);
+      for (size_t i=0; i<8; i++) {
+        const Vec3fa pos(2.0f*drand48()-1.0f,2.0f*drand48()-1.0f,2.0f*drand48()-1.0f);
+        addSphere(scene0,RTC_GEOMETRY_STATIC,pos,0.5f,100);
+        addSphere(scene1,RTC_GEOMETRY_STATIC,pos,0.5f,100);
+      }
+      rtcCommit (scene0);
+      rtcCommit (scene1);
+      passed &= rtcDeviceGetError(device0) == RTC_NO_ERROR;
+      passed &= rtcDeviceGetError(device1) == RTC_NO_ERROR;
+
+      /* some treelet has to get rewritten, which strictly lowers the SAH cost */
+      const std::pair<float,size_t> sah0 = sceneSAH(scene0);
+      const std::pair<float,size_t> sah1 = sceneSAH(scene1);
+      passed &= sah0.first > 0.0f && sah1.first > 0.0f;
+      passed &= sah0.first < sah1.first;
+      passed &= sah0.second <= 32; // maximal build depth of the BVH
+      
+      for (size_t i=0; i<10000; i++) 
+      {
+        Vec3fa org(2.0f*drand48()-1.0f,2.0f*drand48()-1.0f,2.0f*drand48()-1.0f);
+        Vec3fa dir(2.0f*drand48()-1.0f,2.0f*drand48()-1.0f,2.0f*drand48()-1.0f);
+        RTCRay ray0 = makeRay(4.0f*org,dir); rtcIntersect(scene0,ray0);
+        RTCRay ray1 = makeRay(4.0f*org,dir); rtcIntersect(scene1,ray1);
+        passed &= ray0.geomID == ray1.geomID;
+        passed &= ray0.tfar == ray1.tfar;
+      }
+    }
+
+    rtcDeleteDevice(device0);
+    rtcDeleteDevice(device1);
+    return passed;
+  }
+
+#if defined(__TARGET_AVX512KNL__) || defined(__TARGET_AVX512SKX__)
+  bool rtcore_bvh16_triangle4()
+  {
+    /* the BVH16 has to find the same hits as the default triangle accel */
+    std::string cfg = g_rtcore + (g_rtcore != "" ? "," : "") + "tri_accel=bvh16.triangle4";
+    RTCDevice device = rtcNewDevice(cfg.c_str());
+    if (rtcDeviceGetError(device) != RTC_NO_ERROR) {
+      rtcDeleteDevice(device);
+      return false;
+    }
+
+    bool passed = true;
+    {
+      ClearBuffers clear_before_return;
+      RTCSceneRef scene0 = rtcDeviceNewScene(device,RTC_SCENE_STATIC,aflags);
+      RTCSceneRef scene1 = rtcDeviceNewScene(g_device,RTC_SCENE_STATIC,aflags);
+      for (size_t i=0; i<8; i++) {
+        const Vec3fa pos(2.0f*drand48()-1.0f,2.0f*drand48()-1.0f,2.0f*drand48()-1.0f);
+        addSphere(scene0,RTC_GEOMETRY_STATIC,pos,0.5f,100);
+        addSphere(scene1,RTC_GEOMETRY_STATIC,pos,0.5f,100);
+      }
+      rtcCommit (scene0);
+      rtcCommit (scene1);
+      passed &= rtcDeviceGetError(device) == RTC_NO_ERROR;
+      passed &= rtcDeviceGetError(g_device) == RTC_NO_ERROR;
+
+      for (size_t i=0; i<10000; i++) 
+      {
+        Vec3fa org(2.0f*drand48()-1.0f,2.0f*drand48()-1.0f,2.0f*drand48()-1.0f);
+        Vec3fa dir(2.0f*drand48()-1.0f,2.0f*drand48()-1.0f,2.0f*drand48()-1.0f);
+        RTCRay ray0 = makeRay(4.0f*org,dir); rtcIntersect(scene0,ray0);
+        RTCRay ray1 = makeRay(4.0f*org,dir); rtcIntersect(scene1,ray1);
+        passed &= ray0.geomID == ray1.geomID && ray0.primID == ray1.primID;
+        passed &= fabs(ray0.tfar-ray1.tfar) <= 1E-5f*max(1.0f,fabs(ray1.tfar));
+        RTCRay ray2 = makeRay(4.0f*org,dir); rtcOccluded(scene0,ray2);
+        passed &= (ray2.geomID == 0) == (ray1.geomID != RTC_INVALID_GEOMETRY_ID);
+      }
+    }
+
+    rtcDeleteDevice(device);
+    return passed;
+  }
+#endif
+
+  bool rtcore_scene_statistics()
+  {
+    ClearBuffers clear_before_return;
+    RTCSceneRef scene = rtcDeviceNewScene(g_device,RTC_SCENE_STATIC,aflags);
+    AssertNoError();
+    for (size_t i=0; i<8; i++) {
+      const Vec3fa pos(2.0f*drand48()-1.0f,2.0f*drand48()-1.0f,2.0f*drand48()-1.0f);
+      addSphere(scene,RTC_GEOMETRY_STATIC,pos,0.5f,50);
+    }
+    rtcCommit (scene);
+    AssertNoError();
+
+    const size_t num = rtcGetSceneStatistics(scene,nullptr,0);
+    if (num == 0) return false;
+    std::vector<RTCAccelStatistics> stats(num);
+    if (rtcGetSceneStatistics(scene,stats.data(),num) != num) return false;
+    AssertNoError();
+
+    bool passed = true;
+    for (size_t i=0; i<num; i++)
+    {
+      const RTCAccelStatistics& s = stats[i];
+      size_t numLeaves = 0;
+      for (size_t d=0; d<RTC_MAX_STATISTICS_DEPTH; d++) numLeaves += s.leafDepthHistogram[d];
+      passed &= s.primitiveType != nullptr;
+      passed &= s.numPrimitives > 0;
+      passed &= numLeaves == s.numLeaves;
+      passed &= s.leafFillRate > 0.0f && s.leafFillRate <= 1.0f;
+      passed &= s.nodeFillRate >= 0.0f && s.nodeFillRate <= 1.0f;
+      passed &= s.sah > 0.0f;
+      passed &= s.bytesLeaves > 0 && s.bytesAllocated > 0;
+      passed &= s.buildTimeTotal >= s.buildTimePrimRefs+s.buildTimeHierarchy;
+    }
+    return passed;
+  }
+
+  bool rtcore_tessellation_cache_budget()
+  {
+    ClearBuffers clear_before_return;
+    RTCSceneRef scene = rtcDeviceNewScene(g_device,RTC_SCENE_DYNAMIC,aflags);
+    AssertNoError();
+    addSubdivSphere(scene,RTC_GEOMETRY_STATIC,zero,1.0f,10,4);
+    rtcSetTessellationCacheBudget(scene,4*1024*1024);
+    AssertNoError();
+    rtcCommit (scene);
+    AssertNoError();
+
+    for (size_t i=0; i<2*256; i++) {
+      const Vec3fa dir(2.0f*drand48()-1.0f,2.0f*drand48()-1.0f,2.0f*drand48()-1.0f);
+      RTCRay ray = makeRay(zero,dir); rtcIntersect(scene,ray);
+    }
+
+    RTCTessellationCacheStatistics stats;
+    rtcGetTessellationCacheStatistics(scene,&stats);
+    AssertNoError();
+    bool passed = true;
+    passed &= stats.bytes > 0 && stats.bytes <= 4*1024*1024;
+    passed &= stats.misses > 0;
+
+    /* the scene has to hit the same surface after moving between
+     * partitions, which requires cache tags of the previous partition
+     * to be invalid in the new one */
+    RTCRay ray0 = makeRay(zero,Vec3fa(1,0,0)); rtcIntersect(scene,ray0);
+    passed &= ray0.geomID == 0;
+    for (size_t i=0; i<3; i++) 
+    {
+      rtcSetTessellationCacheBudget(scene,(i%2) ? 4*1024*1024 : 0);
+      AssertNoError();
+      RTCRay ray1 = makeRay(zero,Vec3fa(1,0,0)); rtcIntersect(scene,ray1);
+      passed &= ray1.geomID == 0 && ray1.primID == ray0.primID && ray1.tfar == ray0.tfar;
+    }
+
+    /* budgets that starve the shared partition get rejected */
+    rtcSetTessellationCacheBudget(scene,size_t(1) << 40);
+    passed &= rtcDeviceGetError(g_device) == RTC_INVALID_ARGUMENT;
+    rtcSetTessellationCacheBudget(scene,1);
+    passed &= rtcDeviceGetError(g_device) == RTC_INVALID_ARGUMENT;
+    return passed;
+  }
+
+  bool rtcore_geometry_instance(int N)
+  {
+    ClearBuffers clear_before_return;
+    RTCSceneRef scene = rtcDeviceNewScene(g_device,RTC_SCENE_STATIC,aflags);
+    AssertNoError();
+
+    /* sphere that is only visible through a geometry instance and a nested geometry instance */
+    unsigned mesh = addSphere(scene,RTC_GEOMETRY_STATIC,zero,1.0f,50);
+    rtcDisable(scene,mesh);
+    unsigned inst0 = rtcNewGeometryInstance(scene,mesh);
+    unsigned inst1 = rtcNewGeometryInstance(scene,inst0);
+    AssertNoError();
+    const float xfm0[12] = { 1,0,0, 0,1,0, 0,0,1, 5,0,0 };
+    const float xfm1[12] = { 1,0,0, 0,1,0, 0,0,1, 0,0,5 };
+    rtcSetTransform(scene,inst0,RTC_MATRIX_COLUMN_MAJOR,xfm0);
+    rtcSetTransform(scene,inst1,RTC_MATRIX_COLUMN_MAJOR,xfm1);
+    rtcCommit (scene);
+    AssertNoError();
+
+    bool passed = true;
+    RTCRay ray0 = makeRay(Vec3fa(5,10,0),Vec3fa(0,-1,0)); rtcIntersectN(scene,ray0,N);
+    passed &= ray0.geomID == mesh && ray0.instID == inst0 && fabs(ray0.tfar-9.0f) < 0.01f;
+    RTCRay ray1 = makeRay(Vec3fa(5,10,5),Vec3fa(0,-1,0)); rtcIntersectN(scene,ray1,N);
+    passed &= ray1.geomID == mesh && ray1.instID == inst1 && fabs(ray1.tfar-9.0f) < 0.01f;
+    RTCRay ray2 = makeRay(Vec3fa(0,10,0),Vec3fa(0,-1,0)); rtcIntersectN(scene,ray2,N);
+    passed &= ray2.geomID == RTC_INVALID_GEOMETRY_ID;
+    RTCRay ray3 = makeRay(Vec3fa(5,10,5),Vec3fa(0,-1,0)); rtcOccludedN(scene,ray3,N);
+    passed &= ray3.geomID == 0 && ray3.org[0] == 5.0f && ray3.org[2] == 5.0f;
+    AssertNoError();
+
+    /* a single geometry instance still has to get transformed */
+    RTCSceneRef scene1 = rtcDeviceNewScene(g_device,RTC_SCENE_STATIC,aflags);
+    unsigned mesh1 = addSphere(scene1,RTC_GEOMETRY_STATIC,zero,1.0f,50);
+    rtcDisable(scene1,mesh1);
+    unsigned inst2 = rtcNewGeometryInstance(scene1,mesh1);
+    rtcSetTransform(scene1,inst2,RTC_MATRIX_COLUMN_MAJOR,xfm0);
+    rtcCommit (scene1);
+    AssertNoError();
+
+    RTCRay ray4 = makeRay(Vec3fa(5,10,0),Vec3fa(0,-1,0)); rtcIntersectN(scene1,ray4,N);
+    passed &= ray4.geomID == mesh1 && ray4.instID == inst2 && fabs(ray4.tfar-9.0f) < 0.01f;
+    RTCRay ray5 = makeRay(Vec3fa(0,10,0),Vec3fa(0,-1,0)); rtcIntersectN(scene1,ray5,N);
+    passed &= ray5.geomID == RTC_INVALID_GEOMETRY_ID;
+    AssertNoError();
+    return passed;
+  }
+
+  bool rtcore_update_many(RTCGeometryFlags flags)
+  {
+    ClearBuffers clear_before_return;
+    RTCSceneRef scene = rtcDeviceNewScene(g_device,RTC_SCENE_DYNAMIC,aflags);
+    AssertNoError();
+
+    /* grid of spheres where only few of them get modified per commit */
+    const size_t numSpheres = 64;
+    const size_t numPhi = 20;
+    const size_t numVertices = 2*numPhi*(numPhi+1);
+    Vec3fa pos[numSpheres];
+    bool enabled[numSpheres];
+    for (size_t i=0; i<numSpheres; i++) {
+      pos[i] = Vec3fa(4.0f*float(i%8),0.0f,4.0f*float(i/8));
+      enabled[i] = true;
+      if (addSphere(scene,flags,pos[i],1.0f,numPhi) != i) return false;
+    }
+    rtcCommit (scene);
+    AssertNoError();
+
+    for (size_t i=0; i<48; i++)
+    {
+      /* move one sphere up or down, and toggle some other sphere */
+      const size_t k = (7*i)%numSpheres;
+      Vec3fa ds(0.0f,pos[k].y == 0.0f ? 3.0f : -3.0f,0.0f);
+      move_mesh_vec3f(scene,k,numVertices,ds); pos[k] += ds;
+      if (i%3 == 0) {
+        const size_t j = (5*i+3)%numSpheres;
+        if (enabled[j]) rtcDisable(scene,j); else rtcEnable(scene,j);
+        enabled[j] = !enabled[j];
+      }
+      rtcCommit (scene);
+      AssertNoError();
+
+      /* rays have to hit spheres at their new position and miss them at the old position */
+      for (size_t j=0; j<numSpheres; j++)
+      {
+        const unsigned expected = enabled[j] ? unsigned(j) : RTC_INVALID_GEOMETRY_ID;
+        RTCRay ray0 = makeRay(pos[j]+Vec3fa(0,10,0),Vec3fa(0,-1,0));
+        RTCRay ray1 = makeRay(pos[j]+Vec3fa(0,0,-2),Vec3fa(0,0,1),0.0f,4.0f);
+        RTCRay ray2 = makeRay(pos[j]+Vec3fa(0,pos[j].y == 0.0f ? 3.0f : -3.0f,-2),Vec3fa(0,0,1),0.0f,4.0f);
+        rtcIntersect(scene,ray0);
+        rtcIntersect(scene,ray1);
+        rtcIntersect(scene,ray2);
+        if (ray0.geomID != expected ||
+            ray1.geomID != expected ||
+            ray2.geomID != RTC_INVALID_GEOMETRY_ID) return false;
+      }
+    }
+    scene = nullptr;
+    return true;
+  }
+
   bool rtcore_ray_masks_intersect(RTCSceneFlags sflags, RTCGeometryFlags gflags)
   {
     ClearBuffers clear_before_return;
@@ -2024,6 +2418,70 @@ namespace embree
     numFailedTests += !passed;
   }
 
+  void rejectFilter1(void* ptr, RTCRay& ray) {
+    ray.geomID = RTC_INVALID_GEOMETRY_ID;
+  }
+
+  /* the scene has to switch between the lean and the filtering kernels when filters or masks get added or removed */
+  bool rtcore_filter_mask_switch()
+  {
+    ClearBuffers clear_before_return;
+    RTCSceneRef scene = rtcDeviceNewScene(g_device,RTC_SCENE_DYNAMIC,aflags);
+    AssertNoError();
+    unsigned geomID = addSphere(scene,RTC_GEOMETRY_STATIC,zero,1.0f,50);
+    rtcCommit (scene);
+    AssertNoError();
+
+    bool passed = true;
+    RTCRay ray0 = makeRay(Vec3fa(0,0,-10),Vec3fa(0,0,1)); rtcIntersect(scene,ray0);
+    passed &= ray0.geomID == geomID;
+
+    /* adding a filter function has to select the filtering kernels */
+    rtcSetIntersectionFilterFunction(scene,geomID,rejectFilter1);
+    rtcSetOcclusionFilterFunction(scene,geomID,rejectFilter1);
+    rtcCommit (scene);
+    AssertNoError();
+    RTCRay ray1 = makeRay(Vec3fa(0,0,-10),Vec3fa(0,0,1)); rtcIntersect(scene,ray1);
+    RTCRay ray2 = makeRay(Vec3fa(0,0,-10),Vec3fa(0,0,1)); rtcOccluded (scene,ray2);
+    passed &= ray1.geomID == RTC_INVALID_GEOMETRY_ID;
+    passed &= ray2.geomID != 0;
+
+    /* removing it again has to select the lean kernels */
+    rtcSetIntersectionFilterFunction(scene,geomID,nullptr);
+    rtcSetOcclusionFilterFunction(scene,geomID,nullptr);
+    rtcCommit (scene);
+    AssertNoError();
+    RTCRay ray3 = makeRay(Vec3fa(0,0,-10),Vec3fa(0,0,1)); rtcIntersect(scene,ray3);
+    RTCRay ray4 = makeRay(Vec3fa(0,0,-10),Vec3fa(0,0,1)); rtcOccluded (scene,ray4);
+    passed &= ray3.geomID == geomID;
+    passed &= ray4.geomID == 0;
+
+#if defined(RTCORE_RAY_MASK)
+    /* the lean kernels still reject rays with mask 0 */
+    RTCRay ray5 = makeRay(Vec3fa(0,0,-10),Vec3fa(0,0,1)); ray5.mask = 0; rtcIntersect(scene,ray5);
+    passed &= ray5.geomID == RTC_INVALID_GEOMETRY_ID;
+
+    /* a geometry mask has to select the masking kernels */
+    rtcSetMask(scene,geomID,2);
+    rtcCommit (scene);
+    AssertNoError();
+    RTCRay ray6 = makeRay(Vec3fa(0,0,-10),Vec3fa(0,0,1)); ray6.mask = 1; rtcIntersect(scene,ray6);
+    RTCRay ray7 = makeRay(Vec3fa(0,0,-10),Vec3fa(0,0,1)); ray7.mask = 2; rtcIntersect(scene,ray7);
+    passed &= ray6.geomID == RTC_INVALID_GEOMETRY_ID;
+    passed &= ray7.geomID == geomID;
+
+    /* resetting the default mask has to select the lean kernels again */
+    rtcSetMask(scene,geomID,-1);
+    rtcCommit (scene);
+    AssertNoError();
+    RTCRay ray8 = makeRay(Vec3fa(0,0,-10),Vec3fa(0,0,1)); ray8.mask = 1; rtcIntersect(scene,ray8);
+    RTCRay ray9 = makeRay(Vec3fa(0,0,-10),Vec3fa(0,0,1)); ray9.mask = 0; rtcIntersect(scene,ray9);
+    passed &= ray8.geomID == geomID;
+    passed &= ray9.geomID == RTC_INVALID_GEOMETRY_ID;
+#endif
+    return passed;
+  }
+
   bool rtcore_packet_write_test(RTCSceneFlags sflags, RTCGeometryFlags gflags, int type)
   {
     bool passed = true;
@@ -2597,6 +3055,685 @@ namespace embree
     numFailedTests += !passed;
   }
 
+#if defined(RTCORE_RAY_PACKETS) && !defined(__MIC__)
+  bool rtcore_ray_stream(RTCSceneFlags sflags, RTCGeometryFlags gflags)
+  {
+    RTCSceneRef scene = rtcDeviceNewScene(g_device,sflags,(RTCAlgorithmFlags)(aflags | RTC_INTERSECT_STREAM));
+    addSphere(scene,gflags,Vec3fa(-1,0,-1),1.0f,50);
+    addSphere(scene,gflags,Vec3fa(+1,0,+1),1.0f,50);
+    rtcCommit (scene);
+    AssertNoError();
+
+    const size_t N = 1000;
+    RTCRay* rays0 = (RTCRay*) alignedMalloc(N*sizeof(RTCRay));
+    RTCRay* rays1 = (RTCRay*) alignedMalloc(N*sizeof(RTCRay));
+    for (size_t i=0; i<N; i++) {
+      Vec3fa org(2.0f*drand48()-1.0f,2.0f*drand48()-1.0f,2.0f*drand48()-1.0f);
+      Vec3fa dir(2.0f*drand48()-1.0f,2.0f*drand48()-1.0f,2.0f*drand48()-1.0f);
+      rays0[i] = rays1[i] = makeRay(4.0f*org,dir);
+    }
+
+    /* reference results using the single ray API */
+    for (size_t i=0; i<N; i++) rtcIntersect(scene,rays0[i]);
+
+    bool passed = true;
+
+    /* array of structures layout */
+    std::vector<RTCRay> rays(rays1,rays1+N);
+    rtcIntersect1M(scene,rays1,N,sizeof(RTCRay));
+    AssertNoError();
+    for (size_t i=0; i<N; i++) {
+      passed &= rays1[i].geomID == rays0[i].geomID;
+      passed &= rays1[i].primID == rays0[i].primID;
+    }
+    
+    /* structure of pointers layout */
+    std::vector<float> orgx(N), orgy(N), orgz(N), dirx(N), diry(N), dirz(N), tnear(N), tfar(N), u(N), v(N);
+    std::vector<unsigned> geomID(N), primID(N);
+    for (size_t i=0; i<N; i++) {
+      orgx[i] = rays[i].org[0]; orgy[i] = rays[i].org[1]; orgz[i] = rays[i].org[2];
+      dirx[i] = rays[i].dir[0]; diry[i] = rays[i].dir[1]; dirz[i] = rays[i].dir[2];
+      tnear[i] = rays[i].tnear; tfar[i] = rays[i].tfar;
+      geomID[i] = primID[i] = -1;
+    }
+    RTCRayNp raysNp;
+    memset(&raysNp,0,sizeof(raysNp));
+    raysNp.orgx = orgx.data(); raysNp.orgy = orgy.data(); raysNp.orgz = orgz.data();
+    raysNp.dirx = dirx.data(); raysNp.diry = diry.data(); raysNp.dirz = dirz.data();
+    raysNp.tnear = tnear.data(); raysNp.tfar = tfar.data();
+    raysNp.u = u.data(); raysNp.v = v.data();
+    raysNp.geomID = geomID.data(); raysNp.primID = primID.data();
+    rtcIntersectNp(scene,raysNp,N);
+    AssertNoError();
+    for (size_t i=0; i<N; i++) {
+      passed &= geomID[i] == rays0[i].geomID;
+      passed &= primID[i] == rays0[i].primID;
+    }
+
+    /* occlusion queries */
+    for (size_t i=0; i<N; i++) rays1[i] = rays[i];
+    rtcOccluded1M(scene,rays1,N,sizeof(RTCRay));
+    AssertNoError();
+    for (size_t i=0; i<N; i++) 
+      passed &= (rays1[i].geomID == 0) == (rays0[i].geomID != RTC_INVALID_GEOMETRY_ID);
+
+    alignedFree(rays0);
+    alignedFree(rays1);
+    return passed;
+  }
+
+  void rtcore_ray_stream_all()
+  {
+    printf("%30s ... ","ray_stream");
+    bool passed = true;
+    for (int i=0; i<numSceneGeomFlags; i++) 
+    {
+      RTCSceneFlags sflag; RTCGeometryFlags gflag; 
+      getSceneGeomFlag(i,sflag,gflag);
+      bool ok0 = rtcore_ray_stream(sflag,gflag);
+      if (ok0) printf(GREEN("+")); else printf(RED("-"));
+      passed &= ok0;
+    }
+    printf(" %s\n",passed ? GREEN("[PASSED]") : RED("[FAILED]"));
+    fflush(stdout);
+    numFailedTests += !passed;
+  }
+
+  bool rtcore_ray_sorting()
+  {
+    std::string cfg = g_rtcore + (g_rtcore != "" ? "," : "") + "ray_sorting=1";
+    RTCDevice device = rtcNewDevice(cfg.c_str());
+    if (rtcDeviceGetError(device) != RTC_NO_ERROR) return false;
+
+    bool passed = true;
+    {
+      RTCSceneRef scene = rtcDeviceNewScene(device,RTC_SCENE_STATIC,(RTCAlgorithmFlags)(aflags | RTC_INTERSECT_STREAM));
+      addSphere(scene,RTC_GEOMETRY_STATIC,Vec3fa(-1,0,-1),1.0f,50);
+      addSphere(scene,RTC_GEOMETRY_STATIC,Vec3fa(+1,0,+1),1.0f,50);
+      rtcCommit (scene);
+      passed &= rtcDeviceGetError(device) == RTC_NO_ERROR;
+
+      /* the stream is large enough to get sorted as a whole */
+      const size_t N = 4000;
+      std::vector<RTCRay> rays(N), rays0(N), rays1(N);
+      for (size_t i=0; i<N; i++) {
+        Vec3fa org(2.0f*drand48()-1.0f,2.0f*drand48()-1.0f,2.0f*drand48()-1.0f);
+        Vec3fa dir(2.0f*drand48()-1.0f,2.0f*drand48()-1.0f,2.0f*drand48()-1.0f);
+        rays[i] = rays0[i] = rays1[i] = makeRay(4.0f*org,dir);
+      }
+      for (size_t i=0; i<N; i++) rtcIntersect(scene,rays0[i]);
+      rtcIntersect1M(scene,rays1.data(),N,sizeof(RTCRay));
+      for (size_t i=0; i<N; i++) {
+        passed &= rays1[i].geomID == rays0[i].geomID;
+        passed &= rays1[i].primID == rays0[i].primID;
+      }
+
+      /* incoherent packets get split into one sub-packet per octant */
+      for (size_t i=0; i+16<=N; i+=16)
+      {
+#if HAS_INTERSECT8
+        if (hasISA(AVX))
+        {
+          RTCRay8 ray8; memset(&ray8,0,sizeof(ray8));
+          for (size_t j=0; j<8; j++) setRay(ray8,j,rays[i+j]);
+          __aligned(32) int valid8[8] = { -1,-1,-1,-1,-1,-1,-1, 0 };
+          rtcIntersect8(valid8,scene,ray8);
+          for (size_t j=0; j<7; j++) passed &= ray8.geomID[j] == rays0[i+j].geomID && ray8.primID[j] == rays0[i+j].primID;
+          passed &= ray8.geomID[7] == RTC_INVALID_GEOMETRY_ID;
+        }
+#endif
+#if HAS_INTERSECT16
+        if (hasISA(AVX512KNL) || hasISA(KNC))
+        {
+          RTCRay16 ray16; memset(&ray16,0,sizeof(ray16));
+          for (size_t j=0; j<16; j++) setRay(ray16,j,rays[i+j]);
+          __aligned(64) int valid16[16] = { -1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1 };
+          rtcIntersect16(valid16,scene,ray16);
+          for (size_t j=0; j<16; j++) passed &= ray16.geomID[j] == rays0[i+j].geomID && ray16.primID[j] == rays0[i+j].primID;
+        }
+#endif
+      }
+      passed &= rtcDeviceGetError(device) == RTC_NO_ERROR;
+    }
+
+    rtcDeleteDevice(device);
+    return passed;
+  }
+#endif
+
+#if !defined(__WIN32__)
+  size_t removeDirectory(const std::string& dir)
+  {
+    size_t numFiles = 0;
+    if (DIR* d = opendir(dir.c_str())) {
+      while (dirent* e = readdir(d)) {
+        if (std::string(e->d_name) == "." || std::string(e->d_name) == "..") continue;
+        remove((dir+"/"+e->d_name).c_str());
+        numFiles++;
+      }
+      closedir(d);
+    }
+    rmdir(dir.c_str());
+    return numFiles;
+  }
+
+  bool rtcore_bvh_cache()
+  {
+    char dir[] = "/tmp/embree_bvh_cache_XXXXXX";
+    if (mkdtemp(dir) == nullptr) return false;
+    std::string cfg = g_rtcore + (g_rtcore != "" ? "," : "") + "bvh_cache_dir=\"" + dir + "\"";
+    RTCDevice device = rtcNewDevice(cfg.c_str());
+    std::swap(g_device,device);
+
+    bool passed = true;
+    {
+      /* the first scene builds and stores the BVHs, the second one loads them */
+      RTCSceneRef scene0 = rtcDeviceNewScene(g_device,RTC_SCENE_STATIC,aflags);
+      addSphere(scene0,RTC_GEOMETRY_STATIC,Vec3fa(-1,0,-1),1.0f,50);
+      addHair  (scene0,RTC_GEOMETRY_STATIC,Vec3fa(+1,0,+1),1.0f,0.1f,64);
+      rtcCommit (scene0);
+      
+      RTCSceneRef scene1 = rtcDeviceNewScene(g_device,RTC_SCENE_STATIC,aflags);
+      addSphere(scene1,RTC_GEOMETRY_STATIC,Vec3fa(-1,0,-1),1.0f,50);
+      addHair  (scene1,RTC_GEOMETRY_STATIC,Vec3fa(+1,0,+1),1.0f,0.1f,64);
+      rtcCommit (scene1);
+      passed &= rtcDeviceGetError(g_device) == RTC_NO_ERROR;
+
+      for (size_t i=0; i<1000; i++) {
+        Vec3fa org(2.0f*drand48()-1.0f,2.0f*drand48()-1.0f,2.0f*drand48()-1.0f);
+        Vec3fa dir(2.0f*drand48()-1.0f,2.0f*drand48()-1.0f,2.0f*drand48()-1.0f);
+        RTCRay ray0 = makeRay(4.0f*org,dir); rtcIntersect(scene0,ray0);
+        RTCRay ray1 = makeRay(4.0f*org,dir); rtcIntersect(scene1,ray1);
+        passed &= ray0.geomID == ray1.geomID;
+        passed &= ray0.primID == ray1.primID;
+        passed &= ray0.tfar == ray1.tfar;
+      }
+    }
+
+    std::swap(g_device,device);
+    rtcDeleteDevice(device);
+    passed &= removeDirectory(dir) > 0;
+    return passed;
+  }
+
+  size_t countFiles(const std::string& dir, const std::string& prefix, const std::string& suffix)
+  {
+    size_t numFiles = 0;
+    if (DIR* d = opendir(dir.c_str())) {
+      while (dirent* e = readdir(d)) {
+        const std::string name = e->d_name;
+        if (name.size() < prefix.size()+suffix.size()) continue;
+        if (name.compare(0,prefix.size(),prefix) != 0) continue;
+        if (name.compare(name.size()-suffix.size(),suffix.size(),suffix) != 0) continue;
+        numFiles++;
+      }
+      closedir(d);
+    }
+    return numFiles;
+  }
+
+  bool rtcore_subdiv_grid_cache()
+  {
+    char dir[] = "/tmp/embree_grid_cache_XXXXXX";
+    if (mkdtemp(dir) == nullptr) return false;
+    std::string cfg = g_rtcore + (g_rtcore != "" ? "," : "") + "bvh_cache_dir=\"" + dir + "\",subdiv_accel=bvh4.grid.eager,subdiv_grid_compression=1";
+    RTCDevice device = rtcNewDevice(cfg.c_str());
+    std::swap(g_device,device);
+
+    /* the reference device evaluates uncompressed grids and uses no cache */
+    std::string cfgRef = g_rtcore + (g_rtcore != "" ? "," : "") + "subdiv_accel=bvh4.grid.eager,subdiv_grid_compression=0";
+    RTCDevice deviceRef = rtcNewDevice(cfgRef.c_str());
+
+    /* the spheres get random creases, thus all scenes use the same seeds */
+    auto addSphere = [] (const RTCSceneRef& scene) {
+      srand(1234); srand48(1234);
+      addSubdivSphere(scene,RTC_GEOMETRY_STATIC,zero,1.0f,10,8);
+    };
+
+    bool passed = true;
+    {
+      /* the first scene evaluates and stores the compressed grids, the second one loads them */
+      RTCSceneRef scene0 = rtcDeviceNewScene(g_device,RTC_SCENE_STATIC,aflags);
+      addSphere(scene0);
+      rtcCommit (scene0);
+      passed &= countFiles(dir,"subdiv.grids.",".bin") == 1;
+
+      RTCSceneRef scene1 = rtcDeviceNewScene(g_device,RTC_SCENE_STATIC,aflags);
+      addSphere(scene1);
+      rtcCommit (scene1);
+      passed &= rtcDeviceGetError(g_device) == RTC_NO_ERROR;
+
+      RTCSceneRef sceneRef = rtcDeviceNewScene(deviceRef,RTC_SCENE_STATIC,aflags);
+      addSphere(sceneRef);
+      rtcCommit (sceneRef);
+      passed &= rtcDeviceGetError(deviceRef) == RTC_NO_ERROR;
+
+      /* positions get quantized to 21 bits of the mesh bounds, thus hit
+       * distances may only differ by a few quantization steps */
+      const float eps = 1E-5f;
+
+      /* rays from the center have to hit the closed surface despite quantization */
+      for (size_t i=0; i<1000; i++) {
+        Vec3fa dir(2.0f*drand48()-1.0f,2.0f*drand48()-1.0f,2.0f*drand48()-1.0f);
+        RTCRay ray0 = makeRay(zero,dir); rtcIntersect(scene0,ray0);
+        RTCRay ray1 = makeRay(zero,dir); rtcIntersect(scene1,ray1);
+        RTCRay rayRef = makeRay(zero,dir); rtcIntersect(sceneRef,rayRef);
+        passed &= ray0.geomID == 0;
+        passed &= ray0.geomID == ray1.geomID;
+        passed &= ray0.primID == ray1.primID;
+        passed &= ray0.tfar == ray1.tfar;
+        passed &= ray0.geomID == rayRef.geomID;
+        passed &= fabs(ray0.tfar-rayRef.tfar)*length(dir) <= eps;
+      }
+    }
+
+    rtcDeleteDevice(deviceRef);
+    std::swap(g_device,device);
+    rtcDeleteDevice(device);
+    passed &= removeDirectory(dir) > 0;
+    return passed;
+  }
+
+  bool rtcore_out_of_core()
+  {
+    char dir[] = "/tmp/embree_out_of_core_XXXXXX";
+    if (mkdtemp(dir) == nullptr) return false;
+
+    /* a budget of zero pages every object out again after each use */
+    std::string cfg = g_rtcore + (g_rtcore != "" ? "," : "") + "out_of_core_dir=\"" + dir + "\",out_of_core_budget=0";
+    RTCDevice device = rtcNewDevice(cfg.c_str());
+    if (rtcDeviceGetError(device) != RTC_NO_ERROR) return false;
+
+    bool passed = true;
+    {
+      /* the paged scene has to report the same hits as the resident one */
+      RTCSceneRef scene0 = rtcDeviceNewScene(g_device,RTC_SCENE_STATIC,aflags);
+      RTCSceneRef scene1 = rtcDeviceNewScene(device,RTC_SCENE_STATIC,aflags);
+      for (size_t i=0; i<8; i++) {
+        const Vec3fa pos(2.0f*drand48()-1.0f,2.0f*drand48()-1.0f,2.0f*drand48()-1.0f);
+        addSphere(scene0,RTC_GEOMETRY_STATIC,pos,0.5f,20);
+        addSphere(scene1,RTC_GEOMETRY_STATIC,pos,0.5f,20);
+      }
+      rtcCommit (scene0);
+      rtcCommit (scene1);
+      passed &= rtcDeviceGetError(device) == RTC_NO_ERROR;
+
+      for (size_t i=0; i<1000; i++) 
+      {
+        Vec3fa org(2.0f*drand48()-1.0f,2.0f*drand48()-1.0f,2.0f*drand48()-1.0f);
+        Vec3fa dir(2.0f*drand48()-1.0f,2.0f*drand48()-1.0f,2.0f*drand48()-1.0f);
+        RTCRay ray0 = makeRay(4.0f*org,dir); rtcIntersect(scene0,ray0);
+        RTCRay ray1 = makeRay(4.0f*org,dir); rtcIntersect(scene1,ray1);
+        passed &= ray0.geomID == ray1.geomID;
+        passed &= ray0.primID == ray1.primID;
+        passed &= ray0.tfar == ray1.tfar;
+
+        RTCRay shadow0 = makeRay(4.0f*org,dir); rtcOccluded(scene0,shadow0);
+        RTCRay shadow1 = makeRay(4.0f*org,dir); rtcOccluded(scene1,shadow1);
+        passed &= shadow0.geomID == shadow1.geomID;
+      }
+      passed &= rtcDeviceGetError(device) == RTC_NO_ERROR;
+    }
+
+    /* deleting the scene removes all paged files */
+    rtcDeleteDevice(device);
+    passed &= removeDirectory(dir) == 0;
+    return passed;
+  }
+#endif
+
+  bool rtcore_build_memory()
+  {
+    std::string cfg = g_rtcore + (g_rtcore != "" ? "," : "") + "hugepages=thp,alloc_prefault=1,alloc_pool_size=64";
+    RTCDevice device = rtcNewDevice(cfg.c_str());
+    if (rtcDeviceGetError(device) != RTC_NO_ERROR) return false;
+
+    /* later scenes get built from prefaulted and pooled blocks and
+     * have to report the same hits as scenes of the default device */
+    bool passed = true;
+    for (size_t i=0; i<4; i++)
+    {
+      const Vec3fa pos(2.0f*drand48()-1.0f,2.0f*drand48()-1.0f,2.0f*drand48()-1.0f);
+      RTCSceneRef scene0 = rtcDeviceNewScene(g_device,RTC_SCENE_STATIC,aflags);
+      RTCSceneRef scene1 = rtcDeviceNewScene(device,RTC_SCENE_STATIC,aflags);
+      addSphere(scene0,RTC_GEOMETRY_STATIC,pos,1.0f,200);
+      addSphere(scene1,RTC_GEOMETRY_STATIC,pos,1.0f,200);
+      rtcCommit (scene0);
+      rtcCommit (scene1);
+      passed &= rtcDeviceGetError(device) == RTC_NO_ERROR;
+
+      for (size_t j=0; j<100; j++) 
+      {
+        Vec3fa org(2.0f*drand48()-1.0f,2.0f*drand48()-1.0f,2.0f*drand48()-1.0f);
+        Vec3fa dir(2.0f*drand48()-1.0f,2.0f*drand48()-1.0f,2.0f*drand48()-1.0f);
+        RTCRay ray0 = makeRay(4.0f*org,dir); rtcIntersect(scene0,ray0);
+        RTCRay ray1 = makeRay(4.0f*org,dir); rtcIntersect(scene1,ray1);
+        passed &= ray0.primID == ray1.primID;
+        passed &= ray0.tfar == ray1.tfar;
+      }
+    }
+    rtcDeleteDevice(device);
+    return passed;
+  }
+
+  bool rtcore_quantized_bvh(const std::string& accel)
+  {
+    std::string cfg = g_rtcore + (g_rtcore != "" ? "," : "") + "tri_accel=" + accel;
+    RTCDevice device = rtcNewDevice(cfg.c_str());
+    if (rtcDeviceGetError(device) != RTC_NO_ERROR) return false;
+
+    bool passed = true;
+    {
+      /* the quantized BVH has to report the same hits as the default one */
+      RTCSceneRef scene0 = rtcDeviceNewScene(g_device,RTC_SCENE_STATIC,aflags);
+      addSphere(scene0,RTC_GEOMETRY_STATIC,Vec3fa(-1,0,-1),1.0f,100);
+      addSphere(scene0,RTC_GEOMETRY_STATIC,Vec3fa(+1,0,+1),0.01f,10);
+      rtcCommit (scene0);
+
+      RTCSceneRef scene1 = rtcDeviceNewScene(device,RTC_SCENE_STATIC,aflags);
+      addSphere(scene1,RTC_GEOMETRY_STATIC,Vec3fa(-1,0,-1),1.0f,100);
+      addSphere(scene1,RTC_GEOMETRY_STATIC,Vec3fa(+1,0,+1),0.01f,10);
+      rtcCommit (scene1);
+      passed &= rtcDeviceGetError(device) == RTC_NO_ERROR;
+
+      for (size_t i=0; i<1000; i++) 
+      {
+        RTCRay rays[4];
+        for (size_t j=0; j<4; j++) {
+          Vec3fa org(2.0f*drand48()-1.0f,2.0f*drand48()-1.0f,2.0f*drand48()-1.0f);
+          Vec3fa dir(2.0f*drand48()-1.0f,2.0f*drand48()-1.0f,2.0f*drand48()-1.0f);
+          rays[j] = makeRay(4.0f*org,dir);
+          RTCRay ray0 = rays[j]; rtcIntersect(scene0,ray0);
+          RTCRay ray1 = rays[j]; rtcIntersect(scene1,ray1);
+          passed &= ray0.geomID == ray1.geomID;
+          passed &= ray0.tfar == ray1.tfar;
+        }
+
+#if HAS_INTERSECT4
+        RTCRay4 ray4_0; memset(&ray4_0,0,sizeof(ray4_0));
+        RTCRay4 ray4_1; memset(&ray4_1,0,sizeof(ray4_1));
+        for (size_t j=0; j<4; j++) {
+          setRay(ray4_0,j,rays[j]);
+          setRay(ray4_1,j,rays[j]);
+        }
+        __aligned(16) int valid4[4] = { -1,-1,-1,-1 };
+        rtcIntersect4(valid4,scene0,ray4_0);
+        rtcIntersect4(valid4,scene1,ray4_1);
+        for (size_t j=0; j<4; j++) {
+          passed &= ray4_0.geomID[j] == ray4_1.geomID[j];
+          passed &= ray4_0.tfar[j] == ray4_1.tfar[j];
+        }
+#endif
+      }
+    }
+
+    rtcDeleteDevice(device);
+    return passed;
+  }
+
+  bool rtcore_motion_blur_multi_segment(const size_t numTimeSteps)
+  {
+    /* square that moves back and forth between x=0 and x=4 in each time segment */
+    auto offset = [&] (float time) -> float {
+      const float t = time*float(numTimeSteps-1);
+      const float itime = min(floorf(t),float(numTimeSteps-2));
+      const float x0 = (size_t(itime)%2) ? 4.0f : 0.0f;
+      return x0 + (t-itime)*(4.0f-2.0f*x0);
+    };
+
+    RTCSceneRef scene = rtcDeviceNewScene(g_device,RTC_SCENE_STATIC,aflags);
+    unsigned tris  = rtcNewTriangleMesh(scene,RTC_GEOMETRY_STATIC,2,4,numTimeSteps);
+    unsigned quads = rtcNewQuadMesh    (scene,RTC_GEOMETRY_STATIC,1,4,numTimeSteps);
+    unsigned lines = rtcNewLineSegments(scene,RTC_GEOMETRY_STATIC,1,2,numTimeSteps);
+    AssertNoError();
+
+    for (size_t t=0; t<numTimeSteps; t++) 
+    {
+      const float x = offset(float(t)/float(numTimeSteps-1));
+      Vec3fa* vt = (Vec3fa*) rtcMapBuffer(scene,tris,(RTCBufferType)(RTC_VERTEX_BUFFER0+t));
+      vt[0] = Vec3fa(x+0.0f,0.0f,0.0f); vt[1] = Vec3fa(x+1.0f,0.0f,0.0f);
+      vt[2] = Vec3fa(x+1.0f,1.0f,0.0f); vt[3] = Vec3fa(x+0.0f,1.0f,0.0f);
+      rtcUnmapBuffer(scene,tris,(RTCBufferType)(RTC_VERTEX_BUFFER0+t));
+      Vec3fa* vq = (Vec3fa*) rtcMapBuffer(scene,quads,(RTCBufferType)(RTC_VERTEX_BUFFER0+t));
+      vq[0] = Vec3fa(x+0.0f,2.0f,0.0f); vq[1] = Vec3fa(x+1.0f,2.0f,0.0f);
+      vq[2] = Vec3fa(x+1.0f,3.0f,0.0f); vq[3] = Vec3fa(x+0.0f,3.0f,0.0f);
+      rtcUnmapBuffer(scene,quads,(RTCBufferType)(RTC_VERTEX_BUFFER0+t));
+      Vec3fa* vl = (Vec3fa*) rtcMapBuffer(scene,lines,(RTCBufferType)(RTC_VERTEX_BUFFER0+t));
+      vl[0] = Vec3fa(x+0.5f,4.0f,0.0f,0.25f); vl[1] = Vec3fa(x+0.5f,5.0f,0.0f,0.25f);
+      rtcUnmapBuffer(scene,lines,(RTCBufferType)(RTC_VERTEX_BUFFER0+t));
+    }
+    int* triangles = (int*) rtcMapBuffer(scene,tris,RTC_INDEX_BUFFER);
+    triangles[0] = 0; triangles[1] = 1; triangles[2] = 2;
+    triangles[3] = 0; triangles[4] = 2; triangles[5] = 3;
+    rtcUnmapBuffer(scene,tris,RTC_INDEX_BUFFER);
+    int* quad = (int*) rtcMapBuffer(scene,quads,RTC_INDEX_BUFFER);
+    quad[0] = 0; quad[1] = 1; quad[2] = 2; quad[3] = 3;
+    rtcUnmapBuffer(scene,quads,RTC_INDEX_BUFFER);
+    int* segment = (int*) rtcMapBuffer(scene,lines,RTC_INDEX_BUFFER);
+    segment[0] = 0;
+    rtcUnmapBuffer(scene,lines,RTC_INDEX_BUFFER);
+    rtcCommit (scene);
+    AssertNoError();
+
+    /* rays towards the center of each object have to hit, rays next to it have to miss */
+    const unsigned geomIDs[3] = { tris, quads, lines };
+    bool passed = true;
+    for (size_t i=0; i<256; i++) 
+    {
+      RTCRay rays[4];
+      for (size_t j=0; j<4; j++) {
+        const float time = (i%64 == 0) ? float(j)/float(numTimeSteps-1) : float(drand48());
+        const size_t k = (i+j)%3;
+        const float x = offset(time) + ((j == 3) ? 2.0f : 0.5f);
+        rays[j] = makeRay(Vec3fa(x,2.0f*k+0.5f,-1.0f),Vec3fa(0,0,1));
+        rays[j].time = time;
+        RTCRay ray = rays[j]; rtcIntersect(scene,ray);
+        passed &= ray.geomID == ((j == 3) ? RTC_INVALID_GEOMETRY_ID : geomIDs[k]);
+      }
+
+#if HAS_INTERSECT4
+      RTCRay4 ray4; memset(&ray4,0,sizeof(ray4));
+      for (size_t j=0; j<4; j++) setRay(ray4,j,rays[j]);
+      __aligned(16) int valid4[4] = { -1,-1,-1,-1 };
+      rtcIntersect4(valid4,scene,ray4);
+      for (size_t j=0; j<4; j++) 
+        passed &= ray4.geomID[j] == ((j == 3) ? RTC_INVALID_GEOMETRY_ID : geomIDs[(i+j)%3]);
+#endif
+    }
+    return passed;
+  }
+
+  bool rtcore_commit_async()
+  {
+    ClearBuffers clear_before_return;
+
+    /* double buffered scenes: build the next scene while tracing against the current one */
+    RTCSceneRef scene[2] = { rtcDeviceNewScene(g_device,RTC_SCENE_STATIC,aflags), nullptr };
+    AssertNoError();
+    if (addSphere(scene[0],RTC_GEOMETRY_STATIC,Vec3fa(0,0,0),1.0f,50) != 0) return false;
+    rtcCommit (scene[0]);
+    AssertNoError();
+
+    for (size_t i=1; i<8; i++)
+    {
+      RTCSceneRef& cur  = scene[(i+1)%2];
+      RTCSceneRef& next = scene[i%2];
+      next = rtcDeviceNewScene(g_device,RTC_SCENE_STATIC,aflags);
+      if (addSphere(next,RTC_GEOMETRY_STATIC,Vec3fa(4.0f*float(i),0,0),1.0f,200) != 0) return false;
+      rtcCommitAsync (next);
+      AssertNoError();
+
+      /* the previously committed scene stays usable during the asynchronous build */
+      for (size_t j=0; j<64; j++) {
+        RTCRay ray = makeRay(Vec3fa(4.0f*float(i-1),0,-2),Vec3fa(0,0,1));
+        rtcIntersect(cur,ray);
+        if (ray.geomID != 0) return false;
+      }
+
+      rtcWaitCommit (next);
+      AssertNoError();
+      if (!rtcIsCommitted(next)) return false;
+      RTCRay ray = makeRay(Vec3fa(4.0f*float(i),0,-2),Vec3fa(0,0,1));
+      rtcIntersect(next,ray);
+      if (ray.geomID != 0) return false;
+    }
+
+    /* errors of the asynchronous build get reported by rtcWaitCommit */
+    RTCSceneRef scene2 = rtcDeviceNewScene(g_device,RTC_SCENE_STATIC,aflags);
+    unsigned geom = addSphere(scene2,RTC_GEOMETRY_STATIC,zero,1.0f,50);
+    AssertNoError();
+    rtcMapBuffer(scene2,geom,RTC_VERTEX_BUFFER);
+    rtcCommitAsync (scene2);
+    AssertNoError();
+    rtcWaitCommit (scene2);
+    AssertError(RTC_INVALID_OPERATION); // error, buffers still mapped
+    rtcUnmapBuffer(scene2,geom,RTC_VERTEX_BUFFER);
+
+    /* deleting a scene waits for its asynchronous build */
+    rtcCommitAsync (scene2);
+    scene2 = nullptr;
+    AssertNoError();
+    return true;
+  }
+
+  bool rtcore_traversal_statistics()
+  {
+    ClearBuffers clear_before_return;
+    RTCSceneRef scene = rtcDeviceNewScene(g_device,RTC_SCENE_STATIC,aflags);
+    AssertNoError();
+    addSphere(scene,RTC_GEOMETRY_STATIC,zero,1.0f,50);
+    rtcCommit (scene);
+    AssertNoError();
+
+    /* nothing gets counted when statistics are disabled */
+    rtcDeviceResetTraversalStatistics(g_device);
+    RTCRay ray0 = makeRay(Vec3fa(0,0,-2),Vec3fa(0,0,1)); rtcIntersect(scene,ray0);
+    RTCTraversalStatistics intersect, occluded;
+    rtcDeviceGetTraversalStatistics(g_device,&intersect,&occluded);
+    AssertNoError();
+    if (intersect.rays != 0 || occluded.rays != 0) return false;
+
+    rtcDeviceSetParameter1i(g_device,RTC_TRAVERSAL_STATISTICS,1);
+    AssertNoError();
+    RTCTraversalStatistics t0, t1;
+    rtcGetThreadTraversalStatistics(&t0,nullptr);
+    RTCRay ray1 = makeRay(Vec3fa(0,0,-2),Vec3fa(0,0,1)); rtcIntersect(scene,ray1);
+    rtcGetThreadTraversalStatistics(&t1,nullptr);
+    RTCRay ray2 = makeRay(Vec3fa(0,0,-2),Vec3fa(0,0,1)); rtcOccluded(scene,ray2);
+    rtcDeviceGetTraversalStatistics(g_device,&intersect,&occluded);
+    rtcDeviceSetParameter1i(g_device,RTC_TRAVERSAL_STATISTICS,0);
+    AssertNoError();
+
+    /* the per thread difference gives the cost of a single ray */
+    bool passed = ray1.geomID == 0 && ray2.geomID == 0;
+    passed &= t1.rays-t0.rays == 1 && t1.prims > t0.prims;
+    passed &= intersect.rays == 1 && intersect.leaves >= 1 && intersect.prims >= 1;
+    passed &= occluded.rays  == 1 && occluded.leaves  >= 1 && occluded.prims  >= 1;
+
+    rtcDeviceResetTraversalStatistics(g_device);
+    rtcDeviceGetTraversalStatistics(g_device,&intersect,nullptr);
+    passed &= intersect.rays == 0 && intersect.prims == 0;
+    return passed;
+  }
+
+  struct PointQueryCandidates
+  {
+    size_t num;
+    unsigned geomID;
+    bool passed;
+  };
+
+  void countPointQueryCandidates(void* userPtr, RTCPointQuery& query, const RTCClosestPoint& candidate)
+  {
+    PointQueryCandidates* c = (PointQueryCandidates*) userPtr;
+    c->num++;
+    c->passed &= candidate.geomID == c->geomID && candidate.distance <= query.radius;
+  }
+
+  bool rtcore_point_query(RTCSceneFlags sflags)
+  {
+    ClearBuffers clear_before_return;
+    RTCSceneRef scene = rtcDeviceNewScene(g_device,sflags,(RTCAlgorithmFlags)(aflags | RTC_POINT_QUERY));
+    AssertNoError();
+    const Vec3fa pos0(-2,0,0), pos1(+2,0,0);
+    unsigned geom0 = addSphere(scene,RTC_GEOMETRY_STATIC,pos0,1.0f,50);
+    unsigned geom1 = addSphere(scene,RTC_GEOMETRY_STATIC,pos1,1.0f,50);
+    rtcCommit (scene);
+    AssertNoError();
+
+    /* the closest point has to lie on the nearest sphere */
+    bool passed = true;
+    for (size_t i=0; i<100; i++)
+    {
+      const Vec3fa p = 8.0f*Vec3fa(drand48()-0.5f,drand48()-0.5f,drand48()-0.5f);
+      RTCPointQuery query; 
+      query.p[0] = p.x; query.p[1] = p.y; query.p[2] = p.z; query.radius = inf;
+      RTCClosestPoint result;
+      rtcClosestPoint(scene,query,result);
+      AssertNoError();
+
+      const float d0 = length(p-pos0)-1.0f, d1 = length(p-pos1)-1.0f;
+      const Vec3fa q(result.p[0],result.p[1],result.p[2]);
+      passed &= result.geomID == (d0 < d1 ? geom0 : geom1);
+      passed &= fabs(result.distance-min(fabs(d0),fabs(d1))) < 0.01f;
+      passed &= fabs(result.distance-length(q-p)) < 1E-4f;
+    }
+
+    /* nothing is found outside the search radius */
+    RTCPointQuery query; 
+    query.p[0] = 0.0f; query.p[1] = 4.0f; query.p[2] = 0.0f; query.radius = 1.0f;
+    RTCClosestPoint result;
+    rtcClosestPoint(scene,query,result);
+    AssertNoError();
+    passed &= result.geomID == RTC_INVALID_GEOMETRY_ID;
+
+    /* radius query around the center of one sphere reports only its triangles */
+    PointQueryCandidates candidates = { 0, geom0, true };
+    query.p[0] = pos0.x; query.p[1] = pos0.y; query.p[2] = pos0.z; query.radius = 1.5f;
+    rtcPointQuery(scene,query,countPointQueryCandidates,&candidates);
+    AssertNoError();
+    passed &= candidates.passed && candidates.num > 0;
+    return passed;
+  }
+
+  bool rtcore_point_query_points(RTCSceneFlags sflags)
+  {
+    ClearBuffers clear_before_return;
+    RTCSceneRef scene = rtcDeviceNewScene(g_device,sflags,(RTCAlgorithmFlags)(aflags | RTC_POINT_QUERY));
+    AssertNoError();
+    const size_t numPoints = 100;
+    std::vector<Vec3fa> points(numPoints);
+    unsigned geomID = rtcNewPoints(scene,RTC_GEOMETRY_STATIC,numPoints);
+    Vec3fa* vertices = (Vec3fa*) rtcMapBuffer(scene,geomID,RTC_VERTEX_BUFFER);
+    for (size_t i=0; i<numPoints; i++) {
+      points[i] = Vec3fa(8.0f*drand48()-4.0f,8.0f*drand48()-4.0f,8.0f*drand48()-4.0f);
+      points[i].w = 0.1f;
+      vertices[i] = points[i];
+    }
+    rtcUnmapBuffer(scene,geomID,RTC_VERTEX_BUFFER);
+    rtcCommit (scene);
+    AssertNoError();
+
+    /* the closest point has to lie on the surface of the nearest point */
+    bool passed = true;
+    for (size_t i=0; i<100; i++)
+    {
+      const Vec3fa p(8.0f*drand48()-4.0f,8.0f*drand48()-4.0f,8.0f*drand48()-4.0f);
+      size_t nearest = 0;
+      for (size_t j=1; j<numPoints; j++)
+        if (length(p-points[j]) < length(p-points[nearest])) nearest = j;
+      
+      RTCPointQuery query; 
+      query.p[0] = p.x; query.p[1] = p.y; query.p[2] = p.z; query.radius = inf;
+      RTCClosestPoint result;
+      rtcClosestPoint(scene,query,result);
+      AssertNoError();
+      passed &= result.geomID == geomID && result.primID == nearest;
+      passed &= fabs(result.distance-fabs(length(p-points[nearest])-0.1f)) < 1E-4f;
+    }
+    return passed;
+  }
+
   bool rtcore_new_delete_geometry()
   {
     ClearBuffers clear_before_return;
@@ -3455,6 +4592,69 @@ namespace embree
     return passed;
   }
   
+  bool checkInterpolationN(const RTCSceneRef& scene, int geomID, size_t numPrims, RTCBufferType buffer, size_t N)
+  {
+    const size_t numUVs = 19;
+    int valid[numUVs]; unsigned primIDs[numUVs]; float u[numUVs], v[numUVs];
+    for (size_t i=0; i<numUVs; i++) {
+      valid[i] = (i%5 == 3) ? 0 : -1;
+      primIDs[i] = (7*i) % numPrims;
+      u[i] = 0.5f*drand48();
+      v[i] = 0.5f*drand48();
+    }
+
+    std::vector<float> P(N*numUVs,-1.0f), dPdu(N*numUVs,-1.0f), dPdv(N*numUVs,-1.0f);
+    rtcInterpolateN(scene,geomID,valid,primIDs,u,v,numUVs,buffer,P.data(),dPdu.data(),dPdv.data(),N);
+    
+    bool passed = true;
+    for (size_t i=0; i<numUVs; i++)
+    {
+      float P1[256], dPdu1[256], dPdv1[256];
+      rtcInterpolate(scene,geomID,primIDs[i],u[i],v[i],buffer,P1,dPdu1,dPdv1,N);
+      for (size_t j=0; j<N; j++) {
+        if (!valid[i]) {
+          passed &= P[j*numUVs+i] == -1.0f;
+          continue;
+        }
+        passed &= fabs(P[j*numUVs+i]-P1[j]) < 1E-4f;
+        passed &= fabs(dPdu[j*numUVs+i]-dPdu1[j]) < 1E-4f;
+        passed &= fabs(dPdv[j*numUVs+i]-dPdv1[j]) < 1E-4f;
+      }
+    }
+    return passed;
+  }
+
+  bool rtcore_interpolateN(size_t N)
+  {
+    size_t M = num_interpolation_vertices*N+16; // padds the arrays with some valid data
+
+    RTCSceneRef scene = rtcDeviceNewScene(g_device,RTC_SCENE_DYNAMIC,RTC_INTERPOLATE);
+    AssertNoError();
+    unsigned int triID = rtcNewTriangleMesh(scene, RTC_GEOMETRY_STATIC, num_interpolation_triangle_faces, num_interpolation_vertices, 1);
+    rtcSetBuffer(scene, triID, RTC_INDEX_BUFFER,  interpolation_triangle_indices , 0, 3*sizeof(unsigned int));
+    unsigned int quadID = rtcNewQuadMesh(scene, RTC_GEOMETRY_STATIC, num_interpolation_quad_faces, num_interpolation_vertices, 1);
+    rtcSetBuffer(scene, quadID, RTC_INDEX_BUFFER,  interpolation_quad_indices , 0, 4*sizeof(unsigned int));
+    AssertNoError();
+
+    float* vertices0 = new float[M];
+    for (size_t i=0; i<M; i++) vertices0[i] = drand48();
+    rtcSetBuffer(scene, triID,  RTC_USER_VERTEX_BUFFER0, vertices0, 0, N*sizeof(float));
+    rtcSetBuffer(scene, quadID, RTC_USER_VERTEX_BUFFER0, vertices0, 0, N*sizeof(float));
+    AssertNoError();
+
+    rtcDisable(scene,triID);
+    rtcDisable(scene,quadID);
+    rtcCommit(scene);
+    AssertNoError();
+
+    bool passed = true;
+    passed &= checkInterpolationN(scene,triID,num_interpolation_triangle_faces,RTC_USER_VERTEX_BUFFER0,N);
+    passed &= checkInterpolationN(scene,quadID,num_interpolation_quad_faces,RTC_USER_VERTEX_BUFFER0,N);
+
+    delete[] vertices0;
+    return passed;
+  }
+  
   const size_t num_interpolation_hair_vertices = 13;
   const size_t num_interpolation_hairs = 4;
 
@@ -3628,6 +4828,45 @@ namespace embree
     return distance < 0.0002f;
   }
 
+  bool checkPinningOrder(ThreadAffinity affinity, const std::vector<CPULocation>& topology, const size_t* expected)
+  {
+    std::vector<CPULocation> order = getThreadPinningOrder(affinity,topology);
+    if (order.size() != topology.size()) return false;
+    for (size_t i=0; i<order.size(); i++)
+      if (order[i].cpu != expected[i]) return false;
+    return true;
+  }
+
+  bool rtcore_thread_pinning_order()
+  {
+    /* 2 sockets with 2 cores and 2 SMT threads each, numbered like Linux
+     * does, thus the SMT siblings of logical threads 0-3 are 4-7 */
+    std::vector<CPULocation> topology(8);
+    for (size_t i=0; i<8; i++) {
+      topology[i].cpu = i;
+      topology[i].core = i%4;
+      topology[i].socket = (i%4)/2;
+    }
+
+    const size_t linear [8] = { 0,1,2,3,4,5,6,7 };
+    const size_t compact[8] = { 0,4,1,5,2,6,3,7 };
+    const size_t scatter[8] = { 0,2,1,3,4,6,5,7 };
+    const size_t socket [8] = { 0,1,4,5,2,3,6,7 };
+
+    bool passed = true;
+    passed &= checkPinningOrder(AFFINITY_LINEAR ,topology,linear);
+    passed &= checkPinningOrder(AFFINITY_COMPACT,topology,compact);
+    passed &= checkPinningOrder(AFFINITY_SCATTER,topology,scatter);
+    passed &= checkPinningOrder(AFFINITY_SOCKET ,topology,socket);
+
+    /* linear pinning has to pin thread i to logical thread i like set_affinity did */
+    std::vector<CPULocation> order = getThreadPinningOrder(AFFINITY_LINEAR);
+    passed &= order.size() == getNumberOfLogicalThreads();
+    for (size_t i=0; i<order.size(); i++)
+      passed &= order[i].cpu == i;
+    return passed;
+  }
+
   /* main function in embree namespace */
   int main(int argc, char** argv) 
   {
@@ -3662,6 +4901,7 @@ namespace embree
     POSITIVE("empty_static",              rtcore_empty(RTC_SCENE_STATIC));
     POSITIVE("empty_dynamic",             rtcore_empty(RTC_SCENE_DYNAMIC));
     POSITIVE("bary_distance_robust",      rtcore_bary_distance_robust());
+    POSITIVE("thread_pinning_order",      rtcore_thread_pinning_order());
     
     POSITIVE("flags_static_static",       rtcore_dynamic_flag(RTC_SCENE_STATIC, RTC_GEOMETRY_STATIC));
     NEGATIVE("flags_static_deformable",   rtcore_dynamic_flag(RTC_SCENE_STATIC, RTC_GEOMETRY_DEFORMABLE));
@@ -3682,6 +4922,33 @@ namespace embree
 
     POSITIVE("update_deformable",         rtcore_update(RTC_GEOMETRY_DEFORMABLE));
     POSITIVE("update_dynamic",            rtcore_update(RTC_GEOMETRY_DYNAMIC));
+    POSITIVE("update_range",              rtcore_update_range());
+    POSITIVE("refit_quality",             rtcore_refit_quality());
+    POSITIVE("morton_optimized",          rtcore_morton_optimized());
+#if defined(__TARGET_AVX512KNL__) || defined(__TARGET_AVX512SKX__)
+    if (hasISA(AVX512KNL) || hasISA(AVX512SKX)) {
+      POSITIVE("bvh16_triangle4",         rtcore_bvh16_triangle4());
+    }
+#endif
+    POSITIVE("filter_mask_switch",        rtcore_filter_mask_switch());
+    POSITIVE("scene_statistics",          rtcore_scene_statistics());
+    POSITIVE("tessellation_cache_budget", rtcore_tessellation_cache_budget());
+    POSITIVE("geometry_instance_1",       rtcore_geometry_instance(1));
+#if HAS_INTERSECT4
+    POSITIVE("geometry_instance_4",       rtcore_geometry_instance(4));
+#endif
+#if HAS_INTERSECT8
+    if (hasISA(AVX)) {
+      POSITIVE("geometry_instance_8",     rtcore_geometry_instance(8));
+    }
+#endif
+#if HAS_INTERSECT16
+    if (hasISA(AVX512KNL) || hasISA(KNC)) {
+      POSITIVE("geometry_instance_16",    rtcore_geometry_instance(16));
+    }
+#endif
+    POSITIVE("update_many_deformable",    rtcore_update_many(RTC_GEOMETRY_DEFORMABLE));
+    POSITIVE("update_many_dynamic",       rtcore_update_many(RTC_GEOMETRY_DYNAMIC));
     POSITIVE("overlapping_triangles",     rtcore_overlapping_triangles(100000));
     POSITIVE("overlapping_hair",          rtcore_overlapping_hair(100000));
     POSITIVE("new_delete_geometry",       rtcore_new_delete_geometry());
@@ -3700,6 +4967,10 @@ namespace embree
     POSITIVE("interpolate_triangles12",               rtcore_interpolate_triangles(12));
     POSITIVE("interpolate_triangles15",               rtcore_interpolate_triangles(15));
 
+    POSITIVE("interpolateN_4",                   rtcore_interpolateN(4));
+    POSITIVE("interpolateN_7",                   rtcore_interpolateN(7));
+    POSITIVE("interpolateN_12",                  rtcore_interpolateN(12));
+
     POSITIVE("interpolate_hair4",                rtcore_interpolate_hair(4));
     POSITIVE("interpolate_hair5",                rtcore_interpolate_hair(5));
     POSITIVE("interpolate_hair8",                rtcore_interpolate_hair(8));
@@ -3728,6 +4999,36 @@ namespace embree
 
     rtcore_packet_write_test_all();
 
+#if defined(RTCORE_RAY_PACKETS) && !defined(__MIC__)
+    rtcore_ray_stream_all();
+    POSITIVE("ray_sorting",               rtcore_ray_sorting());
+#endif
+
+#if !defined(__WIN32__)
+    POSITIVE("bvh_cache",                 rtcore_bvh_cache());
+    POSITIVE("subdiv_grid_cache",         rtcore_subdiv_grid_cache());
+    POSITIVE("out_of_core",               rtcore_out_of_core());
+#endif
+
+    POSITIVE("build_memory",              rtcore_build_memory());
+
+#if !defined(__MIC__)
+    POSITIVE("quantized_bvh4",            rtcore_quantized_bvh("bvh4q.triangle4"));
+    if (hasISA(AVX)) {
+      POSITIVE("quantized_bvh8",          rtcore_quantized_bvh("bvh8q.triangle4"));
+    }
+#endif
+
+    POSITIVE("motion_blur_3_time_steps",   rtcore_motion_blur_multi_segment(3));
+    POSITIVE("motion_blur_8_time_steps",   rtcore_motion_blur_multi_segment(8));
+    POSITIVE("motion_blur_129_time_steps", rtcore_motion_blur_multi_segment(129));
+    POSITIVE("commit_async",               rtcore_commit_async());
+    POSITIVE("traversal_statistics",       rtcore_traversal_statistics());
+    POSITIVE("point_query_static",         rtcore_point_query(RTC_SCENE_STATIC));
+    POSITIVE("point_query_dynamic",        rtcore_point_query(RTC_SCENE_DYNAMIC));
+    POSITIVE("point_query_points_static",  rtcore_point_query_points(RTC_SCENE_STATIC));
+    POSITIVE("point_query_points_dynamic", rtcore_point_query_points(RTC_SCENE_DYNAMIC));
+
     rtcore_watertight_closed1("sphere", pos);
     rtcore_watertight_closed1("cube",pos);
     rtcore_watertight_plane1(100000);
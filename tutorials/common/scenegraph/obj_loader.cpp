@@ -16,6 +16,8 @@
 
 #include "obj_loader.h"
 #include "texture.h"
+#include "../../../common/sys/thread.h"
+#include "../../../common/sys/sysinfo.h"
 
 namespace embree
 {
@@ -98,73 +100,99 @@ namespace embree
     return Vec3f(x,y,z);
   }
 
-  class OBJLoader
+  /*! handles relative indices and starts indexing from 0, 'count' is the number of elements parsed so far */
+  static inline int fixIndex(int index, size_t count) {
+    return (index > 0 ? index - 1 : (index == 0 ? 0 : (int) count + index));
+  }
+
+  /*! Parse differently formated triplets like: n0, n0/n1/n2, n0//n2, n0/n1.          */
+  /*! Indices are kept as in the file, missing entries are assigned 0. */
+  static Vertex getInt3(const char*& token)
   {
-  public:
+    Vertex v(0);
+    v.v = atoi(token);
+    token += strcspn(token, "/ \t\r");
+    if (token[0] != '/') return(v);
+    token++;
 
-    /*! Constructor. */
-    OBJLoader(const FileName& fileName, const bool subdivMode);
- 
-    /*! output model */
-    Ref<SceneGraph::GroupNode> group;
-  
-  private:
+    // it is i//n
+    if (token[0] == '/') {
+      token++;
+      v.vn = atoi(token);
+      token += strcspn(token, " \t\r");
+      return(v);
+    }
 
-    /*! file to load */
-    FileName path;
-  
-    /*! load only quads and ignore triangles */
-    bool subdivMode;
+    // it is i/t/n or i/t
+    v.vt = atoi(token);
+    token += strcspn(token, "/ \t\r");
+    if (token[0] != '/') return(v);
+    token++;
 
-    /*! Geometry buffer. */
-    avector<Vec3fa> v;
-    avector<Vec3fa> vn;
-    std::vector<Vec2f> vt;
-    std::vector<Crease> ec;
+    // it is i/t/n
+    v.vn = atoi(token);
+    token += strcspn(token, " \t\r");
+    return(v);
+  }
 
-    std::vector<std::vector<Vertex> > curGroup;
+  /*! Part of an OBJ file that gets parsed independently of the other
+   *  parts. Vertex data is stored per chunk, while faces, creases
+   *  and material statements are recorded in file order to get
+   *  resolved sequentially once all chunks are parsed. */
+  struct OBJChunk
+  {
+    enum Type { FACE, CREASE, USEMTL, MTLLIB };
 
-    /*! Material handling. */
-    Ref<SceneGraph::MaterialNode> curMaterial;
-    std::map<std::string, Ref<SceneGraph::MaterialNode> > material;
+    /*! recorded statement together with the number of elements the chunk parsed before it */
+    struct Command 
+    {
+      Command (Type type, size_t ofs, size_t num, size_t nv, size_t nvt, size_t nvn)
+        : type(type), ofs(ofs), num(num), nv(nv), nvt(nvt), nvn(nvn) {}
 
-  private:
-    void loadMTL(const FileName& fileName);
-    int fix_v (int index);
-    int fix_vt(int index);
-    int fix_vn(int index);
-    void flushFaceGroup();
-    Vertex getInt3(const char*& token);
-    uint32_t getVertex(std::map<Vertex,uint32_t>& vertexMap, Ref<SceneGraph::TriangleMeshNode> mesh, const Vertex& i);
-  };
+      Type type;
+      size_t ofs, num;
+      size_t nv, nvt, nvn;
+    };
 
-  OBJLoader::OBJLoader(const FileName &fileName, const bool subdivMode) 
-    : path(fileName.path()), group(new SceneGraph::GroupNode), subdivMode(subdivMode)
-  {
-    /* open file */
-    std::ifstream cin;
-    cin.open(fileName.c_str());
-    if (!cin.is_open()) {
-      THROW_RUNTIME_ERROR("cannot open " + fileName.str());
-      return;
-    }
+    OBJChunk () : begin(nullptr), end(nullptr) {}
 
-    /* generate default material */
-    Material objmtl; new (&objmtl) OBJMaterial;
-    Ref<SceneGraph::MaterialNode> defaultMaterial = new SceneGraph::MaterialNode(objmtl);
-    curMaterial = defaultMaterial;
+    /*! parses all lines of the chunk */
+    void parse();
 
+    /*! thread entry point */
+    static void parseThread(void* ptr);
+
+  public:
+    const char* begin;            //!< first character of the chunk
+    const char* end;              //!< end of the chunk
+    avector<Vec3fa> v;            //!< positions of the chunk
+    avector<Vec3fa> vn;           //!< normals of the chunk
+    std::vector<Vec2f> vt;        //!< texture coordinates of the chunk
+    std::vector<Vertex> faces;    //!< unresolved vertex indices of all faces
+    std::vector<Crease> ec;       //!< unresolved edge creases
+    std::vector<std::string> names; //!< material and material library names
+    std::vector<Command> commands;  //!< statements in file order
+    std::string error;            //!< error message if parsing failed
+  };
+
+  void OBJChunk::parse()
+  {
     char line[10000];
     memset(line, 0, sizeof(line));
 
-    while (cin.peek() != -1)
+    const char* cur = begin;
+    while (cur < end)
     {
       /* load next multiline */
       char* pline = line;
       while (true) {
-        cin.getline(pline, sizeof(line) - (pline - line) - 16, '\n');
+        const char* eol = (const char*) memchr(cur, '\n', end-cur);
+        if (eol == nullptr) eol = end;
+        size_t len = min(size_t(eol-cur), sizeof(line) - (pline - line) - 16);
+        memcpy(pline, cur, len); pline[len] = 0;
+        cur = eol < end ? eol+1 : end;
         ssize_t last = strlen(pline) - 1;
-        if (last < 0 || pline[last] != '\\') break;
+        if (last < 0 || pline[last] != '\\' || cur >= end) break;
         pline += last;
         *pline++ = ' ';
       }
@@ -191,51 +219,195 @@ namespace embree
       {
         parseSep(token += 1);
 
-        std::vector<Vertex> face;
+        const size_t ofs = faces.size();
         while (token[0]) {
-	  Vertex vtx = getInt3(token);
-          face.push_back(vtx);
+          faces.push_back(getInt3(token));
           parseSepOpt(token);
         }
-        curGroup.push_back(face);
+        commands.push_back(Command(FACE,ofs,faces.size()-ofs,v.size(),vt.size(),vn.size()));
         continue;
       }
 
       /*! parse edge crease */
       if (token[0] == 'e' && token[1] == 'c' && isSep(token[2]))
       {
-	parseSep(token += 2);
-	float w = getFloat(token);
-	parseSepOpt(token);
-	int a = fix_v(getInt(token));
-	parseSepOpt(token);
-	int b = fix_v(getInt(token));
-	parseSepOpt(token);
-	ec.push_back(Crease(w, a, b));
-	continue;
+        parseSep(token += 2);
+        float w = getFloat(token);
+        parseSepOpt(token);
+        int a = getInt(token);
+        parseSepOpt(token);
+        int b = getInt(token);
+        parseSepOpt(token);
+        commands.push_back(Command(CREASE,ec.size(),1,v.size(),vt.size(),vn.size()));
+        ec.push_back(Crease(w, a, b));
+        continue;
       }
 
       /*! use material */
       if (!strncmp(token, "usemtl", 6) && isSep(token[6]))
       {
-        flushFaceGroup();
-        std::string name(parseSep(token += 6));
-        if (material.find(name) == material.end()) curMaterial = defaultMaterial;
-        else curMaterial = material[name];
+        commands.push_back(Command(USEMTL,names.size(),1,v.size(),vt.size(),vn.size()));
+        names.push_back(std::string(parseSep(token += 6)));
         continue;
       }
 
       /* load material library */
       if (!strncmp(token, "mtllib", 6) && isSep(token[6])) {
-        loadMTL(path + std::string(parseSep(token += 6)));
+        commands.push_back(Command(MTLLIB,names.size(),1,v.size(),vt.size(),vn.size()));
+        names.push_back(std::string(parseSep(token += 6)));
         continue;
       }
 
       // ignore unknown stuff
     }
-    flushFaceGroup();
+  }
 
-    cin.close();
+  void OBJChunk::parseThread(void* ptr) 
+  {
+    OBJChunk* chunk = (OBJChunk*) ptr;
+    try {
+      chunk->parse();
+    } catch (const std::exception& e) {
+      chunk->error = e.what();
+    }
+  }
+
+  class OBJLoader
+  {
+  public:
+
+    /*! Constructor. */
+    OBJLoader(const FileName& fileName, const bool subdivMode);
+ 
+    /*! output model */
+    Ref<SceneGraph::GroupNode> group;
+  
+  private:
+
+    /*! file to load */
+    FileName path;
+  
+    /*! load only quads and ignore triangles */
+    bool subdivMode;
+
+    /*! Geometry buffer. */
+    avector<Vec3fa> v;
+    avector<Vec3fa> vn;
+    std::vector<Vec2f> vt;
+    std::vector<Crease> ec;
+
+    std::vector<std::vector<Vertex> > curGroup;
+
+    /*! Material handling. */
+    Ref<SceneGraph::MaterialNode> curMaterial;
+    std::map<std::string, Ref<SceneGraph::MaterialNode> > material;
+
+  private:
+    void loadMTL(const FileName& fileName);
+    void flushFaceGroup(size_t nv, size_t nvt, size_t nvn);
+    uint32_t getVertex(std::map<Vertex,uint32_t>& vertexMap, Ref<SceneGraph::TriangleMeshNode> mesh, const Vertex& i);
+  };
+
+  OBJLoader::OBJLoader(const FileName &fileName, const bool subdivMode) 
+    : path(fileName.path()), group(new SceneGraph::GroupNode), subdivMode(subdivMode)
+  {
+    /* map file into memory */
+    size_t bytes = 0;
+    const char* file = (const char*) os_map_file(fileName.c_str(),bytes);
+    if (!file) {
+      std::ifstream cin;
+      cin.open(fileName.c_str());
+      if (!cin.is_open()) {
+        THROW_RUNTIME_ERROR("cannot open " + fileName.str());
+        return;
+      }
+      bytes = 0; // empty file
+    }
+
+    /* generate default material */
+    Material objmtl; new (&objmtl) OBJMaterial;
+    Ref<SceneGraph::MaterialNode> defaultMaterial = new SceneGraph::MaterialNode(objmtl);
+    curMaterial = defaultMaterial;
+
+    /* split file into chunks of complete lines, a line ends at a newline that does not follow a backslash */
+    const size_t minChunkBytes = 1024*1024;
+    const size_t numChunks = max(size_t(1),min(size_t(getNumberOfLogicalThreads()),bytes/minChunkBytes));
+    std::vector<OBJChunk> chunks(numChunks);
+    for (size_t i=0; i<numChunks; i++) 
+    {
+      const char* begin = i == 0 ? file : chunks[i-1].end;
+      const char* end = file + (i+1)*bytes/numChunks;
+      if (end < begin) end = begin;
+      while (end < file+bytes && !(end > file && end[-1] == '\n' && (end-1 == file || end[-2] != '\\'))) end++;
+      chunks[i].begin = begin;
+      chunks[i].end = end;
+    }
+
+    /* parse all chunks in parallel */
+    std::vector<thread_t> threads;
+    for (size_t i=1; i<numChunks; i++)
+      threads.push_back(createThread(OBJChunk::parseThread,&chunks[i]));
+    OBJChunk::parseThread(&chunks[0]);
+    for (size_t i=0; i<threads.size(); i++)
+      join(threads[i]);
+    os_unmap_file((void*)file,bytes);
+
+    for (size_t i=0; i<numChunks; i++)
+      if (chunks[i].error != "") 
+        THROW_RUNTIME_ERROR(fileName.str() + ": " + chunks[i].error);
+
+    /* concatenate vertex data of all chunks */
+    size_t nv = 0, nvt = 0, nvn = 0;
+    for (size_t i=0; i<numChunks; i++) {
+      nv += chunks[i].v.size(); nvt += chunks[i].vt.size(); nvn += chunks[i].vn.size();
+    }
+    v.reserve(nv); vt.reserve(nvt); vn.reserve(nvn);
+    for (size_t i=0; i<numChunks; i++) {
+      for (size_t j=0; j<chunks[i].v .size(); j++) v .push_back(chunks[i].v [j]);
+      for (size_t j=0; j<chunks[i].vt.size(); j++) vt.push_back(chunks[i].vt[j]);
+      for (size_t j=0; j<chunks[i].vn.size(); j++) vn.push_back(chunks[i].vn[j]);
+    }
+
+    /* resolve statements in file order, relative indices refer to the elements parsed before the statement */
+    size_t base_v = 0, base_vt = 0, base_vn = 0;
+    for (size_t i=0; i<numChunks; i++)
+    {
+      const OBJChunk& chunk = chunks[i];
+      for (size_t c=0; c<chunk.commands.size(); c++)
+      {
+        const OBJChunk::Command& cmd = chunk.commands[c];
+        const size_t cv = base_v+cmd.nv, cvt = base_vt+cmd.nvt, cvn = base_vn+cmd.nvn;
+        switch (cmd.type) 
+        {
+        case OBJChunk::FACE: {
+          std::vector<Vertex> face(cmd.num);
+          for (size_t j=0; j<cmd.num; j++) {
+            const Vertex& vtx = chunk.faces[cmd.ofs+j];
+            face[j] = Vertex(fixIndex(vtx.v,cv), vtx.vt ? fixIndex(vtx.vt,cvt) : -1, vtx.vn ? fixIndex(vtx.vn,cvn) : -1);
+          }
+          curGroup.push_back(face);
+          break;
+        }
+        case OBJChunk::CREASE: {
+          const Crease& crease = chunk.ec[cmd.ofs];
+          ec.push_back(Crease(crease.w, fixIndex(crease.a,cv), fixIndex(crease.b,cv)));
+          break;
+        }
+        case OBJChunk::USEMTL: {
+          flushFaceGroup(cv,cvt,cvn);
+          const std::string& name = chunk.names[cmd.ofs];
+          if (material.find(name) == material.end()) curMaterial = defaultMaterial;
+          else curMaterial = material[name];
+          break;
+        }
+        case OBJChunk::MTLLIB: 
+          loadMTL(path + chunk.names[cmd.ofs]);
+          break;
+        }
+      }
+      base_v += chunk.v.size(); base_vt += chunk.vt.size(); base_vn += chunk.vn.size();
+    }
+    flushFaceGroup(v.size(),vt.size(),vn.size());
   }
 
   /* load material file */
@@ -314,41 +486,6 @@ namespace embree
     cin.close();
   }
 
-  /*! handles relative indices and starts indexing from 0 */
-  int OBJLoader::fix_v (int index) { return (index > 0 ? index - 1 : (index == 0 ? 0 : (int) v .size() + index)); }
-  int OBJLoader::fix_vt(int index) { return (index > 0 ? index - 1 : (index == 0 ? 0 : (int) vt.size() + index)); }
-  int OBJLoader::fix_vn(int index) { return (index > 0 ? index - 1 : (index == 0 ? 0 : (int) vn.size() + index)); }
-
-  /*! Parse differently formated triplets like: n0, n0/n1/n2, n0//n2, n0/n1.          */
-  /*! All indices are converted to C-style (from 0). Missing entries are assigned -1. */
-  Vertex OBJLoader::getInt3(const char*& token)
-  {
-    Vertex v(-1);
-    v.v = fix_v(atoi(token));
-    token += strcspn(token, "/ \t\r");
-    if (token[0] != '/') return(v);
-    token++;
-
-    // it is i//n
-    if (token[0] == '/') {
-      token++;
-      v.vn = fix_vn(atoi(token));
-      token += strcspn(token, " \t\r");
-      return(v);
-    }
-
-    // it is i/t/n or i/t
-    v.vt = fix_vt(atoi(token));
-    token += strcspn(token, "/ \t\r");
-    if (token[0] != '/') return(v);
-    token++;
-
-    // it is i/t/n
-    v.vn = fix_vn(atoi(token));
-    token += strcspn(token, " \t\r");
-    return(v);
-  }
-
   uint32_t OBJLoader::getVertex(std::map<Vertex,uint32_t>& vertexMap, Ref<SceneGraph::TriangleMeshNode> mesh, const Vertex& i)
   {
     const std::map<Vertex, uint32_t>::iterator& entry = vertexMap.find(i);
@@ -365,8 +502,8 @@ namespace embree
     return(vertexMap[i] = int(mesh->v.size()) - 1);
   }
 
-  /*! end current facegroup and append to mesh */
-  void OBJLoader::flushFaceGroup()
+  /*! end current facegroup and append to mesh, the group uses the first nv positions, nvt texture coordinates, and nvn normals */
+  void OBJLoader::flushFaceGroup(size_t nv, size_t nvt, size_t nvn)
   {
     if (curGroup.empty()) return;
     
@@ -375,9 +512,9 @@ namespace embree
       Ref<SceneGraph::SubdivMeshNode> mesh = new SceneGraph::SubdivMeshNode(curMaterial);
       group->add(mesh.cast<SceneGraph::Node>());
 
-      for (size_t i=0; i<v.size();  i++) mesh->positions.push_back(v[i]);
-      for (size_t i=0; i<vn.size(); i++) mesh->normals  .push_back(vn[i]);
-      for (size_t i=0; i<vt.size(); i++) mesh->texcoords.push_back(vt[i]);
+      for (size_t i=0; i<nv;  i++) mesh->positions.push_back(v[i]);
+      for (size_t i=0; i<nvn; i++) mesh->normals  .push_back(vn[i]);
+      for (size_t i=0; i<nvt; i++) mesh->texcoords.push_back(vt[i]);
       
       for (size_t i=0; i<ec.size(); ++i) {
         assert(ec[i].a < v.size() && ec[i].b < v.size());
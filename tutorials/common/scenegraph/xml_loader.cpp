@@ -260,7 +260,7 @@ namespace embree
   private:
     template<typename T> T load(const Ref<XML>& xml) { assert(false); return T(zero); }
     template<typename T> T load(const Ref<XML>& xml, const T& opt) { assert(false); return T(zero); }
-    char* loadBinary(const Ref<XML>& xml, size_t eltSize, size_t& size);
+    const char* loadBinary(const Ref<XML>& xml, size_t eltSize, size_t& size);
 
     std::vector<float> loadFloatArray(const Ref<XML>& xml);
     std::vector<Vec2f> loadVec2fArray(const Ref<XML>& xml);
@@ -273,7 +273,9 @@ namespace embree
 
   private:
     FileName path;         //!< path to XML file
-    FILE* binFile;         //!< .bin file for reading binary data
+    const char* binFile;   //!< memory mapped .bin file for reading binary data
+    size_t binFileSize;    //!< size of the .bin file
+    size_t binFileOfs;     //!< offset behind the last binary data read
     FileName binFileName;  //!< name of the .bin file
 
   private:
@@ -393,22 +395,21 @@ namespace embree
     }
   }
 
-  char* XMLLoader::loadBinary(const Ref<XML>& xml, size_t eltSize, size_t& size)
+  const char* XMLLoader::loadBinary(const Ref<XML>& xml, size_t eltSize, size_t& size)
   {
     if (!binFile) 
       THROW_RUNTIME_ERROR("cannot open file "+binFileName.str()+" for reading");
 
-    size_t ofs = atol(xml->parm("ofs").c_str());
-    fseek(binFile,long(ofs),SEEK_SET);
+    size_t ofs = atoll(xml->parm("ofs").c_str());
+    size = atoll(xml->parm("size").c_str());
+    if (size == 0) size = atoll(xml->parm("num").c_str()); // version for BGF format
 
-    size = atol(xml->parm("size").c_str());
-    if (size == 0) size = atol(xml->parm("num").c_str()); // version for BGF format
-    char* data = (char*) alignedMalloc(size*eltSize);
-
-    if (size != fread(data, eltSize, size, binFile)) 
+    if (ofs > binFileSize || size*eltSize > binFileSize-ofs) 
       THROW_RUNTIME_ERROR("error reading from binary file: "+binFileName.str());
 
-    return data;
+    /* data is used directly from the mapped file, pages get read in by the OS on first access */
+    binFileOfs = ofs+size*eltSize;
+    return binFile+ofs;
   }
 
   std::vector<float> XMLLoader::loadFloatArray(const Ref<XML>& xml)
@@ -419,7 +420,8 @@ namespace embree
     size_t size = 0;
     float* data = nullptr;
     if (xml->parm("ofs") != "") {
-      data = (float*)loadBinary(xml,sizeof(float),size);
+      const float* src = (const float*) loadBinary(xml,sizeof(float),size);
+      return std::vector<float>(src,src+size);
     } else {
       size_t elts = xml->body.size();
       size = elts;
@@ -441,7 +443,8 @@ namespace embree
     size_t size = 0;
     Vec2f* data = nullptr;
     if (xml->parm("ofs") != "") {
-      data = (Vec2f*)loadBinary(xml,2*sizeof(float),size);
+      const Vec2f* src = (const Vec2f*) loadBinary(xml,2*sizeof(float),size);
+      return std::vector<Vec2f>(src,src+size);
     } else {
       size_t elts = xml->body.size();
       if (elts % 2 != 0) THROW_RUNTIME_ERROR(xml->loc.str()+": wrong vector<float2> body");
@@ -464,7 +467,8 @@ namespace embree
     size_t size = 0;
     Vec3f* data = nullptr;
     if (xml->parm("ofs") != "") {
-      data = (Vec3f*) loadBinary(xml,3*sizeof(float),size);
+      const Vec3f* src = (const Vec3f*) loadBinary(xml,3*sizeof(float),size);
+      return std::vector<Vec3f>(src,src+size);
     }
     else {
       size_t elts = xml->body.size();
@@ -488,7 +492,12 @@ namespace embree
     size_t size = 0;
     Vec3fa* data = nullptr;
     if (xml->parm("ofs") != "") {
-      data = (Vec3fa*) loadBinary(xml,4*sizeof(float),size);
+      /* mapped data may not be 16 byte aligned, thus copy elementwise */
+      const float* src = (const float*) loadBinary(xml,4*sizeof(float),size);
+      std::vector<Vec3fa> res(size);
+      for (size_t i=0; i<size; i++) 
+        res[i] = Vec3fa(src[4*i+0],src[4*i+1],src[4*i+2],src[4*i+3]);
+      return res;
     }
     else {
       size_t elts = xml->body.size();
@@ -512,7 +521,8 @@ namespace embree
     size_t size = 0;
     int* data = nullptr;
     if (xml->parm("ofs") != "") {
-      data = (int*)loadBinary(xml,sizeof(int),size);
+      const int* src = (const int*) loadBinary(xml,sizeof(int),size);
+      return std::vector<int>(src,src+size);
     } else {
       size_t elts = xml->body.size();
       size = elts;
@@ -534,7 +544,8 @@ namespace embree
     size_t size = 0;
     Vec2i* data = nullptr;
     if (xml->parm("ofs") != "") {
-      data = (Vec2i*) loadBinary(xml,2*sizeof(int),size);
+      const Vec2i* src = (const Vec2i*) loadBinary(xml,2*sizeof(int),size);
+      return std::vector<Vec2i>(src,src+size);
     }
     else {
       size_t elts = xml->body.size();
@@ -558,7 +569,8 @@ namespace embree
     size_t size = 0;
     Vec3i* data = nullptr;
     if (xml->parm("ofs") != "") {
-      data = (Vec3i*) loadBinary(xml,3*sizeof(int),size);
+      const Vec3i* src = (const Vec3i*) loadBinary(xml,3*sizeof(int),size);
+      return std::vector<Vec3i>(src,src+size);
     }
     else {
       size_t elts = xml->body.size();
@@ -582,7 +594,8 @@ namespace embree
     size_t size = 0;
     Vec4i* data = nullptr;
     if (xml->parm("ofs") != "") {
-      data = (Vec4i*) loadBinary(xml,4*sizeof(int),size);
+      const Vec4i* src = (const Vec4i*) loadBinary(xml,4*sizeof(int),size);
+      return std::vector<Vec4i>(src,src+size);
     }
     else {
       size_t elts = xml->body.size();
@@ -686,8 +699,11 @@ namespace embree
       const Texture::Format format = Texture::string_to_format(xml->parm("format"));
       const size_t bytesPerTexel = Texture::getFormatBytesPerTexel(format);
       texture = new Texture(width,height,format);
-      if (width*height != fread(texture->data, bytesPerTexel, width*height, binFile)) 
+      if (xml->parm("ofs") != "") binFileOfs = atoll(xml->parm("ofs").c_str());
+      if (!binFile || binFileOfs > binFileSize || width*height*bytesPerTexel > binFileSize-binFileOfs)
         THROW_RUNTIME_ERROR("error reading from binary file: "+binFileName.str());
+      memcpy(texture->data,binFile+binFileOfs,width*height*bytesPerTexel);
+      binFileOfs += width*height*bytesPerTexel;
     }
     
     if (id != "") textureMap[id] = texture;
@@ -1125,14 +1141,14 @@ namespace embree
     XMLLoader loader(fileName,space); return loader.root;
   }
 
-  XMLLoader::XMLLoader(const FileName& fileName, const AffineSpace3fa& space) : binFile(nullptr), currentNodeID(0)
+  XMLLoader::XMLLoader(const FileName& fileName, const AffineSpace3fa& space) : binFile(nullptr), binFileSize(0), binFileOfs(0), currentNodeID(0)
   {
     path = fileName.path();
     binFileName = fileName.setExt(".bin");
-    binFile = fopen(binFileName.c_str(),"rb");
+    binFile = (const char*) os_map_file(binFileName.c_str(),binFileSize);
     if (!binFile) {
       binFileName = fileName.addExt(".bin");
-      binFile = fopen(binFileName.c_str(),"rb");
+      binFile = (const char*) os_map_file(binFileName.c_str(),binFileSize);
     }
 
     Ref<XML> xml = parseXML(fileName);
@@ -1161,7 +1177,7 @@ namespace embree
   }
 
   XMLLoader::~XMLLoader() {
-    if (binFile) fclose(binFile);
+    if (binFile) os_unmap_file((void*)binFile,binFileSize);
   }
 
   /*! read from disk */
@@ -19,7 +19,8 @@
 #include "../scenegraph/texture.h"
 #include "scene_device.h"
 
-/* the scene to render */
+/* the device and scene to render */
+extern RTCDevice g_device;
 extern RTCScene g_scene;
 
 /* global subdivision level for subdivision geometry */
@@ -29,6 +30,9 @@ unsigned int g_subdivision_levels = 0;
 //float scale = 0.001f;
 float scale = 1.0f / 1000000.0f;
 
+/* scaling of the traversal statistics heatmap */
+float cost_scale = 1.0f / 256.0f;
+
 extern "C" bool g_changed = false;
 
 /* stores pointer to currently used rendePixel function */
@@ -222,6 +226,32 @@ Vec3fa renderPixelCycles(float x, float y, const Vec3fa& vx, const Vec3fa& vy, c
   return Vec3fa((float)(c1-c0)*scale,0.0f,0.0f);
 }
 
+/* renders a heatmap of the number of traversal steps of a ray */
+Vec3fa renderPixelTraversalCost(float x, float y, const Vec3fa& vx, const Vec3fa& vy, const Vec3fa& vz, const Vec3fa& p)
+{
+  /* initialize ray */
+  RTCRay ray;
+  ray.org = p;
+  ray.dir = normalize(x*vx + y*vy + vz);
+  ray.tnear = 0.0f;
+  ray.tfar = inf;
+  ray.geomID = RTC_INVALID_GEOMETRY_ID;
+  ray.primID = RTC_INVALID_GEOMETRY_ID;
+  ray.mask = -1;
+  ray.time = g_debug;
+
+  /* intersect ray with scene and count traversal steps */
+  RTCTraversalStatistics s0, s1;
+  rtcGetThreadTraversalStatistics(&s0,nullptr);
+  rtcIntersect(g_scene,ray);
+  rtcGetThreadTraversalStatistics(&s1,nullptr);
+  const float cost = float((s1.nodes-s0.nodes) + (s1.leaves-s0.leaves) + (s1.prims-s0.prims));
+
+  /* map cost to blue-green-red color ramp */
+  const float c = clamp(cost*cost_scale,0.0f,1.0f);
+  return Vec3fa(clamp(2.0f*c-1.0f,0.0f,1.0f),1.0f-abs(2.0f*c-1.0f),clamp(1.0f-2.0f*c,0.0f,1.0f));
+}
+
 /* renders a single pixel with UV shading */
 Vec3fa renderPixelUV16(float x, float y, const Vec3fa& vx, const Vec3fa& vy, const Vec3fa& vz, const Vec3fa& p)
 {
@@ -401,6 +431,10 @@ extern "C" void device_key_pressed_default(int key)
     g_changed = true;
   }
   else if (key == GLUT_KEY_F12) {
+    if (renderPixel == renderPixelTraversalCost) cost_scale *= 0.5f;
+    PRINT(cost_scale);
+    rtcDeviceSetParameter1i(g_device,RTC_TRAVERSAL_STATISTICS,1);
+    renderPixel = renderPixelTraversalCost;
     g_changed = true;
   }
 }